@@ -75,6 +75,12 @@ public:
   WasmImageType *
   GetOutput(unsigned int idx);
 
+  /** Generate the JSON representation in addition to the binary
+   * descriptor. On by default. */
+  itkSetMacro(GenerateJSON, bool);
+  itkGetConstMacro(GenerateJSON, bool);
+  itkBooleanMacro(GenerateJSON);
+
 protected:
   ImageToWasmImageFilter();
   ~ImageToWasmImageFilter() override = default;
@@ -92,6 +98,9 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool m_GenerateJSON{ true };
 };
 } // end namespace itk
 
@@ -143,6 +143,47 @@ ImageToWasmImageFilter<TImage>
   using ConvertPixelTraits = DefaultConvertPixelTraits<IOPixelType>;
   using ComponentType = typename ConvertPixelTraits::ComponentType;
 
+  const auto & dictionary = image->GetMetaDataDictionary();
+  if constexpr (ImageType::ImageDimension <= wasm::WasmDescriptorMaximumDimension)
+  {
+    auto descriptor = wasm::makeWasmDescriptor<wasm::WasmImageDescriptor>();
+    descriptor.dimension = ImageType::ImageDimension;
+    descriptor.componentType = wasm::descriptorComponentType(wasm::MapComponentType<ComponentType>::ComponentString);
+    descriptor.pixelType = wasm::descriptorPixelType(wasm::MapPixelType<PixelType>::PixelString);
+    descriptor.components = image->GetNumberOfComponentsPerPixel();
+
+    const auto largestRegion = image->GetLargestPossibleRegion();
+    PointType imageOrigin;
+    image->TransformIndexToPhysicalPoint(largestRegion.GetIndex(), imageOrigin);
+    const auto imageSize = image->GetBufferedRegion().GetSize();
+    for( unsigned int ii = 0; ii < ImageType::ImageDimension; ++ii )
+      {
+      descriptor.origin[ii] = imageOrigin[ii];
+      descriptor.spacing[ii] = image->GetSpacing()[ii];
+      descriptor.size[ii] = imageSize[ii];
+      }
+    descriptor.direction = reinterpret_cast< size_t >( image->GetDirection().GetVnlMatrix().begin() );
+    descriptor.data = reinterpret_cast< size_t >( image->GetBufferPointer() );
+
+    if (!dictionary.GetKeys().empty())
+      {
+      rapidjson::Document metadataDocument(rapidjson::kArrayType);
+      wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataDocument, metadataDocument.GetAllocator());
+      rapidjson::StringBuffer metadataBuffer;
+      rapidjson::Writer<rapidjson::StringBuffer> metadataWriter(metadataBuffer);
+      metadataDocument.Accept(metadataWriter);
+      imageJSON->SetMetadataJSON(std::string(metadataBuffer.GetString(), metadataBuffer.GetSize()));
+      descriptor.metadata.address = reinterpret_cast< size_t >( imageJSON->GetMetadataJSON().data() );
+      descriptor.metadata.size = imageJSON->GetMetadataJSON().size();
+      }
+    imageJSON->SetDescriptor(&descriptor.header);
+  }
+
+  if (!this->m_GenerateJSON)
+  {
+    return;
+  }
+
   rapidjson::Document document;
   document.SetObject();
   rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
@@ -196,7 +237,7 @@ ImageToWasmImageFilter<TImage>
   const auto imageSize = image->GetBufferedRegion().GetSize();
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    size.PushBack(rapidjson::Value().SetInt(imageSize[ii]), allocator);
+    size.PushBack(rapidjson::Value().SetUint64(imageSize[ii]), allocator);
     }
 
   document.AddMember( "size", size.Move(), allocator );
@@ -209,7 +250,6 @@ ImageToWasmImageFilter<TImage>
   dataString.SetString( dataStream.str().c_str(), allocator );
   document.AddMember( "data", dataString.Move(), allocator );
 
-  auto dictionary = image->GetMetaDataDictionary();
   rapidjson::Value metadataJson(rapidjson::kArrayType);
   wasm::ConvertMetaDataDictionaryToJSON(dictionary, metadataJson, allocator);
   document.AddMember( "metadata", metadataJson.Move(), allocator );
@@ -227,6 +267,7 @@ ImageToWasmImageFilter<TImage>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateJSON: " << this->m_GenerateJSON << std::endl;
 }
 } // end namespace itk
 
@@ -20,19 +20,19 @@
 
 #include "itkPipeline.h"
 #include "itkWasmStringStream.h"
+#include "itkWasmMemoryStreamBuffer.h"
 
+#include <cstddef>
+#include <memory>
+#include <span>
 #include <string>
-#ifndef ITK_WASM_NO_MEMORY_IO
-#include <sstream>
-#endif
-#ifndef ITK_WASM_NO_FILESYSTEM_IO
-#include <fstream>
-#endif
 
 #include "WebAssemblyInterfaceExport.h"
 
 namespace itk
 {
+class WasmMemoryMappedFile;
+
 namespace wasm
 {
 
@@ -42,7 +42,10 @@ namespace wasm
  *
  * This stream is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
  *
- * Call `Get()` to get the std::istream & to use an input to a pipeline.
+ * Call `Get()` to get the std::istream & to use an input to a pipeline. With
+ * memory IO, the stream reads the input array in place, without a copy.
+ *
+ * Call `GetSpan()` to access the bytes directly, without an std::istream.
  *
  * \ingroup WebAssemblyInterface
  */
@@ -53,42 +56,37 @@ public:
     return *m_IStream;
   }
 
-  void SetJSON(const std::string & json)
-  {
-    if (m_DeleteIStream && m_IStream != nullptr)
-    {
-      delete m_IStream;
-    }
-    m_DeleteIStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-    m_WasmStringStream->SetJSON(json.c_str());
-
-    m_IStream = &(m_WasmStringStream->GetStringStream());
-  }
+  /** The complete input. Memory IO inputs are viewed in place; files are
+   * memory mapped on the first call. The bytes are valid for the lifetime of
+   * this object. */
+  std::span<const std::byte> GetSpan();
 
-  void SetFileName(const std::string & fileName)
+  void SetJSON(const std::string & json);
+
+  void SetFileName(const std::string & fileName);
+
+  InputBinaryStream();
+  ~InputBinaryStream();
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
   {
-    if (m_DeleteIStream && m_IStream != nullptr)
-    {
-      delete m_IStream;
-    }
-    m_IStream = new std::ifstream(fileName, std::ifstream::in | std::ifstream::binary);
-    m_DeleteIStream = true;
+    this->m_MemoryContext = context;
   }
-
-  InputBinaryStream() = default;
-  ~InputBinaryStream()
+  WasmMemoryContext * GetMemoryContext() const
   {
-    if (m_DeleteIStream && m_IStream != nullptr)
-    {
-      delete m_IStream;
-    }
+    return this->m_MemoryContext;
   }
 protected:
+  void DeleteIStream();
+
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   std::istream * m_IStream{nullptr};
   bool m_DeleteIStream{false};
 
-  WasmStringStream::Pointer m_WasmStringStream;
+  std::string m_FileName;
+  std::span<const std::byte> m_Span;
+  std::unique_ptr<WasmMemoryMappedFile> m_MappedFile;
 };
 
 
@@ -60,7 +60,18 @@ public:
 
   InputImage() = default;
   ~InputImage() = default;
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TImage::ConstPointer m_Image;
 };
 
@@ -73,15 +84,22 @@ bool lexical_cast(const std::string &input, InputImage<TImage> &inputImage)
     return false;
   }
 
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputImage.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     using WasmImageToImageFilterType = WasmImageToImageFilter<TImage>;
     auto wasmImageToImageFilter = WasmImageToImageFilterType::New();
     auto wasmImage = WasmImageToImageFilterType::WasmImageType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    wasmImage->SetJSON(json);
+    if (const auto * descriptor = inputImage.GetMemoryContext()->GetInputDescriptor(index))
+    {
+      wasmImage->SetDescriptor(descriptor);
+    }
+    else
+    {
+      const char * json = inputImage.GetMemoryContext()->GetInputJSON(index);
+      wasmImage->SetJSON(json);
+    }
     wasmImageToImageFilter->SetInput(wasmImage);
     wasmImageToImageFilter->Update();
     inputImage.Set(wasmImageToImageFilter->GetOutput());
@@ -56,7 +56,18 @@ public:
 
   InputImageIO() = default;
   ~InputImageIO() = default;
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename WasmImageIOBase::ConstPointer m_WasmImageIOBase;
 };
 
@@ -68,13 +79,13 @@ bool lexical_cast(const std::string &input, InputImageIO &inputImageIO)
     return false;
   }
 
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputImageIO.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    const char * json = inputImageIO.GetMemoryContext()->GetInputJSON(index);
     rapidjson::Document document;
-    document.Parse(json.c_str());
+    document.Parse(json);
 
     auto wasmImageIO = itk::WasmImageIO::New();
     wasmImageIO->SetJSON(document);
@@ -94,10 +105,8 @@ bool lexical_cast(const std::string &input, InputImageIO &inputImageIO)
     const char * dataPtr = reinterpret_cast< char * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
     if (dataPtr != nullptr)
     {
-      WasmImageIOBase::PixelDataContainerType * pixelDataContainer = wasmImageIOBase->GetPixelDataContainer();
-      const size_t pixelDataBytes = wasmImageIO->GetImageSizeInBytes();
-      pixelDataContainer->resize(pixelDataBytes);
-      pixelDataContainer->assign(dataPtr, dataPtr + pixelDataBytes);
+      // The input array is owned by the memory context, so it is only referenced
+      wasmImageIOBase->ImportPixelData(dataPtr, wasmImageIO->GetImageSizeInBytes());
     }
     wasmImageIOBase->SetImageIO(wasmImageIO, false);
     wasmImageIOBase->SetJSON(json);
@@ -112,6 +121,8 @@ bool lexical_cast(const std::string &input, InputImageIO &inputImageIO)
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
     auto wasmImageIO = itk::WasmImageIO::New();
     wasmImageIO->SetFileName(input);
+    // The pixel buffer is only read, so it can refer to the mapped file
+    wasmImageIO->UseMemoryMappingOn();
 
     auto wasmImageIOBase = itk::WasmImageIOBase::New();
     wasmImageIOBase->SetImageIO(wasmImageIO);
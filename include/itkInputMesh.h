@@ -60,7 +60,18 @@ public:
 
   InputMesh() = default;
   ~InputMesh() = default;
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TMesh::ConstPointer m_Mesh;
 };
 
@@ -73,15 +84,22 @@ bool lexical_cast(const std::string &input, InputMesh<TMesh> &inputMesh)
     return false;
   }
 
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputMesh.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     using WasmMeshToMeshFilterType = WasmMeshToMeshFilter<TMesh>;
     auto wasmMeshToMeshFilter = WasmMeshToMeshFilterType::New();
     auto wasmMesh = WasmMeshToMeshFilterType::WasmMeshType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    wasmMesh->SetJSON(json);
+    if (const auto * descriptor = inputMesh.GetMemoryContext()->GetInputDescriptor(index))
+    {
+      wasmMesh->SetDescriptor(descriptor);
+    }
+    else
+    {
+      const char * json = inputMesh.GetMemoryContext()->GetInputJSON(index);
+      wasmMesh->SetJSON(json);
+    }
     wasmMeshToMeshFilter->SetInput(wasmMesh);
     wasmMeshToMeshFilter->Update();
     inputMesh.Set(wasmMeshToMeshFilter->GetOutput());
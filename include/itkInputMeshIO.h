@@ -57,7 +57,18 @@ public:
 
   InputMeshIO() = default;
   ~InputMeshIO() = default;
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename WasmMeshIOBase::ConstPointer m_WasmMeshIOBase;
 };
 
@@ -69,13 +80,13 @@ bool lexical_cast(const std::string &input, InputMeshIO &inputMeshIO)
     return false;
   }
 
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputMeshIO.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    const char * json = inputMeshIO.GetMemoryContext()->GetInputJSON(index);
     rapidjson::Document document;
-    document.Parse(json.c_str());
+    document.Parse(json);
 
     auto wasmMeshIO = itk::WasmMeshIO::New();
     wasmMeshIO->SetJSON(document);
@@ -62,7 +62,18 @@ public:
 
   InputPolyData() = default;
   ~InputPolyData() = default;
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TPolyData::ConstPointer m_PolyData;
 };
 
@@ -75,15 +86,22 @@ bool lexical_cast(const std::string &input, InputPolyData<TPolyData> &inputPolyD
     return false;
   }
 
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputPolyData.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     using WasmPolyDataToPolyDataFilterType = WasmPolyDataToPolyDataFilter<TPolyData>;
     auto wasmPolyDataToPolyDataFilter = WasmPolyDataToPolyDataFilterType::New();
     auto wasmPolyData = WasmPolyDataToPolyDataFilterType::WasmPolyDataType::New();
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
-    wasmPolyData->SetJSON(json);
+    if (const auto * descriptor = inputPolyData.GetMemoryContext()->GetInputDescriptor(index))
+    {
+      wasmPolyData->SetDescriptor(descriptor);
+    }
+    else
+    {
+      const char * json = inputPolyData.GetMemoryContext()->GetInputJSON(index);
+      wasmPolyData->SetJSON(json);
+    }
     wasmPolyDataToPolyDataFilter->SetInput(wasmPolyData);
     wasmPolyDataToPolyDataFilter->Update();
     inputPolyData.Set(wasmPolyDataToPolyDataFilter->GetOutput());
@@ -20,6 +20,7 @@
 
 #include "itkPipeline.h"
 #include "itkWasmStringStream.h"
+#include "itkWasmMemoryStreamBuffer.h"
 
 #include <string>
 #include <sstream>
@@ -38,7 +39,8 @@ namespace wasm
  *
  * This stream is read from the filesystem or memory when ITK_WASM_PARSE_ARGS is called.
  *
- * Call `Get()` to get the std::istream & to use an input to a pipeline.
+ * Call `Get()` to get the std::istream & to use an input to a pipeline. With
+ * memory IO, the stream reads the input array in place, without a copy.
  *
  * \ingroup WebAssemblyInterface
  */
@@ -55,15 +57,13 @@ public:
 
   void SetJSON(const std::string & json)
   {
+    const std::string_view data = WasmStringStream::GetDataFromJSON(json.c_str());
     if (m_DeleteIStream && m_IStream != nullptr)
     {
       delete m_IStream;
     }
-    m_DeleteIStream = false;
-    m_WasmStringStream = WasmStringStream::New();
-    m_WasmStringStream->SetJSON(json.c_str());
-
-    m_IStream = &(m_WasmStringStream->GetStringStream());
+    m_IStream = new WasmMemoryInputStream(data.data(), data.size());
+    m_DeleteIStream = true;
   }
 
   void SetFileName(const std::string & fileName)
@@ -84,11 +84,20 @@ public:
       delete m_IStream;
     }
   }
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   std::istream * m_IStream{nullptr};
   bool m_DeleteIStream{false};
-
-  WasmStringStream::Pointer m_WasmStringStream;
 };
 
 
@@ -136,6 +136,52 @@ MeshToWasmMeshFilter<TMesh>
 
   wasmMesh->SetMesh(mesh);
 
+  {
+    using PointPixelType = typename TMesh::PixelType;
+    using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+    using CellPixelType = typename TMesh::CellPixelType;
+    using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
+
+    auto descriptor = wasm::makeWasmDescriptor<wasm::WasmMeshDescriptor>();
+    descriptor.dimension = MeshType::PointDimension;
+    descriptor.pointComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename MeshType::CoordRepType>::ComponentString);
+    descriptor.pointPixelComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString);
+    descriptor.pointPixelType = wasm::descriptorPixelType(wasm::MapPixelType<PointPixelType>::PixelString);
+    descriptor.pointPixelComponents = ConvertPointPixelTraits::GetNumberOfComponents();
+    descriptor.cellComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename MeshType::CellsVectorContainer::Element>::ComponentString);
+    descriptor.cellPixelComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString);
+    descriptor.cellPixelType = wasm::descriptorPixelType(wasm::MapPixelType<CellPixelType>::PixelString);
+    descriptor.cellPixelComponents = ConvertCellPixelTraits::GetNumberOfComponents();
+
+    descriptor.numberOfPoints = mesh->GetNumberOfPoints();
+    descriptor.numberOfPointPixels = mesh->GetPointData() == nullptr ? 0 : mesh->GetPointData()->Size();
+    descriptor.numberOfCells = mesh->GetNumberOfCells();
+    descriptor.numberOfCellPixels = mesh->GetCellData() == nullptr ? 0 : mesh->GetCellData()->Size();
+    descriptor.cellBufferSize = wasmMesh->GetCellBuffer()->Size();
+    if (descriptor.numberOfPoints > 0)
+    {
+      descriptor.points = reinterpret_cast< size_t >( &(mesh->GetPoints()->at(0)) );
+    }
+    if (descriptor.cellBufferSize > 0)
+    {
+      descriptor.cells = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
+    }
+    if (descriptor.numberOfPointPixels > 0)
+    {
+      descriptor.pointData = reinterpret_cast< size_t >( &(mesh->GetPointData()->at(0)) );
+    }
+    if (descriptor.numberOfCellPixels > 0)
+    {
+      descriptor.cellData = reinterpret_cast< size_t >( &(mesh->GetCellData()->at(0)) );
+    }
+    wasmMesh->SetDescriptor(&descriptor.header);
+  }
+
+  if (!this->m_GenerateJSON)
+  {
+    return;
+  }
+
   rapidjson::Document document;
   document.SetObject();
   rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
@@ -181,37 +227,37 @@ MeshToWasmMeshFilter<TMesh>
   document.AddMember( "meshType", meshType.Move(), allocator );
 
   rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( mesh->GetNumberOfPoints() );
+  numberOfPoints.SetUint64( mesh->GetNumberOfPoints() );
   document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
 
   rapidjson::Value numberOfPointPixels;
   if (mesh->GetPointData() == nullptr)
   {
-    numberOfPointPixels.SetInt( 0 );
+    numberOfPointPixels.SetUint64( 0 );
   }
   else
   {
-    numberOfPointPixels.SetInt( mesh->GetPointData()->Size() );
+    numberOfPointPixels.SetUint64( mesh->GetPointData()->Size() );
   }
   document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
 
   rapidjson::Value numberOfCells;
-  numberOfCells.SetInt( mesh->GetNumberOfCells() );
+  numberOfCells.SetUint64( mesh->GetNumberOfCells() );
   document.AddMember( "numberOfCells", numberOfCells.Move(), allocator );
 
   rapidjson::Value numberOfCellPixels;
   if (mesh->GetCellData() == nullptr)
   {
-    numberOfCellPixels.SetInt( 0 );
+    numberOfCellPixels.SetUint64( 0 );
   }
   else
   {
-    numberOfCellPixels.SetInt( mesh->GetCellData()->Size() );
+    numberOfCellPixels.SetUint64( mesh->GetCellData()->Size() );
   }
   document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
 
   rapidjson::Value cellBufferSizeMember;
-  cellBufferSizeMember.SetInt( wasmMesh->GetCellBuffer()->Size() );
+  cellBufferSizeMember.SetUint64( wasmMesh->GetCellBuffer()->Size() );
   document.AddMember( "cellBufferSize", cellBufferSizeMember.Move(), allocator );
 
   const auto pointsAddress = reinterpret_cast< size_t >( &(mesh->GetPoints()->at(0)) );
@@ -271,6 +317,7 @@ MeshToWasmMeshFilter<TMesh>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateJSON: " << this->m_GenerateJSON << std::endl;
 }
 } // end namespace itk
 
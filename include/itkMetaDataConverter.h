@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMetaDataConverter_h
+#define itkMetaDataConverter_h
+
+#include "itkMetaDataDictionary.h"
+#include "itkMetaDataObject.h"
+#include "itkWasmCBORStream.h"
+
+#include "rapidjson/document.h"
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "cbor.h"
+
+#include <functional>
+#include <string>
+#include <typeinfo>
+#include <utility>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Conversion of the value of a MetaDataObject<T> to and from the JSON and
+ * CBOR representations of a metadata dictionary.
+ *
+ * The encoders write the value of object, an instance of MetaDataObject<T>.
+ * The decoders add key with the value decoded from valueJson or item to the
+ * dictionary. The matchers tell whether valueJson or item is a value of T,
+ * for value types that are not recognized from the shape of the value, see
+ * RegisterMetaDataConverter. Any of them may be empty, e.g. for values that
+ * are only encoded, or only converted in one of the representations. */
+struct MetaDataConverter
+{
+  using JSONEncoderType = std::function<void(const MetaDataObjectBase & object, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator)>;
+  using JSONDecoderType = std::function<void(const std::string & key, const rapidjson::Value & valueJson, MetaDataDictionary & dictionary)>;
+  using JSONMatcherType = std::function<bool(const rapidjson::Value & valueJson)>;
+  using CBOREncoderType = std::function<void(const MetaDataObjectBase & object, WasmCBORStreamWriter & writer)>;
+  using CBORDecoderType = std::function<void(const std::string & key, const cbor_item_t * item, MetaDataDictionary & dictionary)>;
+  using CBORMatcherType = std::function<bool(const cbor_item_t * item)>;
+
+  JSONEncoderType jsonEncoder;
+  JSONDecoderType jsonDecoder;
+  JSONMatcherType jsonMatcher;
+  CBOREncoderType cborEncoder;
+  CBORDecoderType cborDecoder;
+  CBORMatcherType cborMatcher;
+};
+
+/** Register the converter of MetaDataObject values of type valueType,
+ * replacing any previous one, so that dictionaries with custom value types
+ * can be converted to and from JSON and CBOR. Entries whose value type has
+ * no encoder for a representation are skipped.
+ *
+ * Neither representation records the value type. When decoding, the
+ * matchers of the registered converters are consulted first, the most
+ * recently registered first, and the decoder of the first converter that
+ * matches the value is used. Otherwise the type is recognized from the
+ * value, as described by ConvertJSONToMetaDataDictionary and
+ * ConvertCBORToMetaDataDictionary. Decoders of other value types need a
+ * matcher.
+ *
+ * Register converters before converting dictionaries concurrently. */
+WebAssemblyInterface_EXPORT void RegisterMetaDataConverter(const std::type_info & valueType, MetaDataConverter converter);
+
+/** Converter of values of type valueType, or nullptr. */
+WebAssemblyInterface_EXPORT const MetaDataConverter * GetMetaDataConverter(const std::type_info & valueType);
+
+/** Conversion of TValue values, as functions of the value, for
+ * RegisterMetaDataConverter<TValue>. */
+template <typename TValue>
+struct MetaDataValueConverter
+{
+  std::function<void(const TValue & value, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator)> encodeJSON;
+  std::function<TValue(const rapidjson::Value & valueJson)> decodeJSON;
+  MetaDataConverter::JSONMatcherType matchJSON;
+  std::function<void(const TValue & value, WasmCBORStreamWriter & writer)> encodeCBOR;
+  std::function<TValue(const cbor_item_t * item)> decodeCBOR;
+  MetaDataConverter::CBORMatcherType matchCBOR;
+};
+
+/** Register the converter of MetaDataObject<TValue> values from functions
+ * of the value. */
+template <typename TValue>
+void
+RegisterMetaDataConverter(MetaDataValueConverter<TValue> valueConverter)
+{
+  MetaDataConverter converter;
+  if (valueConverter.encodeJSON)
+  {
+    converter.jsonEncoder = [encode = std::move(valueConverter.encodeJSON)](const MetaDataObjectBase & object, rapidjson::Value & valueJson, rapidjson::Document::AllocatorType & allocator) {
+      encode(static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue(), valueJson, allocator);
+    };
+  }
+  if (valueConverter.decodeJSON)
+  {
+    converter.jsonDecoder = [decode = std::move(valueConverter.decodeJSON)](const std::string & key, const rapidjson::Value & valueJson, MetaDataDictionary & dictionary) {
+      EncapsulateMetaData<TValue>(dictionary, key, decode(valueJson));
+    };
+  }
+  converter.jsonMatcher = std::move(valueConverter.matchJSON);
+  if (valueConverter.encodeCBOR)
+  {
+    converter.cborEncoder = [encode = std::move(valueConverter.encodeCBOR)](const MetaDataObjectBase & object, WasmCBORStreamWriter & writer) {
+      encode(static_cast<const MetaDataObject<TValue> &>(object).GetMetaDataObjectValue(), writer);
+    };
+  }
+  if (valueConverter.decodeCBOR)
+  {
+    converter.cborDecoder = [decode = std::move(valueConverter.decodeCBOR)](const std::string & key, const cbor_item_t * item, MetaDataDictionary & dictionary) {
+      EncapsulateMetaData<TValue>(dictionary, key, decode(item));
+    };
+  }
+  converter.cborMatcher = std::move(valueConverter.matchCBOR);
+  RegisterMetaDataConverter(typeid(TValue), std::move(converter));
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,67 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMetaDataDictionaryCBOR_h
+#define itkMetaDataDictionaryCBOR_h
+
+#include "itkMetaDataDictionary.h"
+#include "itkMetaDataConverter.h"
+#include "itkWasmCBORStream.h"
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "cbor.h"
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Write the dictionary as a CBOR map from keys to values.
+ *
+ * Booleans, integers, floating point numbers and strings are written as
+ * the corresponding CBOR data items, with float values kept in single
+ * precision. Numeric std::vector and itk::Array values are written as
+ * RFC 8746 typed arrays, i.e. a tagged bytestring of the values, with the
+ * tags used for the image data. std::vector of std::vector values are
+ * arrays of typed arrays, and itk::Matrix values are RFC 8746 row-major
+ * multi-dimensional arrays. std::vector of std::string values, and
+ * std::vector of those, are arrays of text strings.
+ *
+ * Other value types are written with the CBOR encoders of the registered
+ * converters, see RegisterMetaDataConverter. Entries of value types
+ * without a CBOR encoder are skipped. */
+WebAssemblyInterface_EXPORT void ConvertMetaDataDictionaryToCBOR(const itk::MetaDataDictionary & dictionary, WasmCBORStreamWriter & writer);
+
+/** Add the entries of a CBOR map written by ConvertMetaDataDictionaryToCBOR
+ * to the dictionary.
+ *
+ * Values that a registered CBOR matcher accepts are decoded by its
+ * converter. Otherwise typed arrays are decoded into a std::vector of their
+ * element type, and float and double matrices of dimension 2, 3 or 4 into
+ * an itk::Matrix, other matrices into a std::vector of std::vector. As with
+ * JSON, integers are decoded into the narrowest of int, unsigned int,
+ * int64_t and uint64_t that holds the value. Entries of unsupported CBOR
+ * data items, and matrices whose shape does not match their values, are
+ * skipped. */
+WebAssemblyInterface_EXPORT void ConvertCBORToMetaDataDictionary(const cbor_item_t * metadataItem, itk::MetaDataDictionary & dictionary);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
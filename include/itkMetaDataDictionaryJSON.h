@@ -21,6 +21,7 @@
 #include "itkMetaDataDictionary.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
+#include "itkMetaDataConverter.h"
 #include "itkArray.h"
 #include "itkMatrix.h"
 
@@ -34,8 +35,20 @@ namespace itk
 namespace wasm
 {
 
+/** Append the dictionary entries to the metadataJson array, as [ key, value ]
+ * arrays, with the JSON encoders of the registered converters, see
+ * RegisterMetaDataConverter. Entries of value types without a JSON encoder
+ * are skipped. */
 WebAssemblyInterface_EXPORT void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator);
 
+/** Add the entries of a metadataJson array to the dictionary.
+ *
+ * Values that a registered JSON matcher accepts are decoded by its
+ * converter. Otherwise the value type is inferred from the JSON value:
+ * bool, int, unsigned int, int64_t, uint64_t, double or std::string, or a
+ * std::vector or std::vector of std::vector of these, where numbers take
+ * the narrowest type that holds every element. Matrices are decoded as a
+ * std::vector of std::vector. */
 WebAssemblyInterface_EXPORT void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary);
 
 } // end namespace wasm
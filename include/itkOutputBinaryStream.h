@@ -42,7 +42,9 @@ namespace wasm
  *
  * This stream is written to the filesystem or memory when the object goes out of scope.
  * 
- * Call `Get()` to get the std::ostream & to use an output for a pipeline.
+ * Call `Get()` to get the std::ostream & to use an output for a pipeline,
+ * or `Write()` to append bytes directly. With memory IO, the output is
+ * written into a growable buffer that is exported without a copy.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -53,6 +55,30 @@ public:
     return *m_OStream;
   }
 
+  /** Append size bytes to the output without formatting. With memory IO,
+   * they are copied directly into the exported output buffer. */
+  void Write(const void * data, size_t size)
+  {
+    if (m_WasmStringStream)
+    {
+      m_WasmStringStream->GetOutputBuffer().Append(data, size);
+    }
+    else
+    {
+      m_OStream->write(static_cast< const char * >(data), static_cast< std::streamsize >(size));
+    }
+  }
+
+  /** Reserve memory IO output capacity, e.g. for an upper bound on the
+   * output size that is known before writing. */
+  void Reserve(size_t size)
+  {
+    if (m_WasmStringStream)
+    {
+      m_WasmStringStream->GetOutputBuffer().Reserve(size);
+    }
+  }
+
   void SetFileName(const std::string & fileName)
   {
     if (m_DeleteOStream && m_OStream != nullptr)
@@ -76,7 +102,7 @@ public:
     m_DeleteOStream = false;
     m_WasmStringStream = WasmStringStream::New();
 
-    m_OStream = &(m_WasmStringStream->GetStringStream());
+    m_OStream = &(m_WasmStringStream->GetOutputStream());
     this->m_Identifier = identifier;
   }
   const std::string & GetIdentifier() const
@@ -84,7 +110,17 @@ public:
     return this->m_Identifier;
   }
 
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   std::ostream * m_OStream{nullptr};
   bool m_DeleteOStream{false};
 
@@ -69,7 +69,7 @@ public:
 
   OutputImage() = default;
   ~OutputImage() {
-    if(wasm::Pipeline::get_use_memory_io())
+    if(this->m_MemoryContext->GetUseMemoryIO())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
     if (!this->m_Image.IsNull() && !this->m_Identifier.empty())
@@ -77,19 +77,20 @@ public:
         using ImageToWasmImageFilterType = ImageToWasmImageFilter<ImageType>;
         auto imageToWasmImageFilter = ImageToWasmImageFilterType::New();
         imageToWasmImageFilter->SetInput(this->m_Image);
+        imageToWasmImageFilter->SetGenerateJSON(this->m_MemoryContext->GetUseOutputJSON());
         imageToWasmImageFilter->Update();
         auto wasmImage = imageToWasmImageFilter->GetOutput();
         const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmImage);
+        this->m_MemoryContext->SetOutputDataObject(index, wasmImage);
 
         const auto dataAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetBufferPointer() );
         using ConvertPixelTraits = DefaultConvertPixelTraits<typename ImageType::PixelType>;
         const auto dataSize = wasmImage->GetImage()->GetPixelContainer()->Size() * sizeof(typename ConvertPixelTraits::ComponentType);
-        setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+        this->m_MemoryContext->SetOutputArray(index, 0, dataAddress, dataSize);
 
         const auto directionAddress = reinterpret_cast< size_t >( wasmImage->GetImage()->GetDirection().GetVnlMatrix().begin() );
         const auto directionSize = wasmImage->GetImage()->GetDirection().GetVnlMatrix().size() * sizeof(double);
-        setMemoryStoreOutputArray(0, index, 1, directionAddress, directionSize);
+        this->m_MemoryContext->SetOutputArray(index, 1, directionAddress, directionSize);
       }
 #else
     std::cerr << "Memory IO not supported" << std::endl;
@@ -109,7 +110,18 @@ public:
 #endif
     }
   }
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TImage::ConstPointer m_Image;
 
   std::string m_Identifier;
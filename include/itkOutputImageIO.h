@@ -72,7 +72,7 @@ public:
 
   OutputImageIO() = default;
   ~OutputImageIO() {
-    if(wasm::Pipeline::get_use_memory_io())
+    if(this->m_MemoryContext->GetUseMemoryIO())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
     if (!this->m_ImageIO.IsNull() && !this->m_Identifier.empty())
@@ -80,20 +80,20 @@ public:
     const auto index = std::stoi(this->m_Identifier);
     auto wasmImageIOBase = itk::WasmImageIOBase::New();
     wasmImageIOBase->SetImageIO(this->m_ImageIO);
-    setMemoryStoreOutputDataObject(0, index, wasmImageIOBase);
+    this->m_MemoryContext->SetOutputDataObject(index, wasmImageIOBase);
 
     const auto directionAddress = reinterpret_cast< size_t >( &(wasmImageIOBase->GetDirectionContainer()->at(0)) );
     const auto directionSize = wasmImageIOBase->GetDirectionContainer()->size() * sizeof(double);
-    setMemoryStoreOutputArray(0, index, 1, directionAddress, directionSize);
+    this->m_MemoryContext->SetOutputArray(index, 1, directionAddress, directionSize);
 
     if (this->m_InformationOnly)
     {
       return;
     }
 
-    const auto dataAddress = reinterpret_cast< size_t >( &(wasmImageIOBase->GetPixelDataContainer()->at(0)) );
-    const auto dataSize = wasmImageIOBase->GetPixelDataContainer()->size();
-    setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+    const auto dataAddress = reinterpret_cast< size_t >( wasmImageIOBase->GetPixelData() );
+    const auto dataSize = wasmImageIOBase->GetPixelDataSize();
+    this->m_MemoryContext->SetOutputArray(index, 0, dataAddress, dataSize);
 
     }
 #else
@@ -151,7 +151,18 @@ public:
 #endif
     }
   }
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename ImageIOBase::Pointer m_ImageIO;
 
   std::string m_Identifier;
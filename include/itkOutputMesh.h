@@ -70,7 +70,7 @@ public:
 
   OutputMesh() = default;
   ~OutputMesh() {
-    if(wasm::Pipeline::get_use_memory_io())
+    if(this->m_MemoryContext->GetUseMemoryIO())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
     if (!this->m_Mesh.IsNull() && !this->m_Identifier.empty())
@@ -78,23 +78,24 @@ public:
         using MeshToWasmMeshFilterType = MeshToWasmMeshFilter<MeshType>;
         auto meshToWasmMeshFilter = MeshToWasmMeshFilterType::New();
         meshToWasmMeshFilter->SetInput(this->m_Mesh);
+        meshToWasmMeshFilter->SetGenerateJSON(this->m_MemoryContext->GetUseOutputJSON());
         meshToWasmMeshFilter->Update();
         auto wasmMesh = meshToWasmMeshFilter->GetOutput();
         const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmMesh);
+        this->m_MemoryContext->SetOutputDataObject(index, wasmMesh);
 
         if (this->m_Mesh->GetNumberOfPoints() > 0)
         {
           const auto pointsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPoints()->at(0)) );
           const auto pointsSize = wasmMesh->GetMesh()->GetPoints()->Size() * sizeof(typename MeshType::CoordRepType) * MeshType::PointDimension;
-          setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
+          this->m_MemoryContext->SetOutputArray(index, 0, pointsAddress, pointsSize);
         }
 
         if (this->m_Mesh->GetNumberOfCells() > 0)
         {
           const auto cellsAddress = reinterpret_cast< size_t >( &(wasmMesh->GetCellBuffer()->at(0)) );
           const auto cellsSize = wasmMesh->GetCellBuffer()->Size() * sizeof(typename MeshType::CellIdentifier);
-          setMemoryStoreOutputArray(0, index, 1, cellsAddress, cellsSize);
+          this->m_MemoryContext->SetOutputArray(index, 1, cellsAddress, cellsSize);
         }
 
         if (this->m_Mesh->GetPointData() != nullptr && this->m_Mesh->GetPointData()->Size() > 0)
@@ -103,7 +104,7 @@ public:
           using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
           const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetPointData()->at(0)) );
           const auto pointDataSize = wasmMesh->GetMesh()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 2, pointDataAddress, pointDataSize);
+          this->m_MemoryContext->SetOutputArray(index, 2, pointDataAddress, pointDataSize);
         }
 
         if (this->m_Mesh->GetCellData() != nullptr && this->m_Mesh->GetCellData()->Size() > 0)
@@ -112,7 +113,7 @@ public:
           using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
           const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmMesh->GetMesh()->GetCellData()->at(0)) );
           const auto cellDataSize = wasmMesh->GetMesh()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 3, cellDataAddress, cellDataSize);
+          this->m_MemoryContext->SetOutputArray(index, 3, cellDataAddress, cellDataSize);
         }
       }
 #else
@@ -137,7 +138,18 @@ public:
 #endif
     }
   }
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TMesh::ConstPointer m_Mesh;
 
   std::string m_Identifier;
@@ -76,7 +76,7 @@ namespace itk
       OutputMeshIO() = default;
       ~OutputMeshIO()
       {
-        if (wasm::Pipeline::get_use_memory_io())
+        if (this->m_MemoryContext->GetUseMemoryIO())
         {
 #ifndef ITK_WASM_NO_MEMORY_IO
           if (!this->m_MeshIO.IsNull() && !this->m_Identifier.empty())
@@ -84,7 +84,7 @@ namespace itk
             const auto index = std::stoi(this->m_Identifier);
             auto wasmMeshIOBase = itk::WasmMeshIOBase::New();
             wasmMeshIOBase->SetMeshIO(this->m_MeshIO);
-            setMemoryStoreOutputDataObject(0, index, wasmMeshIOBase);
+            this->m_MemoryContext->SetOutputDataObject(index, wasmMeshIOBase);
 
             if (this->m_InformationOnly)
             {
@@ -95,28 +95,28 @@ namespace itk
             if (pointsSize)
             {
               const auto pointsAddress = reinterpret_cast<size_t>(&(wasmMeshIOBase->GetPointsContainer()->at(0)));
-              setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
+              this->m_MemoryContext->SetOutputArray(index, 0, pointsAddress, pointsSize);
             }
 
             const auto cellsSize = wasmMeshIOBase->GetCellsContainer()->size();
             if (cellsSize)
             {
               const auto cellsAddress = reinterpret_cast<size_t>(&(wasmMeshIOBase->GetCellsContainer()->at(0)));
-              setMemoryStoreOutputArray(0, index, 1, cellsAddress, cellsSize);
+              this->m_MemoryContext->SetOutputArray(index, 1, cellsAddress, cellsSize);
             }
 
             const auto pointDataSize = wasmMeshIOBase->GetPointDataContainer()->size();
             if (pointDataSize)
             {
               const auto pointDataAddress = reinterpret_cast<size_t>(&(wasmMeshIOBase->GetPointDataContainer()->at(0)));
-              setMemoryStoreOutputArray(0, index, 2, pointDataAddress, pointDataSize);
+              this->m_MemoryContext->SetOutputArray(index, 2, pointDataAddress, pointDataSize);
             }
 
             const auto cellDataSize = wasmMeshIOBase->GetCellDataContainer()->size();
             if (cellDataSize)
             {
               const auto cellDataAddress = reinterpret_cast<size_t>(&(wasmMeshIOBase->GetCellDataContainer()->at(0)));
-              setMemoryStoreOutputArray(0, index, 3, cellDataAddress, cellDataSize);
+              this->m_MemoryContext->SetOutputArray(index, 3, cellDataAddress, cellDataSize);
             }
           }
 #else
@@ -202,7 +202,17 @@ namespace itk
         }
       }
 
+      /** Memory IO context, the current context of the thread at construction by default. */
+      void SetMemoryContext(WasmMemoryContext * context)
+      {
+        this->m_MemoryContext = context;
+      }
+      WasmMemoryContext * GetMemoryContext() const
+      {
+        return this->m_MemoryContext;
+      }
     protected:
+      WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
       typename MeshIOBase::Pointer m_MeshIO;
 
       std::string m_Identifier;
@@ -71,7 +71,7 @@ public:
 
   OutputPolyData() = default;
   ~OutputPolyData() {
-    if(wasm::Pipeline::get_use_memory_io())
+    if(this->m_MemoryContext->GetUseMemoryIO())
     {
 #ifndef ITK_WASM_NO_MEMORY_IO
     if (!this->m_PolyData.IsNull() && !this->m_Identifier.empty())
@@ -79,44 +79,45 @@ public:
         using PolyDataToWasmPolyDataFilterType = PolyDataToWasmPolyDataFilter<PolyDataType>;
         auto polyDataToWasmPolyDataFilter = PolyDataToWasmPolyDataFilterType::New();
         polyDataToWasmPolyDataFilter->SetInput(this->m_PolyData);
+        polyDataToWasmPolyDataFilter->SetGenerateJSON(this->m_MemoryContext->GetUseOutputJSON());
         polyDataToWasmPolyDataFilter->Update();
         auto wasmPolyData = polyDataToWasmPolyDataFilter->GetOutput();
         const auto index = std::stoi(this->m_Identifier);
-        setMemoryStoreOutputDataObject(0, index, wasmPolyData);
+        this->m_MemoryContext->SetOutputDataObject(index, wasmPolyData);
 
         if (this->m_PolyData->GetNumberOfPoints() > 0)
         {
           const auto pointsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPoints()->at(0)) );
           const auto pointsSize = wasmPolyData->GetPolyData()->GetPoints()->Size() * PolyDataType::PointDimension * sizeof(typename PolyDataType::CoordRepType);
-          setMemoryStoreOutputArray(0, index, 0, pointsAddress, pointsSize);
+          this->m_MemoryContext->SetOutputArray(index, 0, pointsAddress, pointsSize);
         }
 
         if (this->m_PolyData->GetVertices() && this->m_PolyData->GetVertices()->Size() > 0)
         {
           const auto verticesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetVertices()->at(0)) );
           const auto verticesSize = wasmPolyData->GetPolyData()->GetVertices()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 1, verticesAddress, verticesSize);
+          this->m_MemoryContext->SetOutputArray(index, 1, verticesAddress, verticesSize);
         }
 
         if (this->m_PolyData->GetLines() && this->m_PolyData->GetLines()->Size() > 0)
         {
           const auto linesAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetLines()->at(0)) );
           const auto linesSize = wasmPolyData->GetPolyData()->GetLines()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 2, linesAddress, linesSize);
+          this->m_MemoryContext->SetOutputArray(index, 2, linesAddress, linesSize);
         }
 
         if (this->m_PolyData->GetPolygons() && this->m_PolyData->GetPolygons()->Size() > 0)
         {
           const auto polygonsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPolygons()->at(0)) );
           const auto polygonsSize = wasmPolyData->GetPolyData()->GetPolygons()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 3, polygonsAddress, polygonsSize);
+          this->m_MemoryContext->SetOutputArray(index, 3, polygonsAddress, polygonsSize);
         }
 
         if (this->m_PolyData->GetTriangleStrips() && this->m_PolyData->GetTriangleStrips()->Size() > 0)
         {
           const auto triangleStripsAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetTriangleStrips()->at(0)) );
           const auto triangleStripsSize = wasmPolyData->GetPolyData()->GetTriangleStrips()->Size() * sizeof(uint32_t);
-          setMemoryStoreOutputArray(0, index, 4, triangleStripsAddress, triangleStripsSize);
+          this->m_MemoryContext->SetOutputArray(index, 4, triangleStripsAddress, triangleStripsSize);
         }
 
         if (this->m_PolyData->GetPointData() != nullptr && this->m_PolyData->GetPointData()->Size() > 0)
@@ -125,7 +126,7 @@ public:
           using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
           const auto pointDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetPointData()->at(0)) );
           const auto pointDataSize = wasmPolyData->GetPolyData()->GetPointData()->Size() * sizeof(typename ConvertPointPixelTraits::ComponentType) * ConvertPointPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 5, pointDataAddress, pointDataSize);
+          this->m_MemoryContext->SetOutputArray(index, 5, pointDataAddress, pointDataSize);
         }
 
         if (this->m_PolyData->GetCellData() != nullptr && this->m_PolyData->GetCellData()->Size() > 0)
@@ -134,7 +135,7 @@ public:
           using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
           const auto cellDataAddress = reinterpret_cast< size_t >( &(wasmPolyData->GetPolyData()->GetCellData()->at(0)) );
           const auto cellDataSize = wasmPolyData->GetPolyData()->GetCellData()->Size() * sizeof(typename ConvertCellPixelTraits::ComponentType) * ConvertCellPixelTraits::GetNumberOfComponents();
-          setMemoryStoreOutputArray(0, index, 6, cellDataAddress, cellDataSize);
+          this->m_MemoryContext->SetOutputArray(index, 6, cellDataAddress, cellDataSize);
         }
       }
 #else
@@ -163,7 +164,18 @@ public:
 #endif
     }
   }
+
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   typename TPolyData::ConstPointer m_PolyData;
 
   std::string m_Identifier;
@@ -43,6 +43,8 @@ namespace wasm
  * This stream is written to the filesystem or memory when the object goes out of scope.
  * 
  * Call `Get()` to get the std::ostream & to use an output for a pipeline.
+ * With memory IO, the output is written into a growable buffer that is
+ * exported without a copy.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -76,7 +78,7 @@ public:
     m_DeleteOStream = false;
     m_WasmStringStream = WasmStringStream::New();
 
-    m_OStream = &(m_WasmStringStream->GetStringStream());
+    m_OStream = &(m_WasmStringStream->GetOutputStream());
     this->m_Identifier = identifier;
   }
   const std::string & GetIdentifier() const
@@ -84,7 +86,17 @@ public:
     return this->m_Identifier;
   }
 
+  /** Memory IO context, the current context of the thread at construction by default. */
+  void SetMemoryContext(WasmMemoryContext * context)
+  {
+    this->m_MemoryContext = context;
+  }
+  WasmMemoryContext * GetMemoryContext() const
+  {
+    return this->m_MemoryContext;
+  }
 protected:
+  WasmMemoryContext * m_MemoryContext{ WasmMemoryContext::GetCurrent() };
   std::ostream * m_OStream{nullptr};
   bool m_DeleteOStream{false};
 
@@ -28,6 +28,8 @@
 
 #include "rapidjson/document.h"
 
+#include "itkWasmMemoryContext.h"
+
 #include "WebAssemblyInterfaceExport.h"
 
 
@@ -141,8 +143,14 @@ rapidjson::Value getArrayJson(Iteratorable container, rapidjson::Document::Alloc
 class WebAssemblyInterface_EXPORT Pipeline: public CLI::App
 {
 public:
-    /** Make a new Pipeline application. `name` should be CamelCase by convention. */
-    Pipeline(std::string name, std::string description, int argc, char **argv);
+    /** Make a new Pipeline application. `name` should be CamelCase by convention.
+     *
+     * The memory IO context becomes the current context of the calling
+     * thread until the pipeline is destroyed. Give each pipeline that runs
+     * concurrently its own context. If context is nullptr, it is the context
+     * whose index, as returned by itk_wasm_context_create, follows the hidden
+     * `--memory-io-context` argument, otherwise the default context. */
+    Pipeline(std::string name, std::string description, int argc, char **argv, WasmMemoryContext * context = nullptr);
 
     /** Exit. */
     auto exit(const CLI::Error &e) -> int;
@@ -151,9 +159,15 @@ public:
         CLI::App::parse(m_argc, m_argv);
     }
 
+    /** Whether the current memory IO context of the thread uses memory IO. */
     static auto get_use_memory_io()
     {
-      return m_UseMemoryIO;
+      return WasmMemoryContext::GetCurrent()->GetUseMemoryIO();
+    }
+
+    WasmMemoryContext * get_memory_context() const
+    {
+      return m_MemoryContext;
     }
 
     int get_argc() const
@@ -180,7 +194,10 @@ public:
 
     ~Pipeline() override;
 private:
-    static bool m_UseMemoryIO;
+    bool m_UseMemoryIO{false};
+    uint32_t m_MemoryContextIndex{0};
+    WasmMemoryContext * m_MemoryContext;
+    WasmMemoryContext * m_PreviousMemoryContext;
     int m_argc;
     char **m_argv;
     std::string m_Version;
@@ -136,6 +136,39 @@ PolyDataToWasmPolyDataFilter<TPolyData>
 
   wasmPolyData->SetPolyData(polyData);
 
+  {
+    using PointPixelType = typename TPolyData::PixelType;
+    using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
+    using CellPixelType = typename TPolyData::CellPixelType;
+    using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
+
+    auto descriptor = wasm::makeWasmDescriptor<wasm::WasmPolyDataDescriptor>();
+    descriptor.pointPixelComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString);
+    descriptor.pointPixelType = wasm::descriptorPixelType(wasm::MapPixelType<PointPixelType>::PixelString);
+    descriptor.pointPixelComponents = ConvertPointPixelTraits::GetNumberOfComponents();
+    descriptor.cellPixelComponentType = wasm::descriptorComponentType(wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString);
+    descriptor.cellPixelType = wasm::descriptorPixelType(wasm::MapPixelType<CellPixelType>::PixelString);
+    descriptor.cellPixelComponents = ConvertCellPixelTraits::GetNumberOfComponents();
+
+    const auto arrayAddress = [](const auto * container, uint64_t & size) -> uint64_t {
+      size = container == nullptr ? 0 : container->Size();
+      return size == 0 ? 0 : reinterpret_cast< size_t >( &(container->at(0)) );
+    };
+    descriptor.points = arrayAddress(polyData->GetPoints(), descriptor.numberOfPoints);
+    descriptor.vertices = arrayAddress(polyData->GetVertices(), descriptor.verticesBufferSize);
+    descriptor.lines = arrayAddress(polyData->GetLines(), descriptor.linesBufferSize);
+    descriptor.polygons = arrayAddress(polyData->GetPolygons(), descriptor.polygonsBufferSize);
+    descriptor.triangleStrips = arrayAddress(polyData->GetTriangleStrips(), descriptor.triangleStripsBufferSize);
+    descriptor.pointData = arrayAddress(polyData->GetPointData(), descriptor.numberOfPointPixels);
+    descriptor.cellData = arrayAddress(polyData->GetCellData(), descriptor.numberOfCellPixels);
+    wasmPolyData->SetDescriptor(&descriptor.header);
+  }
+
+  if (!this->m_GenerateJSON)
+  {
+    return;
+  }
+
   rapidjson::Document document;
   document.SetObject();
   rapidjson::Document::AllocatorType& allocator = document.GetAllocator();
@@ -170,72 +203,72 @@ PolyDataToWasmPolyDataFilter<TPolyData>
   document.AddMember( "polyDataType", polyDataType.Move(), allocator );
 
   rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( polyData->GetNumberOfPoints() );
+  numberOfPoints.SetUint64( polyData->GetNumberOfPoints() );
   document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
 
   rapidjson::Value verticesBufferSize;
   if (polyData->GetPointData() == nullptr)
   {
-    verticesBufferSize.SetInt( 0 );
+    verticesBufferSize.SetUint64( 0 );
   }
   else
   {
-    verticesBufferSize.SetInt( polyData->GetVertices()->Size() );
+    verticesBufferSize.SetUint64( polyData->GetVertices()->Size() );
   }
   document.AddMember( "verticesBufferSize", verticesBufferSize.Move(), allocator );
 
   rapidjson::Value linesBufferSize;
   if (polyData->GetPointData() == nullptr)
   {
-    linesBufferSize.SetInt( 0 );
+    linesBufferSize.SetUint64( 0 );
   }
   else
   {
-    linesBufferSize.SetInt( polyData->GetLines()->Size() );
+    linesBufferSize.SetUint64( polyData->GetLines()->Size() );
   }
   document.AddMember( "linesBufferSize", linesBufferSize.Move(), allocator );
 
   rapidjson::Value polygonsBufferSize;
   if (polyData->GetPointData() == nullptr)
   {
-    polygonsBufferSize.SetInt( 0 );
+    polygonsBufferSize.SetUint64( 0 );
   }
   else
   {
-    polygonsBufferSize.SetInt( polyData->GetPolygons()->Size() );
+    polygonsBufferSize.SetUint64( polyData->GetPolygons()->Size() );
   }
   document.AddMember( "polygonsBufferSize", polygonsBufferSize.Move(), allocator );
 
   rapidjson::Value triangleStripsBufferSize;
   if (polyData->GetPointData() == nullptr)
   {
-    triangleStripsBufferSize.SetInt( 0 );
+    triangleStripsBufferSize.SetUint64( 0 );
   }
   else
   {
-    triangleStripsBufferSize.SetInt( polyData->GetTriangleStrips()->Size() );
+    triangleStripsBufferSize.SetUint64( polyData->GetTriangleStrips()->Size() );
   }
   document.AddMember( "triangleStripsBufferSize", triangleStripsBufferSize.Move(), allocator );
 
   rapidjson::Value numberOfPointPixels;
   if (polyData->GetPointData() == nullptr)
   {
-    numberOfPointPixels.SetInt( 0 );
+    numberOfPointPixels.SetUint64( 0 );
   }
   else
   {
-    numberOfPointPixels.SetInt( polyData->GetPointData()->Size() );
+    numberOfPointPixels.SetUint64( polyData->GetPointData()->Size() );
   }
   document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
 
   rapidjson::Value numberOfCellPixels;
   if (polyData->GetCellData() == nullptr)
   {
-    numberOfCellPixels.SetInt( 0 );
+    numberOfCellPixels.SetUint64( 0 );
   }
   else
   {
-    numberOfCellPixels.SetInt( polyData->GetCellData()->Size() );
+    numberOfCellPixels.SetUint64( polyData->GetCellData()->Size() );
   }
   document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
 
@@ -336,6 +369,7 @@ PolyDataToWasmPolyDataFilter<TPolyData>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "GenerateJSON: " << this->m_GenerateJSON << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,186 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmCBORStream_h
+#define itkWasmCBORStream_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cbor.h"
+
+namespace itk
+{
+/**
+ *\class WasmCBORStreamReader
+ * \brief Incremental decoder for the CBOR encoded itk-wasm file formats.
+ *
+ * The itk-wasm CBOR files are a map of small header items and large typed
+ * array bytestrings. This reader decodes the map one data item at a time
+ * from a std::istream. Header items are decoded into libcbor items with
+ * ReadItem, while bytestring payloads are read directly into a destination
+ * buffer with ReadBytes or skipped with SkipBytes, without an intermediate
+ * copy.
+ *
+ * Only definite-length strings, bytestrings, arrays and maps are supported
+ * outside of ReadItem and SkipItem.
+ *
+ * Malformed input results in a std::runtime_error. The lengths of strings,
+ * bytestrings, arrays and maps are checked against the bytes remaining in
+ * a seekable stream before anything is allocated. In a stream that is not
+ * seekable, e.g. a decompressing stream, strings are read in chunks so that
+ * the allocation is bounded by the data that is actually present.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmCBORStreamReader
+{
+public:
+  explicit WasmCBORStreamReader(std::istream & stream)
+    : m_Stream(stream)
+  {}
+
+  /** Read the head of the next data item. Returns the argument, e.g. the
+   * length of a string or the number of map entries. */
+  uint64_t
+  ReadHead(uint8_t & majorType);
+
+  /** Read the head of a definite-length map and return its entry count. */
+  uint64_t
+  ReadMapHead();
+
+  /** Read a text string, e.g. a map key. */
+  std::string
+  ReadString();
+
+  /** Read the head of a bytestring that is optionally wrapped in a tag, e.g.
+   * an RFC 8746 typed array. Returns the number of payload bytes, which
+   * follow in the stream. */
+  uint64_t
+  ReadByteStringHead(uint64_t * tag = nullptr);
+
+  /** Read payload bytes into the provided buffer. */
+  void
+  ReadBytes(void * buffer, uint64_t numberOfBytes);
+
+  /** Skip payload bytes, seeking if the stream supports it. */
+  void
+  SkipBytes(uint64_t numberOfBytes);
+
+  /** Read the next complete data item into a libcbor item. The caller owns
+   * the result and releases it with cbor_decref. Intended for small items. */
+  cbor_item_t *
+  ReadItem();
+
+  /** Skip the next complete data item. */
+  void
+  SkipItem();
+
+private:
+  uint64_t
+  ReadArgument(uint8_t additionalInformation, std::vector< unsigned char > * encoded);
+
+  /** Read or skip a complete data item, appending its encoding if encoded
+   * is not nullptr. */
+  void
+  WalkItem(std::vector< unsigned char > * encoded);
+
+  uint8_t
+  ReadByte();
+
+  /** Number of bytes left in the stream, or the largest uint64_t if the
+   * stream is not seekable. */
+  uint64_t
+  RemainingBytes();
+
+  /** Throw if length items of at least bytesPerItem bytes each cannot
+   * follow in the stream. */
+  void
+  CheckLength(uint64_t length, uint64_t bytesPerItem, const char * description);
+
+  /** Append payload bytes to buffer, growing it as the bytes are read when
+   * the size of the stream is not known. */
+  void
+  AppendBytes(std::vector< unsigned char > & buffer, uint64_t numberOfBytes);
+
+  std::istream & m_Stream;
+  // Offset of the end of a seekable stream, found on first use
+  std::streamoff m_StreamEnd{ -1 };
+  bool m_StreamEndKnown{ false };
+};
+
+/**
+ *\class WasmCBORStreamWriter
+ * \brief Incremental encoder for the CBOR encoded itk-wasm file formats.
+ *
+ * The counterpart of WasmCBORStreamReader. Data item heads are encoded
+ * directly into a std::ostream, small header items can be serialized from
+ * libcbor items with WriteItem, and bytestring payloads are written with a
+ * single write from the caller's buffer, without an intermediate copy.
+ *
+ * Stream failures result in a std::runtime_error.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmCBORStreamWriter
+{
+public:
+  explicit WasmCBORStreamWriter(std::ostream & stream)
+    : m_Stream(stream)
+  {}
+
+  /** Write the head of a data item in its shortest encoding. */
+  void
+  WriteHead(uint8_t majorType, uint64_t argument);
+
+  /** Write the head of a definite-length map with the given entry count. */
+  void
+  WriteMapHead(uint64_t numberOfEntries);
+
+  /** Write a text string, e.g. a map key. */
+  void
+  WriteString(std::string_view string);
+
+  /** Write a tag head. The tagged item follows. */
+  void
+  WriteTag(uint64_t tag);
+
+  /** Write the head of a bytestring. The payload follows with WriteBytes. */
+  void
+  WriteByteStringHead(uint64_t numberOfBytes);
+
+  /** Write payload bytes from the provided buffer. */
+  void
+  WriteBytes(const void * buffer, uint64_t numberOfBytes);
+
+  /** Serialize a complete libcbor item. Intended for small items. */
+  void
+  WriteItem(const cbor_item_t * item);
+
+private:
+  std::ostream & m_Stream;
+};
+
+} // namespace itk
+
+#endif
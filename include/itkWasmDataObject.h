@@ -20,6 +20,9 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkDataObject.h"
+#include "itkWasmDescriptor.h"
+
+#include <vector>
 
 namespace itk
 {
@@ -52,6 +55,23 @@ public:
     return this->m_JSON;
   }
 
+  /** Get/Set the binary descriptor representation, an alternative to the
+   * JSON representation. The descriptor is copied. GetDescriptor returns
+   * nullptr when none is set. */
+  void SetDescriptor(const wasm::WasmDescriptorHeader * descriptor);
+  const wasm::WasmDescriptorHeader * GetDescriptor() const
+  {
+    if (this->m_Descriptor.empty())
+    {
+      return nullptr;
+    }
+    return reinterpret_cast<const wasm::WasmDescriptorHeader *>(this->m_Descriptor.data());
+  }
+  size_t GetDescriptorSize() const
+  {
+    return this->m_Descriptor.empty() ? 0 : this->GetDescriptor()->size;
+  }
+
   /** Get/Set the DataObject used to generate the JSON representation.
    * 
    * We hold a reference to this object. */
@@ -65,6 +85,8 @@ protected:
   PrintSelf(std::ostream & os, Indent indent) const override;
 
   std::string m_JSON;
+  // uint64_t elements keep the descriptor fields aligned
+  std::vector<uint64_t> m_Descriptor;
   DataObject::ConstPointer m_DataObject;
 };
 
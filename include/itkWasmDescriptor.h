@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmDescriptor_h
+#define itkWasmDescriptor_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "rapidjson/document.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace itk
+{
+namespace wasm
+{
+
+/** Binary descriptors of the data objects exchanged through memory IO.
+ *
+ * A descriptor carries the same information as the JSON representation of
+ * a WasmImage, WasmMesh or WasmPolyData, as a fixed layout of little-endian
+ * integers and doubles, so it is read without parsing. Every field has a
+ * fixed width and is aligned to its size, so the layout is the same for
+ * wasm32, wasm64 and native builds. Array addresses are 64-bit, and 0 when
+ * the array is empty. Only wasm32 and native builds are configured today;
+ * the 64-bit fields keep the layout unchanged for a future wasm64 target.
+ *
+ * Component types are IOComponentEnum values and pixel types IOPixelEnum
+ * values. 64-bit integers are LONGLONG and ULONGLONG, as in
+ * IOComponentEnumFromWasmComponentType.
+ *
+ * Metadata is referenced as the JSON text of the `metadata` member of the
+ * JSON representation, which is only parsed when it is present.
+ */
+constexpr uint32_t WasmDescriptorMagic = 0x44574b49; // "IKWD"
+constexpr uint16_t WasmDescriptorVersion = 1;
+constexpr unsigned int WasmDescriptorMaximumDimension = 6;
+
+enum class WasmDescriptorKind : uint16_t
+{
+  Image = 1,
+  Mesh = 2,
+  PolyData = 3,
+  // Reserved: transforms have no memory IO representation yet
+  Transform = 4,
+};
+
+struct WasmDescriptorHeader
+{
+  uint32_t magic;
+  uint16_t version;
+  uint16_t kind;
+  /** Size of the complete descriptor in bytes. */
+  uint32_t size;
+  uint32_t reserved;
+};
+
+/** Address and byte length of a JSON text. */
+struct WasmDescriptorText
+{
+  uint64_t address;
+  uint64_t size;
+};
+
+struct WasmImageDescriptor
+{
+  static constexpr WasmDescriptorKind Kind = WasmDescriptorKind::Image;
+
+  WasmDescriptorHeader header;
+  uint32_t dimension;
+  uint32_t componentType;
+  uint32_t pixelType;
+  uint32_t components;
+  double origin[WasmDescriptorMaximumDimension];
+  double spacing[WasmDescriptorMaximumDimension];
+  uint64_t size[WasmDescriptorMaximumDimension];
+  /** dimension x dimension doubles, row major. */
+  uint64_t direction;
+  uint64_t data;
+  WasmDescriptorText metadata;
+};
+
+struct WasmMeshDescriptor
+{
+  static constexpr WasmDescriptorKind Kind = WasmDescriptorKind::Mesh;
+
+  WasmDescriptorHeader header;
+  uint32_t dimension;
+  uint32_t pointComponentType;
+  uint32_t pointPixelComponentType;
+  uint32_t pointPixelType;
+  uint32_t pointPixelComponents;
+  uint32_t cellComponentType;
+  uint32_t cellPixelComponentType;
+  uint32_t cellPixelType;
+  uint32_t cellPixelComponents;
+  uint32_t reserved;
+  uint64_t numberOfPoints;
+  uint64_t numberOfPointPixels;
+  uint64_t numberOfCells;
+  uint64_t numberOfCellPixels;
+  uint64_t cellBufferSize;
+  uint64_t points;
+  uint64_t cells;
+  uint64_t pointData;
+  uint64_t cellData;
+};
+
+struct WasmPolyDataDescriptor
+{
+  static constexpr WasmDescriptorKind Kind = WasmDescriptorKind::PolyData;
+
+  WasmDescriptorHeader header;
+  uint32_t pointPixelComponentType;
+  uint32_t pointPixelType;
+  uint32_t pointPixelComponents;
+  uint32_t cellPixelComponentType;
+  uint32_t cellPixelType;
+  uint32_t cellPixelComponents;
+  uint64_t numberOfPoints;
+  uint64_t verticesBufferSize;
+  uint64_t linesBufferSize;
+  uint64_t polygonsBufferSize;
+  uint64_t triangleStripsBufferSize;
+  uint64_t numberOfPointPixels;
+  uint64_t numberOfCellPixels;
+  uint64_t points;
+  uint64_t vertices;
+  uint64_t lines;
+  uint64_t polygons;
+  uint64_t triangleStrips;
+  uint64_t pointData;
+  uint64_t cellData;
+};
+
+static_assert(sizeof(WasmDescriptorHeader) == 16, "Unexpected descriptor header layout");
+static_assert(sizeof(WasmImageDescriptor) == 208, "Unexpected image descriptor layout");
+static_assert(sizeof(WasmMeshDescriptor) == 128, "Unexpected mesh descriptor layout");
+static_assert(sizeof(WasmPolyDataDescriptor) == 152, "Unexpected polydata descriptor layout");
+
+/** A descriptor of type TDescriptor with an initialized header. */
+template <typename TDescriptor>
+TDescriptor
+makeWasmDescriptor()
+{
+  TDescriptor descriptor{};
+  descriptor.header.magic = WasmDescriptorMagic;
+  descriptor.header.version = WasmDescriptorVersion;
+  descriptor.header.kind = static_cast<uint16_t>(TDescriptor::Kind);
+  descriptor.header.size = sizeof(TDescriptor);
+  return descriptor;
+}
+
+/** Check the magic, version and kind of a descriptor of size bytes. Throws
+ * a std::runtime_error if it does not describe a kind object. */
+WebAssemblyInterface_EXPORT
+void
+checkWasmDescriptor(const void * descriptor, size_t size, WasmDescriptorKind kind, size_t kindSize);
+
+/** The descriptor as a TDescriptor, after checking it. */
+template <typename TDescriptor>
+const TDescriptor *
+castWasmDescriptor(const WasmDescriptorHeader * header)
+{
+  checkWasmDescriptor(header, header == nullptr ? 0 : header->size, TDescriptor::Kind, sizeof(TDescriptor));
+  return reinterpret_cast<const TDescriptor *>(header);
+}
+
+/** A 64-bit count or address from a descriptor as a size_t. Throws a
+ * std::runtime_error when it does not fit in this address space, as on
+ * wasm32 for objects described by a 64-bit host. */
+inline size_t
+descriptorSize(uint64_t value)
+{
+  if (value > std::numeric_limits<size_t>::max())
+  {
+    throw std::runtime_error("Descriptor value exceeds the address space");
+  }
+  return static_cast<size_t>(value);
+}
+
+/** Descriptors from the JSON representations, for inputs that arrive as
+ * JSON. The metadata is left empty; it remains in the JSON document. */
+WebAssemblyInterface_EXPORT
+WasmImageDescriptor
+imageDescriptorFromJSON(const rapidjson::Value & json);
+
+WebAssemblyInterface_EXPORT
+WasmMeshDescriptor
+meshDescriptorFromJSON(const rapidjson::Value & json);
+
+WebAssemblyInterface_EXPORT
+WasmPolyDataDescriptor
+polyDataDescriptorFromJSON(const rapidjson::Value & json);
+
+/** IOComponentEnum value of a component type string, as stored in a
+ * descriptor. */
+WebAssemblyInterface_EXPORT
+uint32_t
+descriptorComponentType(const std::string_view & wasmComponentType);
+
+/** IOPixelEnum value of a pixel type string, as stored in a descriptor. */
+WebAssemblyInterface_EXPORT
+uint32_t
+descriptorPixelType(const std::string_view & wasmPixelType);
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
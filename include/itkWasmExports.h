@@ -21,7 +21,7 @@
 #ifndef ITK_WASM_NO_MEMORY_IO
 // WebAssembly exports for memory io
 
-#include "itkWasmDataObject.h"
+#include "itkWasmMemoryContext.h"
 
 #if defined(__EMSCRIPTEN__)
 #  include "emscripten/em_macros.h"
@@ -36,16 +36,18 @@ namespace itk
 namespace wasm
 {
 
-// dataset index, array index
-using InputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
-using InputArrayStoreValueType = std::vector<uint8_t>;
-using InputArrayStoreType = std::map<InputArrayStoreKeyType, InputArrayStoreValueType>;
-
 // Function for the Pipeline Input's and Output's to set / get from the memory store
+// of the context with the memoryIndex, see WasmMemoryContext
+
+WebAssemblyInterface_EXPORT const char * getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index);
 
-WebAssemblyInterface_EXPORT const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index);
+WebAssemblyInterface_EXPORT const InputArrayStoreType & getMemoryInputArrayStore(uint32_t memoryIndex = 0);
 
-WebAssemblyInterface_EXPORT const InputArrayStoreType & getMemoryInputArrayStore();
+// Binary descriptor of an input, or nullptr when the input was provided as JSON
+WebAssemblyInterface_EXPORT const WasmDescriptorHeader * getMemoryStoreInputDescriptor(uint32_t memoryIndex, uint32_t index);
+
+// Whether outputs carry a JSON representation in addition to their binary descriptor
+WebAssemblyInterface_EXPORT bool getMemoryStoreUseOutputJSON(uint32_t memoryIndex);
 
 WebAssemblyInterface_EXPORT void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject);
 
@@ -60,13 +62,29 @@ extern "C"
 
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size);
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_input_descriptor_alloc(uint32_t memoryIndex, uint32_t index, size_t size);
+
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_descriptor_version();
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_set_output_json(uint32_t memoryIndex, uint32_t enabled);
 
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index);
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_descriptor_address(uint32_t memoryIndex, uint32_t index);
+WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_descriptor_size(uint32_t memoryIndex, uint32_t index);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 WebAssemblyInterface_EXPORT size_t EMSCRIPTEN_KEEPALIVE itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t subIndex);
 
+// Release the inputs and outputs of the default context. The memory of the
+// inputs is kept for reuse by the next invocation.
 WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_free_all();
+// Return the memory the default context kept for reuse to the system allocator.
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_trim();
+
+// Contexts for concurrent pipeline executions. The returned index is the
+// memoryIndex of the exports above.
+WebAssemblyInterface_EXPORT uint32_t EMSCRIPTEN_KEEPALIVE itk_wasm_context_create();
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_context_free_all(uint32_t memoryIndex);
+WebAssemblyInterface_EXPORT void EMSCRIPTEN_KEEPALIVE itk_wasm_context_delete(uint32_t memoryIndex);
 
 } // end extern "C"
 
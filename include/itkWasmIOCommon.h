@@ -26,6 +26,8 @@
 #include "itkCommonEnums.h"
 
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "cbor.h"
 
@@ -80,6 +82,12 @@ WebAssemblyInterface_EXPORT
 void
 readCBORBuffer(const cbor_item_t * index, const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead);
 
+/** RFC 8746 typed array CBOR tag for the component type. Throws a
+ * std::logic_error for an unexpected component type. */
+WebAssemblyInterface_EXPORT
+uint64_t
+cborTypedArrayTag(IOComponentEnum ioComponent);
+
 WebAssemblyInterface_EXPORT
 void
 writeCBORBuffer(cbor_item_t * index, const char * dataName, const void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent);
@@ -88,6 +96,47 @@ WebAssemblyInterface_EXPORT
 size_t
 ITKComponentSize( const CommonEnums::IOComponent );
 
+/** \class WasmMemoryMappedFile
+ *
+ * \brief Read-only memory mapping of a file.
+ *
+ * Pages are faulted in lazily when they are accessed. On platforms without
+ * mmap, e.g. WASI, the file content is read into a buffer owned by the
+ * object instead. The data is valid for the lifetime of the object.
+ *
+ * If the file cannot be opened or mapped, a std::runtime_error is thrown.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmMemoryMappedFile
+{
+public:
+  explicit WasmMemoryMappedFile(const std::string & fileName);
+  ~WasmMemoryMappedFile();
+
+  WasmMemoryMappedFile(const WasmMemoryMappedFile &) = delete;
+  WasmMemoryMappedFile & operator=(const WasmMemoryMappedFile &) = delete;
+
+  const char * GetData() const
+  {
+    return m_Data;
+  }
+
+  SizeValueType GetSize() const
+  {
+    return m_Size;
+  }
+
+private:
+  const char * m_Data{ nullptr };
+  SizeValueType m_Size{ 0 };
+#if defined(_WIN32)
+  void * m_FileHandle{ nullptr };
+  void * m_MappingHandle{ nullptr };
+#endif
+  std::vector< char > m_Buffer;
+};
+
 } // end namespace itk
 
 #endif // itkWasmIOCommon_h
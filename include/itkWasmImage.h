@@ -63,9 +63,20 @@ public:
     return static_cast< const ImageType * >(this->GetDataObject());
   }
 
+  /** JSON text of the image metadata referenced by the binary descriptor. */
+  void SetMetadataJSON(const std::string & metadataJSON) {
+    this->m_MetadataJSON = metadataJSON;
+  }
+
+  const std::string & GetMetadataJSON() const {
+    return this->m_MetadataJSON;
+  }
+
 protected:
   WasmImage() = default;
   ~WasmImage() override = default;
+
+  std::string m_MetadataJSON;
 };
 
 } // namespace itk
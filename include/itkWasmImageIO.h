@@ -20,7 +20,11 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkStreamingImageIOBase.h"
+#include "itkWasmIOCommon.h"
+#include "itkWasmPayloadFilter.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 #include "rapidjson/document.h"
 
 namespace itk
@@ -35,6 +39,14 @@ namespace itk
  *
  * The file extensions used are .iwi and .iwi.cbor.
  *
+ * When a ChunkSize is set, the .iwi directory format stores the pixel
+ * buffer as an N-D grid of chunk files, data/chunks/<i>.<j>.<k>.raw, and
+ * records the grid in index.json. Streamed reads and writes then only touch
+ * the chunks that overlap the requested ImageIORegion.
+ *
+ * With UseMemoryMapping enabled, data/data.raw of the .iwi directory format
+ * is memory mapped instead of read through a stream.
+ *
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
  */
@@ -69,6 +81,56 @@ public:
   /** Reads the data from disk into the memory buffer provided. */
   void Read(void *buffer) override;
 
+  /** The .iwi directory format supports streaming, .iwi.cbor does not. */
+  bool CanStreamRead() override;
+  bool CanStreamWrite() override;
+
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
+  /** Set/Get the size of the chunks the .iwi directory format pixel data is
+   * split into. An empty chunk size, the default, writes a single
+   * contiguous data/data.raw. The chunk size is read from index.json in
+   * ReadImageInformation. */
+  void SetChunkSize(const std::vector< SizeValueType > & chunkSize)
+  {
+    if (m_ChunkSize != chunkSize)
+    {
+      m_ChunkSize = chunkSize;
+      this->Modified();
+    }
+  }
+  const std::vector< SizeValueType > & GetChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /** Set/Get whether Read memory maps data/data.raw of the .iwi directory
+   * format and copies the IORegion directly out of the page cache. Off by
+   * default. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
+  /** Set/Get the reversible filter applied to the pixel payload of the
+   * CBOR encodings before it is written, to improve compression. It is
+   * recorded in the CBOR header and set from it by ReadImageInformation.
+   * None by default. */
+  itkSetMacro(PayloadFilter, WasmPayloadFilterEnum);
+  itkGetConstMacro(PayloadFilter, WasmPayloadFilterEnum);
+
+  /** Memory map the pixel buffer of the .iwi directory format after
+   * ReadImageInformation. Pages are faulted in lazily and the data stays
+   * valid while the returned mapping is alive. Returns nullptr for formats
+   * without a single contiguous pixel file, i.e. .iwi.cbor and chunked
+   * .iwi. */
+  std::shared_ptr< const WasmMemoryMappedFile > MapPixelData();
+
 #if !defined(ITK_WRAPPING_PARSER)
   /** Set the JSON representation of the image information. */
   void SetJSON(rapidjson::Document & json);
@@ -101,7 +163,54 @@ protected:
   }
 
   void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
-  size_t WriteCBOR(const void * buffer = nullptr, unsigned char ** cborBuffer = nullptr, bool allocateCBORBuffer = false);
+  /** Incrementally decode the CBOR map from the stream. The pixel payload
+   * is read directly into the buffer, or skipped when buffer is nullptr.
+   *
+   * When buffer is nullptr and the pixel data is the last entry, decoding
+   * stops with the stream positioned at the start of the payload and the
+   * payload length is returned, so that ReadCBORData() can continue the
+   * same pass. Otherwise zero is returned. */
+  SizeValueType ReadCBOR(void * buffer, std::istream & inputStream);
+  /** Read the pixel payload, whose bytestring head has already been
+   * decoded, from the stream into the buffer. */
+  void ReadCBORData(void * buffer, std::istream & inputStream, SizeValueType dataLength);
+  void WriteCBOR(const void * buffer = nullptr);
+  /** Encode the CBOR map into the stream. The pixel payload is written
+   * with a single write directly from the buffer. */
+  void WriteCBOR(const void * buffer, std::ostream & outputStream);
+  /** Encode the CBOR map up to the pixel payload. With withData, the map
+   * ends with the data key and bytestring head, and the caller writes the
+   * GetImageSizeInBytes() payload bytes. */
+  void WriteCBORHeader(std::ostream & outputStream, bool withData);
+  /** Write the GetImageSizeInBytes() payload bytes that follow a
+   * WriteCBORHeader() with data, applying the payload filter. */
+  void WriteCBORData(const void * buffer, std::ostream & outputStream);
+
+  /** Copy the part of destinationRegion that lies within sourceRegion from
+   * a buffer laid out over sourceRegion into a buffer laid out over
+   * destinationRegion. */
+  void CopyRegion(const void * source, const ImageIORegion & sourceRegion,
+    void * destination, const ImageIORegion & destinationRegion) const;
+
+  /** Read or write the chunks of the .iwi directory format that overlap the
+   * current IORegion. */
+  void ReadChunks(void * buffer);
+  void WriteChunks(const void * buffer);
+
+  bool IsChunked() const
+  {
+    return !m_ChunkSize.empty();
+  }
+
+  /** Payload filter layout of the image. Filter blocks are slices along
+   * the slowest-varying dimension. */
+  WasmPayloadLayout GetPayloadLayout() const;
+
+  std::vector< SizeValueType > m_ChunkSize;
+
+  bool m_UseMemoryMapping{ false };
+
+  WasmPayloadFilterEnum m_PayloadFilter{ WasmPayloadFilterEnum::None };
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmImageIO);
@@ -20,9 +20,12 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkWasmDataObject.h"
+#include "itkWasmIOCommon.h"
 #include "itkImageIOBase.h"
 #include "itkVectorContainer.h"
 
+#include <memory>
+
 namespace itk
 {
 /**
@@ -37,6 +40,12 @@ namespace itk
  * 
  * - 0: Pixel buffer `data`
  * - 1: Orientation `direction`
+ *
+ * When SetImageIO is given a WasmImageIO with UseMemoryMapping enabled, the
+ * pixel buffer refers directly to the memory mapped .iwi data file and the
+ * PixelDataContainer is left empty. The same holds for a buffer imported with
+ * ImportPixelData, e.g. a memory IO input array. Use GetPixelData and
+ * GetPixelDataSize to access the pixel buffer in any case.
  * 
  * \ingroup WebAssemblyInterface
  */
@@ -81,6 +90,37 @@ public:
     return this->m_PixelDataContainer.GetPointer();
   }
 
+  /** Refer to an external pixel buffer of size bytes without a copy. The
+   * buffer is not owned and must outlive this object. */
+  void ImportPixelData(const char * data, SizeValueType size);
+
+  /** Pixel buffer, either the memory mapped file, the imported buffer, or
+   * the PixelDataContainer. */
+  const char * GetPixelData() const
+  {
+    if (this->m_PixelDataMapping)
+    {
+      return this->m_PixelDataMapping->GetData();
+    }
+    if (this->m_ImportedPixelData != nullptr)
+    {
+      return this->m_ImportedPixelData;
+    }
+    return this->m_PixelDataContainer->size() == 0 ? nullptr : &(this->m_PixelDataContainer->at(0));
+  }
+  SizeValueType GetPixelDataSize() const
+  {
+    if (this->m_PixelDataMapping)
+    {
+      return this->m_ImageIOBase->GetImageSizeInBytes();
+    }
+    if (this->m_ImportedPixelData != nullptr)
+    {
+      return this->m_ImportedPixelDataSize;
+    }
+    return this->m_PixelDataContainer->size();
+  }
+
 protected:
   WasmImageIOBase();
   ~WasmImageIOBase() override = default;
@@ -90,6 +130,9 @@ protected:
 
   DirectionContainerType::Pointer m_DirectionContainer;
   PixelDataContainerType::Pointer m_PixelDataContainer;
+  std::shared_ptr< const WasmMemoryMappedFile > m_PixelDataMapping;
+  const char * m_ImportedPixelData{ nullptr };
+  SizeValueType m_ImportedPixelDataSize{ 0 };
 
   ImageIOBase::ConstPointer m_ImageIOBase;
 };
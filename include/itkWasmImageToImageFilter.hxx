@@ -27,6 +27,8 @@
 #include "itkWasmMapPixelType.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
+#include "itkCommonEnums.h"
+#include "itkWasmDescriptor.h"
 
 #include "rapidjson/document.h"
 
@@ -132,8 +134,7 @@ WasmImageToImageFilter<TImage>
 ::GenerateData()
 {
   // Get the input and output pointers
-  const WasmImageType * imageJSON = this->GetInput();
-  const std::string json(imageJSON->GetJSON());
+  const WasmImageType * wasmImage = this->GetInput();
   ImageType * image = this->GetOutput();
 
   using IOPixelType = typename TImage::IOPixelType;
@@ -141,26 +142,46 @@ WasmImageToImageFilter<TImage>
   using ConvertPixelTraits = DefaultConvertPixelTraits<PixelType>;
   constexpr unsigned int Dimension = TImage::ImageDimension;
 
+  // The binary descriptor when there is one, otherwise the JSON representation
   rapidjson::Document document;
-  if (document.Parse(json.c_str()).HasParseError())
+  wasm::WasmImageDescriptor descriptor;
+  const rapidjson::Value * metadataJson = nullptr;
+  if (const wasm::WasmDescriptorHeader * header = wasmImage->GetDescriptor())
     {
-    throw std::runtime_error("Could not parse JSON");
+    descriptor = *wasm::castWasmDescriptor<wasm::WasmImageDescriptor>(header);
+    if (descriptor.metadata.size)
+      {
+      const auto * metadataText = reinterpret_cast< const char * >( static_cast< size_t >(descriptor.metadata.address) );
+      if (document.Parse(metadataText, descriptor.metadata.size).HasParseError())
+        {
+        throw std::runtime_error("Could not parse metadata JSON");
+        }
+      metadataJson = &document;
+      }
+    }
+  else
+    {
+    if (document.Parse(wasmImage->GetJSON().c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
+    descriptor = wasm::imageDescriptorFromJSON(document);
+    if (document.HasMember("metadata"))
+      {
+      metadataJson = &document["metadata"];
+      }
     }
 
-  const rapidjson::Value & imageType = document["imageType"];
-  const int dimension = imageType["dimension"].GetInt();
-  if (dimension != Dimension)
+  if (descriptor.dimension != Dimension)
   {
     throw std::runtime_error("Unexpected dimension");
   }
-  const std::string componentType( imageType["componentType"].GetString() );
-  if ( componentType != itk::wasm::MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString )
+  if ( descriptor.componentType != wasm::descriptorComponentType(itk::wasm::MapComponentType<typename ConvertPixelTraits::ComponentType>::ComponentString) )
   {
     throw std::runtime_error("Unexpected component type");
   }
 
-  const std::string pixelType( imageType["pixelType"].GetString() );
-  if ( pixelType != itk::wasm::MapPixelType<PixelType>::PixelString )
+  if ( descriptor.pixelType != wasm::descriptorPixelType(itk::wasm::MapPixelType<PixelType>::PixelString) )
   {
     throw std::runtime_error("Unexpected pixel type");
   }
@@ -169,65 +190,57 @@ WasmImageToImageFilter<TImage>
   auto filter = FilterType::New();
 
   // Don't throw when PixelType is VariableLengthPixel where number of components is 0
-  if (ConvertPixelTraits::GetNumberOfComponents() != 0 && imageType["components"].GetInt() != ConvertPixelTraits::GetNumberOfComponents() )
+  if (ConvertPixelTraits::GetNumberOfComponents() != 0 && descriptor.components != ConvertPixelTraits::GetNumberOfComponents() )
   {
     throw std::runtime_error("Unexpected number of components");
   }
 
   using OriginType = typename ImageType::PointType;
   OriginType origin;
-  const rapidjson::Value & originJson = document["origin"];
-  int count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = originJson.Begin(); itr != originJson.End(); ++itr )
-    {
-    origin[count] = itr->GetDouble();
-    ++count;
-    }
-  filter->SetOrigin( origin );
-
   using SpacingType = typename ImageType::SpacingType;
   SpacingType spacing;
-  const rapidjson::Value & spacingJson = document["spacing"];
-  count = 0;
-  for( rapidjson::Value::ConstValueIterator itr = spacingJson.Begin(); itr != spacingJson.End(); ++itr )
+  using SizeType = typename ImageType::SizeType;
+  SizeType size;
+  SizeValueType totalSize = 1;
+  for (unsigned int ii = 0; ii < Dimension; ++ii)
     {
-    spacing[count] = itr->GetDouble();
-    ++count;
+    origin[ii] = descriptor.origin[ii];
+    spacing[ii] = descriptor.spacing[ii];
+    size[ii] = wasm::descriptorSize(descriptor.size[ii]);
+    totalSize *= size[ii];
     }
+  filter->SetOrigin( origin );
   filter->SetSpacing( spacing );
 
+  // A descriptor without a direction, e.g. from JSON that omits it, has the
+  // identity direction
   using DirectionType = typename ImageType::DirectionType;
-  const rapidjson::Value & directionJson = document["direction"];
-  const std::string directionString( directionJson.GetString() );
-  const double * directionPtr = reinterpret_cast< double * >( std::strtoull(directionString.substr(35).c_str(), nullptr, 10) );
-  using VnlMatrixType = typename DirectionType::InternalMatrixType;
-  const VnlMatrixType vnlMatrix(directionPtr);
-  const DirectionType direction(vnlMatrix);
-  filter->SetDirection(direction);
-
-  using SizeType = typename ImageType::SizeType;
-  SizeType size;
-  const rapidjson::Value & sizeJson = document["size"];
-  count = 0;
-  SizeValueType totalSize = 1;
-  for( rapidjson::Value::ConstValueIterator itr = sizeJson.Begin(); itr != sizeJson.End(); ++itr )
+  DirectionType direction;
+  direction.SetIdentity();
+  if (descriptor.direction)
     {
-    size[count] = itr->GetInt();
-    totalSize *= size[count];
-    ++count;
+    const double * directionPtr = reinterpret_cast< double * >( static_cast< size_t >(descriptor.direction) );
+    using VnlMatrixType = typename DirectionType::InternalMatrixType;
+    const VnlMatrixType vnlMatrix(directionPtr);
+    direction = DirectionType(vnlMatrix);
     }
+  filter->SetDirection(direction);
+
   using RegionType = typename ImageType::RegionType;
   RegionType region;
   region.SetSize( size );
   filter->SetRegion( region );
 
-  const rapidjson::Value & dataJson = document["data"];
-  const std::string dataString( dataJson.GetString() );
-  IOPixelType * dataPtr = reinterpret_cast< IOPixelType * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
+  if (!descriptor.data && totalSize)
+  {
+    throw std::runtime_error("Missing pixel data");
+  }
+  IOPixelType * dataPtr = reinterpret_cast< IOPixelType * >( static_cast< size_t >(descriptor.data) );
   const bool letImageContainerManageMemory = false;
-  if (pixelType == "VariableLengthVector" || pixelType == "VariableSizeMatrix")
+  if (descriptor.pixelType == static_cast< uint32_t >(IOPixelEnum::VARIABLELENGTHVECTOR) ||
+      descriptor.pixelType == static_cast< uint32_t >(IOPixelEnum::VARIABLESIZEMATRIX))
     {
-    filter->SetImportPointer( dataPtr, totalSize, letImageContainerManageMemory, imageType["components"].GetInt());
+    filter->SetImportPointer( dataPtr, totalSize, letImageContainerManageMemory, descriptor.components);
     }
   else
     {
@@ -236,11 +249,10 @@ WasmImageToImageFilter<TImage>
   filter->Update();
   image->Graft(filter->GetOutput());
 
-  if (document.HasMember("metadata"))
+  if (metadataJson != nullptr)
   {
-    auto dictionary = image->GetMetaDataDictionary();
-    const rapidjson::Value & metadataJson = document["metadata"];
-    wasm::ConvertJSONToMetaDataDictionary(metadataJson, dictionary);
+    MetaDataDictionary & dictionary = image->GetMetaDataDictionary();
+    wasm::ConvertJSONToMetaDataDictionary(*metadataJson, dictionary);
   }
 
 }
@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmImportContainer_h
+#define itkWasmImportContainer_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkIntTypes.h"
+
+#include <algorithm>
+
+namespace itk
+{
+
+/** Convert numberOfComponents float components to double. Uses SSE2 or
+ * WebAssembly SIMD kernels when available. */
+WebAssemblyInterface_EXPORT
+void
+convertComponents(const float * input, double * output, SizeValueType numberOfComponents);
+
+/** Convert numberOfComponents double components to float, rounding to
+ * nearest like a static_cast. */
+WebAssemblyInterface_EXPORT
+void
+convertComponents(const double * input, float * output, SizeValueType numberOfComponents);
+
+/** Convert components of any other pair of types with a static_cast. */
+template <typename TInputComponent, typename TOutputComponent>
+void
+convertComponents(const TInputComponent * input, TOutputComponent * output, SizeValueType numberOfComponents)
+{
+  std::transform(input, input + numberOfComponents, output,
+    [](const TInputComponent value) { return static_cast<TOutputComponent>(value); });
+}
+
+namespace wasm
+{
+
+/** Import numberOfElements elements of a memory IO buffer with the layout of
+ * the container elements into an itk::VectorContainer.
+ *
+ * The elements are copied in a single pass into the capacity the container
+ * already has, without value-initializing them first.
+ */
+template <typename TContainer, typename TElement>
+void
+importContainer(TContainer * container, const TElement * buffer, SizeValueType numberOfElements)
+{
+  container->assign(buffer, buffer + numberOfElements);
+}
+
+/** Import numberOfElements elements of numberOfComponents components of
+ * type TInputComponent into a container whose elements have components of
+ * type TOutputComponent, e.g. float points into a mesh with double
+ * coordinates.
+ *
+ * The storage of an itk::VectorContainer cannot be left uninitialized, so
+ * instead of resizing it, which value-initializes every element, blocks of
+ * elements are converted into a small buffer and appended into reserved
+ * capacity. Each element of the container is written once.
+ */
+template <typename TOutputComponent, typename TContainer, typename TInputComponent>
+void
+importConvertedContainer(TContainer * container, const TInputComponent * buffer, SizeValueType numberOfElements, unsigned int numberOfComponents)
+{
+  using ElementType = typename TContainer::Element;
+  static_assert(sizeof(ElementType) % sizeof(TOutputComponent) == 0, "Unexpected container element layout");
+  // Small enough for the stack and the L1 cache
+  constexpr SizeValueType blockSize = 256;
+  ElementType block[blockSize];
+  auto & elements = container->CastToSTLContainer();
+  elements.clear();
+  elements.reserve(numberOfElements);
+  for (SizeValueType offset = 0; offset < numberOfElements; offset += blockSize)
+  {
+    const SizeValueType count = std::min(blockSize, numberOfElements - offset);
+    convertComponents(buffer + offset * numberOfComponents, reinterpret_cast<TOutputComponent *>(block), count * numberOfComponents);
+    elements.insert(elements.end(), block, block + count);
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif // itkWasmImportContainer_h
@@ -0,0 +1,111 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMemoryArena_h
+#define itkWasmMemoryArena_h
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "WebAssemblyInterfaceExport.h"
+
+namespace itk
+{
+/**
+ *\class WasmMemoryArena
+ * \brief Pool of uninitialized, size-class reused memory blocks.
+ *
+ * Blocks are rounded up to a size class: a multiple of a quarter of the
+ * power of two below the requested size, so at most a quarter of a block
+ * is unused. Released blocks are kept per size class and handed back by
+ * later allocations of the same class without touching the system
+ * allocator or initializing the memory.
+ *
+ * Reset releases every block while keeping the capacity, and Trim returns
+ * the released blocks to the system allocator. An allocation that finds no
+ * released block of its class while released blocks at least as large as
+ * it are held trims them first, so blocks of classes that are no longer
+ * requested do not accumulate.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmMemoryArena
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmMemoryArena);
+
+  /** Alignment of the blocks, in bytes. */
+  static constexpr size_t Alignment = 64;
+
+  WasmMemoryArena() = default;
+  ~WasmMemoryArena();
+
+  /** Uninitialized block of at least size bytes. */
+  void *
+  Allocate(size_t size);
+
+  /** Keep a block for reuse. The block must have been allocated by this
+   * arena and not yet released. */
+  void
+  Release(void * block);
+
+  /** Release every block. */
+  void
+  Reset();
+
+  /** Return the released blocks to the system allocator. */
+  void
+  Trim();
+
+  /** Usable size of a block of this arena. */
+  size_t
+  GetBlockSize(const void * block) const;
+
+  /** Bytes of the blocks held from the system allocator, in use or not. */
+  size_t
+  GetReservedSize() const
+  {
+    return m_ReservedSize;
+  }
+
+  /** Bytes of the blocks in use. */
+  size_t
+  GetInUseSize() const
+  {
+    return m_InUseSize;
+  }
+
+  /** Size of the class of blocks that serves size bytes. */
+  static size_t
+  SizeClass(size_t size);
+
+private:
+  // block -> size class
+  std::unordered_map<const void *, size_t> m_InUseBlocks;
+  // size class -> released blocks
+  std::map<size_t, std::vector<void *>> m_ReleasedBlocks;
+  size_t m_ReservedSize{ 0 };
+  size_t m_InUseSize{ 0 };
+};
+
+} // namespace itk
+
+#endif
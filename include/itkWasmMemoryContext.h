@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMemoryContext_h
+#define itkWasmMemoryContext_h
+
+#include "itkWasmDataObject.h"
+#include "itkWasmDescriptor.h"
+#include "itkWasmMemoryArena.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "WebAssemblyInterfaceExport.h"
+
+namespace itk
+{
+namespace wasm
+{
+
+// dataset index, array index
+using InputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
+// address, size of a block of the input arena
+using InputArrayStoreValueType = std::pair<size_t, size_t>;
+using InputArrayStoreType = std::map<InputArrayStoreKeyType, InputArrayStoreValueType>;
+
+/**
+ *\class WasmMemoryContext
+ * \brief Memory IO state of a pipeline execution.
+ *
+ * A context owns the memory IO input and output stores and whether the
+ * pipeline uses memory IO. Pipelines that run concurrently in one process,
+ * each on its own thread, each use their own context.
+ *
+ * The default context, index 0, is the one the itk_wasm_* exports use
+ * without an explicit memory index. A Pipeline makes its context the
+ * current context of its thread for its lifetime; the Input* and Output*
+ * pipeline arguments use the current context at construction unless
+ * another is set.
+ *
+ * A context itself is not synchronized: it must be used by one pipeline
+ * execution at a time.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmMemoryContext
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmMemoryContext);
+
+  /** Create and register a context with a new index. */
+  WasmMemoryContext();
+  ~WasmMemoryContext();
+
+  /** Index of the context, the memoryIndex of the itk_wasm_* exports. */
+  uint32_t
+  GetIndex() const
+  {
+    return m_Index;
+  }
+
+  static WasmMemoryContext *
+  GetDefault();
+
+  /** Registered context with the index, or nullptr. */
+  static WasmMemoryContext *
+  GetContext(uint32_t index);
+
+  /** Current context of the calling thread, the default context if none
+   * was set. */
+  static WasmMemoryContext *
+  GetCurrent();
+
+  /** Set the current context of the calling thread, nullptr for the
+   * default context, and return the previous one. */
+  static WasmMemoryContext *
+  SetCurrent(WasmMemoryContext * context);
+
+  bool
+  GetUseMemoryIO() const
+  {
+    return m_UseMemoryIO;
+  }
+  void
+  SetUseMemoryIO(bool useMemoryIO)
+  {
+    m_UseMemoryIO = useMemoryIO;
+  }
+
+  /** Whether outputs carry a JSON representation in addition to their
+   * binary descriptor. */
+  bool
+  GetUseOutputJSON() const
+  {
+    return m_UseOutputJSON;
+  }
+  void
+  SetUseOutputJSON(bool useOutputJSON)
+  {
+    m_UseOutputJSON = useOutputJSON;
+  }
+
+  /** Uninitialized memory for an input, returned as its address. */
+  size_t
+  AllocateInputArray(uint32_t index, uint32_t subIndex, size_t size);
+  size_t
+  AllocateInputJSON(uint32_t index, size_t size);
+  size_t
+  AllocateInputDescriptor(uint32_t index, size_t size);
+
+  /** JSON text of an input, terminated by a null character, or an empty
+   * string. */
+  const char *
+  GetInputJSON(uint32_t index) const;
+
+  const InputArrayStoreType &
+  GetInputArrayStore() const
+  {
+    return m_InputArrayStore;
+  }
+
+  /** Binary descriptor of an input, or nullptr when the input was provided
+   * as JSON. */
+  const WasmDescriptorHeader *
+  GetInputDescriptor(uint32_t index) const;
+
+  void
+  SetOutputDataObject(uint32_t index, const WasmDataObject * dataObject);
+  /** Output data object, or nullptr. */
+  const WasmDataObject *
+  GetOutputDataObject(uint32_t index) const;
+
+  void
+  SetOutputArray(uint32_t index, uint32_t subIndex, size_t address, size_t size);
+  /** Address and size of an output array, zero if it was not set. */
+  std::pair<size_t, size_t>
+  GetOutputArray(uint32_t index, uint32_t subIndex) const;
+
+  /** Release the inputs and outputs. The memory of the inputs is kept for
+   * reuse by the next execution. */
+  void
+  FreeAll();
+
+  /** Return the memory kept for reuse to the system allocator. */
+  void
+  Trim();
+
+private:
+  explicit WasmMemoryContext(uint32_t index);
+
+  uint32_t m_Index;
+  bool m_UseMemoryIO{ false };
+  bool m_UseOutputJSON{ true };
+
+  // Input arrays are often hundreds of MB, and a warm module is typically
+  // called again with inputs of the same shape. Their blocks come from an
+  // arena so repeated executions neither zero fill nor reallocate them.
+  WasmMemoryArena m_InputArena;
+  InputArrayStoreType m_InputArrayStore;
+  // Uninitialized JSON text, terminated after its size, whose buffer is kept
+  // for the next execution
+  struct InputJSON
+  {
+    std::unique_ptr<char[]> buffer;
+    size_t capacity{ 0 };
+    size_t size{ 0 };
+  };
+  // index
+  std::map<uint32_t, InputJSON> m_InputJSONStore;
+  // index -> descriptor, in uint64_t elements to keep its fields aligned, and its size in bytes
+  std::map<uint32_t, std::pair<std::vector<uint64_t>, size_t>> m_InputDescriptorStore;
+
+  std::map<uint32_t, WasmDataObject::ConstPointer> m_OutputDataObjectStore;
+  // dataset index, array index -> address, size
+  std::map<std::pair<uint32_t, uint32_t>, std::pair<size_t, size_t>> m_OutputArrayStore;
+};
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
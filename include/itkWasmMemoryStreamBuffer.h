@@ -0,0 +1,308 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMemoryStreamBuffer_h
+#define itkWasmMemoryStreamBuffer_h
+
+#include <streambuf>
+#include <istream>
+#include <ostream>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace itk
+{
+/**
+ *\class WasmMemoryStreamBuffer
+ * \brief Read-only std::streambuf over a contiguous memory buffer.
+ *
+ * The buffer is not copied; it must outlive the stream buffer. Seeking is
+ * supported, so it can back a std::istream for random access decoding of
+ * in-memory data.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmMemoryStreamBuffer : public std::streambuf
+{
+public:
+  WasmMemoryStreamBuffer(const char * data, size_t size)
+  {
+    char * begin = const_cast< char * >( data );
+    this->setg(begin, begin, begin + size);
+  }
+
+protected:
+  pos_type
+  seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::in))
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type base = 0;
+    switch (direction)
+    {
+      case std::ios_base::beg:
+        base = 0;
+        break;
+      case std::ios_base::cur:
+        base = this->gptr() - this->eback();
+        break;
+      case std::ios_base::end:
+        base = this->egptr() - this->eback();
+        break;
+      default:
+        return pos_type(off_type(-1));
+    }
+    const off_type position = base + offset;
+    if (position < 0 || position > this->egptr() - this->eback())
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->eback(), this->eback() + position, this->egptr());
+    return pos_type(position);
+  }
+
+  pos_type
+  seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+  std::streamsize
+  showmanyc() override
+  {
+    return this->egptr() - this->gptr();
+  }
+};
+
+/**
+ *\class WasmMemoryInputStream
+ * \brief std::istream over a contiguous memory buffer without a copy.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmMemoryInputStream : public std::istream
+{
+public:
+  WasmMemoryInputStream(const char * data, size_t size)
+    : std::istream(nullptr)
+    , m_StreamBuffer(data, size)
+  {
+    this->rdbuf(&m_StreamBuffer);
+  }
+
+private:
+  WasmMemoryStreamBuffer m_StreamBuffer;
+};
+
+/**
+ *\class WasmGrowableStreamBuffer
+ * \brief Write-only std::streambuf that appends to a growing memory buffer.
+ *
+ * The buffer is owned by the stream buffer and written in place, so its
+ * content can be exported without a copy. The capacity doubles when it is
+ * exhausted, so appends take amortized constant time and the buffer is not
+ * zero-initialized. Seeking within the written bytes is supported; the size
+ * is the end of the furthest write.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmGrowableStreamBuffer : public std::streambuf
+{
+public:
+  WasmGrowableStreamBuffer() = default;
+
+  WasmGrowableStreamBuffer(const WasmGrowableStreamBuffer &) = delete;
+  WasmGrowableStreamBuffer & operator=(const WasmGrowableStreamBuffer &) = delete;
+
+  const char * GetData() const
+  {
+    return m_Buffer.get();
+  }
+
+  size_t GetSize() const
+  {
+    return std::max(m_Size, this->GetPosition());
+  }
+
+  size_t GetCapacity() const
+  {
+    return m_Capacity;
+  }
+
+  /** Ensure a capacity of at least capacity bytes, e.g. when the size of the
+   * output is known in advance. */
+  void Reserve(size_t capacity)
+  {
+    if (capacity <= m_Capacity)
+    {
+      return;
+    }
+    const size_t position = this->GetPosition();
+    m_Size = this->GetSize();
+    std::unique_ptr<char[]> buffer(new char[capacity]);
+    if (m_Size > 0)
+    {
+      std::memcpy(buffer.get(), m_Buffer.get(), m_Size);
+    }
+    m_Buffer = std::move(buffer);
+    m_Capacity = capacity;
+    this->SetPosition(position);
+  }
+
+  /** Append size bytes at the current position without formatting. */
+  void Append(const void * data, size_t size)
+  {
+    if (size == 0)
+    {
+      return;
+    }
+    this->Grow(size);
+    std::memcpy(this->pptr(), data, size);
+    this->SetPosition(this->GetPosition() + size);
+  }
+
+  /** Discard the content, keeping the capacity. */
+  void Clear()
+  {
+    m_Size = 0;
+    this->SetPosition(0);
+  }
+
+protected:
+  int_type
+  overflow(int_type ch) override
+  {
+    if (traits_type::eq_int_type(ch, traits_type::eof()))
+    {
+      return traits_type::not_eof(ch);
+    }
+    this->Grow(1);
+    *this->pptr() = traits_type::to_char_type(ch);
+    this->SetPosition(this->GetPosition() + 1);
+    return ch;
+  }
+
+  std::streamsize
+  xsputn(const char_type * data, std::streamsize count) override
+  {
+    this->Append(data, static_cast<size_t>(count));
+    return count;
+  }
+
+  pos_type
+  seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override
+  {
+    if (!(which & std::ios_base::out))
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type base = 0;
+    switch (direction)
+    {
+      case std::ios_base::beg:
+        base = 0;
+        break;
+      case std::ios_base::cur:
+        base = static_cast<off_type>(this->GetPosition());
+        break;
+      case std::ios_base::end:
+        base = static_cast<off_type>(this->GetSize());
+        break;
+      default:
+        return pos_type(off_type(-1));
+    }
+    const off_type position = base + offset;
+    if (position < 0 || position > static_cast<off_type>(this->GetSize()))
+    {
+      return pos_type(off_type(-1));
+    }
+    m_Size = this->GetSize();
+    this->SetPosition(static_cast<size_t>(position));
+    return pos_type(position);
+  }
+
+  pos_type
+  seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+private:
+  size_t GetPosition() const
+  {
+    return m_Buffer ? static_cast<size_t>(this->pptr() - m_Buffer.get()) : 0;
+  }
+
+  // setp() and pbump() are limited to int offsets, so the put area starts at
+  // the current position
+  void SetPosition(size_t position)
+  {
+    this->setp(m_Buffer.get() + position, m_Buffer.get() + m_Capacity);
+  }
+
+  void Grow(size_t count)
+  {
+    const size_t required = this->GetPosition() + count;
+    if (required > m_Capacity)
+    {
+      this->Reserve(std::max({ required, 2 * m_Capacity, InitialCapacity }));
+    }
+  }
+
+  static constexpr size_t InitialCapacity = 4096;
+
+  std::unique_ptr<char[]> m_Buffer;
+  size_t m_Capacity{ 0 };
+  size_t m_Size{ 0 };
+};
+
+/**
+ *\class WasmGrowableOutputStream
+ * \brief std::ostream that appends to a WasmGrowableStreamBuffer.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmGrowableOutputStream : public std::ostream
+{
+public:
+  WasmGrowableOutputStream()
+    : std::ostream(nullptr)
+  {
+    this->rdbuf(&m_StreamBuffer);
+  }
+
+  WasmGrowableStreamBuffer & GetStreamBuffer()
+  {
+    return m_StreamBuffer;
+  }
+
+  const WasmGrowableStreamBuffer & GetStreamBuffer() const
+  {
+    return m_StreamBuffer;
+  }
+
+private:
+  WasmGrowableStreamBuffer m_StreamBuffer;
+};
+
+} // namespace itk
+
+#endif
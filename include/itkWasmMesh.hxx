@@ -19,6 +19,7 @@
 #define itkWasmMesh_hxx
 
 #include "itkWasmMesh.h"
+#include "itkWasmMeshCellBuffer.h"
 
 namespace itk
 {
@@ -28,7 +29,7 @@ void
 WasmMesh<TMesh>
 ::SetMesh(const MeshType * mesh)
 {
-  this->m_CellBufferContainer = const_cast<MeshType *>(mesh)->GetCellsArray();
+  this->m_CellBufferContainer = WasmMeshCellBuffer<MeshType>::GetCellBuffer(mesh);
   this->SetDataObject(const_cast<MeshType *>(mesh));
 }
 
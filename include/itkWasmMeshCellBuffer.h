@@ -0,0 +1,94 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMeshCellBuffer_h
+#define itkWasmMeshCellBuffer_h
+
+#include "itkIntTypes.h"
+
+#include <mutex>
+#include <unordered_map>
+
+namespace itk
+{
+/**
+ *\class WasmMeshCellBuffer
+ * \brief Cached cell buffer of a TMesh, in the Mesh::GetCellsArray() layout.
+ *
+ * Each cell is its cell type, its number of points and its point
+ * identifiers. Mesh::GetCellsArray() walks every cell to rebuild this
+ * buffer each time it is called. GetCellBuffer() instead keeps the buffer
+ * of a mesh until the mesh is deleted and rebuilds it only when the cells
+ * container of the mesh is replaced or modified.
+ *
+ * Setting a cell with Mesh::SetCell modifies the cells container. A cell
+ * edited in place through a pointer to it does not: call Modified() on the
+ * cells container after such an edit.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TMesh>
+class ITK_TEMPLATE_EXPORT WasmMeshCellBuffer
+{
+public:
+  using MeshType = TMesh;
+  using CellBufferContainerType = typename MeshType::CellsVectorContainer;
+  using CellBufferContainerPointer = typename CellBufferContainerType::Pointer;
+
+  /** Cells per chunk of a parallel build. */
+  static constexpr SizeValueType CellsPerChunk = 16384;
+
+  /** Cell buffer of the current cells of mesh, built if the cached buffer
+   * is missing or out of date. The buffer must not be modified. */
+  static CellBufferContainerPointer
+  GetCellBuffer(const MeshType * mesh);
+
+  /** Record cellBuffer as the cell buffer of the current cells of mesh,
+   * e.g. the buffer the cells were just imported from. */
+  static void
+  SetCellBuffer(const MeshType * mesh, CellBufferContainerType * cellBuffer);
+
+  /** Build the cell buffer of mesh, in parallel chunks of cells: the size
+   * of each chunk is computed first, then each chunk is written at its
+   * offset. */
+  static CellBufferContainerPointer
+  BuildCellBuffer(const MeshType * mesh);
+
+private:
+  struct CacheEntry
+  {
+    const void * cells{ nullptr };
+    ModifiedTimeType cellsMTime{ 0 };
+    CellBufferContainerPointer cellBuffer;
+  };
+
+  struct Cache
+  {
+    std::mutex mutex;
+    std::unordered_map<const MeshType *, CacheEntry> entries;
+  };
+
+  static Cache &
+  GetCache();
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWasmMeshCellBuffer.hxx"
+#endif
+
+#endif
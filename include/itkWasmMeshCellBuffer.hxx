@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMeshCellBuffer_hxx
+#define itkWasmMeshCellBuffer_hxx
+
+#include "itkWasmMeshCellBuffer.h"
+#include "itkMultiThreaderBase.h"
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+namespace itk
+{
+
+template <typename TMesh>
+auto
+WasmMeshCellBuffer<TMesh>
+::GetCache() -> Cache &
+{
+  // Never destroyed, so that meshes released during static destruction can
+  // still remove their entries
+  static auto * cache = new Cache;
+  return *cache;
+}
+
+template <typename TMesh>
+auto
+WasmMeshCellBuffer<TMesh>
+::GetCellBuffer(const MeshType * mesh) -> CellBufferContainerPointer
+{
+  const auto * cells = mesh->GetCells();
+  if (cells == nullptr)
+  {
+    return CellBufferContainerType::New();
+  }
+
+  Cache & cache = GetCache();
+  {
+    const std::lock_guard<std::mutex> lock(cache.mutex);
+    const auto entry = cache.entries.find(mesh);
+    if (entry != cache.entries.end() && entry->second.cells == cells && entry->second.cellsMTime == cells->GetMTime())
+    {
+      return entry->second.cellBuffer;
+    }
+  }
+
+  auto cellBuffer = BuildCellBuffer(mesh);
+  SetCellBuffer(mesh, cellBuffer);
+  return cellBuffer;
+}
+
+template <typename TMesh>
+void
+WasmMeshCellBuffer<TMesh>
+::SetCellBuffer(const MeshType * mesh, CellBufferContainerType * cellBuffer)
+{
+  const auto * cells = mesh->GetCells();
+  if (cells == nullptr)
+  {
+    return;
+  }
+
+  Cache & cache = GetCache();
+  const std::lock_guard<std::mutex> lock(cache.mutex);
+  const auto [entry, inserted] = cache.entries.try_emplace(mesh);
+  entry->second.cells = cells;
+  entry->second.cellsMTime = cells->GetMTime();
+  entry->second.cellBuffer = cellBuffer;
+  if (inserted)
+  {
+    mesh->AddObserver(DeleteEvent(), [mesh](const EventObject &) {
+      Cache & deleteCache = GetCache();
+      const std::lock_guard<std::mutex> deleteLock(deleteCache.mutex);
+      deleteCache.entries.erase(mesh);
+    });
+  }
+}
+
+template <typename TMesh>
+auto
+WasmMeshCellBuffer<TMesh>
+::BuildCellBuffer(const MeshType * mesh) -> CellBufferContainerPointer
+{
+  using CellType = typename MeshType::CellType;
+  using ElementType = typename CellBufferContainerType::Element;
+
+  auto cellBuffer = CellBufferContainerType::New();
+  const auto * cells = mesh->GetCells();
+  if (cells == nullptr || cells->Size() == 0)
+  {
+    return cellBuffer;
+  }
+
+  // The cells container is not necessarily random access
+  std::vector<const CellType *> cellPointers;
+  cellPointers.reserve(cells->Size());
+  for (auto cellIt = cells->Begin(); cellIt != cells->End(); ++cellIt)
+  {
+    cellPointers.push_back(cellIt.Value());
+  }
+  const SizeValueType numberOfCells = cellPointers.size();
+  const SizeValueType numberOfChunks = (numberOfCells + CellsPerChunk - 1) / CellsPerChunk;
+  const auto chunkCells = [numberOfCells](SizeValueType chunk) {
+    const SizeValueType begin = chunk * CellsPerChunk;
+    return std::make_pair(begin, std::min(begin + CellsPerChunk, numberOfCells));
+  };
+
+  // chunkOffsets[chunk + 1] is first the size of the chunk, then the end of
+  // the chunk once summed
+  std::vector<SizeValueType> chunkOffsets(numberOfChunks + 1, 0);
+  auto multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const auto [begin, end] = chunkCells(chunk);
+      SizeValueType chunkSize = 0;
+      for (SizeValueType cellId = begin; cellId < end; ++cellId)
+      {
+        chunkSize += 2 + cellPointers[cellId]->GetNumberOfPoints();
+      }
+      chunkOffsets[chunk + 1] = chunkSize;
+    },
+    nullptr);
+  std::partial_sum(chunkOffsets.begin(), chunkOffsets.end(), chunkOffsets.begin());
+
+  auto & buffer = cellBuffer->CastToSTLContainer();
+  buffer.resize(chunkOffsets.back());
+  ElementType * bufferData = buffer.data();
+  multiThreader->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const auto [begin, end] = chunkCells(chunk);
+      ElementType * output = bufferData + chunkOffsets[chunk];
+      for (SizeValueType cellId = begin; cellId < end; ++cellId)
+      {
+        const CellType * cell = cellPointers[cellId];
+        *output++ = static_cast<ElementType>(cell->GetType());
+        *output++ = static_cast<ElementType>(cell->GetNumberOfPoints());
+        output = std::transform(cell->PointIdsBegin(), cell->PointIdsEnd(), output,
+          [](const typename MeshType::PointIdentifier pointId) { return static_cast<ElementType>(pointId); });
+      }
+    },
+    nullptr);
+  return cellBuffer;
+}
+
+} // end namespace itk
+
+#endif
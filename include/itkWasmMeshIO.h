@@ -20,7 +20,12 @@
 #include "WebAssemblyInterfaceExport.h"
 
 #include "itkMeshIOBase.h"
+#include "itkWasmIOCommon.h"
 #include <fstream>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 #include "rapidjson/document.h"
 #include "cbor.h"
@@ -36,6 +41,21 @@ namespace itk
  * replaced by binary files on the filesystem or in a CBOR file.
  *
  * The file extensions used are .iwm and .iwm.cbor.
+ *
+ * ReadMeshInformation only decodes the header of .iwm.cbor and records
+ * where the points, cells, point data and cell data payloads are. The
+ * Read methods then copy each payload directly from the file into the
+ * caller's buffer, or from a memory mapping with UseMemoryMapping.
+ *
+ * Two optional write modes reduce the size of surface meshes. With
+ * SetPointQuantizationPrecision, float32 and float64 points are stored as
+ * unsigned integers over their bounding box. The meshType then records the
+ * unsigned integer type as pointComponentType, and the bounding box and
+ * float type in pointQuantization, so readers unaware of the quantization
+ * do not take the points for floats. The Read methods expand them back to
+ * the float type.
+ * With NarrowCellComponentTypeOn, cells are stored with the narrowest
+ * unsigned integer type that holds their values.
  * 
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -72,6 +92,28 @@ public:
   /** Set the JSON representation of the image information. */
   void SetJSON(rapidjson::Document & json);
 
+  /** Set/Get whether the Read methods copy the .iwm.cbor payloads out of a
+   * memory mapping of the file instead of reading them through a stream.
+   * Off by default. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
+  /** Set/Get the precision, in coordinate units, to which float32 and
+   * float64 points are quantized when written. The points are stored as
+   * the narrowest of uint8, uint16 or uint32 that resolves the precision
+   * across their bounding box. Zero, the default, stores the points
+   * unchanged. */
+  itkSetMacro(PointQuantizationPrecision, double);
+  itkGetConstMacro(PointQuantizationPrecision, double);
+
+  /** Set/Get whether cells are written with the narrowest unsigned integer
+   * type that holds their cell types, sizes and point identifiers. Off by
+   * default. */
+  itkSetMacro(NarrowCellComponentType, bool);
+  itkGetConstMacro(NarrowCellComponentType, bool);
+  itkBooleanMacro(NarrowCellComponentType);
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Writes the data to disk from the memory buffer provided. Make sure
@@ -100,15 +142,68 @@ protected:
   ~WasmMeshIO() override;
   void PrintSelf(std::ostream & os, Indent indent) const override;
 
-  /** Reads in the mesh information and populates the related buffers. */
-  void ReadCBOR(void * buffer = nullptr, unsigned char * cborBuffer = nullptr, size_t cborBufferLength = 0);
+  /** Reads in the mesh information from the CBOR file and records the
+   * locations of the data payloads. */
+  void ReadCBOR();
+  /** Reads in the mesh information from an in-memory CBOR encoding, e.g.
+   * after decompression. The encoding is kept to read the data payloads
+   * from. */
+  void ReadCBOR(std::vector< char > && cborBuffer);
+  /** Copy a data payload recorded by ReadCBOR into the buffer. */
+  virtual void ReadCBORData(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead);
+  /** Apply a top-level header item of the CBOR map, e.g. meshType. */
+  void ReadCBORHeaderItem(std::string_view key, const cbor_item_t * value);
   /** Writes the buffers into the CBOR item and the buffer out to disk. */
   void WriteCBOR();
 
   cbor_item_t * m_CBORRoot{ nullptr };
 
+  bool m_UseMemoryMapping{ false };
+  double m_PointQuantizationPrecision{ 0.0 };
+  bool m_NarrowCellComponentType{ false };
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmMeshIO);
+
+  void ReadCBORIndex(std::istream & inputStream);
+
+  /** Byte range of a typed array payload in the CBOR encoding. */
+  struct CBORDataLocation
+  {
+    SizeValueType offset{ 0 };
+    SizeValueType length{ 0 };
+  };
+  std::map< std::string, CBORDataLocation, std::less<> > m_CBORDataLocations;
+
+  /** Write the index.json of an .iwm directory. */
+  void WriteJSONIndex();
+
+  /** Quantize float32 or float64 points when PointQuantizationPrecision is
+   * set. Returns whether they were quantized. */
+  bool QuantizePoints(const void * points, std::vector< char > & quantizedPoints);
+  /** Expand quantized points to the pointComponentType. */
+  void DequantizePoints(const void * quantizedPoints, void * points) const;
+  /** Narrow the cell component type when NarrowCellComponentType is set.
+   * Returns whether the cells were narrowed. */
+  bool NarrowCells(const void * cells, std::vector< char > & narrowedCells);
+
+  /** Storage of quantized points, where a coordinate is
+   * minimum + q * (maximum - minimum) / max(q) for the stored unsigned
+   * integer q. The componentType is the stored unsigned integer type, or
+   * unknown when the points are not quantized. */
+  struct PointQuantization
+  {
+    CommonEnums::IOComponent componentType{ CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE };
+    std::vector< double > minimum;
+    std::vector< double > maximum;
+  };
+  PointQuantization m_PointQuantization;
+
+  /** Component type the cells were written with, unknown unless narrowed. */
+  CommonEnums::IOComponent m_WrittenCellComponentType{ CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE };
+
+  std::vector< char > m_CBORBuffer;
+  std::unique_ptr< const WasmMemoryMappedFile > m_MemoryMappedFile;
 };
 } // end namespace itk
 
@@ -0,0 +1,101 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmMeshLocality_h
+#define itkWasmMeshLocality_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkMeshIOBase.h"
+
+#include <vector>
+
+namespace itk
+{
+
+/** Point identifiers of the cells of a mesh in compressed sparse row form:
+ * the points of cell c are pointIds[offsets[c]] up to
+ * pointIds[offsets[c + 1]]. */
+struct WasmMeshCellPoints
+{
+  std::vector< SizeValueType > offsets{ 0 };
+  std::vector< SizeValueType > pointIds;
+
+  SizeValueType
+  GetNumberOfCells() const
+  {
+    return offsets.size() - 1;
+  }
+};
+
+/** Reordering of a mesh. cellOrder[newCellId] is the previous identifier
+ * of the cell, and pointOrder[newPointId] that of the point. */
+struct WasmMeshLocalityOrder
+{
+  std::vector< SizeValueType > cellOrder;
+  std::vector< SizeValueType > pointOrder;
+};
+
+/** Rendering locality of the cells of a mesh. */
+struct WasmMeshLocalityMetrics
+{
+  /** Misses of a FIFO post-transform vertex cache per cell (ACMR). 0.5 to
+   * 0.7 is typical of optimized triangle meshes, 3 the worst case. */
+  double averageCacheMissRatio{ 0.0 };
+  /** Misses of the same cache per referenced point (ATVR). 1 is optimal. */
+  double averageTransformedVertexRatio{ 0.0 };
+  /** Mean difference between the largest and smallest point identifier of
+   * a cell, a measure of vertex fetch locality. */
+  double meanPointIdentifierSpan{ 0.0 };
+};
+
+/** Cell points of a cell buffer in the MeshIOBase encoding, where each cell
+ * is its cell type, its number of points and its point identifiers, all of
+ * the cell component type. Throws a std::runtime_error if the buffer is
+ * malformed or the component type is not an integer type. */
+WebAssemblyInterface_EXPORT
+WasmMeshCellPoints
+cellPointsFromCellBuffer(const void * cells, IOComponentEnum componentType, SizeValueType numberOfCells,
+  SizeValueType cellBufferSize);
+
+/** Order the cells for a post-transform vertex cache of cacheSize points,
+ * with Forsyth's linear-speed vertex cache optimization, then number the
+ * points in the order of their first use by the reordered cells. Points no
+ * cell uses follow in their previous order. */
+WebAssemblyInterface_EXPORT
+WasmMeshLocalityOrder
+computeMeshLocalityOrder(const WasmMeshCellPoints & cellPoints, SizeValueType numberOfPoints,
+  unsigned int cacheSize = 32);
+
+/** Locality of the cells, simulating a FIFO vertex cache of cacheSize
+ * points. */
+WebAssemblyInterface_EXPORT
+WasmMeshLocalityMetrics
+measureMeshLocality(const WasmMeshCellPoints & cellPoints, unsigned int cacheSize = 32);
+
+/** Reorder arrays in the MeshIOBase encoding described by meshInformation.
+ * Point data and cell data are reordered with their points and cells when
+ * there is one pixel per point or cell, and left unchanged otherwise. */
+WebAssemblyInterface_EXPORT
+void
+applyMeshLocalityOrder(const MeshIOBase * meshInformation, const WasmMeshLocalityOrder & order,
+  std::vector< char > & points, std::vector< char > & cells, std::vector< char > & pointData,
+  std::vector< char > & cellData);
+
+} // end namespace itk
+
+#endif // itkWasmMeshLocality_h
@@ -77,6 +77,24 @@ public:
   MeshType *
   GetOutput(unsigned int idx);
 
+  /** Create the cells in per-type pools owned by a WasmPackedCellsContainer,
+   * rather than allocating and setting them one by one. The output mesh then
+   * uses the CellsAllocatedAsStaticArray allocation method. On by default. */
+  itkSetMacro(PackCells, bool);
+  itkGetConstMacro(PackCells, bool);
+  itkBooleanMacro(PackCells);
+
+  /** Keep a copy of the imported cell buffer as the cached cell buffer of the
+   * output mesh, see WasmMeshCellBuffer, so that exporting the mesh before
+   * its cells change does not rebuild it. Only applies to packed cells
+   * imported from a buffer in the Mesh::GetCellsArray() layout. The copy
+   * is held until the mesh is deleted, so this is only worthwhile for
+   * meshes that are exported again. Off by default: the buffer is then
+   * built and cached when the mesh is first exported. */
+  itkSetMacro(CacheCellBuffer, bool);
+  itkGetConstMacro(CacheCellBuffer, bool);
+  itkBooleanMacro(CacheCellBuffer);
+
 protected:
   WasmMeshToMeshFilter();
   ~WasmMeshToMeshFilter() override = default;
@@ -94,6 +112,10 @@ protected:
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  bool m_PackCells{ true };
+  bool m_CacheCellBuffer{ false };
 };
 } // end namespace itk
 
@@ -35,6 +35,10 @@
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
 #include "itkMeshConvertPixelTraits.h"
+#include "itkWasmDescriptor.h"
+#include "itkWasmImportContainer.h"
+#include "itkWasmMeshCellBuffer.h"
+#include "itkWasmPackedCellsContainer.h"
 
 #include "rapidjson/document.h"
 
@@ -43,7 +47,7 @@ namespace
 
 template<typename TMesh, typename TCellBufferType>
 void
-populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, TCellBufferType * cellsBufferPtr)
+populateCells(TMesh * mesh, itk::SizeValueType cellBufferSize, const TCellBufferType * cellsBufferPtr)
 {
   using MeshType = TMesh;
 
@@ -360,8 +364,7 @@ WasmMeshToMeshFilter<TMesh>
 ::GenerateData()
 {
   // Get the input and output pointers
-  const WasmMeshType * meshJSON = this->GetInput();
-  const std::string json(meshJSON->GetJSON());
+  const WasmMeshType * wasmMesh = this->GetInput();
   MeshType * mesh = this->GetOutput();
 
   using PointPixelType = typename MeshType::PixelType;
@@ -369,130 +372,125 @@ WasmMeshToMeshFilter<TMesh>
   using CellPixelType = typename MeshType::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
 
-  rapidjson::Document document;
-  if (document.Parse(json.c_str()).HasParseError())
+  // The binary descriptor when there is one, otherwise the JSON representation
+  wasm::WasmMeshDescriptor descriptor;
+  if (const wasm::WasmDescriptorHeader * header = wasmMesh->GetDescriptor())
     {
-    throw std::runtime_error("Could not parse JSON");
+    descriptor = *wasm::castWasmDescriptor<wasm::WasmMeshDescriptor>(header);
+    }
+  else
+    {
+    rapidjson::Document document;
+    if (document.Parse(wasmMesh->GetJSON().c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
+    descriptor = wasm::meshDescriptorFromJSON(document);
     }
 
-  const rapidjson::Value & meshType = document["meshType"];
-
-  const rapidjson::Value & numberOfPointsJson = document["numberOfPoints"];
-  const SizeValueType numberOfPoints = numberOfPointsJson.GetInt();
-
-  const rapidjson::Value & numberOfPointPixelsJson = document["numberOfPointPixels"];
-  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetInt();
-  // const rapidjson::Value & pointPixelComponentsJson = meshType["pointPixelComponents"];
-  // const SizeValueType pointPixelComponents = pointPixelComponentsJson.GetInt();
-
-  const rapidjson::Value & numberOfCellPixelsJson = document["numberOfCellPixels"];
-  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetInt();
-  // const rapidjson::Value & cellPixelComponentsJson = meshType["cellPixelComponents"];
-  // const SizeValueType cellPixelComponents = cellPixelComponentsJson.GetInt();
+  const SizeValueType numberOfPoints = wasm::descriptorSize(descriptor.numberOfPoints);
+  const SizeValueType numberOfPointPixels = wasm::descriptorSize(descriptor.numberOfPointPixels);
+  const SizeValueType numberOfCellPixels = wasm::descriptorSize(descriptor.numberOfCellPixels);
 
-  const int dimension = meshType["dimension"].GetInt();
+  const unsigned int dimension = descriptor.dimension;
   if (dimension != MeshType::PointDimension)
   {
     throw std::runtime_error("Unexpected dimension");
   }
-  const std::string pointPixelComponentType( meshType["pointPixelComponentType"].GetString() );
-  if (numberOfPointPixels && pointPixelComponentType != itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString )
+  if (numberOfPointPixels && descriptor.pointPixelComponentType != wasm::descriptorComponentType(itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString) )
   {
     throw std::runtime_error("Unexpected point pixel component type");
   }
 
-  const std::string pointPixelType( meshType["pointPixelType"].GetString() );
-  if (numberOfPointPixels && pointPixelType != itk::wasm::MapPixelType<PointPixelType>::PixelString )
+  if (numberOfPointPixels && descriptor.pointPixelType != wasm::descriptorPixelType(itk::wasm::MapPixelType<PointPixelType>::PixelString) )
   {
     throw std::runtime_error("Unexpected point pixel type");
   }
 
-  const std::string cellPixelComponentType( meshType["cellPixelComponentType"].GetString() );
-  if (numberOfCellPixels && cellPixelComponentType != itk::wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString )
+  if (numberOfCellPixels && descriptor.cellPixelComponentType != wasm::descriptorComponentType(itk::wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString) )
   {
     throw std::runtime_error("Unexpected cell pixel component type");
   }
 
-  const std::string cellPixelType( meshType["cellPixelType"].GetString() );
-  if (numberOfCellPixels && cellPixelType != itk::wasm::MapPixelType<CellPixelType>::PixelString )
+  if (numberOfCellPixels && descriptor.cellPixelType != wasm::descriptorPixelType(itk::wasm::MapPixelType<CellPixelType>::PixelString) )
   {
     throw std::runtime_error("Unexpected cell pixel type");
   }
 
-  mesh->GetPoints()->resize(numberOfPoints);
   using PointType = typename MeshType::PointType;
-  const rapidjson::Value & pointsJson = document["points"];
-  const std::string pointsString( pointsJson.GetString() );
-  const std::string pointComponentType( meshType["pointComponentType"].GetString() );
+  using CoordRepType = typename MeshType::CoordRepType;
+  const size_t pointsAddress = static_cast< size_t >(descriptor.points);
   if (numberOfPoints)
   {
-    if (pointComponentType == itk::wasm::MapComponentType<typename MeshType::CoordRepType>::ComponentString )
+    if (descriptor.pointComponentType == wasm::descriptorComponentType(itk::wasm::MapComponentType<CoordRepType>::ComponentString) )
     {
-      const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
-      mesh->GetPoints()->assign(pointsPtr, pointsPtr + numberOfPoints);
+      const auto * pointsPtr = reinterpret_cast< const PointType * >( pointsAddress );
+      wasm::importContainer(mesh->GetPoints(), pointsPtr, numberOfPoints);
     }
-    else if (pointComponentType == itk::wasm::MapComponentType<float>::ComponentString)
+    else if (descriptor.pointComponentType == static_cast< uint32_t >(IOComponentEnum::FLOAT))
     {
-      auto * pointsPtr = reinterpret_cast< float * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
-      const size_t pointComponents = numberOfPoints * dimension;
-      auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
-      std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
+      const auto * pointsPtr = reinterpret_cast< const float * >( pointsAddress );
+      wasm::importConvertedContainer<CoordRepType>(mesh->GetPoints(), pointsPtr, numberOfPoints, dimension);
     }
-    else if (pointComponentType == itk::wasm::MapComponentType<double>::ComponentString)
+    else if (descriptor.pointComponentType == static_cast< uint32_t >(IOComponentEnum::DOUBLE))
     {
-      auto * pointsPtr = reinterpret_cast< double * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
-      const size_t pointComponents = numberOfPoints * dimension;
-      auto * pointsContainerPtr = reinterpret_cast<typename MeshType::CoordRepType *>(&(mesh->GetPoints()->at(0)) );
-      std::copy(pointsPtr, pointsPtr + pointComponents, pointsContainerPtr);
+      const auto * pointsPtr = reinterpret_cast< const double * >( pointsAddress );
+      wasm::importConvertedContainer<CoordRepType>(mesh->GetPoints(), pointsPtr, numberOfPoints, dimension);
     }
     else
     {
       throw std::runtime_error("Unexpected point component type");
     }
   }
+  else
+  {
+    mesh->GetPoints()->Initialize();
+  }
 
 
-  const rapidjson::Value & cellBufferSizeJson = document["cellBufferSize"];
-  const SizeValueType cellBufferSize = cellBufferSizeJson.GetInt();
-  const rapidjson::Value & cellsJson = document["cells"];
-  const std::string cellsString( cellsJson.GetString() );
-  using CellBufferType = typename WasmMeshType::CellBufferContainerType::Element;
-  CellBufferType * cellsBufferPtr = reinterpret_cast< CellBufferType * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
-  const std::string cellComponentType( meshType["cellComponentType"].GetString() );
-  if (cellComponentType == "uint32")
+  const SizeValueType cellBufferSize = wasm::descriptorSize(descriptor.cellBufferSize);
+  const size_t cellsAddress = static_cast< size_t >(descriptor.cells);
+  const auto importCells = [this, mesh, cellBufferSize](const auto * cellsBufferPtr) {
+    if (!this->m_PackCells)
+    {
+      populateCells(mesh, cellBufferSize, cellsBufferPtr);
+      return;
+    }
+    auto cells = WasmPackedCellsContainer<MeshType>::New();
+    cells->Import(cellsBufferPtr, cellBufferSize);
+    cells->SetMeshCells(mesh);
+    if (this->m_CacheCellBuffer && cells->IsCellsArrayLayout())
+    {
+      using CellBufferType = typename WasmMeshCellBuffer<MeshType>::CellBufferContainerType;
+      auto cellBuffer = CellBufferType::New();
+      wasm::importContainer(cellBuffer.GetPointer(), cellsBufferPtr, cellBufferSize);
+      WasmMeshCellBuffer<MeshType>::SetCellBuffer(mesh, cellBuffer);
+    }
+  };
+  if (descriptor.cellComponentType == static_cast< uint32_t >(IOComponentEnum::UINT))
   {
-    uint32_t * cellsBufferPtr = reinterpret_cast< uint32_t * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
-    populateCells<MeshType, uint32_t>(mesh, cellBufferSize, cellsBufferPtr);
+    importCells(reinterpret_cast< const uint32_t * >( cellsAddress ));
   }
-  else if (cellComponentType == "uint64")
+  else if (descriptor.cellComponentType == static_cast< uint32_t >(IOComponentEnum::ULONGLONG))
   {
-    uint64_t * cellsBufferPtr = reinterpret_cast< uint64_t * >( static_cast< size_t >(std::strtoull(cellsString.substr(35).c_str(), nullptr, 10)) );
-    populateCells<MeshType, uint64_t>(mesh, cellBufferSize, cellsBufferPtr);
+    importCells(reinterpret_cast< const uint64_t * >( cellsAddress ));
   }
   else
   {
     throw std::runtime_error("Unexpected cell component type");
   }
 
-  const rapidjson::Value & pointDataJson = document["pointData"];
-  using PointPixelType = typename TMesh::PixelType;
-  const std::string pointDataString( pointDataJson.GetString() );
-  auto pointDataPtr = reinterpret_cast< PointPixelType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
-  mesh->GetPointData()->resize(numberOfPointPixels);
-  mesh->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels);
-
-  const rapidjson::Value & cellDataJson = document["cellData"];
-  using CellPixelType = typename TMesh::CellPixelType;
-  const std::string cellDataString( cellDataJson.GetString() );
-  auto cellDataPtr = reinterpret_cast< CellPixelType * >( std::strtoull(cellDataString.substr(35).c_str(), nullptr, 10) );
+  const auto * pointDataPtr = reinterpret_cast< const PointPixelType * >( static_cast< size_t >(descriptor.pointData) );
+  wasm::importContainer(mesh->GetPointData(), pointDataPtr, numberOfPointPixels);
+
+  const auto * cellDataPtr = reinterpret_cast< const CellPixelType * >( static_cast< size_t >(descriptor.cellData) );
   if (mesh->GetCellData() == nullptr)
   {
     mesh->SetCellData(MeshType::CellDataContainer::New());
   }
   if (numberOfCellPixels)
   {
-    mesh->GetCellData()->resize(numberOfCellPixels);
-    mesh->GetCellData()->assign(cellDataPtr, cellDataPtr + numberOfCellPixels);
+    wasm::importContainer(mesh->GetCellData(), cellDataPtr, numberOfCellPixels);
   }
 }
 
@@ -502,6 +500,8 @@ WasmMeshToMeshFilter<TMesh>
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "PackCells: " << this->m_PackCells << std::endl;
+  os << indent << "CacheCellBuffer: " << this->m_CacheCellBuffer << std::endl;
 }
 } // end namespace itk
 
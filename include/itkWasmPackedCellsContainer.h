@@ -0,0 +1,137 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPackedCellsContainer_h
+#define itkWasmPackedCellsContainer_h
+
+#include "itkHexahedronCell.h"
+#include "itkLineCell.h"
+#include "itkPolygonCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkQuadraticEdgeCell.h"
+#include "itkQuadraticTriangleCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkTriangleCell.h"
+#include "itkVertexCell.h"
+
+#include <memory>
+
+namespace itk
+{
+/**
+ *\class WasmPackedCellsContainer
+ * \brief Cells container of a TMesh that owns its cells in contiguous pools.
+ *
+ * Import() creates the cells of a cell buffer in the MeshIOBase encoding,
+ * where each cell is its cell type, its number of points and its point
+ * identifiers. The cells of each type are constructed in a single array
+ * instead of being allocated one by one, and the container is filled
+ * directly instead of through TMesh::SetCell.
+ *
+ * The container, not the mesh, owns the cells: a mesh that uses it must have
+ * the CellsAllocatedAsStaticArray allocation method. Cells added later to
+ * such a mesh with SetCell are not released by the mesh.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+template <typename TMesh>
+class ITK_TEMPLATE_EXPORT WasmPackedCellsContainer : public TMesh::CellsContainer
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WasmPackedCellsContainer);
+
+  /** Standard class type aliases. */
+  using Self = WasmPackedCellsContainer;
+  using Superclass = typename TMesh::CellsContainer;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmPackedCellsContainer, VectorContainer);
+
+  using MeshType = TMesh;
+  using CellType = typename MeshType::CellType;
+  using CellIdentifier = typename MeshType::CellIdentifier;
+  using PointIdentifier = typename MeshType::PointIdentifier;
+
+  /** Replace the cells with those of a cell buffer of cellBufferSize
+   * elements. Polylines become one line cell per segment and three point
+   * polygons become triangles. Throws a std::runtime_error if the buffer is
+   * malformed. */
+  template <typename TCellBuffer>
+  void
+  Import(const TCellBuffer * cellBuffer, SizeValueType cellBufferSize);
+
+  /** Whether the last imported cell buffer has the layout that
+   * Mesh::GetCellsArray() produces for the imported cells, i.e. it has no
+   * polylines and no three point polygons. */
+  bool
+  IsCellsArrayLayout() const
+  {
+    return m_CellsArrayLayout;
+  }
+
+  /** Use the cells of this container as the cells of mesh. */
+  void
+  SetMeshCells(MeshType * mesh);
+
+protected:
+  WasmPackedCellsContainer() = default;
+  ~WasmPackedCellsContainer() override = default;
+
+private:
+  template <typename TCell>
+  struct CellPool
+  {
+    std::unique_ptr<TCell[]> cells;
+    SizeValueType size{ 0 };
+
+    void
+    Allocate(SizeValueType count)
+    {
+      cells.reset(count > 0 ? new TCell[count] : nullptr);
+      size = 0;
+    }
+
+    TCell *
+    Next()
+    {
+      return &cells[size++];
+    }
+  };
+
+  bool m_CellsArrayLayout{ false };
+  CellPool<VertexCell<CellType>> m_VertexCells;
+  CellPool<LineCell<CellType>> m_LineCells;
+  CellPool<TriangleCell<CellType>> m_TriangleCells;
+  CellPool<QuadrilateralCell<CellType>> m_QuadrilateralCells;
+  CellPool<PolygonCell<CellType>> m_PolygonCells;
+  CellPool<TetrahedronCell<CellType>> m_TetrahedronCells;
+  CellPool<HexahedronCell<CellType>> m_HexahedronCells;
+  CellPool<QuadraticEdgeCell<CellType>> m_QuadraticEdgeCells;
+  CellPool<QuadraticTriangleCell<CellType>> m_QuadraticTriangleCells;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkWasmPackedCellsContainer.hxx"
+#endif
+
+#endif
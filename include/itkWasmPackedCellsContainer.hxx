@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPackedCellsContainer_hxx
+#define itkWasmPackedCellsContainer_hxx
+
+#include "itkWasmPackedCellsContainer.h"
+#include "itkCommonEnums.h"
+
+#include <stdexcept>
+
+namespace itk
+{
+
+template <typename TMesh>
+template <typename TCellBuffer>
+void
+WasmPackedCellsContainer<TMesh>
+::Import(const TCellBuffer * cellBuffer, SizeValueType cellBufferSize)
+{
+  // Count the cells of each type first, so that each pool is one allocation
+  SizeValueType vertexCells = 0;
+  SizeValueType lineCells = 0;
+  SizeValueType triangleCells = 0;
+  SizeValueType quadrilateralCells = 0;
+  SizeValueType polygonCells = 0;
+  SizeValueType tetrahedronCells = 0;
+  SizeValueType hexahedronCells = 0;
+  SizeValueType quadraticEdgeCells = 0;
+  SizeValueType quadraticTriangleCells = 0;
+  const auto expectPoints = [](SizeValueType cellPoints, unsigned int expected, const char * message) {
+    if (cellPoints != expected)
+    {
+      throw std::runtime_error(message);
+    }
+  };
+  bool cellsArrayLayout = true;
+  SizeValueType index = 0;
+  while (index < cellBufferSize)
+  {
+    if (cellBufferSize - index < 2)
+    {
+      throw std::runtime_error("Truncated cell buffer");
+    }
+    const auto type = static_cast<CellGeometryEnum>(static_cast<int>(cellBuffer[index]));
+    const auto cellPoints = static_cast<SizeValueType>(cellBuffer[index + 1]);
+    index += 2;
+    if (cellPoints > cellBufferSize - index)
+    {
+      throw std::runtime_error("Truncated cell buffer");
+    }
+    switch (type)
+    {
+      case CellGeometryEnum::VERTEX_CELL:
+        expectPoints(cellPoints, VertexCell<CellType>::NumberOfPoints, "Invalid Vertex Cell number of points");
+        ++vertexCells;
+        break;
+      case CellGeometryEnum::LINE_CELL:
+        // Polylines are loaded as individual edges
+        if (cellPoints < 2)
+        {
+          throw std::runtime_error("Invalid Line Cell number of points");
+        }
+        lineCells += cellPoints - 1;
+        cellsArrayLayout = cellsArrayLayout && cellPoints == 2;
+        break;
+      case CellGeometryEnum::TRIANGLE_CELL:
+        expectPoints(cellPoints, TriangleCell<CellType>::NumberOfPoints, "Invalid Triangle Cell number of points");
+        ++triangleCells;
+        break;
+      case CellGeometryEnum::QUADRILATERAL_CELL:
+        expectPoints(cellPoints, QuadrilateralCell<CellType>::NumberOfPoints, "Invalid Quadrilateral Cell with number of points");
+        ++quadrilateralCells;
+        break;
+      case CellGeometryEnum::POLYGON_CELL:
+        if (cellPoints == TriangleCell<CellType>::NumberOfPoints)
+        {
+          ++triangleCells;
+          cellsArrayLayout = false;
+        }
+        else
+        {
+          ++polygonCells;
+        }
+        break;
+      case CellGeometryEnum::TETRAHEDRON_CELL:
+        expectPoints(cellPoints, TetrahedronCell<CellType>::NumberOfPoints, "Invalid Tetrahedron Cell number of points");
+        ++tetrahedronCells;
+        break;
+      case CellGeometryEnum::HEXAHEDRON_CELL:
+        expectPoints(cellPoints, HexahedronCell<CellType>::NumberOfPoints, "Invalid Hexahedron Cell number of points");
+        ++hexahedronCells;
+        break;
+      case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+        expectPoints(cellPoints, QuadraticEdgeCell<CellType>::NumberOfPoints, "Invalid Quadratic edge Cell number of points");
+        ++quadraticEdgeCells;
+        break;
+      case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+        expectPoints(cellPoints, QuadraticTriangleCell<CellType>::NumberOfPoints, "Invalid Quadratic triangle Cell number of points");
+        ++quadraticTriangleCells;
+        break;
+      default:
+        throw std::runtime_error("Unknown cell type");
+    }
+    index += cellPoints;
+  }
+
+  this->Initialize();
+  m_CellsArrayLayout = cellsArrayLayout;
+  m_VertexCells.Allocate(vertexCells);
+  m_LineCells.Allocate(lineCells);
+  m_TriangleCells.Allocate(triangleCells);
+  m_QuadrilateralCells.Allocate(quadrilateralCells);
+  m_PolygonCells.Allocate(polygonCells);
+  m_TetrahedronCells.Allocate(tetrahedronCells);
+  m_HexahedronCells.Allocate(hexahedronCells);
+  m_QuadraticEdgeCells.Allocate(quadraticEdgeCells);
+  m_QuadraticTriangleCells.Allocate(quadraticTriangleCells);
+  const SizeValueType numberOfCells = vertexCells + lineCells + triangleCells + quadrilateralCells + polygonCells +
+                                      tetrahedronCells + hexahedronCells + quadraticEdgeCells + quadraticTriangleCells;
+  if (numberOfCells == 0)
+  {
+    return;
+  }
+  this->Reserve(numberOfCells);
+
+  CellIdentifier id = 0;
+  index = 0;
+  const auto insertCell = [this, cellBuffer, &id, &index](auto & pool, SizeValueType cellPoints) {
+    auto * cell = pool.Next();
+    for (SizeValueType jj = 0; jj < cellPoints; ++jj)
+    {
+      cell->SetPointId(static_cast<int>(jj), static_cast<PointIdentifier>(cellBuffer[index++]));
+    }
+    this->InsertElement(id++, cell);
+  };
+  while (index < cellBufferSize)
+  {
+    const auto type = static_cast<CellGeometryEnum>(static_cast<int>(cellBuffer[index]));
+    const auto cellPoints = static_cast<SizeValueType>(cellBuffer[index + 1]);
+    index += 2;
+    switch (type)
+    {
+      case CellGeometryEnum::VERTEX_CELL:
+        insertCell(m_VertexCells, cellPoints);
+        break;
+      case CellGeometryEnum::LINE_CELL:
+        for (SizeValueType jj = 1; jj < cellPoints; ++jj)
+        {
+          auto * cell = m_LineCells.Next();
+          cell->SetPointId(0, static_cast<PointIdentifier>(cellBuffer[index]));
+          cell->SetPointId(1, static_cast<PointIdentifier>(cellBuffer[index + 1]));
+          ++index;
+          this->InsertElement(id++, cell);
+        }
+        ++index;
+        break;
+      case CellGeometryEnum::TRIANGLE_CELL:
+        insertCell(m_TriangleCells, cellPoints);
+        break;
+      case CellGeometryEnum::QUADRILATERAL_CELL:
+        insertCell(m_QuadrilateralCells, cellPoints);
+        break;
+      case CellGeometryEnum::POLYGON_CELL:
+        if (cellPoints == TriangleCell<CellType>::NumberOfPoints)
+        {
+          insertCell(m_TriangleCells, cellPoints);
+        }
+        else
+        {
+          insertCell(m_PolygonCells, cellPoints);
+        }
+        break;
+      case CellGeometryEnum::TETRAHEDRON_CELL:
+        insertCell(m_TetrahedronCells, cellPoints);
+        break;
+      case CellGeometryEnum::HEXAHEDRON_CELL:
+        insertCell(m_HexahedronCells, cellPoints);
+        break;
+      case CellGeometryEnum::QUADRATIC_EDGE_CELL:
+        insertCell(m_QuadraticEdgeCells, cellPoints);
+        break;
+      case CellGeometryEnum::QUADRATIC_TRIANGLE_CELL:
+        insertCell(m_QuadraticTriangleCells, cellPoints);
+        break;
+      default:
+        // Validated above
+        break;
+    }
+  }
+}
+
+template <typename TMesh>
+void
+WasmPackedCellsContainer<TMesh>
+::SetMeshCells(MeshType * mesh)
+{
+  // Releases the previous cells with the previous allocation method
+  mesh->SetCells(this);
+  mesh->SetCellsAllocationMethod(MeshEnums::MeshClassCellsAllocationMethod::CellsAllocatedAsStaticArray);
+}
+
+} // end namespace itk
+
+#endif
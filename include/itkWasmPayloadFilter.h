@@ -0,0 +1,96 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmPayloadFilter_h
+#define itkWasmPayloadFilter_h
+
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkIntTypes.h"
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace itk
+{
+
+/** Reversible filters applied to a pixel payload before compression.
+ *
+ * Byte shuffle regroups the bytes of the components by significance so that
+ * the slowly varying high bytes form long runs. Delta coding stores the
+ * difference to the same component of the previous pixel in the row, as an
+ * unsigned integer of the component size, which also makes it exact for
+ * floating point data. DeltaShuffle applies delta coding, then shuffle.
+ */
+enum class WasmPayloadFilterEnum : uint8_t
+{
+  None = 0,
+  Shuffle,
+  Delta,
+  DeltaShuffle
+};
+
+WebAssemblyInterface_EXPORT
+std::ostream &
+operator<<(std::ostream & out, const WasmPayloadFilterEnum value);
+
+/** Name of the filter, as recorded in the CBOR header: "none", "shuffle",
+ * "delta" or "delta-shuffle". */
+WebAssemblyInterface_EXPORT
+std::string
+payloadFilterToString(WasmPayloadFilterEnum filter);
+
+/** Filter from its name. Throws a std::runtime_error for an unknown name. */
+WebAssemblyInterface_EXPORT
+WasmPayloadFilterEnum
+payloadFilterFromString(const std::string & name);
+
+/** Layout of the payload the filter is applied to. */
+struct WasmPayloadLayout
+{
+  /** Bytes per component: the shuffle element size and delta integer width. */
+  unsigned int componentSize{ 1 };
+  /** Components per pixel: the delta stride. */
+  unsigned int numberOfComponents{ 1 };
+  /** Pixels per row: delta coding restarts on each row. */
+  SizeValueType rowLength{ 1 };
+  /** Bytes per block, a whole number of rows. Blocks are shuffled
+   * independently so that a block can be reversed on its own. */
+  SizeValueType blockSize{ 0 };
+};
+
+/** Filter numberOfBytes, a whole number of blocks, from input into output.
+ * Trailing bytes that do not form a whole component are copied unchanged.
+ * The buffers must not overlap. 2 and 4 byte components use SSE2 or
+ * WebAssembly SIMD kernels when available: shuffle and delta encoding for
+ * any stride, delta decoding for one component or strides of at least a
+ * vector. */
+WebAssemblyInterface_EXPORT
+void
+applyPayloadFilter(WasmPayloadFilterEnum filter, const WasmPayloadLayout & layout,
+  const void * input, void * output, SizeValueType numberOfBytes);
+
+/** Reverse applyPayloadFilter(). The buffers must not overlap. */
+WebAssemblyInterface_EXPORT
+void
+reversePayloadFilter(WasmPayloadFilterEnum filter, const WasmPayloadLayout & layout,
+  const void * input, void * output, SizeValueType numberOfBytes);
+
+} // end namespace itk
+
+#endif // itkWasmPayloadFilter_h
@@ -32,6 +32,8 @@
 #include "itkVertexCell.h"
 
 #include <exception>
+#include "itkWasmDescriptor.h"
+#include "itkWasmImportContainer.h"
 #include "itkWasmMapComponentType.h"
 #include "itkWasmMapPixelType.h"
 #include "itkMeshConvertPixelTraits.h"
@@ -140,8 +142,7 @@ WasmPolyDataToPolyDataFilter<TPolyData>
 ::GenerateData()
 {
   // Get the input and output pointers
-  const WasmPolyDataType * polyDataJSON = this->GetInput();
-  const std::string json(polyDataJSON->GetJSON());
+  const WasmPolyDataType * wasmPolyData = this->GetInput();
   PolyDataType * polyData = this->GetOutput();
 
   using PointPixelType = typename PolyDataType::PixelType;
@@ -149,126 +150,96 @@ WasmPolyDataToPolyDataFilter<TPolyData>
   using CellPixelType = typename PolyDataType::CellPixelType;
   using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
 
-  rapidjson::Document document;
-  if (document.Parse(json.c_str()).HasParseError())
+  // The binary descriptor when there is one, otherwise the JSON representation
+  wasm::WasmPolyDataDescriptor descriptor;
+  if (const wasm::WasmDescriptorHeader * header = wasmPolyData->GetDescriptor())
     {
-    throw std::runtime_error("Could not parse JSON");
+    descriptor = *wasm::castWasmDescriptor<wasm::WasmPolyDataDescriptor>(header);
+    }
+  else
+    {
+    rapidjson::Document document;
+    if (document.Parse(wasmPolyData->GetJSON().c_str()).HasParseError())
+      {
+      throw std::runtime_error("Could not parse JSON");
+      }
+    descriptor = wasm::polyDataDescriptorFromJSON(document);
     }
 
-  const rapidjson::Value & polyDataType = document["polyDataType"];
-
-  const std::string pointPixelComponentType( polyDataType["pointPixelComponentType"].GetString() );
-  if ( pointPixelComponentType != itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString )
+  if ( descriptor.pointPixelComponentType != wasm::descriptorComponentType(itk::wasm::MapComponentType<typename ConvertPointPixelTraits::ComponentType>::ComponentString) )
   {
     throw std::runtime_error("Unexpected point pixel component type");
   }
 
-  const std::string pointPixelType( polyDataType["pointPixelType"].GetString() );
-  if ( pointPixelType != itk::wasm::MapPixelType<PointPixelType>::PixelString )
+  if ( descriptor.pointPixelType != wasm::descriptorPixelType(itk::wasm::MapPixelType<PointPixelType>::PixelString) )
   {
     throw std::runtime_error("Unexpected point pixel type");
   }
 
-  const std::string cellPixelComponentType( polyDataType["cellPixelComponentType"].GetString() );
-  if ( cellPixelComponentType != itk::wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString )
+  if ( descriptor.cellPixelComponentType != wasm::descriptorComponentType(itk::wasm::MapComponentType<typename ConvertCellPixelTraits::ComponentType>::ComponentString) )
   {
     throw std::runtime_error("Unexpected cell pixel component type");
   }
 
-  const std::string cellPixelType( polyDataType["cellPixelType"].GetString() );
-  if ( cellPixelType != itk::wasm::MapPixelType<CellPixelType>::PixelString )
+  if ( descriptor.cellPixelType != wasm::descriptorPixelType(itk::wasm::MapPixelType<CellPixelType>::PixelString) )
   {
     throw std::runtime_error("Unexpected cell pixel type");
   }
 
-  const rapidjson::Value & numberOfPointsJson = document["numberOfPoints"];
-  const SizeValueType numberOfPoints = numberOfPointsJson.GetInt();
+  const SizeValueType numberOfPoints = wasm::descriptorSize(descriptor.numberOfPoints);
   if (numberOfPoints)
   {
     using PointType = typename PolyDataType::PointType;
-    const rapidjson::Value & pointsJson = document["points"];
-    const std::string pointsString( pointsJson.GetString() );
-    const auto * pointsPtr = reinterpret_cast< PointType * >( std::strtoull(pointsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPoints()->resize(numberOfPoints);
-    polyData->GetPoints()->assign(pointsPtr, pointsPtr + numberOfPoints);
+    const auto * pointsPtr = reinterpret_cast< const PointType * >( static_cast< size_t >(descriptor.points) );
+    wasm::importContainer(polyData->GetPoints(), pointsPtr, numberOfPoints);
   }
 
-  const rapidjson::Value & verticesBufferSizeJson = document["verticesBufferSize"];
-  const SizeValueType verticesBufferSize = verticesBufferSizeJson.GetInt();
+  const SizeValueType verticesBufferSize = wasm::descriptorSize(descriptor.verticesBufferSize);
   if (verticesBufferSize)
   {
-    const rapidjson::Value & verticesJson = document["vertices"];
-    const std::string verticesString( verticesJson.GetString() );
-    auto verticesPtr = reinterpret_cast< uint32_t * >( std::strtoull(verticesString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetVertices()->resize(verticesBufferSize);
-    polyData->GetVertices()->assign(verticesPtr, verticesPtr + verticesBufferSize);
+    const auto * verticesPtr = reinterpret_cast< const uint32_t * >( static_cast< size_t >(descriptor.vertices) );
+    wasm::importContainer(polyData->GetVertices(), verticesPtr, verticesBufferSize);
   }
 
-  const rapidjson::Value & linesBufferSizeJson = document["linesBufferSize"];
-  const SizeValueType linesBufferSize = linesBufferSizeJson.GetInt();
+  const SizeValueType linesBufferSize = wasm::descriptorSize(descriptor.linesBufferSize);
   if (linesBufferSize)
   {
-    const rapidjson::Value & linesJson = document["lines"];
-    const std::string linesString( linesJson.GetString() );
-    auto linesPtr = reinterpret_cast< uint32_t * >( std::strtoull(linesString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetLines()->resize(linesBufferSize);
-    polyData->GetLines()->assign(linesPtr, linesPtr + linesBufferSize);
+    const auto * linesPtr = reinterpret_cast< const uint32_t * >( static_cast< size_t >(descriptor.lines) );
+    wasm::importContainer(polyData->GetLines(), linesPtr, linesBufferSize);
   }
 
-  const rapidjson::Value & polygonsBufferSizeJson = document["polygonsBufferSize"];
-  const SizeValueType polygonsBufferSize = polygonsBufferSizeJson.GetInt();
+  const SizeValueType polygonsBufferSize = wasm::descriptorSize(descriptor.polygonsBufferSize);
   if (polygonsBufferSize)
   {
-    const rapidjson::Value & polygonsJson = document["polygons"];
-    const std::string polygonsString( polygonsJson.GetString() );
-    auto polygonsPtr = reinterpret_cast< uint32_t * >( std::strtoull(polygonsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPolygons()->resize(polygonsBufferSize);
-    polyData->GetPolygons()->assign(polygonsPtr, polygonsPtr + polygonsBufferSize);
+    const auto * polygonsPtr = reinterpret_cast< const uint32_t * >( static_cast< size_t >(descriptor.polygons) );
+    wasm::importContainer(polyData->GetPolygons(), polygonsPtr, polygonsBufferSize);
   }
 
-  const rapidjson::Value & triangleStripsBufferSizeJson = document["triangleStripsBufferSize"];
-  const SizeValueType triangleStripsBufferSize = triangleStripsBufferSizeJson.GetInt();
+  const SizeValueType triangleStripsBufferSize = wasm::descriptorSize(descriptor.triangleStripsBufferSize);
   if (triangleStripsBufferSize)
   {
-    const rapidjson::Value & triangleStripsJson = document["triangleStrips"];
-    const std::string triangleStripsString( triangleStripsJson.GetString() );
-    auto triangleStripsPtr = reinterpret_cast< uint32_t * >( std::strtoull(triangleStripsString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetTriangleStrips()->resize(triangleStripsBufferSize);
-    polyData->GetTriangleStrips()->assign(triangleStripsPtr, triangleStripsPtr + triangleStripsBufferSize);
+    const auto * triangleStripsPtr = reinterpret_cast< const uint32_t * >( static_cast< size_t >(descriptor.triangleStrips) );
+    wasm::importContainer(polyData->GetTriangleStrips(), triangleStripsPtr, triangleStripsBufferSize);
   }
 
-  const rapidjson::Value & numberOfPointPixelsJson = document["numberOfPointPixels"];
-  const SizeValueType numberOfPointPixels = numberOfPointPixelsJson.GetInt();
+  const SizeValueType numberOfPointPixels = wasm::descriptorSize(descriptor.numberOfPointPixels);
   if (numberOfPointPixels)
   {
-    const rapidjson::Value & pointPixelComponentsJson = polyDataType["pointPixelComponents"];
-    const SizeValueType pointPixelComponents = pointPixelComponentsJson.GetInt();
-    const rapidjson::Value & pointDataJson = document["pointData"];
-    using PointPixelType = typename TPolyData::PixelType;
-    using ConvertPointPixelTraits = MeshConvertPixelTraits<PointPixelType>;
-    const std::string pointDataString( pointDataJson.GetString() );
-    auto pointDataPtr = reinterpret_cast< typename ConvertPointPixelTraits::ComponentType * >( std::strtoull(pointDataString.substr(35).c_str(), nullptr, 10) );
-    polyData->GetPointData()->resize(numberOfPointPixels * pointPixelComponents);
-    polyData->GetPointData()->assign(pointDataPtr, pointDataPtr + numberOfPointPixels * pointPixelComponents);
+    const SizeValueType pointPixelComponents = wasm::descriptorSize(descriptor.pointPixelComponents);
+    const auto * pointDataPtr = reinterpret_cast< const typename ConvertPointPixelTraits::ComponentType * >( static_cast< size_t >(descriptor.pointData) );
+    wasm::importContainer(polyData->GetPointData(), pointDataPtr, numberOfPointPixels * pointPixelComponents);
   }
 
-  const rapidjson::Value & numberOfCellPixelsJson = document["numberOfCellPixels"];
-  const SizeValueType numberOfCellPixels = numberOfCellPixelsJson.GetInt();
+  const SizeValueType numberOfCellPixels = wasm::descriptorSize(descriptor.numberOfCellPixels);
   if (numberOfCellPixels)
   {
-    const rapidjson::Value & cellPixelComponentsJson = polyDataType["cellPixelComponents"];
-    const SizeValueType cellPixelComponents = cellPixelComponentsJson.GetInt();
-    const rapidjson::Value & cellDataJson = document["cellData"];
-    using CellPixelType = typename TPolyData::CellPixelType;
-    using ConvertCellPixelTraits = MeshConvertPixelTraits<CellPixelType>;
-    const std::string cellDataString( cellDataJson.GetString() );
-    auto cellDataPtr = reinterpret_cast< typename ConvertCellPixelTraits::ComponentType * >( std::strtoull(cellDataString.substr(35).c_str(), nullptr, 10) );
+    const SizeValueType cellPixelComponents = wasm::descriptorSize(descriptor.cellPixelComponents);
+    const auto * cellDataPtr = reinterpret_cast< const typename ConvertCellPixelTraits::ComponentType * >( static_cast< size_t >(descriptor.cellData) );
     if (polyData->GetCellData() == nullptr)
     {
       polyData->SetCellData(PolyDataType::CellDataContainer::New());
     }
-    polyData->GetCellData()->resize(numberOfCellPixels * cellPixelComponents);
-    polyData->GetCellData()->assign(cellDataPtr, cellDataPtr + numberOfCellPixels * cellPixelComponents);
+    wasm::importContainer(polyData->GetCellData(), cellDataPtr, numberOfCellPixels * cellPixelComponents);
   }
 }
 
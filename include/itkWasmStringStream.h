@@ -19,7 +19,10 @@
 #define itkWasmStringStream_h
 
 #include "itkWasmDataObject.h"
+#include "itkWasmMemoryStreamBuffer.h"
 #include "rapidjson/document.h"
+#include <sstream>
+#include <string>
 #include <string_view>
 
 #include "WebAssemblyInterfaceExport.h"
@@ -28,9 +31,10 @@ namespace itk
 {
 /**
  *\class WasmStringStream
- * \brief JSON representation for a std::stringstream
+ * \brief JSON representation for a text or binary stream
  *
- * JSON representation for a std::stringstream for interfacing across programming languages and runtimes.
+ * JSON representation for a text or binary stream for interfacing across programming languages and runtimes.
+ * The stream content is held in a single growable buffer, which is exported in place.
  * 
  * { size: sizeInBytes, data: stringDataURI }
  * 
@@ -58,53 +62,80 @@ public:
   itkTypeMacro(WasmStringStream, WasmDataObject);
 
   void SetString(const std::string & string) {
-    this->m_StringStream.str(string);
-    this->UpdateJSON();
+    WasmGrowableStreamBuffer & buffer = this->m_OutputStream.GetStreamBuffer();
+    buffer.Clear();
+    buffer.Append(string.data(), string.size());
+    this->UpdateOutputJSON();
   }
 
-  const std::string & GetString() {
-    this->m_String = m_StringStream.str();
-    return this->m_String;
+  std::string GetString() const {
+    return std::string(this->GetOutputData());
   }
 
-  std::stringstream & GetStringStream() {
-    return this->m_StringStream;
+  void SetJSON(const char * jsonChar) override
+  {
+    const std::string_view data = GetDataFromJSON(jsonChar);
+    WasmGrowableStreamBuffer & buffer = this->m_OutputStream.GetStreamBuffer();
+    buffer.Clear();
+    buffer.Append(data.data(), data.size());
+
+    Superclass::SetJSON(jsonChar);
   }
 
-  void SetJSON(const char * jsonChar) override
+  /** Output stream that appends to the growable buffer that backs this
+   * object. The buffer is exported in place, without a copy, by
+   * GetOutputData(). */
+  std::ostream & GetOutputStream() {
+    return this->m_OutputStream;
+  }
+
+  WasmGrowableStreamBuffer & GetOutputBuffer() {
+    return this->m_OutputStream.GetStreamBuffer();
+  }
+
+  std::string_view GetOutputData() const {
+    const WasmGrowableStreamBuffer & buffer = this->m_OutputStream.GetStreamBuffer();
+    return std::string_view(buffer.GetData(), buffer.GetSize());
+  }
+
+  /** Describe the output buffer in the JSON representation. */
+  void UpdateOutputJSON()
+  {
+    const std::string_view data = this->GetOutputData();
+    this->SetDataJSON(data.data(), data.size());
+  }
+
+  /** The bytes described by a { data, size } JSON, viewed in place in
+   * memory without a copy. */
+  static std::string_view GetDataFromJSON(const char * jsonChar)
   {
-    std::string json(jsonChar);
     rapidjson::Document document;
-    if (document.Parse(json.c_str()).HasParseError())
+    if (document.Parse(jsonChar).HasParseError())
       {
       throw std::runtime_error("Could not parse JSON");
       }
     const rapidjson::Value & dataJson = document["data"];
     const std::string dataString( dataJson.GetString() );
     const char * dataPtr = reinterpret_cast< char * >( std::strtoull(dataString.substr(35).c_str(), nullptr, 10) );
-    size_t size = document["size"].GetInt();
-    const std::string_view string(dataPtr, size);
-    m_StringStream.str(std::string{string});
-
-    Superclass::SetJSON(jsonChar);
+    const size_t size = document["size"].GetUint64();
+    return std::string_view(dataPtr, size);
   }
 protected:
   WasmStringStream() = default;
   ~WasmStringStream() override = default;
 
-  void UpdateJSON()
+  void SetDataJSON(const char * data, size_t size)
   {
     std::ostringstream jsonStream;
     jsonStream << "{ \"data\": \"data:application/vnd.itk.address,0:";
-    jsonStream << reinterpret_cast< size_t >( m_StringStream.str().data() );
+    jsonStream << reinterpret_cast< size_t >( data );
     jsonStream << "\", \"size\": ";
-    jsonStream << m_StringStream.str().size() + 1;
+    jsonStream << size;
     jsonStream << "}";
     this->m_JSON = jsonStream.str();
   }
 
-  std::stringstream m_StringStream;
-  std::string m_String;
+  WasmGrowableOutputStream m_OutputStream;
 
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
@@ -0,0 +1,98 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmVisitComponentType_h
+#define itkWasmVisitComponentType_h
+
+#include "itkCommonEnums.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Call the functor with a value of the C++ type of an unsigned integer
+ * component, as ITKComponentSize sizes it. Throws a std::runtime_error for
+ * other component types. */
+template <typename TFunctor>
+void
+visitUnsignedComponent(CommonEnums::IOComponent componentType, TFunctor && functor)
+{
+  switch (componentType)
+  {
+    case CommonEnums::IOComponent::UCHAR:
+      functor(uint8_t{});
+      return;
+    case CommonEnums::IOComponent::USHORT:
+      functor(uint16_t{});
+      return;
+    case CommonEnums::IOComponent::UINT:
+      functor(uint32_t{});
+      return;
+    case CommonEnums::IOComponent::ULONG:
+    case CommonEnums::IOComponent::ULONGLONG:
+      functor(uint64_t{});
+      return;
+    default:
+      throw std::runtime_error("Not an unsigned integer component type");
+  }
+}
+
+/** Call the functor with a value of the C++ type of an integer component,
+ * as ITKComponentSize sizes it, e.g. of the cell buffer of a mesh. Throws a
+ * std::runtime_error for other component types. */
+template <typename TFunctor>
+void
+visitIntegerComponent(CommonEnums::IOComponent componentType, TFunctor && functor)
+{
+  switch (componentType)
+  {
+    case CommonEnums::IOComponent::CHAR:
+      functor(int8_t{});
+      return;
+    case CommonEnums::IOComponent::SHORT:
+      functor(int16_t{});
+      return;
+    case CommonEnums::IOComponent::INT:
+      functor(int32_t{});
+      return;
+    case CommonEnums::IOComponent::LONG:
+    case CommonEnums::IOComponent::LONGLONG:
+      functor(int64_t{});
+      return;
+    case CommonEnums::IOComponent::UCHAR:
+    case CommonEnums::IOComponent::USHORT:
+    case CommonEnums::IOComponent::UINT:
+    case CommonEnums::IOComponent::ULONG:
+    case CommonEnums::IOComponent::ULONGLONG:
+      visitUnsignedComponent(componentType, std::forward<TFunctor>(functor));
+      return;
+    default:
+      throw std::runtime_error("Not an integer component type");
+  }
+}
+
+} // end namespace wasm
+
+} // end namespace itk
+
+#endif // itkWasmVisitComponentType_h
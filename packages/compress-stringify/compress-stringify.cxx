@@ -22,6 +22,8 @@
 #include <sstream>
 #include <vector>
 #include <iterator>
+#include <span>
+#include <cstddef>
 
 #include "zstd.h"
 #include "cpp-base64/base64.h"
@@ -30,17 +32,33 @@
 #include "itkInputBinaryStream.h"
 #include "itkOutputTextStream.h"
 #include "itkOutputBinaryStream.h"
+#include "itkWasmPayloadFilter.h"
 
-int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel)
+// Apply the optional byte filter that prepares typed data for compression.
+// Without a filter, the input is compressed in place.
+std::span<const std::byte> filterInput(std::span<const std::byte> inputBinary, std::vector<std::byte> & filtered, itk::WasmPayloadFilterEnum filter, unsigned int elementSize)
+{
+  if (filter == itk::WasmPayloadFilterEnum::None)
+  {
+    return inputBinary;
+  }
+  itk::WasmPayloadLayout layout;
+  layout.componentSize = elementSize;
+  layout.rowLength = inputBinary.size() / elementSize;
+  filtered.resize(inputBinary.size());
+  itk::applyPayloadFilter(filter, layout, inputBinary.data(), filtered.data(), inputBinary.size());
+  return filtered;
+}
+
+int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, itk::WasmPayloadFilterEnum filter, unsigned int elementSize)
 {
   itk::wasm::OutputBinaryStream outputBinaryStream;
   pipeline.add_option("output", outputBinaryStream, "Output compressed binary")->type_name("OUTPUT_BINARY_STREAM");
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
+  std::vector<std::byte> filtered;
+  const std::span<const std::byte> inputBinary = filterInput(inputBinaryStream.GetSpan(), filtered, filter, elementSize);
 
 
   const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
@@ -49,22 +67,20 @@ int compress(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inpu
   const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary.data(), inputBinary.size(), compressionLevel);
   compressedBinary.resize(compressedSize);
 
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+  outputBinaryStream.Write(compressedBinary.data(), compressedBinary.size());
 
   return EXIT_SUCCESS;
 }
 
-int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, const std::string & dataURLPrefix)
+int compressStringify(itk::wasm::Pipeline & pipeline, itk::wasm::InputBinaryStream & inputBinaryStream, int compressionLevel, itk::WasmPayloadFilterEnum filter, unsigned int elementSize, const std::string & dataURLPrefix)
 {
   itk::wasm::OutputTextStream outputTextStream;
   pipeline.add_option("output", outputTextStream, "Output dataURL+base64 compressed binary")->type_name("OUTPUT_TEXT_STREAM");
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) );
+  std::vector<std::byte> filtered;
+  const std::span<const std::byte> inputBinary = filterInput(inputBinaryStream.GetSpan(), filtered, filter, elementSize);
 
 
   const size_t compressedBufferSize = ZSTD_compressBound(inputBinary.size());
@@ -100,11 +116,33 @@ int main(int argc, char * argv[])
   std::string dataURLPrefix("data:application/zstd;base64,");
   pipeline.add_option("-p,--data-url-prefix", dataURLPrefix, "dataURL prefix");
 
+  std::string filterName("none");
+  pipeline.add_option("-f,--filter", filterName, "Byte filter applied before compression: none, shuffle, delta, or delta-shuffle. Pass the same filter to parse-string-decompress.");
+
+  unsigned int elementSize = 1;
+  pipeline.add_option("-e,--element-size", elementSize, "Size in bytes of the typed array elements, for the filter");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
+  itk::WasmPayloadFilterEnum filter;
+  try
+  {
+    filter = itk::payloadFilterFromString(filterName);
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (elementSize == 0)
+  {
+    std::cerr << "The element size must be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   if(stringify)
   {
-    return compressStringify(pipeline, inputBinaryStream, compressionLevel, dataURLPrefix);
+    return compressStringify(pipeline, inputBinaryStream, compressionLevel, filter, elementSize, dataURLPrefix);
   }
-  return compress(pipeline, inputBinaryStream, compressionLevel);
+  return compress(pipeline, inputBinaryStream, compressionLevel, filter, elementSize);
 }
@@ -22,6 +22,10 @@
 #include <sstream>
 #include <vector>
 #include <iterator>
+#include <span>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
 
 #include "zstd.h"
 #include "cpp-base64/base64.h"
@@ -30,8 +34,70 @@
 #include "itkInputBinaryStream.h"
 #include "itkInputTextStream.h"
 #include "itkOutputBinaryStream.h"
+#include "itkWasmPayloadFilter.h"
 
-int decompress(itk::wasm::Pipeline & pipeline)
+// Reverse the optional byte filter applied by compress-stringify
+void unfilterOutput(std::vector<char> & decompressedBinary, itk::WasmPayloadFilterEnum filter, unsigned int elementSize)
+{
+  if (filter == itk::WasmPayloadFilterEnum::None)
+  {
+    return;
+  }
+  itk::WasmPayloadLayout layout;
+  layout.componentSize = elementSize;
+  layout.rowLength = decompressedBinary.size() / elementSize;
+  std::vector<char> unfiltered(decompressedBinary.size());
+  itk::reversePayloadFilter(filter, layout, decompressedBinary.data(), unfiltered.data(), decompressedBinary.size());
+  decompressedBinary.swap(unfiltered);
+}
+
+// Decompress a zstd frame. The output is sized from the frame content size
+// when the frame header records it, otherwise it is decompressed as a stream.
+std::vector<char> decompressZstd(const void * input, size_t inputSize)
+{
+  const unsigned long long contentSize = ZSTD_getFrameContentSize(input, inputSize);
+  if (contentSize == ZSTD_CONTENTSIZE_ERROR)
+  {
+    throw std::runtime_error("The input is not a zstd frame");
+  }
+
+  if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN)
+  {
+    std::vector<char> decompressed(static_cast<size_t>(contentSize));
+    const size_t result = ZSTD_decompress(decompressed.data(), decompressed.size(), input, inputSize);
+    if (ZSTD_isError(result))
+    {
+      throw std::runtime_error(ZSTD_getErrorName(result));
+    }
+    decompressed.resize(result);
+    return decompressed;
+  }
+
+  const auto contextDeleter = [](ZSTD_DCtx * context) { ZSTD_freeDCtx(context); };
+  std::unique_ptr<ZSTD_DCtx, decltype(contextDeleter)> context(ZSTD_createDCtx(), contextDeleter);
+  std::vector<char> decompressed;
+  ZSTD_inBuffer inputBuffer{ input, inputSize, 0 };
+  size_t result = 0;
+  do
+  {
+    const size_t position = decompressed.size();
+    decompressed.resize(position + ZSTD_DStreamOutSize());
+    ZSTD_outBuffer outputBuffer{ decompressed.data() + position, decompressed.size() - position, 0 };
+    result = ZSTD_decompressStream(context.get(), &outputBuffer, &inputBuffer);
+    if (ZSTD_isError(result))
+    {
+      throw std::runtime_error(ZSTD_getErrorName(result));
+    }
+    decompressed.resize(position + outputBuffer.pos);
+    if (result != 0 && inputBuffer.pos == inputBuffer.size && outputBuffer.pos == 0)
+    {
+      throw std::runtime_error("The zstd input is truncated");
+    }
+  } while (inputBuffer.pos < inputBuffer.size || result != 0);
+  return decompressed;
+}
+
+int decompress(itk::wasm::Pipeline & pipeline, itk::WasmPayloadFilterEnum filter, unsigned int elementSize)
 {
   itk::wasm::InputBinaryStream inputBinaryStream;
   pipeline.add_option("input", inputBinaryStream, "Compressed input")->type_name("INPUT_BINARY_STREAM");
@@ -41,24 +107,26 @@ int decompress(itk::wasm::Pipeline & pipeline)
 
   ITK_WASM_PARSE(pipeline);
 
-  std::string inputBinary;
-  inputBinary.assign( (std::istreambuf_iterator<char>(inputBinaryStream.Get()) ), 
-                      (std::istreambuf_iterator<char>()) ); 
-
+  const std::span<const std::byte> inputBinary = inputBinaryStream.GetSpan();
 
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
+  std::vector<char> decompressedBinary;
+  try
+  {
+    decompressedBinary = decompressZstd(inputBinary.data(), inputBinary.size());
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  unfilterOutput(decompressedBinary, filter, elementSize);
 
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  outputBinaryStream.Write(decompressedBinary.data(), decompressedBinary.size());
 
   return EXIT_SUCCESS;
 }
 
-int decodeDecompress(itk::wasm::Pipeline & pipeline)
+int decodeDecompress(itk::wasm::Pipeline & pipeline, itk::WasmPayloadFilterEnum filter, unsigned int elementSize)
 {
   itk::wasm::InputTextStream inputTextStream;
   pipeline.add_option("input", inputTextStream, "Compressed input")->type_name("INPUT_TEXT_STREAM");
@@ -82,14 +150,19 @@ int decodeDecompress(itk::wasm::Pipeline & pipeline)
 
   auto inputBinary = base64_decode(inputText);
 
-  const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-  std::vector<char> decompressedBinary(decompressedBufferSize);
-
-  const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-  decompressedBinary.resize(decompressedSize);
+  std::vector<char> decompressedBinary;
+  try
+  {
+    decompressedBinary = decompressZstd(inputBinary.data(), inputBinary.size());
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  unfilterOutput(decompressedBinary, filter, elementSize);
 
-  std::ostream_iterator<char> oIt(outputBinaryStream.Get());
-  std::copy(decompressedBinary.begin(), decompressedBinary.end(), oIt);
+  outputBinaryStream.Write(decompressedBinary.data(), decompressedBinary.size());
 
   return EXIT_SUCCESS;
 }
@@ -101,12 +174,34 @@ int main(int argc, char * argv[])
   bool parseString = false;
   pipeline.add_flag("-s,--parse-string", parseString, "Parse the input string before decompression");
 
+  std::string filterName("none");
+  pipeline.add_option("-f,--filter", filterName, "Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle");
+
+  unsigned int elementSize = 1;
+  pipeline.add_option("-e,--element-size", elementSize, "Size in bytes of the typed array elements, for the filter");
+
   ITK_WASM_PRE_PARSE(pipeline);
 
+  itk::WasmPayloadFilterEnum filter;
+  try
+  {
+    filter = itk::payloadFilterFromString(filterName);
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (elementSize == 0)
+  {
+    std::cerr << "The element size must be positive" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   if(parseString)
   {
-    return decodeDecompress(pipeline);
+    return decodeDecompress(pipeline, filter, elementSize);
   }
-  return decompress(pipeline);
+  return decompress(pipeline, filter, elementSize);
 }
 
@@ -21,6 +21,8 @@ async def compress_stringify_async(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +38,12 @@ async def compress_stringify_async(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param filter: Byte filter applied before compression: none, shuffle, delta, or delta-shuffle. Pass the same filter to parse-string-decompress.
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -49,6 +57,10 @@ async def compress_stringify_async(
         kwargs["compressionLevel"] = to_js(compression_level)
     if data_url_prefix:
         kwargs["dataUrlPrefix"] = to_js(data_url_prefix)
+    if filter:
+        kwargs["filter"] = to_js(filter)
+    if element_size:
+        kwargs["elementSize"] = to_js(element_size)
 
     outputs = await js_module.compressStringify(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -19,6 +19,8 @@ from itkwasm import (
 async def parse_string_decompress_async(
     input: bytes,
     parse_string: bool = False,
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -28,6 +30,12 @@ async def parse_string_decompress_async(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param filter: Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
@@ -37,6 +45,10 @@ async def parse_string_decompress_async(
     kwargs = {}
     if parse_string:
         kwargs["parseString"] = to_js(parse_string)
+    if filter:
+        kwargs["filter"] = to_js(filter)
+    if element_size:
+        kwargs["elementSize"] = to_js(element_size)
 
     outputs = await js_module.parseStringDecompress(to_js(input), webWorker=web_worker, noCopy=True, **kwargs)
 
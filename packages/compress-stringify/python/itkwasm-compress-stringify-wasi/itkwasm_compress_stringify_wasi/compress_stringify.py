@@ -21,6 +21,8 @@ def compress_stringify(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -36,6 +38,12 @@ def compress_stringify(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param filter: Byte filter applied before compression: none, shuffle, delta, or delta-shuffle. Pass the same filter to parse-string-decompress.
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
@@ -71,6 +79,14 @@ def compress_stringify(
         args.append('--data-url-prefix')
         args.append(str(data_url_prefix))
 
+    if filter:
+        args.append('--filter')
+        args.append(str(filter))
+
+    if element_size:
+        args.append('--element-size')
+        args.append(str(element_size))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
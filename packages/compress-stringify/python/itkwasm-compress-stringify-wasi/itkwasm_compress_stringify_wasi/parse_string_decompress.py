@@ -19,6 +19,8 @@ from itkwasm import (
 def parse_string_decompress(
     input: bytes,
     parse_string: bool = False,
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -28,6 +30,12 @@ def parse_string_decompress(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param filter: Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
@@ -55,6 +63,14 @@ def parse_string_decompress(
     if parse_string:
         args.append('--parse-string')
 
+    if filter:
+        args.append('--filter')
+        args.append(str(filter))
+
+    if element_size:
+        args.append('--element-size')
+        args.append(str(element_size))
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
@@ -30,4 +30,20 @@ def test_we_can_use_a_custom_data_url_prefix():
     assert decompressed_data[0] == 222
     assert decompressed_data[1] == 173
     assert decompressed_data[2] == 190
-    assert decompressed_data[3] == 239
\ No newline at end of file
+    assert decompressed_data[3] == 239
+
+def assert_filter_round_trip(filter):
+    data = b''.join((index * 257 + 3).to_bytes(2, 'little') for index in range(256))
+    compressed_data = compress_stringify(data, filter=filter, element_size=2)
+    decompressed_data = parse_string_decompress(compressed_data, filter=filter, element_size=2)
+
+    assert bytes(decompressed_data) == data
+
+def test_decompress_reverses_the_shuffle_filter():
+    assert_filter_round_trip('shuffle')
+
+def test_decompress_reverses_the_delta_filter():
+    assert_filter_round_trip('delta')
+
+def test_decompress_reverses_the_delta_shuffle_filter():
+    assert_filter_round_trip('delta-shuffle')
@@ -13,6 +13,8 @@ async def compress_stringify_async(
     stringify: bool = False,
     compression_level: int = 3,
     data_url_prefix: str = "data:application/zstd;base64,",
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary, compress and optionally base64 encode.
 
@@ -28,9 +30,15 @@ async def compress_stringify_async(
     :param data_url_prefix: dataURL prefix
     :type  data_url_prefix: str
 
+    :param filter: Byte filter applied before compression: none, shuffle, delta, or delta-shuffle. Pass the same filter to parse-string-decompress.
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output compressed binary
     :rtype:  bytes
     """
     func = environment_dispatch("itkwasm_compress_stringify", "compress_stringify_async")
-    output = await func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix)
+    output = await func(input, stringify=stringify, compression_level=compression_level, data_url_prefix=data_url_prefix, filter=filter, element_size=element_size)
     return output
@@ -11,6 +11,8 @@ from itkwasm import (
 def parse_string_decompress(
     input: bytes,
     parse_string: bool = False,
+    filter: str = "none",
+    element_size: int = 1,
 ) -> bytes:
     """Given a binary or string produced with compress-stringify, decompress and optionally base64 decode.
 
@@ -20,9 +22,15 @@ def parse_string_decompress(
     :param parse_string: Parse the input string before decompression
     :type  parse_string: bool
 
+    :param filter: Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle
+    :type  filter: str
+
+    :param element_size: Size in bytes of the typed array elements, for the filter
+    :type  element_size: int
+
     :return: Output decompressed binary
     :rtype:  bytes
     """
     func = environment_dispatch("itkwasm_compress_stringify", "parse_string_decompress")
-    output = func(input, parse_string=parse_string)
+    output = func(input, parse_string=parse_string, filter=filter, element_size=element_size)
     return output
@@ -56,6 +56,14 @@ async function compressStringifyNode(
   if (options.dataUrlPrefix) {
     args.push('--data-url-prefix', options.dataUrlPrefix.toString())
 
+  }
+  if (options.filter) {
+    args.push('--filter', options.filter.toString())
+
+  }
+  if (options.elementSize) {
+    args.push('--element-size', options.elementSize.toString())
+
   }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'compress-stringify')
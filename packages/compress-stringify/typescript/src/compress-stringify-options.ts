@@ -12,6 +12,12 @@ interface CompressStringifyOptions extends WorkerPoolFunctionOption {
   /** dataURL prefix */
   dataUrlPrefix?: string
 
+  /** Byte filter applied before compression: none, shuffle, delta, or delta-shuffle. Pass the same filter to parse-string-decompress. */
+  filter?: string
+
+  /** Size in bytes of the typed array elements, for the filter */
+  elementSize?: number
+
 }
 
 export default CompressStringifyOptions
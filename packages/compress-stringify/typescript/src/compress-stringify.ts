@@ -58,6 +58,14 @@ async function compressStringify(
   if (options.dataUrlPrefix) {
     args.push('--data-url-prefix', options.dataUrlPrefix.toString())
 
+  }
+  if (options.filter) {
+    args.push('--filter', options.filter.toString())
+
+  }
+  if (options.elementSize) {
+    args.push('--element-size', options.elementSize.toString())
+
   }
 
   const pipelinePath = 'compress-stringify'
@@ -4,6 +4,12 @@ interface ParseStringDecompressNodeOptions {
   /** Parse the input string before decompression */
   parseString?: boolean
 
+  /** Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle */
+  filter?: string
+
+  /** Size in bytes of the typed array elements, for the filter */
+  elementSize?: number
+
 }
 
 export default ParseStringDecompressNodeOptions
@@ -49,6 +49,14 @@ async function parseStringDecompressNode(
   if (options.parseString) {
     options.parseString && args.push('--parse-string')
   }
+  if (options.filter) {
+    args.push('--filter', options.filter.toString())
+
+  }
+  if (options.elementSize) {
+    args.push('--element-size', options.elementSize.toString())
+
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'parse-string-decompress')
 
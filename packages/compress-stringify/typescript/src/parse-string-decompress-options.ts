@@ -6,6 +6,12 @@ interface ParseStringDecompressOptions extends WorkerPoolFunctionOption {
   /** Parse the input string before decompression */
   parseString?: boolean
 
+  /** Byte filter applied by compress-stringify: none, shuffle, delta, or delta-shuffle */
+  filter?: string
+
+  /** Size in bytes of the typed array elements, for the filter */
+  elementSize?: number
+
 }
 
 export default ParseStringDecompressOptions
@@ -51,6 +51,14 @@ async function parseStringDecompress(
   if (options.parseString) {
     options.parseString && args.push('--parse-string')
   }
+  if (options.filter) {
+    args.push('--filter', options.filter.toString())
+
+  }
+  if (options.elementSize) {
+    args.push('--element-size', options.elementSize.toString())
+
+  }
 
   const pipelinePath = 'parse-string-decompress'
 
@@ -60,3 +60,40 @@ test("We can use a custom dataUrlPrefix", async (t) => {
   t.is(decompressedData[2], 190);
   t.is(decompressedData[3], 239);
 });
+
+test("Decompress a frame without a recorded content size", async (t) => {
+  // A single raw block frame whose header omits the content size
+  const compressedData = new Uint8Array([
+    0x28, 0xb5, 0x2f, 0xfd, 0x00, 0x00, 0x21, 0x00, 0x00, 222, 173, 190, 239,
+  ]);
+  const { output: decompressedData } =
+    await parseStringDecompressNode(compressedData);
+
+  t.is(decompressedData.length, 4);
+  t.is(decompressedData[0], 222);
+  t.is(decompressedData[1], 173);
+  t.is(decompressedData[2], 190);
+  t.is(decompressedData[3], 239);
+});
+
+test("Decompress rejects input that is not a zstd frame", async (t) => {
+  const data = new Uint8Array([222, 173, 190, 239]);
+  await t.throwsAsync(parseStringDecompressNode(data));
+});
+
+for (const filter of ["shuffle", "delta", "delta-shuffle"]) {
+  test(`Decompress reverses the ${filter} filter`, async (t) => {
+    const values = new Uint16Array(256).map((_, index) => index * 257 + 3);
+    const data = new Uint8Array(values.buffer);
+    const { output: compressedData } = await compressStringifyNode(data, {
+      filter,
+      elementSize: 2,
+    });
+    const { output: decompressedData } = await parseStringDecompressNode(
+      compressedData,
+      { filter, elementSize: 2 },
+    );
+
+    t.deepEqual(new Uint8Array(decompressedData), data);
+  });
+}
@@ -3,6 +3,7 @@ from pathlib import Path, PurePosixPath
 from dataclasses import asdict
 from typing import List, Union, Dict, Tuple, Set
 import ctypes
+import struct
 import sys
 import os
 
@@ -60,6 +61,72 @@ def array_like_to_bytes(arr: ArrayLike) -> bytes:
     return array_like_to_numpy_array(arr).tobytes()
 
 
+# Binary image descriptor, see include/itkWasmDescriptor.h: the header,
+# dimension, componentType, pixelType, components, origin, spacing, size,
+# and the direction, data and metadata addresses.
+_image_descriptor_format = "<IHHII4I6d6d6QQQQQ"
+_descriptor_magic = 0x44574B49
+_descriptor_version = 1
+_image_descriptor_kind = 1
+
+# IOComponentEnum and IOPixelEnum values of the interface type strings
+_descriptor_component_types = {
+    "uint8": 1,
+    "int8": 2,
+    "uint16": 3,
+    "int16": 4,
+    "uint32": 5,
+    "int32": 6,
+    "uint64": 9,
+    "int64": 10,
+    "float32": 11,
+    "float64": 12,
+}
+_descriptor_pixel_types = {
+    "Unknown": 0,
+    "Scalar": 1,
+    "RGB": 2,
+    "RGBA": 3,
+    "Offset": 4,
+    "Vector": 5,
+    "Point": 6,
+    "CovariantVector": 7,
+    "SymmetricSecondRankTensor": 8,
+    "DiffusionTensor3D": 9,
+    "Complex": 10,
+    "FixedArray": 11,
+    "Array": 12,
+    "Matrix": 13,
+    "VariableLengthVector": 14,
+    "VariableSizeMatrix": 15,
+}
+
+
+def image_descriptor(image: Image, data_ptr: int, direction_ptr: int) -> bytes:
+    """Pack the binary descriptor of an image whose arrays are at the given addresses."""
+    dimension = image.imageType.dimension
+    padding = 6 - dimension
+    return struct.pack(
+        _image_descriptor_format,
+        _descriptor_magic,
+        _descriptor_version,
+        _image_descriptor_kind,
+        struct.calcsize(_image_descriptor_format),
+        0,
+        dimension,
+        _descriptor_component_types[str(image.imageType.componentType)],
+        _descriptor_pixel_types[str(image.imageType.pixelType)],
+        image.imageType.components,
+        *[float(value) for value in image.origin], *[0.0] * padding,
+        *[float(value) for value in image.spacing], *[0.0] * padding,
+        *[int(value) for value in image.size], *[0] * padding,
+        direction_ptr,
+        data_ptr,
+        0,
+        0,
+    )
+
+
 class RunInstance:
     """Helper for working with the wasm module instance created when a Pipeline is run."""
 
@@ -90,8 +157,16 @@ class RunInstance:
         self._instance = instance
 
         self._memory = instance.exports(store)["memory"]
+        # Addresses and sizes are 64-bit in memory64 modules. No memory64
+        # pipelines are built yet; every shipped module takes the 32-bit mask.
+        self._address_mask = 0xFFFFFFFFFFFFFFFF if self._memory.type(store).is_64 else 0xFFFFFFFF
         self._input_array_alloc = instance.exports(store)["itk_wasm_input_array_alloc"]
         self._input_json_alloc = instance.exports(store)["itk_wasm_input_json_alloc"]
+        # Modules built before the binary descriptors take JSON inputs only
+        try:
+            self._input_descriptor_alloc = instance.exports(store)["itk_wasm_input_descriptor_alloc"]
+        except KeyError:
+            self._input_descriptor_alloc = None
         self._output_array_address = instance.exports(store)["itk_wasm_output_array_address"]
         self._output_array_size = instance.exports(store)["itk_wasm_output_array_size"]
         self._output_json_address = instance.exports(store)["itk_wasm_output_json_address"]
@@ -101,8 +176,8 @@ class RunInstance:
         _initialize(store)
 
     def wasmtime_lift(self, ptr: int, size: int):
-        ptr = ptr & 0xFFFFFFFF
-        size = size & 0xFFFFFFFF
+        ptr = ptr & self._address_mask
+        size = size & self._address_mask
         if ptr + size > self._memory.data_len(self._store):
             raise IndexError("attempting to lift of bounds")
         raw_base = self._memory.data_ptr(self._store)
@@ -110,7 +185,7 @@ class RunInstance:
         return ctypes.string_at(base, size)
 
     def wasmtime_lower(self, ptr: int, data: Union[bytes, bytearray]):
-        ptr = ptr & 0xFFFFFFFF
+        ptr = ptr & self._address_mask
         size = len(data)
         if ptr + size > self._memory.data_len(self._store):
             raise IndexError("attempting to lower out of bounds")
@@ -130,6 +205,14 @@ class RunInstance:
         json_ptr = self._input_json_alloc(self._store, 0, input_index, len(data_json))
         self.wasmtime_lower(json_ptr, data_json)
 
+    @property
+    def has_input_descriptors(self) -> bool:
+        return self._input_descriptor_alloc is not None
+
+    def set_input_descriptor(self, descriptor: bytes, input_index: int) -> None:
+        descriptor_ptr = self._input_descriptor_alloc(self._store, 0, input_index, len(descriptor))
+        self.wasmtime_lower(descriptor_ptr, descriptor)
+
     def get_output_json(self, output_index: int) -> Dict:
         json_ptr = self._output_json_address(self._store, 0, output_index)
         json_len = self._output_json_size(self._store, 0, output_index)
@@ -231,16 +314,19 @@ class Pipeline:
                 data_ptr = ri.set_input_array(mv, index, 0)
                 dv = array_like_to_bytes(image.direction)
                 direction_ptr = ri.set_input_array(dv, index, 1)
-                image_json = {
-                    "imageType": asdict(image.imageType),
-                    "name": image.name,
-                    "origin": image.origin,
-                    "spacing": image.spacing,
-                    "direction": f"data:application/vnd.itk.address,0:{direction_ptr}",
-                    "size": image.size,
-                    "data": f"data:application/vnd.itk.address,0:{data_ptr}",
-                }
-                ri.set_input_json(image_json, index)
+                if ri.has_input_descriptors:
+                    ri.set_input_descriptor(image_descriptor(image, data_ptr, direction_ptr), index)
+                else:
+                    image_json = {
+                        "imageType": asdict(image.imageType),
+                        "name": image.name,
+                        "origin": image.origin,
+                        "spacing": image.spacing,
+                        "direction": f"data:application/vnd.itk.address,0:{direction_ptr}",
+                        "size": image.size,
+                        "data": f"data:application/vnd.itk.address,0:{data_ptr}",
+                    }
+                    ri.set_input_json(image_json, index)
             elif input_.type == InterfaceTypes.Mesh:
                 mesh = input_.data
                 if mesh.numberOfPoints:
@@ -1,6 +1,7 @@
 from pathlib import Path, PurePosixPath
 import tempfile
 from dataclasses import asdict
+import struct
 import sys
 
 import pytest
@@ -20,6 +21,7 @@ from itkwasm import (
     Image,
     Mesh,
 )
+from itkwasm.pipeline import image_descriptor
 
 test_input_dir = Path(__file__).resolve().parent / "input"
 test_baseline_dir = Path(__file__).resolve().parent / "baseline"
@@ -170,6 +172,27 @@ def test_pipeline_write_read_image():
     assert difference == 0.0
 
 
+def test_image_descriptor():
+    image = Image(
+        imageType={"dimension": 2, "componentType": "int16", "pixelType": "Vector", "components": 3},
+        origin=[1.0, 2.0],
+        spacing=[0.5, 0.25],
+        size=[4, 3],
+    )
+    descriptor = image_descriptor(image, 1024, 2048)
+    assert len(descriptor) == 208
+
+    fields = struct.unpack("<IHHII4I6d6d6QQQQQ", descriptor)
+    assert fields[0:5] == (0x44574B49, 1, 1, 208, 0)
+    # dimension, int16 SHORT, VECTOR, components
+    assert fields[5:9] == (2, 4, 5, 3)
+    assert fields[9:15] == (1.0, 2.0, 0.0, 0.0, 0.0, 0.0)
+    assert fields[15:21] == (0.5, 0.25, 0.0, 0.0, 0.0, 0.0)
+    assert fields[21:27] == (4, 3, 0, 0, 0, 0)
+    # direction, data and the empty metadata
+    assert fields[27:31] == (2048, 1024, 0, 0)
+
+
 def test_pipeline_dask_array_input():
     pipeline = Pipeline(test_input_dir / "median-filter-test.wasi.wasm")
 
@@ -6,8 +6,8 @@ function getFileExtension (filePath: string): string {
   } else if (extension.toLowerCase() === 'cbor') {
     const index = filePath.slice(0, -5).lastIndexOf('.')
     extension = filePath.slice((index - 1 >>> 0) + 2)
-  } else if (extension.toLowerCase() === 'zst') {
-    // .iwi.cbor.zstd
+  } else if (extension.toLowerCase() === 'zst' || extension.toLowerCase() === 'lz4') {
+    // .iwi.cbor.zst, .iwi.cbor.lz4
     const index = filePath.slice(0, -10).lastIndexOf('.')
     extension = filePath.slice((index - 1 >>> 0) + 2)
   } else if (extension.toLowerCase() === 'zip') {
@@ -66,6 +66,69 @@ function setPipelineModuleInputJSON (emscriptenModule: PipelineEmscriptenModule,
   emscriptenModule.stringToUTF8(dataJSON, jsonPtr, length)
 }
 
+// Binary image descriptor layout, see include/itkWasmDescriptor.h
+const descriptorMagic = 0x44574b49
+const descriptorVersion = 1
+const imageDescriptorKind = 1
+const imageDescriptorSize = 208
+const descriptorMaximumDimension = 6
+
+// IOComponentEnum and IOPixelEnum values of the interface type strings
+const descriptorComponentTypes: Record<string, number> = {
+  uint8: 1,
+  int8: 2,
+  uint16: 3,
+  int16: 4,
+  uint32: 5,
+  int32: 6,
+  uint64: 9,
+  int64: 10,
+  float32: 11,
+  float64: 12
+}
+const descriptorPixelTypes: Record<string, number> = {
+  Unknown: 0,
+  Scalar: 1,
+  RGB: 2,
+  RGBA: 3,
+  Offset: 4,
+  Vector: 5,
+  Point: 6,
+  CovariantVector: 7,
+  SymmetricSecondRankTensor: 8,
+  DiffusionTensor3D: 9,
+  Complex: 10,
+  FixedArray: 11,
+  Array: 12,
+  Matrix: 13,
+  VariableLengthVector: 14,
+  VariableSizeMatrix: 15
+}
+
+function setPipelineModuleInputImageDescriptor (emscriptenModule: PipelineEmscriptenModule, image: Image, dataPtr: number, directionPtr: number, metadataPtr: number, metadataSize: number, inputIndex: number): void {
+  const descriptor = new DataView(new ArrayBuffer(imageDescriptorSize))
+  descriptor.setUint32(0, descriptorMagic, true)
+  descriptor.setUint16(4, descriptorVersion, true)
+  descriptor.setUint16(6, imageDescriptorKind, true)
+  descriptor.setUint32(8, imageDescriptorSize, true)
+  descriptor.setUint32(16, image.imageType.dimension, true)
+  descriptor.setUint32(20, descriptorComponentTypes[image.imageType.componentType], true)
+  descriptor.setUint32(24, descriptorPixelTypes[image.imageType.pixelType], true)
+  descriptor.setUint32(28, image.imageType.components, true)
+  for (let ii = 0; ii < image.imageType.dimension && ii < descriptorMaximumDimension; ii++) {
+    descriptor.setFloat64(32 + ii * 8, image.origin[ii], true)
+    descriptor.setFloat64(80 + ii * 8, image.spacing[ii], true)
+    descriptor.setBigUint64(128 + ii * 8, BigInt(image.size[ii]), true)
+  }
+  descriptor.setBigUint64(176, BigInt(directionPtr), true)
+  descriptor.setBigUint64(184, BigInt(dataPtr), true)
+  descriptor.setBigUint64(192, BigInt(metadataPtr), true)
+  descriptor.setBigUint64(200, BigInt(metadataSize), true)
+
+  const descriptorPtr = (emscriptenModule._itk_wasm_input_descriptor_alloc as (memoryIndex: number, index: number, size: number) => number)(0, inputIndex, imageDescriptorSize)
+  emscriptenModule.HEAPU8.set(new Uint8Array(descriptor.buffer), descriptorPtr)
+}
+
 function getPipelineModuleOutputArray (emscriptenModule: PipelineEmscriptenModule, outputIndex: number, subIndex: number, componentType: typeof IntTypes[keyof typeof IntTypes] | typeof FloatTypes[keyof typeof FloatTypes]): TypedArray | Float32Array | Uint32Array | null {
   const dataPtr = emscriptenModule.ccall('itk_wasm_output_array_address', 'number', ['number', 'number', 'number'], [0, outputIndex, subIndex])
   const dataSize = emscriptenModule.ccall('itk_wasm_output_array_size', 'number', ['number', 'number', 'number'], [0, outputIndex, subIndex])
@@ -125,6 +188,12 @@ function runPipelineEmscripten (pipelineModule: PipelineEmscriptenModule, args:
           const dataPtr = setPipelineModuleInputArray(pipelineModule, image.data, index, 0)
           const directionPtr = setPipelineModuleInputArray(pipelineModule, image.direction, index, 1)
           const metadata = typeof image.metadata?.entries !== 'undefined' ? JSON.stringify(Array.from(image.metadata.entries())) : '[]'
+          if (typeof pipelineModule._itk_wasm_input_descriptor_alloc === 'function') {
+            const metadataArray = encoder.encode(metadata)
+            const metadataPtr = setPipelineModuleInputArray(pipelineModule, metadataArray, index, 2)
+            setPipelineModuleInputImageDescriptor(pipelineModule, image, dataPtr, directionPtr, metadataPtr, metadataArray.byteLength, index)
+            break
+          }
           const imageJSON = {
             imageType: image.imageType,
             name: image.name,
@@ -18,6 +18,9 @@ interface PipelineEmscriptenModule extends EmscriptenModule {
   stackSave: () => number
   stackRestore: (ptr: number) => void
 
+  // Only exported by modules built with the binary descriptors
+  _itk_wasm_input_descriptor_alloc?: (memoryIndex: number, index: number, size: number) => number
+
   resetModuleStdout: () => void
   resetModuleStderr: () => void
   getModuleStdout: () => string
@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmImageIO.h"
+#include "itkWasmLz4ImageIO.h"
+#include "itkWasmZstdImageIO.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Encode and decode throughput of the LZ4 and zstd codecs for .iwi.cbor.
+// Decode times are the best of several full reads, which is what
+// interactive viewers pay when loading an image.
+//
+// Usage: wasm-codec-image-io-benchmark <output-directory> <input.iwi.cbor>...
+//
+// Results are printed as tab-separated values.
+namespace
+{
+
+struct Codec
+{
+  const char * name;
+  const char * extension;
+  int          compressionLevel;
+};
+
+itk::WasmImageIO::Pointer
+createImageIO(const Codec & codec)
+{
+  if (std::string(codec.name) == "lz4")
+  {
+    return itk::WasmLz4ImageIO::New().GetPointer();
+  }
+  auto imageIO = itk::WasmZstdImageIO::New();
+  // A single frame, as the LZ4 codec writes
+  imageIO->SetSeekable(false);
+  return imageIO.GetPointer();
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> <input.iwi.cbor>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  const std::vector<Codec> codecs{ { "lz4", ".iwi.cbor.lz4", 1 },
+                                   { "lz4", ".iwi.cbor.lz4", 9 },
+                                   { "zstd", ".iwi.cbor.zst", 1 },
+                                   { "zstd", ".iwi.cbor.zst", 3 } };
+  constexpr unsigned int decodeRepetitions = 5;
+
+  std::cout << "image\tcodec\tlevel\tratio\tencode_seconds\tencode_MB_per_second\tdecode_seconds\tdecode_MB_per_second"
+            << std::endl;
+  try
+  {
+    for (int ii = 2; ii < argc; ++ii)
+    {
+      const std::string inputFile = argv[ii];
+      auto inputIO = itk::WasmImageIO::New();
+      inputIO->SetFileName(inputFile);
+      inputIO->ReadImageInformation();
+      const unsigned int dimension = inputIO->GetNumberOfDimensions();
+      itk::ImageIORegion ioRegion(dimension);
+      for (unsigned int dim = 0; dim < dimension; ++dim)
+      {
+        ioRegion.SetSize(dim, inputIO->GetDimensions(dim));
+      }
+      inputIO->SetIORegion(ioRegion);
+      const itk::SizeValueType imageSizeInBytes = inputIO->GetImageSizeInBytes();
+      std::vector<char> pixels(imageSizeInBytes);
+      inputIO->Read(pixels.data());
+
+      for (const Codec & codec : codecs)
+      {
+        const std::string outputFile = outputDirectory + "/" +
+          itksys::SystemTools::GetFilenameWithoutExtension(inputFile) + "-benchmark" + codec.extension;
+
+        itk::WasmImageIO::Pointer outputIO = createImageIO(codec);
+        outputIO->SetFileName(outputFile);
+        outputIO->SetNumberOfDimensions(dimension);
+        outputIO->SetComponentType(inputIO->GetComponentType());
+        outputIO->SetPixelType(inputIO->GetPixelType());
+        outputIO->SetNumberOfComponents(inputIO->GetNumberOfComponents());
+        for (unsigned int dim = 0; dim < dimension; ++dim)
+        {
+          outputIO->SetDimensions(dim, inputIO->GetDimensions(dim));
+          outputIO->SetSpacing(dim, inputIO->GetSpacing(dim));
+          outputIO->SetOrigin(dim, inputIO->GetOrigin(dim));
+          outputIO->SetDirection(dim, inputIO->GetDirection(dim));
+        }
+        outputIO->SetIORegion(ioRegion);
+        outputIO->SetCompressionLevel(codec.compressionLevel);
+
+        const auto encodeStart = std::chrono::steady_clock::now();
+        outputIO->Write(pixels.data());
+        const std::chrono::duration<double> encodeElapsed = std::chrono::steady_clock::now() - encodeStart;
+        const double compressedSize = static_cast<double>(itksys::SystemTools::FileLength(outputFile));
+
+        double decodeSeconds = 0.0;
+        for (unsigned int repetition = 0; repetition < decodeRepetitions; ++repetition)
+        {
+          itk::WasmImageIO::Pointer readIO = createImageIO(codec);
+          readIO->SetFileName(outputFile);
+          const auto decodeStart = std::chrono::steady_clock::now();
+          readIO->ReadImageInformation();
+          readIO->SetIORegion(ioRegion);
+          readIO->Read(pixels.data());
+          const std::chrono::duration<double> decodeElapsed = std::chrono::steady_clock::now() - decodeStart;
+          decodeSeconds = repetition == 0 ? decodeElapsed.count() : std::min(decodeSeconds, decodeElapsed.count());
+        }
+
+        std::cout << itksys::SystemTools::GetFilenameName(inputFile) << '\t' << codec.name << '\t'
+                  << codec.compressionLevel << '\t' << imageSizeInBytes / compressedSize << '\t'
+                  << encodeElapsed.count() << '\t' << imageSizeInBytes / encodeElapsed.count() / 1.0e6 << '\t'
+                  << decodeSeconds << '\t' << imageSizeInBytes / decodeSeconds / 1.0e6 << std::endl;
+        itksys::SystemTools::RemoveFile(outputFile);
+      }
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
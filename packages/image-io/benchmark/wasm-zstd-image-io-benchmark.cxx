@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmImageIO.h"
+#include "itkWasmZstdImageIO.h"
+#include "itksys/SystemTools.hxx"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Compression throughput and ratio of .iwi.cbor.zst across compression
+// levels, worker thread counts and payload filters. Run on int16 and
+// float32 inputs to compare the byte shuffle and delta filters.
+//
+// Usage: wasm-zstd-image-io-benchmark <output-directory> <input.iwi.cbor>...
+//
+// Results are printed as tab-separated values.
+int
+main(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> <input.iwi.cbor>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  const std::vector<int> compressionLevels{ 1, 3, 9, 19 };
+  std::vector<unsigned int> workerCounts{ 0, 2, 4 };
+  const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+  if (hardwareThreads > 4)
+  {
+    workerCounts.push_back(hardwareThreads);
+  }
+
+  const std::vector<itk::WasmPayloadFilterEnum> payloadFilters{ itk::WasmPayloadFilterEnum::None,
+                                                                  itk::WasmPayloadFilterEnum::Shuffle,
+                                                                  itk::WasmPayloadFilterEnum::Delta,
+                                                                  itk::WasmPayloadFilterEnum::DeltaShuffle };
+
+  std::cout << "image\tfilter\tlevel\tworkers\tlong_distance_matching\tseconds\tMB_per_second\tratio\tread_seconds\tread_MB_per_second" << std::endl;
+  try
+  {
+    for (int ii = 2; ii < argc; ++ii)
+    {
+      const std::string inputFile = argv[ii];
+      auto inputIO = itk::WasmImageIO::New();
+      inputIO->SetFileName(inputFile);
+      inputIO->ReadImageInformation();
+      const unsigned int dimension = inputIO->GetNumberOfDimensions();
+      itk::ImageIORegion ioRegion(dimension);
+      for (unsigned int dim = 0; dim < dimension; ++dim)
+      {
+        ioRegion.SetSize(dim, inputIO->GetDimensions(dim));
+      }
+      inputIO->SetIORegion(ioRegion);
+      const itk::SizeValueType imageSizeInBytes = inputIO->GetImageSizeInBytes();
+      std::vector<char> pixels(imageSizeInBytes);
+      inputIO->Read(pixels.data());
+
+      const std::string outputFile = outputDirectory + "/" +
+        itksys::SystemTools::GetFilenameWithoutExtension(inputFile) + "-benchmark.iwi.cbor.zst";
+      for (const auto payloadFilter : payloadFilters)
+      {
+        for (const bool longDistanceMatching : { false, true })
+        {
+          for (const int level : compressionLevels)
+          {
+            for (const unsigned int workers : workerCounts)
+            {
+              auto outputIO = itk::WasmZstdImageIO::New();
+              outputIO->SetFileName(outputFile);
+              outputIO->SetNumberOfDimensions(dimension);
+              outputIO->SetComponentType(inputIO->GetComponentType());
+              outputIO->SetPixelType(inputIO->GetPixelType());
+              outputIO->SetNumberOfComponents(inputIO->GetNumberOfComponents());
+              for (unsigned int dim = 0; dim < dimension; ++dim)
+              {
+                outputIO->SetDimensions(dim, inputIO->GetDimensions(dim));
+                outputIO->SetSpacing(dim, inputIO->GetSpacing(dim));
+                outputIO->SetOrigin(dim, inputIO->GetOrigin(dim));
+                outputIO->SetDirection(dim, inputIO->GetDirection(dim));
+              }
+              outputIO->SetIORegion(ioRegion);
+              outputIO->SetCompressionLevel(level);
+              outputIO->SetNumberOfWorkers(workers);
+              outputIO->SetLongDistanceMatching(longDistanceMatching);
+              outputIO->SetPayloadFilter(payloadFilter);
+
+              const auto start = std::chrono::steady_clock::now();
+              outputIO->Write(pixels.data());
+              const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+              const double compressedSize = static_cast<double>(itksys::SystemTools::FileLength(outputFile));
+
+              // Decode time includes reversing the payload filter
+              auto readIO = itk::WasmZstdImageIO::New();
+              readIO->SetFileName(outputFile);
+              const auto readStart = std::chrono::steady_clock::now();
+              readIO->ReadImageInformation();
+              readIO->SetIORegion(ioRegion);
+              readIO->Read(pixels.data());
+              const std::chrono::duration<double> readElapsed = std::chrono::steady_clock::now() - readStart;
+
+              std::cout << itksys::SystemTools::GetFilenameName(inputFile) << '\t' << payloadFilter << '\t' << level << '\t'
+                        << workers << '\t' << longDistanceMatching << '\t' << elapsed.count() << '\t'
+                        << imageSizeInBytes / elapsed.count() / 1.0e6 << '\t' << imageSizeInBytes / compressedSize << '\t'
+                        << readElapsed.count() << '\t' << imageSizeInBytes / readElapsed.count() / 1.0e6 << std::endl;
+            }
+          }
+        }
+      }
+      itksys::SystemTools::RemoveFile(outputFile);
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmCompressedImageIO.h"
+
+#include <fstream>
+#include <vector>
+
+namespace itk
+{
+
+struct WasmCompressedImageIO::DecompressionState
+{
+  std::string fileName;
+  std::ifstream compressedStream;
+  std::unique_ptr< std::streambuf > decompressStreamBuffer;
+  std::istream decompressStream{ nullptr };
+  SizeValueType dataLength{ 0 };
+};
+
+
+WasmCompressedImageIO
+::WasmCompressedImageIO()
+{
+}
+
+
+WasmCompressedImageIO
+::~WasmCompressedImageIO()
+{
+}
+
+
+void
+WasmCompressedImageIO
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfDecompressions: " << m_NumberOfDecompressions << std::endl;
+}
+
+
+bool
+WasmCompressedImageIO
+::IsSupportedFileName(const std::string & fileName) const
+{
+  if ( fileName.rfind(".iwi") == std::string::npos )
+    {
+    itkDebugMacro(<< "The filename extension is not recognized");
+    return false;
+    }
+
+  // Files compressed with another codec require its ImageIO
+  if ( fileName.rfind(".zst") != std::string::npos || fileName.rfind(".lz4") != std::string::npos )
+    {
+    return this->IsCompressedFileName(fileName);
+    }
+
+  return true;
+}
+
+
+bool
+WasmCompressedImageIO
+::CanReadFile(const char *filename)
+{
+  return this->IsSupportedFileName(filename);
+}
+
+
+void
+WasmCompressedImageIO
+::StartDecompression()
+{
+  m_Decompression = std::make_unique< DecompressionState >();
+  m_Decompression->fileName = this->GetFileName();
+  try
+  {
+    this->OpenFileForReading( m_Decompression->compressedStream, m_Decompression->fileName );
+    m_Decompression->decompressStreamBuffer = this->CreateDecompressStreamBuffer( m_Decompression->compressedStream );
+  }
+  catch (const std::runtime_error & error)
+  {
+    m_Decompression.reset();
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+  m_Decompression->decompressStream.rdbuf( m_Decompression->decompressStreamBuffer.get() );
+  ++m_NumberOfDecompressions;
+}
+
+
+void
+WasmCompressedImageIO
+::ResetDecompression()
+{
+  m_Decompression.reset();
+}
+
+
+void
+WasmCompressedImageIO
+::ReadImageInformation()
+{
+  this->SetByteOrderToLittleEndian();
+
+  if ( this->IsCompressedFileName(this->GetFileName()) )
+  {
+    // Only the header is decompressed: the CBOR decoder stops before the
+    // pixel data, which is the last entry. The pass is kept open so that
+    // Read() continues from there.
+    this->StartDecompression();
+    m_Decompression->dataLength = this->ReadCBOR(nullptr, m_Decompression->decompressStream);
+    this->ReadCompressedInformation();
+    return;
+  }
+
+  Superclass::ReadImageInformation();
+}
+
+
+void
+WasmCompressedImageIO
+::Read( void *buffer )
+{
+  if ( !this->IsCompressedFileName(this->GetFileName()) )
+  {
+    Superclass::Read(buffer);
+    return;
+  }
+
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  if ( ioRegion.GetNumberOfPixels() == this->GetImageSizeInPixels() )
+  {
+    this->ReadDecompressed(buffer);
+    return;
+  }
+
+  this->ReadCompressedRegion(buffer);
+}
+
+
+void
+WasmCompressedImageIO
+::ReadCompressedRegion( void *buffer )
+{
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  ImageIORegion largestRegion( dimension );
+  for ( unsigned int dim = 0; dim < dimension; ++dim )
+  {
+    largestRegion.SetSize( dim, this->GetDimensions( dim ) );
+  }
+  std::vector< char > image( this->GetImageSizeInBytes() );
+  this->ReadDecompressed( image.data() );
+  this->CopyRegion( image.data(), largestRegion, buffer, this->GetIORegion() );
+}
+
+
+bool
+WasmCompressedImageIO
+::CanStreamRead()
+{
+  if ( this->IsCompressedFileName(this->GetFileName()) )
+  {
+    return false;
+  }
+  return Superclass::CanStreamRead();
+}
+
+
+ImageIORegion
+WasmCompressedImageIO
+::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if ( this->IsCompressedFileName(this->GetFileName()) )
+  {
+    return ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+}
+
+
+void
+WasmCompressedImageIO
+::ReadDecompressed( void *buffer )
+{
+  std::unique_ptr< DecompressionState > decompression = std::move( m_Decompression );
+  if ( decompression && decompression->fileName == this->GetFileName() && decompression->dataLength > 0 )
+  {
+    this->ReadCBORData(buffer, decompression->decompressStream, decompression->dataLength);
+    return;
+  }
+
+  this->StartDecompression();
+  decompression = std::move( m_Decompression );
+  this->ReadCBOR(buffer, decompression->decompressStream);
+}
+
+
+bool
+WasmCompressedImageIO
+::CanWriteFile(const char *name)
+{
+  const std::string filename = name;
+
+  if( filename == "" )
+    {
+    return false;
+    }
+
+  return this->IsSupportedFileName(filename);
+}
+
+} // end namespace itk
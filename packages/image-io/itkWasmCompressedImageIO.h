@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmCompressedImageIO_h
+#define itkWasmCompressedImageIO_h
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmImageIO.h"
+
+#include <memory>
+#include <streambuf>
+
+namespace itk
+{
+/** \class WasmCompressedImageIO
+ *
+ * \brief Base class of the compressed itk-wasm image formats.
+ *
+ * Implements reading of a CBOR file compressed as a whole, e.g.
+ * .iwi.cbor.zst or .iwi.cbor.lz4. ReadImageInformation() only decompresses
+ * the header and keeps the decompression pass open, so that Read()
+ * continues from the start of the pixel data. Uncompressed files are
+ * handled by WasmImageIO.
+ *
+ * Subclasses provide the file name suffix and the decompressing stream
+ * buffer of their codec, and write the compressed file.
+ *
+ * \ingroup IOFilters
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmCompressedImageIO: public WasmImageIO
+{
+public:
+  /** Standard class typedefs. */
+  typedef WasmCompressedImageIO Self;
+  typedef WasmImageIO           Superclass;
+  typedef SmartPointer< Self >  Pointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmCompressedImageIO, WasmImageIO);
+
+  /** Determine the file type. Returns true for uncompressed itk-wasm image
+   * files and files compressed with the codec of this ImageIO. */
+  bool CanReadFile(const char *) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void ReadImageInformation() override;
+
+  /** Reads the data from disk into the memory buffer provided. */
+  void Read(void *buffer) override;
+
+  bool CanStreamRead() override;
+
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
+
+  /** Determine the file type. Returns true for uncompressed itk-wasm image
+   * files and files compressed with the codec of this ImageIO. */
+  bool CanWriteFile(const char *) override;
+
+  /** Number of decompression passes started by this object. A
+   * ReadImageInformation() followed by Read() costs one pass. */
+  itkGetConstMacro(NumberOfDecompressions, SizeValueType);
+
+protected:
+  WasmCompressedImageIO();
+  ~WasmCompressedImageIO() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Whether path ends with the file name suffix of the codec. */
+  virtual bool IsCompressedFileName(const std::string & path) const = 0;
+
+  /** Create a stream buffer that decompresses compressedStream. */
+  virtual std::unique_ptr< std::streambuf > CreateDecompressStreamBuffer(std::istream & compressedStream) const = 0;
+
+  /** Called by ReadImageInformation() after the header of a compressed file
+   * has been read, e.g. to load an index of the compressed file. */
+  virtual void ReadCompressedInformation() {}
+
+  /** Read an IORegion smaller than the image from a compressed file. The
+   * whole image is decompressed and the region copied out. */
+  virtual void ReadCompressedRegion(void * buffer);
+
+  /** Close the pass left open by ReadImageInformation(). */
+  void ResetDecompression();
+
+  SizeValueType m_NumberOfDecompressions{ 0 };
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WasmCompressedImageIO);
+
+  /** Whether fileName is an itk-wasm image file, uncompressed or compressed
+   * with the codec of this ImageIO. */
+  bool IsSupportedFileName(const std::string & fileName) const;
+
+  /** Start a new decompression pass over the current file. */
+  void StartDecompression();
+
+  /** Read the whole image, continuing the pass of ReadImageInformation()
+   * when possible. */
+  void ReadDecompressed(void * buffer);
+
+  /** Decompression pass left open by ReadImageInformation(), positioned at
+   * the start of the pixel data, for Read() to continue. */
+  struct DecompressionState;
+  std::unique_ptr< DecompressionState > m_Decompression;
+};
+} // end namespace itk
+
+#endif // itkWasmCompressedImageIO_h
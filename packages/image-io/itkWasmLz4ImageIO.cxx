@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmLz4ImageIO.h"
+#include "itkWasmLz4StreamBuffer.h"
+#include "lz4frame.h"
+
+namespace itk
+{
+
+namespace
+{
+
+bool
+fileNameIsLz4(const std::string & path)
+{
+  const std::string::size_type lz4Pos = path.rfind(".lz4");
+  return lz4Pos != std::string::npos && lz4Pos == path.length() - 4;
+}
+
+} // end anonymous namespace
+
+
+WasmLz4ImageIO
+::WasmLz4ImageIO()
+{
+  this->AddSupportedWriteExtension(".iwi.cbor.lz4");
+  this->AddSupportedReadExtension(".iwi.cbor.lz4");
+
+  this->Self::SetMaximumCompressionLevel(LZ4F_compressionLevel_max());
+  this->Self::SetCompressionLevel(1);
+}
+
+
+WasmLz4ImageIO
+::~WasmLz4ImageIO()
+{
+}
+
+
+void
+WasmLz4ImageIO
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+
+bool
+WasmLz4ImageIO
+::IsCompressedFileName(const std::string & path) const
+{
+  return fileNameIsLz4(path);
+}
+
+
+std::unique_ptr< std::streambuf >
+WasmLz4ImageIO
+::CreateDecompressStreamBuffer(std::istream & compressedStream) const
+{
+  return std::make_unique< WasmLz4DecompressStreamBuffer >( compressedStream );
+}
+
+
+void
+WasmLz4ImageIO
+::WriteImageInformation()
+{
+  Superclass::WriteImageInformation();
+}
+
+
+void
+WasmLz4ImageIO
+::Write( const void *buffer )
+{
+  const std::string path(this->GetFileName());
+
+  if ( fileNameIsLz4(path) )
+  {
+    std::ofstream outputStream;
+    this->OpenFileForWriting( outputStream, path.c_str(), true, false );
+    try
+    {
+      // The CBOR encoding is compressed as it is produced
+      WasmLz4CompressStreamBuffer compressBuffer(outputStream, this->GetCompressionLevel());
+      std::ostream compressStream(&compressBuffer);
+      this->WriteCBOR(buffer, compressStream);
+      compressBuffer.Finish();
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro("Could not write " << path << ": " << error.what());
+    }
+    return;
+  }
+
+  Superclass::Write( buffer );
+}
+
+} // end namespace itk
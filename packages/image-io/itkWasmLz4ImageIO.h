@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmLz4ImageIO_h
+#define itkWasmLz4ImageIO_h
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmCompressedImageIO.h"
+
+namespace itk
+{
+/** \class WasmLz4ImageIO
+ *
+ * \brief Read and write an itk::Image in a web-friendly format.
+ *
+ * This format is intended to facilitate data exchange in itk-wasm.
+ * It reads and writes an itk-wasm Image object in a CBOR file on the
+ * filesystem with JSON files and binary files for TypedArrays.
+ *
+ * This class extends WasmCompressedImageIO by adding support for LZ4 frame
+ * compression. LZ4 trades compression ratio for decompression speed; use
+ * WasmZstdImageIO when the ratio matters more than decode latency.
+ *
+ * The file extensions used are .iwi, .iwi.cbor, and .iwi.cbor.lz4.
+ *
+ * The compression level is set with SetCompressionLevel(). Levels below 3
+ * use the fast LZ4 compressor and higher levels LZ4HC, which compresses
+ * slower but decompresses just as fast.
+ *
+ * \ingroup IOFilters
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmLz4ImageIO: public WasmCompressedImageIO
+{
+public:
+  /** Standard class typedefs. */
+  typedef WasmLz4ImageIO        Self;
+  typedef WasmCompressedImageIO Superclass;
+  typedef SmartPointer< Self >  Pointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmLz4ImageIO, WasmCompressedImageIO);
+
+  /** Set the spacing and dimension information for the set filename. */
+  void WriteImageInformation() override;
+
+  /** Writes the data to disk from the memory buffer provided. Make sure
+   * that the IORegions has been set properly. */
+  void Write(const void *buffer) override;
+
+protected:
+  WasmLz4ImageIO();
+  ~WasmLz4ImageIO() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool IsCompressedFileName(const std::string & path) const override;
+
+  std::unique_ptr< std::streambuf > CreateDecompressStreamBuffer(std::istream & compressedStream) const override;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WasmLz4ImageIO);
+};
+} // end namespace itk
+
+#endif // itkWasmLz4ImageIO_h
@@ -0,0 +1,297 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmLz4StreamBuffer_h
+#define itkWasmLz4StreamBuffer_h
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+#include "lz4frame.h"
+
+namespace itk
+{
+/**
+ *\class WasmLz4DecompressStreamBuffer
+ * \brief Read-only std::streambuf that incrementally decompresses LZ4 frames.
+ *
+ * Compressed input is pulled from the source stream in fixed size blocks
+ * and only decompressed as far as the consumer reads. Large reads are
+ * decompressed directly into the destination buffer.
+ *
+ * Corrupt or truncated input results in a std::runtime_error.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmLz4DecompressStreamBuffer : public std::streambuf
+{
+public:
+  explicit WasmLz4DecompressStreamBuffer(std::istream & source)
+    : m_Source(source)
+    , m_InputBuffer(64 * 1024)
+    , m_OutputBuffer(256 * 1024)
+  {
+    const LZ4F_errorCode_t result = LZ4F_createDecompressionContext(&m_Context, LZ4F_VERSION);
+    if (LZ4F_isError(result))
+    {
+      throw std::runtime_error(std::string("lz4 decompression failed: ") + LZ4F_getErrorName(result));
+    }
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data());
+  }
+
+  ~WasmLz4DecompressStreamBuffer() override
+  {
+    LZ4F_freeDecompressionContext(m_Context);
+  }
+
+  WasmLz4DecompressStreamBuffer(const WasmLz4DecompressStreamBuffer &) = delete;
+  WasmLz4DecompressStreamBuffer & operator=(const WasmLz4DecompressStreamBuffer &) = delete;
+
+protected:
+  int_type
+  underflow() override
+  {
+    if (this->gptr() < this->egptr())
+    {
+      return traits_type::to_int_type(*this->gptr());
+    }
+    const size_t produced = this->Decompress(m_OutputBuffer.data(), m_OutputBuffer.size());
+    if (produced == 0)
+    {
+      return traits_type::eof();
+    }
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data() + produced);
+    return traits_type::to_int_type(*this->gptr());
+  }
+
+  std::streamsize
+  xsgetn(char * destination, std::streamsize count) override
+  {
+    const std::streamsize buffered = std::min< std::streamsize >(count, this->egptr() - this->gptr());
+    std::memcpy(destination, this->gptr(), buffered);
+    this->gbump(static_cast< int >(buffered));
+    if (buffered == count)
+    {
+      return count;
+    }
+    const size_t produced = this->Decompress(destination + buffered, static_cast< size_t >(count - buffered));
+    return buffered + static_cast< std::streamsize >(produced);
+  }
+
+private:
+  /** Decompress until the output is full or the compressed input ends.
+   * Returns the number of bytes produced. */
+  size_t
+  Decompress(char * output, size_t outputSize)
+  {
+    size_t produced = 0;
+    while (produced < outputSize)
+    {
+      if (m_InputPosition == m_InputSize && !m_SourceExhausted)
+      {
+        m_Source.read(m_InputBuffer.data(), static_cast< std::streamsize >(m_InputBuffer.size()));
+        m_InputSize = static_cast< size_t >(m_Source.gcount());
+        m_InputPosition = 0;
+        m_SourceExhausted = m_InputSize == 0;
+      }
+      size_t inputSize = m_InputSize - m_InputPosition;
+      size_t outputCapacity = outputSize - produced;
+      const size_t hint = LZ4F_decompress(m_Context, output + produced, &outputCapacity,
+                                          m_InputBuffer.data() + m_InputPosition, &inputSize, nullptr);
+      if (LZ4F_isError(hint))
+      {
+        throw std::runtime_error(std::string("lz4 decompression failed: ") + LZ4F_getErrorName(hint));
+      }
+      m_InputPosition += inputSize;
+      produced += outputCapacity;
+      // Without more input, a call after the end of the last frame expects
+      // the header of another one
+      if (m_SourceExhausted && m_InputPosition == m_InputSize && outputCapacity == 0)
+      {
+        if (!m_FrameComplete)
+        {
+          throw std::runtime_error("lz4 decompression failed: truncated input");
+        }
+        break;
+      }
+      m_FrameComplete = hint == 0;
+    }
+    return produced;
+  }
+
+  std::istream &            m_Source;
+  LZ4F_dctx *               m_Context{ nullptr };
+  std::vector< char >       m_InputBuffer;
+  std::vector< char >       m_OutputBuffer;
+  size_t                    m_InputPosition{ 0 };
+  size_t                    m_InputSize{ 0 };
+  bool                      m_SourceExhausted{ false };
+  bool                      m_FrameComplete{ false };
+};
+
+/**
+ *\class WasmLz4CompressStreamBuffer
+ * \brief Write-only std::streambuf that incrementally compresses into an LZ4 frame.
+ *
+ * Writes are gathered into a staging buffer of one LZ4 block and
+ * compressed a block at a time. Call Finish() to end the frame after the
+ * last write.
+ *
+ * Compression levels below 3 use the fast LZ4 compressor, higher levels
+ * LZ4HC. Decompression speed is the same for all levels.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmLz4CompressStreamBuffer : public std::streambuf
+{
+public:
+  WasmLz4CompressStreamBuffer(std::ostream & sink, int compressionLevel)
+    : m_Sink(sink)
+    , m_InputBuffer(blockSize)
+  {
+    std::memset(&m_Preferences, 0, sizeof(m_Preferences));
+    m_Preferences.frameInfo.blockSizeID = LZ4F_max1MB;
+    m_Preferences.compressionLevel = compressionLevel;
+    const LZ4F_errorCode_t result = LZ4F_createCompressionContext(&m_Context, LZ4F_VERSION);
+    if (LZ4F_isError(result))
+    {
+      throw std::runtime_error(std::string("lz4 compression failed: ") + LZ4F_getErrorName(result));
+    }
+    m_OutputBuffer.resize(std::max(LZ4F_compressBound(blockSize, &m_Preferences), static_cast< size_t >(LZ4F_HEADER_SIZE_MAX)));
+    this->setp(m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size());
+  }
+
+  ~WasmLz4CompressStreamBuffer() override
+  {
+    LZ4F_freeCompressionContext(m_Context);
+  }
+
+  WasmLz4CompressStreamBuffer(const WasmLz4CompressStreamBuffer &) = delete;
+  WasmLz4CompressStreamBuffer & operator=(const WasmLz4CompressStreamBuffer &) = delete;
+
+  /** Compress any staged input and write the end of the frame. */
+  void
+  Finish()
+  {
+    this->CompressStaged();
+    this->Begin();
+    const size_t written = LZ4F_compressEnd(m_Context, m_OutputBuffer.data(), m_OutputBuffer.size(), nullptr);
+    this->WriteOutput(written);
+  }
+
+protected:
+  int_type
+  overflow(int_type character) override
+  {
+    this->CompressStaged();
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      *this->pptr() = traits_type::to_char_type(character);
+      this->pbump(1);
+    }
+    return traits_type::not_eof(character);
+  }
+
+  std::streamsize
+  xsputn(const char * source, std::streamsize count) override
+  {
+    if (count <= this->epptr() - this->pptr())
+    {
+      std::memcpy(this->pptr(), source, static_cast< size_t >(count));
+      this->pbump(static_cast< int >(count));
+      return count;
+    }
+    this->CompressStaged();
+    // Whole blocks are compressed directly from the caller's memory
+    std::streamsize remaining = count;
+    while (remaining >= static_cast< std::streamsize >(blockSize))
+    {
+      this->Compress(source, blockSize);
+      source += blockSize;
+      remaining -= static_cast< std::streamsize >(blockSize);
+    }
+    std::memcpy(this->pptr(), source, static_cast< size_t >(remaining));
+    this->pbump(static_cast< int >(remaining));
+    return count;
+  }
+
+private:
+  static constexpr size_t blockSize = 1024 * 1024;
+
+  void
+  Begin()
+  {
+    if (m_Started)
+    {
+      return;
+    }
+    const size_t written = LZ4F_compressBegin(m_Context, m_OutputBuffer.data(), m_OutputBuffer.size(), &m_Preferences);
+    this->WriteOutput(written);
+    m_Started = true;
+  }
+
+  void
+  CompressStaged()
+  {
+    const auto staged = static_cast< size_t >(this->pptr() - this->pbase());
+    if (staged > 0)
+    {
+      this->Compress(this->pbase(), staged);
+    }
+    this->setp(m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size());
+  }
+
+  /** Compress at most one block of input. */
+  void
+  Compress(const char * input, size_t inputSize)
+  {
+    this->Begin();
+    const size_t written =
+      LZ4F_compressUpdate(m_Context, m_OutputBuffer.data(), m_OutputBuffer.size(), input, inputSize, nullptr);
+    this->WriteOutput(written);
+  }
+
+  void
+  WriteOutput(size_t result)
+  {
+    if (LZ4F_isError(result))
+    {
+      throw std::runtime_error(std::string("lz4 compression failed: ") + LZ4F_getErrorName(result));
+    }
+    m_Sink.write(m_OutputBuffer.data(), static_cast< std::streamsize >(result));
+    if (!m_Sink)
+    {
+      throw std::runtime_error("lz4 compression failed: could not write output");
+    }
+  }
+
+  std::ostream &        m_Sink;
+  LZ4F_cctx *           m_Context{ nullptr };
+  LZ4F_preferences_t    m_Preferences;
+  std::vector< char >   m_InputBuffer;
+  std::vector< char >   m_OutputBuffer;
+  bool                  m_Started{ false };
+};
+
+} // namespace itk
+
+#endif
@@ -17,16 +17,77 @@
  *=========================================================================*/
 
 #include "itkWasmZstdImageIO.h"
+#include "itkWasmZstdStreamBuffer.h"
+#include "itkWasmMemoryStreamBuffer.h"
 #include "zstd.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
+namespace
+{
+
+// zstd seekable format, see contrib/seekable_format in the zstd sources
+constexpr uint32_t zstdSkippableMagicNumber = 0x184D2A5E;
+constexpr uint32_t zstdSeekableMagicNumber = 0x8F92EAB1;
+constexpr size_t   zstdSeekTableFooterSize = 9;
+constexpr uint8_t  zstdSeekTableChecksumFlag = 0x80;
+// Frame sizes are stored as 32 bit values
+constexpr SizeValueType maximumSeekableFrameSize = 0x7FFFFFFF;
+
+bool
+fileNameIsZstd(const std::string & path)
+{
+  const std::string::size_type zstdPos = path.rfind(".zst");
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
+void
+writeLittleEndian32(std::ostream & stream, uint32_t value)
+{
+  const char bytes[4] = { static_cast< char >(value & 0xFF), static_cast< char >((value >> 8) & 0xFF),
+                          static_cast< char >((value >> 16) & 0xFF), static_cast< char >((value >> 24) & 0xFF) };
+  stream.write(bytes, 4);
+}
+
+uint32_t
+readLittleEndian32(const char * bytes)
+{
+  const auto * data = reinterpret_cast< const unsigned char * >(bytes);
+  return static_cast< uint32_t >(data[0]) | (static_cast< uint32_t >(data[1]) << 8) |
+         (static_cast< uint32_t >(data[2]) << 16) | (static_cast< uint32_t >(data[3]) << 24);
+}
+
+void
+writeSeekTable(std::ostream & stream, const std::vector< WasmZstdCompressStreamBuffer::Frame > & frames)
+{
+  constexpr uint32_t entrySize = 8;
+  writeLittleEndian32(stream, zstdSkippableMagicNumber);
+  writeLittleEndian32(stream, static_cast< uint32_t >(frames.size() * entrySize + zstdSeekTableFooterSize));
+  for (const auto & frame : frames)
+  {
+    writeLittleEndian32(stream, static_cast< uint32_t >(frame.compressedSize));
+    writeLittleEndian32(stream, static_cast< uint32_t >(frame.decompressedSize));
+  }
+  writeLittleEndian32(stream, static_cast< uint32_t >(frames.size()));
+  const char descriptor = 0;
+  stream.write(&descriptor, 1);
+  writeLittleEndian32(stream, zstdSeekableMagicNumber);
+}
+
+} // end anonymous namespace
+
+
 WasmZstdImageIO
 ::WasmZstdImageIO()
 {
   this->AddSupportedWriteExtension(".iwi.cbor.zst");
   this->AddSupportedReadExtension(".iwi.cbor.zst");
+
+  this->Self::SetMaximumCompressionLevel(ZSTD_maxCLevel());
+  this->Self::SetCompressionLevel(3);
 }
 
 
@@ -36,119 +97,226 @@ WasmZstdImageIO
 }
 
 
-bool
+void
 WasmZstdImageIO
-::CanReadFile(const char *filename)
+::PrintSelf(std::ostream & os, Indent indent) const
 {
-  std::string fname = filename;
+  Superclass::PrintSelf(os, indent);
 
-  bool extensionFound = false;
-  std::string::size_type extensionPos = fname.rfind(".iwi");
-  if ( extensionPos != std::string::npos )
-    {
-    extensionFound = true;
-    }
+  os << indent << "NumberOfWorkers: " << m_NumberOfWorkers << std::endl;
+  os << indent << "LongDistanceMatching: " << (m_LongDistanceMatching ? "On" : "Off") << std::endl;
+  os << indent << "Seekable: " << (m_Seekable ? "On" : "Off") << std::endl;
+  os << indent << "SeekableFrameSize: " << m_SeekableFrameSize << std::endl;
+  os << indent << "SeekTable frames: " << m_SeekTable.size() << std::endl;
+}
 
-  if ( !extensionFound )
-    {
-    itkDebugMacro(<< "The filename extension is not recognized");
-    return false;
-    }
 
-  return true;
+bool
+WasmZstdImageIO
+::IsCompressedFileName(const std::string & path) const
+{
+  return fileNameIsZstd(path);
 }
 
 
-
-void
+std::unique_ptr< std::streambuf >
 WasmZstdImageIO
-::ReadImageInformation()
+::CreateDecompressStreamBuffer(std::istream & compressedStream) const
 {
-  this->SetByteOrderToLittleEndian();
+  return std::make_unique< WasmZstdDecompressStreamBuffer >( compressedStream );
+}
 
-  const std::string path = this->GetFileName();
 
-  std::string::size_type zstdPos = path.rfind(".zst");
-  if ( ( zstdPos != std::string::npos )
-       && ( zstdPos == path.length() - 4 ) )
+bool
+WasmZstdImageIO
+::CanStreamRead()
+{
+  if ( fileNameIsZstd(this->GetFileName()) && !m_SeekTable.empty() )
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
-
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
-
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
-
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
-
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
-    return;
+    return true;
   }
-
-  Superclass::ReadImageInformation();
+  return Superclass::CanStreamRead();
 }
 
 
-void
+ImageIORegion
 WasmZstdImageIO
-::Read( void *buffer )
+::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
 {
-  const std::string path = this->GetFileName();
-  std::string::size_type zstdPos = path.rfind(".zst");
-  if ( ( zstdPos != std::string::npos )
-       && ( zstdPos == path.length() - 4 ) )
+  if ( fileNameIsZstd(this->GetFileName()) && !m_SeekTable.empty() )
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
-
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
+    return StreamingImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+}
 
 
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+void
+WasmZstdImageIO
+::ReadCompressedInformation()
+{
+  m_SeekTable.clear();
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
+  std::ifstream inputStream;
+  this->OpenFileForReading( inputStream, this->GetFileName() );
+  inputStream.seekg( 0, std::ios::end );
+  const auto fileSize = static_cast< uint64_t >( inputStream.tellg() );
+  if ( fileSize < zstdSeekTableFooterSize + 8 )
+  {
+    return;
+  }
 
-    this->ReadCBOR(buffer, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+  char footer[zstdSeekTableFooterSize];
+  inputStream.seekg( fileSize - zstdSeekTableFooterSize );
+  inputStream.read( footer, zstdSeekTableFooterSize );
+  if ( !inputStream || readLittleEndian32( footer + 5 ) != zstdSeekableMagicNumber )
+  {
     return;
   }
+  const uint32_t numberOfFrames = readLittleEndian32( footer );
+  const uint64_t entrySize = ( footer[4] & zstdSeekTableChecksumFlag ) ? 12 : 8;
+  const uint64_t tableSize = numberOfFrames * entrySize + zstdSeekTableFooterSize;
+  if ( fileSize < tableSize + 8 )
+  {
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  std::vector< char > table( tableSize + 8 );
+  inputStream.seekg( fileSize - table.size() );
+  inputStream.read( table.data(), table.size() );
+  if ( !inputStream || readLittleEndian32( table.data() ) != zstdSkippableMagicNumber ||
+       readLittleEndian32( table.data() + 4 ) != tableSize )
+  {
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
 
-  Superclass::Read(buffer);
+  m_SeekTable.resize( numberOfFrames );
+  uint64_t compressedOffset = 0;
+  uint64_t decompressedOffset = 0;
+  for ( uint32_t ii = 0; ii < numberOfFrames; ++ii )
+  {
+    const char * entry = table.data() + 8 + ii * entrySize;
+    SeekTableFrame & frame = m_SeekTable[ii];
+    frame.compressedOffset = compressedOffset;
+    frame.compressedSize = readLittleEndian32( entry );
+    frame.decompressedOffset = decompressedOffset;
+    frame.decompressedSize = readLittleEndian32( entry + 4 );
+    compressedOffset += frame.compressedSize;
+    decompressedOffset += frame.decompressedSize;
+  }
+  if ( compressedOffset + table.size() != fileSize )
+  {
+    m_SeekTable.clear();
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
 }
 
 
-bool
+void
 WasmZstdImageIO
-::CanWriteFile(const char *name)
+::ReadCompressedRegion( void *buffer )
 {
-  std::string filename = name;
+  if ( m_SeekTable.empty() )
+  {
+    Superclass::ReadCompressedRegion(buffer);
+    return;
+  }
+  this->ResetDecompression();
+
+  // The pixel data is the last entry, so it ends the decompressed stream.
+  // Frames are decoded in order and their whole slices along the slowest
+  // dimension are copied out as they complete. A filtered payload is
+  // reversed in whole filter blocks: one slice, or the whole image in 1-D
+  // where the block is the single row.
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const unsigned int sliceDimension = dimension - 1;
+  const ImageIORegion & ioRegion = this->GetIORegion();
+  const SizeValueType imageSizeInBytes = this->GetImageSizeInBytes();
+  const SizeValueType sliceBytes = imageSizeInBytes / this->GetDimensions( sliceDimension );
+  const WasmPayloadLayout payloadLayout = this->GetPayloadLayout();
+  const SizeValueType slicesPerBlock =
+    m_PayloadFilter == WasmPayloadFilterEnum::None ? 1 : std::max< SizeValueType >( 1, payloadLayout.blockSize / sliceBytes );
+
+  const SeekTableFrame & lastFrame = m_SeekTable.back();
+  const uint64_t decompressedSize = lastFrame.decompressedOffset + lastFrame.decompressedSize;
+  if ( decompressedSize < imageSizeInBytes )
+  {
+    itkExceptionMacro("The zstd seek table of " << this->GetFileName() << " does not cover the pixel data");
+  }
+  const uint64_t payloadOffset = decompressedSize - imageSizeInBytes;
+  const auto regionBegin = static_cast< SizeValueType >( ioRegion.GetIndex( sliceDimension ) );
+  const SizeValueType regionEnd = regionBegin + ioRegion.GetSize( sliceDimension );
+  const SizeValueType firstSlice = regionBegin / slicesPerBlock * slicesPerBlock;
+  const SizeValueType endSlice = std::min< SizeValueType >(
+    ( regionEnd + slicesPerBlock - 1 ) / slicesPerBlock * slicesPerBlock, this->GetDimensions( sliceDimension ) );
+  const uint64_t rangeBegin = payloadOffset + firstSlice * sliceBytes;
+  const uint64_t rangeEnd = payloadOffset + endSlice * sliceBytes;
+
+  ImageIORegion slabRegion( dimension );
+  for ( unsigned int dim = 0; dim < sliceDimension; ++dim )
+  {
+    slabRegion.SetSize( dim, this->GetDimensions( dim ) );
+  }
 
-  if( filename == "" )
+  std::ifstream compressedStream;
+  this->OpenFileForReading( compressedStream, this->GetFileName() );
+  const auto contextDeleter = [](ZSTD_DCtx * context) { ZSTD_freeDCtx(context); };
+  std::unique_ptr< ZSTD_DCtx, decltype(contextDeleter) > context( ZSTD_createDCtx(), contextDeleter );
+  ++m_NumberOfDecompressions;
+
+  std::vector< char > compressed;
+  std::vector< char > decompressed;
+  std::vector< char > pending;
+  std::vector< char > unfiltered;
+  SizeValueType pendingSlice = firstSlice;
+  for ( const SeekTableFrame & frame : m_SeekTable )
+  {
+    const uint64_t frameEnd = frame.decompressedOffset + frame.decompressedSize;
+    if ( frameEnd <= rangeBegin )
     {
-    return false;
+      continue;
     }
-
-  bool extensionFound = false;
-  std::string::size_type iwiPos = filename.rfind(".iwi");
-  if ( iwiPos != std::string::npos )
+    if ( frame.decompressedOffset >= rangeEnd )
     {
-    extensionFound = true;
+      break;
     }
 
-  if ( !extensionFound )
+    compressed.resize( frame.compressedSize );
+    compressedStream.seekg( frame.compressedOffset );
+    compressedStream.read( compressed.data(), compressed.size() );
+    if ( !compressedStream )
+    {
+      itkExceptionMacro("Could not read a zstd frame from " << this->GetFileName());
+    }
+    decompressed.resize( frame.decompressedSize );
+    const size_t result = ZSTD_decompressDCtx( context.get(), decompressed.data(), decompressed.size(),
+                                               compressed.data(), compressed.size() );
+    if ( ZSTD_isError( result ) || result != frame.decompressedSize )
     {
-    itkDebugMacro(<< "The filename extension is not recognized");
-    return false;
+      itkExceptionMacro("Could not decompress a zstd frame from " << this->GetFileName());
     }
 
-  return true;
+    const uint64_t begin = std::max( frame.decompressedOffset, rangeBegin );
+    const uint64_t end = std::min( frameEnd, rangeEnd );
+    pending.insert( pending.end(), decompressed.begin() + ( begin - frame.decompressedOffset ),
+                    decompressed.begin() + ( end - frame.decompressedOffset ) );
+    const SizeValueType completeSlices = pending.size() / ( slicesPerBlock * sliceBytes ) * slicesPerBlock;
+    if ( completeSlices > 0 )
+    {
+      slabRegion.SetIndex( sliceDimension, static_cast< IndexValueType >( pendingSlice ) );
+      slabRegion.SetSize( sliceDimension, completeSlices );
+      const char * slab = pending.data();
+      if ( m_PayloadFilter != WasmPayloadFilterEnum::None )
+      {
+        unfiltered.resize( completeSlices * sliceBytes );
+        reversePayloadFilter( m_PayloadFilter, payloadLayout, slab, unfiltered.data(), unfiltered.size() );
+        slab = unfiltered.data();
+      }
+      this->CopyRegion( slab, slabRegion, buffer, ioRegion );
+      pending.erase( pending.begin(), pending.begin() + completeSlices * sliceBytes );
+      pendingSlice += completeSlices;
+    }
+  }
 }
 
 
@@ -166,25 +334,82 @@ WasmZstdImageIO
 {
   const std::string path(this->GetFileName());
 
-  std::string::size_type cborPos = path.rfind(".zst");
-  if ( ( cborPos != std::string::npos )
-       && ( cborPos == path.length() - 4 ) )
+  if ( fileNameIsZstd(path) )
   {
-    unsigned char * inputBinary;
-    const size_t inputBinarySize = this->WriteCBOR(buffer, &inputBinary, true);
-
-    const size_t compressedBufferSize = ZSTD_compressBound(inputBinarySize);
-    std::vector<char> compressedBinary(compressedBufferSize);
-
-    constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, inputBinary, inputBinarySize, compressionLevel);
-    free(inputBinary);
-    compressedBinary.resize(compressedSize);
-
     std::ofstream outputStream;
     this->OpenFileForWriting( outputStream, path.c_str(), true, false );
-    std::ostream_iterator<char> oIt(outputStream);
-    std::copy(compressedBinary.begin(), compressedBinary.end(), oIt);
+    WasmZstdCompressStreamBuffer compressBuffer(outputStream, this->GetCompressionLevel());
+    // Fails without multithreading support, which leaves compression on
+    // the calling thread
+    ZSTD_CCtx_setParameter(compressBuffer.GetContext(), ZSTD_c_nbWorkers, static_cast< int >(m_NumberOfWorkers));
+    ZSTD_CCtx_setParameter(compressBuffer.GetContext(), ZSTD_c_enableLongDistanceMatching, m_LongDistanceMatching ? 1 : 0);
+    std::ostream compressStream(&compressBuffer);
+
+    // The header is encoded once into memory so that the frame size can be
+    // pledged in the frame header. The payload is then compressed directly
+    // from the buffer.
+    WasmGrowableOutputStream headerStream;
+    this->WriteCBORHeader(headerStream, buffer != nullptr);
+    const WasmGrowableStreamBuffer & header = headerStream.GetStreamBuffer();
+
+    const SizeValueType imageSizeInBytes = this->GetImageSizeInBytes();
+    const unsigned int sliceDimension = this->GetNumberOfDimensions() - 1;
+    const SizeValueType sliceBytes = imageSizeInBytes / std::max< SizeValueType >(this->GetDimensions(sliceDimension), 1);
+    try
+    {
+      if ( buffer != nullptr && m_Seekable && sliceBytes > 0 && sliceBytes <= maximumSeekableFrameSize )
+      {
+        // Header frame, then pixel data frames of whole slices
+        compressBuffer.SetPledgedFrameSize(header.GetSize());
+        compressStream.write(header.GetData(), static_cast< std::streamsize >(header.GetSize()));
+        compressBuffer.EndFrame();
+
+        const SizeValueType slicesPerFrame =
+          std::max< SizeValueType >(std::min(m_SeekableFrameSize, maximumSeekableFrameSize) / sliceBytes, 1);
+        const SizeValueType numberOfSlices = this->GetDimensions(sliceDimension);
+        const char * pixels = static_cast< const char * >(buffer);
+        const WasmPayloadLayout payloadLayout = this->GetPayloadLayout();
+        std::vector< char > filtered;
+        for ( SizeValueType slice = 0; slice < numberOfSlices; slice += slicesPerFrame )
+        {
+          const SizeValueType frameBytes = std::min(slicesPerFrame, numberOfSlices - slice) * sliceBytes;
+          const char * frame = pixels + slice * sliceBytes;
+          if ( m_PayloadFilter != WasmPayloadFilterEnum::None )
+          {
+            // Filter blocks are slices, so each frame is filtered on its own
+            filtered.resize(frameBytes);
+            applyPayloadFilter(m_PayloadFilter, payloadLayout, frame, filtered.data(), frameBytes);
+            frame = filtered.data();
+          }
+          compressBuffer.SetPledgedFrameSize(frameBytes);
+          compressStream.write(frame, static_cast< std::streamsize >(frameBytes));
+          compressBuffer.EndFrame();
+        }
+        if ( !compressStream )
+        {
+          itkExceptionMacro("Could not write " << path);
+        }
+        writeSeekTable(outputStream, compressBuffer.GetFrames());
+      }
+      else
+      {
+        compressBuffer.SetPledgedFrameSize(header.GetSize() + (buffer != nullptr ? imageSizeInBytes : 0));
+        compressStream.write(header.GetData(), static_cast< std::streamsize >(header.GetSize()));
+        if ( buffer != nullptr )
+        {
+          this->WriteCBORData(buffer, compressStream);
+        }
+        compressBuffer.Finish();
+        if ( !compressStream )
+        {
+          itkExceptionMacro("Could not write " << path);
+        }
+      }
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro("Could not write " << path << ": " << error.what());
+    }
     return;
   }
 
@@ -19,7 +19,9 @@
 #define itkWasmZstdImageIO_h
 #include "WebAssemblyInterfaceExport.h"
 
-#include "itkWasmImageIO.h"
+#include "itkWasmCompressedImageIO.h"
+
+#include <cstdint>
 
 namespace itk
 {
@@ -34,37 +36,42 @@ namespace itk
  * This class extends WasmImageIO by adding support for zstandard compression.
  *
  * The file extensions used are .iwi, .iwi.cbor, and .iwi.cbor.zstd.
+ *
+ * The zstd compression level is set with SetCompressionLevel(). Native
+ * builds can compress with worker threads, see SetNumberOfWorkers().
+ *
+ * By default .iwi.cbor.zst is written as a single zstd frame with its
+ * content size in the frame header, so one-shot decoders such as
+ * ZSTD_decompress can read it. With SeekableOn() the file is written in the
+ * zstd seekable format instead: the pixel data is split into independently
+ * compressed frames of whole slices along the slowest-varying dimension,
+ * followed by a seek table in a skippable frame. Region reads then only
+ * decode the overlapping frames. The file remains a valid zstd stream for
+ * streaming decoders.
  * 
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
  */
-class WebAssemblyInterface_EXPORT WasmZstdImageIO: public WasmImageIO
+class WebAssemblyInterface_EXPORT WasmZstdImageIO: public WasmCompressedImageIO
 {
 public:
   /** Standard class typedefs. */
-  typedef WasmZstdImageIO      Self;
-  typedef WasmImageIO          Superclass;
-  typedef SmartPointer< Self > Pointer;
+  typedef WasmZstdImageIO       Self;
+  typedef WasmCompressedImageIO Superclass;
+  typedef SmartPointer< Self >  Pointer;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro(WasmZstdImageIO, WasmImageIO);
-
-  /** Determine the file type. Returns true if this ImageIO can read the
-   * file specified. */
-  bool CanReadFile(const char *) override;
+  itkTypeMacro(WasmZstdImageIO, WasmCompressedImageIO);
 
-  /** Set the spacing and dimension information for the set filename. */
-  void ReadImageInformation() override;
-
-  /** Reads the data from disk into the memory buffer provided. */
-  void Read(void *buffer) override;
+  /** Seekable .iwi.cbor.zst files can be read by region. Valid after
+   * ReadImageInformation(). */
+  bool CanStreamRead() override;
 
-  /** Determine the file type. Returns true if this ImageIO can write the
-   * file specified. */
-  bool CanWriteFile(const char *) override;
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const override;
 
   /** Set the spacing and dimension information for the set filename. */
   void WriteImageInformation() override;
@@ -73,12 +80,60 @@ public:
    * that the IORegions has been set properly. */
   void Write(const void *buffer) override;
 
+  /** Number of zstd worker threads used for compression. Zero, the
+   * default, compresses on the calling thread. Ignored when zstd was built
+   * without multithreading support, e.g. for WebAssembly. */
+  itkSetMacro(NumberOfWorkers, unsigned int);
+  itkGetConstMacro(NumberOfWorkers, unsigned int);
+
+  /** Enable zstd long distance matching. This improves the ratio of large
+   * images with repeated content at the cost of memory. Off by default. */
+  itkSetMacro(LongDistanceMatching, bool);
+  itkGetConstMacro(LongDistanceMatching, bool);
+  itkBooleanMacro(LongDistanceMatching);
+
+  /** Write .iwi.cbor.zst in the seekable format. Off by default. */
+  itkSetMacro(Seekable, bool);
+  itkGetConstMacro(Seekable, bool);
+  itkBooleanMacro(Seekable);
+
+  /** Target uncompressed size, in bytes, of the pixel data frames of a
+   * seekable file. A frame holds at least one slice. 4 MiB by default. */
+  itkSetMacro(SeekableFrameSize, SizeValueType);
+  itkGetConstMacro(SeekableFrameSize, SizeValueType);
+
 protected:
   WasmZstdImageIO();
   ~WasmZstdImageIO() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  bool IsCompressedFileName(const std::string & path) const override;
+
+  std::unique_ptr< std::streambuf > CreateDecompressStreamBuffer(std::istream & compressedStream) const override;
+
+  /** Load the seek table of the current file, if it has one. */
+  void ReadCompressedInformation() override;
+
+  /** Decode only the seekable frames that overlap the IORegion, or the
+   * whole file when it has no seek table. */
+  void ReadCompressedRegion(void * buffer) override;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdImageIO);
+
+  struct SeekTableFrame
+  {
+    uint64_t compressedOffset;
+    uint64_t compressedSize;
+    uint64_t decompressedOffset;
+    uint64_t decompressedSize;
+  };
+  std::vector< SeekTableFrame > m_SeekTable;
+
+  unsigned int  m_NumberOfWorkers{ 0 };
+  bool          m_LongDistanceMatching{ false };
+  bool          m_Seekable{ false };
+  SizeValueType m_SeekableFrameSize{ 4 * 1024 * 1024 };
 };
 } // end namespace itk
 
@@ -0,0 +1,303 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmZstdStreamBuffer_h
+#define itkWasmZstdStreamBuffer_h
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <streambuf>
+#include <vector>
+
+#include "zstd.h"
+
+namespace itk
+{
+/**
+ *\class WasmZstdDecompressStreamBuffer
+ * \brief Read-only std::streambuf that incrementally decompresses zstd data.
+ *
+ * Compressed input is pulled from the source stream in ZSTD_DStreamInSize()
+ * blocks and only decompressed as far as the consumer reads. Large reads are
+ * decompressed directly into the destination buffer.
+ *
+ * Corrupt or truncated input results in a std::runtime_error.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmZstdDecompressStreamBuffer : public std::streambuf
+{
+public:
+  explicit WasmZstdDecompressStreamBuffer(std::istream & source)
+    : m_Source(source)
+    , m_Context(ZSTD_createDStream())
+    , m_InputBuffer(ZSTD_DStreamInSize())
+    , m_OutputBuffer(ZSTD_DStreamOutSize())
+  {
+    ZSTD_initDStream(m_Context);
+    m_Input = ZSTD_inBuffer{ m_InputBuffer.data(), 0, 0 };
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data());
+  }
+
+  ~WasmZstdDecompressStreamBuffer() override
+  {
+    ZSTD_freeDStream(m_Context);
+  }
+
+  WasmZstdDecompressStreamBuffer(const WasmZstdDecompressStreamBuffer &) = delete;
+  WasmZstdDecompressStreamBuffer & operator=(const WasmZstdDecompressStreamBuffer &) = delete;
+
+protected:
+  int_type
+  underflow() override
+  {
+    if (this->gptr() < this->egptr())
+    {
+      return traits_type::to_int_type(*this->gptr());
+    }
+    ZSTD_outBuffer output{ m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+    this->Decompress(output);
+    if (output.pos == 0)
+    {
+      return traits_type::eof();
+    }
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data() + output.pos);
+    return traits_type::to_int_type(*this->gptr());
+  }
+
+  std::streamsize
+  xsgetn(char * destination, std::streamsize count) override
+  {
+    const std::streamsize buffered = std::min< std::streamsize >(count, this->egptr() - this->gptr());
+    std::memcpy(destination, this->gptr(), buffered);
+    this->gbump(static_cast< int >(buffered));
+    if (buffered == count)
+    {
+      return count;
+    }
+    ZSTD_outBuffer output{ destination + buffered, static_cast< size_t >(count - buffered), 0 };
+    this->Decompress(output);
+    return buffered + static_cast< std::streamsize >(output.pos);
+  }
+
+private:
+  /** Decompress until the output is full or the compressed input ends. */
+  void
+  Decompress(ZSTD_outBuffer & output)
+  {
+    while (output.pos < output.size)
+    {
+      if (m_Input.pos == m_Input.size && !m_SourceExhausted)
+      {
+        m_Source.read(m_InputBuffer.data(), static_cast< std::streamsize >(m_InputBuffer.size()));
+        m_Input.size = static_cast< size_t >(m_Source.gcount());
+        m_Input.pos = 0;
+        m_SourceExhausted = m_Input.size == 0;
+      }
+      const size_t outputPosition = output.pos;
+      const size_t result = ZSTD_decompressStream(m_Context, &output, &m_Input);
+      if (ZSTD_isError(result))
+      {
+        throw std::runtime_error(std::string("zstd decompression failed: ") + ZSTD_getErrorName(result));
+      }
+      // Without more input, a call after the end of the last frame expects
+      // the header of another one
+      if (m_SourceExhausted && m_Input.pos == m_Input.size && output.pos == outputPosition)
+      {
+        if (!m_FrameComplete)
+        {
+          throw std::runtime_error("zstd decompression failed: truncated input");
+        }
+        return;
+      }
+      m_FrameComplete = result == 0;
+    }
+  }
+
+  std::istream &  m_Source;
+  ZSTD_DStream *  m_Context;
+  std::vector< char > m_InputBuffer;
+  std::vector< char > m_OutputBuffer;
+  ZSTD_inBuffer   m_Input;
+  bool            m_SourceExhausted{ false };
+  bool            m_FrameComplete{ false };
+};
+
+/**
+ *\class WasmZstdCompressStreamBuffer
+ * \brief Write-only std::streambuf that incrementally compresses into a zstd frame.
+ *
+ * Small writes are gathered into a ZSTD_CStreamInSize() staging buffer.
+ * Large writes are compressed directly from the caller's memory. Call
+ * Finish() to end the frame after the last write.
+ *
+ * When the uncompressed size is known, pass it as pledgedSize so that it is
+ * recorded in the frame header.
+ *
+ * EndFrame() splits the output into independently decodable frames, whose
+ * sizes are reported by GetFrames() for a seek table.
+ *
+ * \ingroup WebAssemblyInterface
+ */
+class WasmZstdCompressStreamBuffer : public std::streambuf
+{
+public:
+  WasmZstdCompressStreamBuffer(std::ostream & sink, int compressionLevel,
+                               unsigned long long pledgedSize = ZSTD_CONTENTSIZE_UNKNOWN)
+    : m_Sink(sink)
+    , m_Context(ZSTD_createCCtx())
+    , m_InputBuffer(ZSTD_CStreamInSize())
+    , m_OutputBuffer(ZSTD_CStreamOutSize())
+  {
+    ZSTD_CCtx_setParameter(m_Context, ZSTD_c_compressionLevel, compressionLevel);
+    ZSTD_CCtx_setPledgedSrcSize(m_Context, pledgedSize);
+    this->setp(m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size());
+  }
+
+  ~WasmZstdCompressStreamBuffer() override
+  {
+    ZSTD_freeCCtx(m_Context);
+  }
+
+  WasmZstdCompressStreamBuffer(const WasmZstdCompressStreamBuffer &) = delete;
+  WasmZstdCompressStreamBuffer & operator=(const WasmZstdCompressStreamBuffer &) = delete;
+
+  /** Compression context, to set further parameters before the first write. */
+  ZSTD_CCtx *
+  GetContext()
+  {
+    return m_Context;
+  }
+
+  /** Compressed and decompressed size of a completed frame. */
+  struct Frame
+  {
+    unsigned long long compressedSize;
+    unsigned long long decompressedSize;
+  };
+
+  /** Compress any staged input and write the end of the frame. */
+  void
+  Finish()
+  {
+    this->EndFrame();
+  }
+
+  /** End the current frame. Following writes start a new frame. */
+  void
+  EndFrame()
+  {
+    this->CompressStaged();
+    ZSTD_inBuffer input{ nullptr, 0, 0 };
+    this->Compress(input, ZSTD_e_end);
+    m_Frames.push_back(Frame{ m_CompressedSize - m_FrameCompressedStart, m_DecompressedSize - m_FrameDecompressedStart });
+    m_FrameCompressedStart = m_CompressedSize;
+    m_FrameDecompressedStart = m_DecompressedSize;
+  }
+
+  /** Record the uncompressed size of the next frame in its header. */
+  void
+  SetPledgedFrameSize(unsigned long long pledgedSize)
+  {
+    ZSTD_CCtx_setPledgedSrcSize(m_Context, pledgedSize);
+  }
+
+  const std::vector< Frame > &
+  GetFrames() const
+  {
+    return m_Frames;
+  }
+
+protected:
+  int_type
+  overflow(int_type character) override
+  {
+    this->CompressStaged();
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      *this->pptr() = traits_type::to_char_type(character);
+      this->pbump(1);
+    }
+    return traits_type::not_eof(character);
+  }
+
+  std::streamsize
+  xsputn(const char * source, std::streamsize count) override
+  {
+    if (count <= this->epptr() - this->pptr())
+    {
+      std::memcpy(this->pptr(), source, static_cast< size_t >(count));
+      this->pbump(static_cast< int >(count));
+      return count;
+    }
+    this->CompressStaged();
+    ZSTD_inBuffer input{ source, static_cast< size_t >(count), 0 };
+    this->Compress(input, ZSTD_e_continue);
+    m_DecompressedSize += static_cast< unsigned long long >(count);
+    return count;
+  }
+
+private:
+  void
+  CompressStaged()
+  {
+    ZSTD_inBuffer input{ this->pbase(), static_cast< size_t >(this->pptr() - this->pbase()), 0 };
+    this->Compress(input, ZSTD_e_continue);
+    m_DecompressedSize += input.size;
+    this->setp(m_InputBuffer.data(), m_InputBuffer.data() + m_InputBuffer.size());
+  }
+
+  /** Compress all of the input and, for ZSTD_e_end, flush the frame epilogue. */
+  void
+  Compress(ZSTD_inBuffer & input, ZSTD_EndDirective directive)
+  {
+    bool done = false;
+    while (!done)
+    {
+      ZSTD_outBuffer output{ m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+      const size_t remaining = ZSTD_compressStream2(m_Context, &output, &input, directive);
+      if (ZSTD_isError(remaining))
+      {
+        throw std::runtime_error(std::string("zstd compression failed: ") + ZSTD_getErrorName(remaining));
+      }
+      m_Sink.write(m_OutputBuffer.data(), static_cast< std::streamsize >(output.pos));
+      m_CompressedSize += output.pos;
+      if (!m_Sink)
+      {
+        throw std::runtime_error("zstd compression failed: could not write output");
+      }
+      done = directive == ZSTD_e_end ? remaining == 0 : input.pos == input.size;
+    }
+  }
+
+  std::ostream &  m_Sink;
+  ZSTD_CCtx *     m_Context;
+  std::vector< char > m_InputBuffer;
+  std::vector< char > m_OutputBuffer;
+  std::vector< Frame > m_Frames;
+  unsigned long long m_CompressedSize{ 0 };
+  unsigned long long m_DecompressedSize{ 0 };
+  unsigned long long m_FrameCompressedStart{ 0 };
+  unsigned long long m_FrameDecompressedStart{ 0 };
+};
+
+} // namespace itk
+
+#endif
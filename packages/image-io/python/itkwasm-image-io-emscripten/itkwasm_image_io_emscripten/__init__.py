@@ -45,5 +45,7 @@ from .wasm_read_image_async import wasm_read_image_async
 from .wasm_write_image_async import wasm_write_image_async
 from .wasm_zstd_read_image_async import wasm_zstd_read_image_async
 from .wasm_zstd_write_image_async import wasm_zstd_write_image_async
+from .wasm_lz4_read_image_async import wasm_lz4_read_image_async
+from .wasm_lz4_write_image_async import wasm_lz4_write_image_async
 
 from ._version import __version__
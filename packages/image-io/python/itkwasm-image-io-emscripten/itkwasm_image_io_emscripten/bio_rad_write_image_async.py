@@ -22,6 +22,11 @@ async def bio_rad_write_image_async(
     serialized_image: str,
     information_only: bool = False,
     use_compression: bool = False,
+    compression_level: int = -1,
+    number_of_workers: int = 0,
+    long_distance_matching: bool = False,
+    payload_filter: str = "none",
+    seekable: bool = False,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an image file format
 
@@ -37,6 +42,21 @@ async def bio_rad_write_image_async(
     :param use_compression: Use compression in the written file
     :type  use_compression: bool
 
+    :param compression_level: Compression level, if supported. Defaults to the level of the file format.
+    :type  compression_level: int
+
+    :param number_of_workers: Number of compression worker threads, if supported. 0 compresses on the calling thread.
+    :type  number_of_workers: int
+
+    :param long_distance_matching: Use long distance matching for compression, if supported
+    :type  long_distance_matching: bool
+
+    :param payload_filter: Pixel byte filter applied before compression, if supported: none, shuffle, delta, or delta-shuffle
+    :type  payload_filter: str
+
+    :param seekable: Write frames with a seek table so that regions can be read without decompressing the whole file, if supported
+    :type  seekable: bool
+
     :return: Whether the input could be written. If false, the output image is not valid.
     :rtype:  Any
     """
@@ -48,6 +68,16 @@ async def bio_rad_write_image_async(
         kwargs["informationOnly"] = to_js(information_only)
     if use_compression:
         kwargs["useCompression"] = to_js(use_compression)
+    if compression_level:
+        kwargs["compressionLevel"] = to_js(compression_level)
+    if number_of_workers:
+        kwargs["numberOfWorkers"] = to_js(number_of_workers)
+    if long_distance_matching:
+        kwargs["longDistanceMatching"] = to_js(long_distance_matching)
+    if payload_filter:
+        kwargs["payloadFilter"] = to_js(payload_filter)
+    if seekable:
+        kwargs["seekable"] = to_js(seekable)
 
     outputs = await js_module.bioRadWriteImage(to_js(image), to_js(serialized_image), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -16,6 +16,7 @@ extension_to_image_io = OrderedDict([
   ('.iwi', 'wasm'),
   ('.iwi.cbor', 'wasm'),
   ('.iwi.cbor.zst', 'wasmZstd'),
+  ('.iwi.cbor.lz4', 'wasmLz4'),
 
   ('.lsm', 'lsm'),
 
@@ -45,5 +45,7 @@ from .wasm_read_image import wasm_read_image
 from .wasm_write_image import wasm_write_image
 from .wasm_zstd_read_image import wasm_zstd_read_image
 from .wasm_zstd_write_image import wasm_zstd_write_image
+from .wasm_lz4_read_image import wasm_lz4_read_image
+from .wasm_lz4_write_image import wasm_lz4_write_image
 
 from ._version import __version__
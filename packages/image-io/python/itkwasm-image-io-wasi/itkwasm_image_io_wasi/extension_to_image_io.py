@@ -16,6 +16,7 @@ extension_to_image_io = OrderedDict([
   ('.iwi', 'wasm'),
   ('.iwi.cbor', 'wasm'),
   ('.iwi.cbor.zst', 'wasm_zstd'),
+  ('.iwi.cbor.lz4', 'wasm_lz4'),
 
   ('.lsm', 'lsm'),
 
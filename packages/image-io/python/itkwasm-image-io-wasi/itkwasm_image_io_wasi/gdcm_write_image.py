@@ -22,6 +22,11 @@ def gdcm_write_image(
     serialized_image: str,
     information_only: bool = False,
     use_compression: bool = False,
+    compression_level: int = -1,
+    number_of_workers: int = 0,
+    long_distance_matching: bool = False,
+    payload_filter: str = "none",
+    seekable: bool = False,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an image file format
 
@@ -37,6 +42,21 @@ def gdcm_write_image(
     :param use_compression: Use compression in the written file
     :type  use_compression: bool
 
+    :param compression_level: Compression level, if supported. Defaults to the level of the file format.
+    :type  compression_level: int
+
+    :param number_of_workers: Number of compression worker threads, if supported. 0 compresses on the calling thread.
+    :type  number_of_workers: int
+
+    :param long_distance_matching: Use long distance matching for compression, if supported
+    :type  long_distance_matching: bool
+
+    :param payload_filter: Pixel byte filter applied before compression, if supported: none, shuffle, delta, or delta-shuffle
+    :type  payload_filter: str
+
+    :param seekable: Write frames with a seek table so that regions can be read without decompressing the whole file, if supported
+    :type  seekable: bool
+
     :return: Whether the input could be written. If false, the output image is not valid.
     :rtype:  Any
     """
@@ -71,6 +91,24 @@ def gdcm_write_image(
     if use_compression:
         args.append('--use-compression')
 
+    if compression_level:
+        args.append('--compression-level')
+        args.append(str(compression_level))
+
+    if number_of_workers:
+        args.append('--number-of-workers')
+        args.append(str(number_of_workers))
+
+    if long_distance_matching:
+        args.append('--long-distance-matching')
+
+    if payload_filter:
+        args.append('--payload-filter')
+        args.append(str(payload_filter))
+
+    if seekable:
+        args.append('--seekable')
+
 
     outputs = _pipeline.run(args, pipeline_outputs, pipeline_inputs)
 
@@ -12,14 +12,15 @@ image_io_index = [
   'mrc',
   'lsm',
   'mgh',
-  'bioRad',
+  'bio_rad',
   'gipl',
-  'geAdw',
+  'ge_adw',
   'ge4',
   'ge5',
   'gdcm',
   'scanco',
   'wasm',
-  'wasmZstd',
+  'wasm_zstd',
+  'wasm_lz4',
 ]
 
@@ -1,4 +1,5 @@
 from itkwasm import PixelTypes, IntTypes
+import numpy as np
 
 from itkwasm_image_io_wasi import read_image, imread, write_image, imwrite
 
@@ -50,6 +51,17 @@ def test_write_image():
     image = read_image(test_output_file_path)
     verify_image(image)
 
+def test_write_image_compressed():
+    image = read_image(test_input_file_path)
+
+    for extension in [".iwi.cbor.zst", ".iwi.cbor.lz4"]:
+        output_file_path = test_output_path / f"read-write-cthead1{extension}"
+        write_image(image, output_file_path)
+
+        image_back = read_image(output_file_path)
+        verify_image(image_back)
+        assert np.array_equal(image_back.data, image.data)
+
 def test_imwrite():
     image = imread(test_input_file_path)
 
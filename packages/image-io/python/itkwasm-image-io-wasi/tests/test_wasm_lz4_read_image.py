@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_image_io_wasi import wasm_lz4_read_image
+
+from .common import test_input_path, test_output_path
+
+def test_wasm_lz4_read_image():
+    pass
@@ -89,5 +89,9 @@ from .wasm_zstd_read_image_async import wasm_zstd_read_image_async
 from .wasm_zstd_read_image import wasm_zstd_read_image
 from .wasm_zstd_write_image_async import wasm_zstd_write_image_async
 from .wasm_zstd_write_image import wasm_zstd_write_image
+from .wasm_lz4_read_image_async import wasm_lz4_read_image_async
+from .wasm_lz4_read_image import wasm_lz4_read_image
+from .wasm_lz4_write_image_async import wasm_lz4_write_image_async
+from .wasm_lz4_write_image import wasm_lz4_write_image
 
 from ._version import __version__
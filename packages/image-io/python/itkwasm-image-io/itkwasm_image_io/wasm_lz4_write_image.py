@@ -0,0 +1,57 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    Image,
+    BinaryFile,
+)
+
+def wasm_lz4_write_image(
+    image: Image,
+    serialized_image: str,
+    information_only: bool = False,
+    use_compression: bool = False,
+    compression_level: int = -1,
+    number_of_workers: int = 0,
+    long_distance_matching: bool = False,
+    payload_filter: str = "none",
+    seekable: bool = False,
+) -> Tuple[Any]:
+    """Write an itk-wasm file format converted to an image file format
+
+    :param image: Input image
+    :type  image: Image
+
+    :param serialized_image: Output image serialized in the file format.
+    :type  serialized_image: str
+
+    :param information_only: Only write image metadata -- do not write pixel data.
+    :type  information_only: bool
+
+    :param use_compression: Use compression in the written file
+    :type  use_compression: bool
+
+    :param compression_level: Compression level, if supported. Defaults to the level of the file format.
+    :type  compression_level: int
+
+    :param number_of_workers: Number of compression worker threads, if supported. 0 compresses on the calling thread.
+    :type  number_of_workers: int
+
+    :param long_distance_matching: Use long distance matching for compression, if supported
+    :type  long_distance_matching: bool
+
+    :param payload_filter: Pixel byte filter applied before compression, if supported: none, shuffle, delta, or delta-shuffle
+    :type  payload_filter: str
+
+    :param seekable: Write frames with a seek table so that regions can be read without decompressing the whole file, if supported
+    :type  seekable: bool
+
+    :return: Whether the input could be written. If false, the output image is not valid.
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_image_io", "wasm_lz4_write_image")
+    output = func(image, serialized_image, information_only=information_only, use_compression=use_compression, compression_level=compression_level, number_of_workers=number_of_workers, long_distance_matching=long_distance_matching, payload_filter=payload_filter, seekable=seekable)
+    return output
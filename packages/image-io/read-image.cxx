@@ -70,6 +70,8 @@
 #elif IMAGE_IO_CLASS == 21
 #elif IMAGE_IO_CLASS == 22
 #include "itkWasmZstdImageIO.h"
+#elif IMAGE_IO_CLASS == 23
+#include "itkWasmLz4ImageIO.h"
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
@@ -171,6 +173,8 @@ int main (int argc, char * argv[])
   return readImage<itk::WasmImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
 #elif IMAGE_IO_CLASS == 22
   return readImage<itk::WasmZstdImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
+#elif IMAGE_IO_CLASS == 23
+  return readImage<itk::WasmLz4ImageIO>(inputFileName, couldRead, outputImageIO, informationOnly);
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
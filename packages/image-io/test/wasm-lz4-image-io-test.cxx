@@ -0,0 +1,115 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmLz4ImageIO.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include <iostream>
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output.iwi.cbor.lz4>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * imageFile = argv[1];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = unsigned short;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  size[2] = 12;
+  image->SetRegions(size);
+  image->Allocate();
+  PixelType value = 0;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(value);
+    value = static_cast<PixelType>(value * 31 + 7);
+  }
+
+  try
+  {
+    // The fast compressor and LZ4HC
+    for (const int compressionLevel : { 1, 9 })
+    {
+      auto writeIO = itk::WasmLz4ImageIO::New();
+      writeIO->SetCompressionLevel(compressionLevel);
+      using WriterType = itk::ImageFileWriter<ImageType>;
+      auto writer = WriterType::New();
+      writer->SetImageIO(writeIO);
+      writer->SetFileName(imageFile);
+      writer->SetInput(image);
+      writer->Update();
+
+      auto imageIO = itk::WasmLz4ImageIO::New();
+      using ReaderType = itk::ImageFileReader<ImageType>;
+      auto reader = ReaderType::New();
+      reader->SetImageIO(imageIO);
+      reader->SetFileName(imageFile);
+      reader->Update();
+
+      if (imageIO->GetNumberOfDecompressions() != 1)
+      {
+        std::cerr << "Expected one decompression pass, got " << imageIO->GetNumberOfDecompressions() << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      const ImageType * readImage = reader->GetOutput();
+      if (readImage->GetLargestPossibleRegion() != image->GetLargestPossibleRegion())
+      {
+        std::cerr << "Read image region does not match" << std::endl;
+        return EXIT_FAILURE;
+      }
+      itk::ImageRegionConstIterator<ImageType> expectedIt(image, image->GetLargestPossibleRegion());
+      itk::ImageRegionConstIterator<ImageType> readIt(readImage, readImage->GetLargestPossibleRegion());
+      for (; !expectedIt.IsAtEnd(); ++expectedIt, ++readIt)
+      {
+        if (expectedIt.Get() != readIt.Get())
+        {
+          std::cerr << "Pixel mismatch at " << expectedIt.GetIndex() << " with compression level "
+                    << compressionLevel << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    auto imageIO = itk::WasmLz4ImageIO::New();
+    if (imageIO->CanReadFile("image.iwi.cbor.zst") || imageIO->CanWriteFile("image.iwi.cbor.zst"))
+    {
+      std::cerr << "Expected .iwi.cbor.zst to require WasmZstdImageIO" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
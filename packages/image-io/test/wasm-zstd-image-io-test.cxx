@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmZstdImageIO.h"
+#include "itkImage.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "zstd.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output.iwi.cbor.zst>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * imageFile = argv[1];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = unsigned short;
+  using ImageType = itk::Image<PixelType, Dimension>;
+
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  size[2] = 12;
+  image->SetRegions(size);
+  image->Allocate();
+  PixelType value = 0;
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(value);
+    value = static_cast<PixelType>(value * 31 + 7);
+  }
+
+  try
+  {
+    using WriterType = itk::ImageFileWriter<ImageType>;
+    auto writer = WriterType::New();
+    writer->SetImageIO(itk::WasmZstdImageIO::New());
+    writer->SetFileName(imageFile);
+    writer->SetInput(image);
+    writer->Update();
+
+    auto imageIO = itk::WasmZstdImageIO::New();
+    using ReaderType = itk::ImageFileReader<ImageType>;
+    auto reader = ReaderType::New();
+    reader->SetImageIO(imageIO);
+    reader->SetFileName(imageFile);
+    reader->Update();
+
+    if (imageIO->GetNumberOfDecompressions() != 1)
+    {
+      std::cerr << "Expected one decompression pass, got " << imageIO->GetNumberOfDecompressions() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const ImageType * readImage = reader->GetOutput();
+    if (readImage->GetLargestPossibleRegion() != image->GetLargestPossibleRegion())
+    {
+      std::cerr << "Read image region does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+    itk::ImageRegionConstIterator<ImageType> expectedIt(image, image->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> readIt(readImage, readImage->GetLargestPossibleRegion());
+    for (; !expectedIt.IsAtEnd(); ++expectedIt, ++readIt)
+    {
+      if (expectedIt.Get() != readIt.Get())
+      {
+        std::cerr << "Pixel mismatch at " << expectedIt.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // The default file is one frame with its content size, as the one-shot
+    // decode in compress-stringify's parse-string-decompress expects
+    std::ifstream compressedFile(imageFile, std::ios::binary);
+    const std::vector<char> compressed((std::istreambuf_iterator<char>(compressedFile)), std::istreambuf_iterator<char>());
+    const unsigned long long contentSize = ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+    if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR)
+    {
+      std::cerr << "Expected the frame content size in the default file" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (ZSTD_findFrameCompressedSize(compressed.data(), compressed.size()) != compressed.size())
+    {
+      std::cerr << "Expected the default file to be a single zstd frame" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<char> decompressed(contentSize);
+    const size_t decompressedSize = ZSTD_decompress(decompressed.data(), decompressed.size(), compressed.data(), compressed.size());
+    if (ZSTD_isError(decompressedSize) || decompressedSize != contentSize)
+    {
+      std::cerr << "One-shot decompression failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+    const size_t pixelDataSize = image->GetLargestPossibleRegion().GetNumberOfPixels() * sizeof(PixelType);
+    if (decompressedSize < pixelDataSize ||
+        !std::equal(decompressed.end() - pixelDataSize, decompressed.end(), reinterpret_cast<const char *>(image->GetBufferPointer())))
+    {
+      std::cerr << "One-shot decompression does not end with the pixel data" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // A Read() without a preceding ReadImageInformation() starts its own pass
+    imageIO->Read(const_cast<PixelType *>(readImage->GetBufferPointer()));
+    if (imageIO->GetNumberOfDecompressions() != 2)
+    {
+      std::cerr << "Expected a second decompression pass, got " << imageIO->GetNumberOfDecompressions() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    // Seekable frames of two slices: a region read only decodes the
+    // frames that overlap it
+    auto seekableWriteIO = itk::WasmZstdImageIO::New();
+    seekableWriteIO->SeekableOn();
+    seekableWriteIO->SetSeekableFrameSize(2 * size[0] * size[1] * sizeof(PixelType));
+    writer->SetImageIO(seekableWriteIO);
+    writer->Update();
+
+    auto regionIO = itk::WasmZstdImageIO::New();
+    auto regionReader = ReaderType::New();
+    regionReader->SetImageIO(regionIO);
+    regionReader->SetFileName(imageFile);
+    regionReader->UpdateOutputInformation();
+    if (!regionIO->CanStreamRead())
+    {
+      std::cerr << "Expected a seekable file to be streamable" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    ImageType::RegionType region;
+    region.SetIndex(0, 10);
+    region.SetIndex(1, 5);
+    region.SetIndex(2, 3);
+    region.SetSize(0, 40);
+    region.SetSize(1, 25);
+    region.SetSize(2, 5);
+    regionReader->GetOutput()->SetRequestedRegion(region);
+    regionReader->Update();
+
+    const ImageType * regionImage = regionReader->GetOutput();
+    if (regionImage->GetBufferedRegion() != region)
+    {
+      std::cerr << "Expected only the requested region to be read, got " << regionImage->GetBufferedRegion() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (itk::ImageRegionConstIterator<ImageType> it(regionImage, region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != image->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Region pixel mismatch at " << it.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A filtered 1-D payload is one filter block, the whole row, so a
+    // region read reverses the filter over the whole row
+    using LineType = itk::Image<PixelType, 1>;
+    auto line = LineType::New();
+    LineType::RegionType lineRegion;
+    lineRegion.SetSize(0, 4096);
+    line->SetRegions(lineRegion);
+    line->Allocate();
+    for (itk::ImageRegionIterator<LineType> it(line, lineRegion); !it.IsAtEnd(); ++it)
+    {
+      it.Set(static_cast<PixelType>(it.GetIndex()[0] * it.GetIndex()[0]));
+    }
+    std::string lineFile(imageFile);
+    lineFile.insert(lineFile.rfind(".iwi.cbor.zst"), "-line");
+    for (const auto payloadFilter : { itk::WasmPayloadFilterEnum::Delta, itk::WasmPayloadFilterEnum::Shuffle,
+                                      itk::WasmPayloadFilterEnum::DeltaShuffle })
+    {
+      auto lineWriteIO = itk::WasmZstdImageIO::New();
+      lineWriteIO->SetPayloadFilter(payloadFilter);
+      lineWriteIO->SeekableOn();
+      lineWriteIO->SetSeekableFrameSize(1000);
+      auto lineWriter = itk::ImageFileWriter<LineType>::New();
+      lineWriter->SetImageIO(lineWriteIO);
+      lineWriter->SetFileName(lineFile);
+      lineWriter->SetInput(line);
+      lineWriter->Update();
+
+      auto lineReader = itk::ImageFileReader<LineType>::New();
+      lineReader->SetImageIO(itk::WasmZstdImageIO::New());
+      lineReader->SetFileName(lineFile);
+      LineType::RegionType lineRequest;
+      lineRequest.SetIndex(0, 1000);
+      lineRequest.SetSize(0, 500);
+      lineReader->GetOutput()->SetRequestedRegion(lineRequest);
+      lineReader->Update();
+      const LineType * lineImage = lineReader->GetOutput();
+      if (!lineImage->GetBufferedRegion().IsInside(lineRequest))
+      {
+        std::cerr << "Expected the requested 1-D region to be read, got " << lineImage->GetBufferedRegion() << std::endl;
+        return EXIT_FAILURE;
+      }
+      for (itk::ImageRegionConstIterator<LineType> it(lineImage, lineRequest); !it.IsAtEnd(); ++it)
+      {
+        if (it.Get() != line->GetPixel(it.GetIndex()))
+        {
+          std::cerr << "1-D " << payloadFilter << " region pixel mismatch at " << it.GetIndex() << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    auto foreignCodecIO = itk::WasmZstdImageIO::New();
+    if (foreignCodecIO->CanReadFile("image.iwi.cbor.lz4") || foreignCodecIO->CanWriteFile("image.iwi.cbor.lz4"))
+    {
+      std::cerr << "Expected .iwi.cbor.lz4 to require WasmLz4ImageIO" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -61,6 +61,24 @@ async function bioRadWriteImageNode(
   if (options.useCompression) {
     options.useCompression && args.push('--use-compression')
   }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.numberOfWorkers) {
+    args.push('--number-of-workers', options.numberOfWorkers.toString())
+
+  }
+  if (options.longDistanceMatching) {
+    options.longDistanceMatching && args.push('--long-distance-matching')
+  }
+  if (options.payloadFilter) {
+    args.push('--payload-filter', options.payloadFilter.toString())
+
+  }
+  if (options.seekable) {
+    options.seekable && args.push('--seekable')
+  }
 
   const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'bio-rad-write-image')
 
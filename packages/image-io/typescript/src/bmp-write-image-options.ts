@@ -9,6 +9,21 @@ interface BmpWriteImageOptions extends WorkerPoolFunctionOption {
   /** Use compression in the written file */
   useCompression?: boolean
 
+  /** Compression level, if supported. Defaults to the level of the file format. */
+  compressionLevel?: number
+
+  /** Number of compression worker threads, if supported. 0 compresses on the calling thread. */
+  numberOfWorkers?: number
+
+  /** Use long distance matching for compression, if supported */
+  longDistanceMatching?: boolean
+
+  /** Pixel byte filter applied before compression, if supported: none, shuffle, delta, or delta-shuffle */
+  payloadFilter?: string
+
+  /** Write frames with a seek table so that regions can be read without decompressing the whole file, if supported */
+  seekable?: boolean
+
 }
 
 export default BmpWriteImageOptions
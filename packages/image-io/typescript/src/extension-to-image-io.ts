@@ -14,6 +14,7 @@ const extensionToImageIo = new Map([
   ['iwi', 'wasm'],
   ['iwi.cbor', 'wasm'],
   ['iwi.cbor.zst', 'wasmZstd'],
+  ['iwi.cbor.lz4', 'wasmLz4'],
 
   ['lsm', 'lsm'],
 
@@ -43,6 +43,8 @@ import wasmReadImageNode from './wasm-read-image-node.js'
 import wasmWriteImageNode from './wasm-write-image-node.js'
 import wasmZstdReadImageNode from './wasm-zstd-read-image-node.js'
 import wasmZstdWriteImageNode from './wasm-zstd-write-image-node.js'
+import wasmLz4ReadImageNode from './wasm-lz4-read-image-node.js'
+import wasmLz4WriteImageNode from './wasm-lz4-write-image-node.js'
 
 const imageIoIndexNode = new Map([
   ['png', [pngReadImageNode, pngWriteImageNode]],
@@ -67,7 +69,8 @@ const imageIoIndexNode = new Map([
   ['scanco', [scancoReadImageNode, scancoWriteImageNode]],
   ['fdf', [fdfReadImageNode, null]],
   ['wasm', [wasmReadImageNode, wasmWriteImageNode]],
-  ['wasmZstd', [wasmZstdReadImageNode, wasmZstdWriteImageNode]]
+  ['wasmZstd', [wasmZstdReadImageNode, wasmZstdWriteImageNode]],
+  ['wasmLz4', [wasmLz4ReadImageNode, wasmLz4WriteImageNode]]
 ])
 
 export default imageIoIndexNode
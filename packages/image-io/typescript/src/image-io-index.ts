@@ -43,6 +43,8 @@ import wasmReadImage from './wasm-read-image.js'
 import wasmWriteImage from './wasm-write-image.js'
 import wasmZstdReadImage from './wasm-zstd-read-image.js'
 import wasmZstdWriteImage from './wasm-zstd-write-image.js'
+import wasmLz4ReadImage from './wasm-lz4-read-image.js'
+import wasmLz4WriteImage from './wasm-lz4-write-image.js'
 
 const imageIoIndex = new Map([
   ['png', [pngReadImage, pngWriteImage]],
@@ -67,7 +69,8 @@ const imageIoIndex = new Map([
   ['scanco', [scancoReadImage, scancoWriteImage]],
   ['fdf', [fdfReadImage, null]],
   ['wasm', [wasmReadImage, wasmWriteImage]],
-  ['wasmZstd', [wasmZstdReadImage, wasmZstdWriteImage]]
+  ['wasmZstd', [wasmZstdReadImage, wasmZstdWriteImage]],
+  ['wasmLz4', [wasmLz4ReadImage, wasmLz4WriteImage]]
 ])
 
 export default imageIoIndex
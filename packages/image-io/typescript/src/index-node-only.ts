@@ -331,3 +331,17 @@ export type { WasmZstdWriteImageNodeResult }
 
 import wasmZstdWriteImageNode from './wasm-zstd-write-image-node.js'
 export { wasmZstdWriteImageNode }
+
+
+import WasmLz4ReadImageNodeResult from './wasm-lz4-read-image-node-result.js'
+export type { WasmLz4ReadImageNodeResult }
+
+import wasmLz4ReadImageNode from './wasm-lz4-read-image-node.js'
+export { wasmLz4ReadImageNode }
+
+
+import WasmLz4WriteImageNodeResult from './wasm-lz4-write-image-node-result.js'
+export type { WasmLz4WriteImageNodeResult }
+
+import wasmLz4WriteImageNode from './wasm-lz4-write-image-node.js'
+export { wasmLz4WriteImageNode }
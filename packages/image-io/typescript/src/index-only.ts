@@ -489,3 +489,23 @@ export { wasmZstdWriteImage }
 
 import WasmZstdWriteImageOptions from './wasm-zstd-write-image-options.js'
 export type { WasmZstdWriteImageOptions }
+
+
+import WasmLz4ReadImageResult from './wasm-lz4-read-image-result.js'
+export type { WasmLz4ReadImageResult }
+
+import wasmLz4ReadImage from './wasm-lz4-read-image.js'
+export { wasmLz4ReadImage }
+
+import WasmLz4ReadImageOptions from './wasm-lz4-read-image-options.js'
+export type { WasmLz4ReadImageOptions }
+
+
+import WasmLz4WriteImageResult from './wasm-lz4-write-image-result.js'
+export type { WasmLz4WriteImageResult }
+
+import wasmLz4WriteImage from './wasm-lz4-write-image.js'
+export { wasmLz4WriteImage }
+
+import WasmLz4WriteImageOptions from './wasm-lz4-write-image-options.js'
+export type { WasmLz4WriteImageOptions }
@@ -0,0 +1,9 @@
+// Generated file. To retain edits, remove this comment.
+
+interface WasmLz4ReadImageNodeOptions {
+  /** Only read image metadata -- do not read pixel data. */
+  informationOnly?: boolean
+
+}
+
+export default WasmLz4ReadImageNodeOptions
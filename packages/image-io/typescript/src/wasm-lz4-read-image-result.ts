@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible, Image, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface WasmLz4ReadImageResult extends WorkerPoolFunctionResult {
+  /** Whether the input could be read. If false, the output image is not valid. */
+  couldRead: JsonCompatible
+
+  /** Output image */
+  image: Image
+
+}
+
+export default WasmLz4ReadImageResult
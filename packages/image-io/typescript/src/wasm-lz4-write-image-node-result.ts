@@ -0,0 +1,12 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible } from 'itk-wasm'
+
+interface WasmLz4WriteImageNodeResult {
+  /** Whether the input could be written. If false, the output image is not valid. */
+  couldWrite: JsonCompatible
+
+  /** Output image serialized in the file format. */
+}
+
+export default WasmLz4WriteImageNodeResult
@@ -0,0 +1,100 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  Image,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import WasmLz4WriteImageNodeOptions from './wasm-lz4-write-image-node-options.js'
+import WasmLz4WriteImageNodeResult from './wasm-lz4-write-image-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Write an itk-wasm file format converted to an image file format
+ *
+ * @param {Image} image - Input image
+ * @param {string} serializedImage - Output image serialized in the file format.
+ * @param {WasmLz4WriteImageNodeOptions} options - options object
+ *
+ * @returns {Promise<WasmLz4WriteImageNodeResult>} - result object
+ */
+async function wasmLz4WriteImageNode(
+  image: Image,
+  serializedImage: string,
+  options: WasmLz4WriteImageNodeOptions = {}
+) : Promise<WasmLz4WriteImageNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Image, data: image },
+  ]
+
+  const args = []
+  // Inputs
+  const imageName = '0'
+  args.push(imageName)
+
+  // Outputs
+  const couldWriteName = '0'
+  args.push(couldWriteName)
+
+  const serializedImageName = serializedImage
+  args.push(serializedImageName)
+  mountDirs.add(path.dirname(serializedImageName))
+
+  // Options
+  args.push('--memory-io')
+  if (options.informationOnly) {
+    options.informationOnly && args.push('--information-only')
+  }
+  if (options.useCompression) {
+    options.useCompression && args.push('--use-compression')
+  }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.numberOfWorkers) {
+    args.push('--number-of-workers', options.numberOfWorkers.toString())
+
+  }
+  if (options.longDistanceMatching) {
+    options.longDistanceMatching && args.push('--long-distance-matching')
+  }
+  if (options.payloadFilter) {
+    args.push('--payload-filter', options.payloadFilter.toString())
+
+  }
+  if (options.seekable) {
+    options.seekable && args.push('--seekable')
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'wasm-lz4-write-image')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    couldWrite: outputs[0]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default wasmLz4WriteImageNode
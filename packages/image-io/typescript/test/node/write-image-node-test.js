@@ -54,3 +54,14 @@ test('Test writing a PNG with writeImageNode, cast to the specified componentTyp
   const imageBack = await readImageNode(testOutputCastFilePath)
   verifyImage(t, imageBack, componentType, pixelType)
 })
+
+test('Test writing compressed itk-wasm images with writeImageNode', async t => {
+  const image = await readImageNode(testInputFilePath)
+  for (const extension of ['iwi.cbor.zst', 'iwi.cbor.lz4']) {
+    const outputFilePath = path.join(testOutputPath, `write-image-node-test-cthead1.${extension}`)
+    await writeImageNode(image, outputFilePath)
+    const imageBack = await readImageNode(outputFilePath)
+    verifyImage(t, imageBack)
+    t.deepEqual(imageBack.data, image.data, `data (${extension})`)
+  }
+})
@@ -70,6 +70,8 @@
 #elif IMAGE_IO_CLASS == 21
 #elif IMAGE_IO_CLASS == 22
 #include "itkWasmZstdImageIO.h"
+#elif IMAGE_IO_CLASS == 23
+#include "itkWasmLz4ImageIO.h"
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
@@ -83,8 +85,18 @@
 #include "itkWasmImageIOBase.h"
 #include "itkImageIOBase.h"
 
+struct CompressionOptions
+{
+  // Negative keeps the default of the image IO
+  int compressionLevel = -1;
+  unsigned int numberOfWorkers = 0;
+  bool longDistanceMatching = false;
+  std::string payloadFilter = "none";
+  bool seekable = false;
+};
+
 template <typename TImageIO>
-int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression)
+int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, const CompressionOptions & compressionOptions)
 {
   using ImageIOType = TImageIO;
 
@@ -102,6 +114,26 @@ int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStre
 
   imageIO->SetFileName(outputFileName);
   imageIO->SetUseCompression(useCompression);
+  if (compressionOptions.compressionLevel >= 0)
+  {
+    imageIO->SetCompressionLevel(compressionOptions.compressionLevel);
+  }
+#if IMAGE_IO_CLASS == 22
+  imageIO->SetNumberOfWorkers(compressionOptions.numberOfWorkers);
+  imageIO->SetLongDistanceMatching(compressionOptions.longDistanceMatching);
+  imageIO->SetSeekable(compressionOptions.seekable);
+#endif
+#if IMAGE_IO_CLASS == 21 || IMAGE_IO_CLASS == 22 || IMAGE_IO_CLASS == 23
+  try
+  {
+    imageIO->SetPayloadFilter(itk::payloadFilterFromString(compressionOptions.payloadFilter));
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+#endif
 
   const itk::WasmImageIOBase * inputWasmImageIOBase = inputImageIO.Get();
   const itk::ImageIOBase * inputImageIOBase = inputWasmImageIOBase->GetImageIO();
@@ -134,7 +166,7 @@ int writeImage(itk::wasm::InputImageIO & inputImageIO, itk::wasm::OutputTextStre
   imageIO->WriteImageInformation();
   if (!informationOnly)
   {
-    imageIO->Write( reinterpret_cast< const void * >( &(inputWasmImageIOBase->GetPixelDataContainer()->at(0)) ));
+    imageIO->Write( reinterpret_cast< const void * >( inputWasmImageIOBase->GetPixelData() ));
   }
 
   return EXIT_SUCCESS;
@@ -161,54 +193,67 @@ int main (int argc, char * argv[])
   bool useCompression = false;
   pipeline.add_flag("-c,--use-compression", useCompression, "Use compression in the written file");
 
+  CompressionOptions compressionOptions;
+  pipeline.add_option("--compression-level", compressionOptions.compressionLevel, "Compression level, if supported. Defaults to the level of the file format.");
+
+  pipeline.add_option("--number-of-workers", compressionOptions.numberOfWorkers, "Number of compression worker threads, if supported. 0 compresses on the calling thread.");
+
+  pipeline.add_flag("--long-distance-matching", compressionOptions.longDistanceMatching, "Use long distance matching for compression, if supported");
+
+  pipeline.add_option("--payload-filter", compressionOptions.payloadFilter, "Pixel byte filter applied before compression, if supported: none, shuffle, delta, or delta-shuffle");
+
+  pipeline.add_flag("--seekable", compressionOptions.seekable, "Write frames with a seek table so that regions can be read without decompressing the whole file, if supported");
+
   ITK_WASM_PARSE(pipeline);
 
 #if IMAGE_IO_CLASS == 0
-  return writeImage<itk::PNGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::PNGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 1
-  return writeImage<itk::MetaImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MetaImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 2
-  return writeImage<itk::TIFFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::TIFFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 3
-  return writeImage<itk::NiftiImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::NiftiImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 4
-  return writeImage<itk::JPEGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::JPEGImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 5
-  return writeImage<itk::NrrdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::NrrdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 6
-  return writeImage<itk::VTKImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::VTKImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 7
-  return writeImage<itk::BMPImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::BMPImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 8
-  return writeImage<itk::HDF5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::HDF5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 9
-  return writeImage<itk::MINCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MINCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 10
-  return writeImage<itk::MRCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MRCImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 11
-  return writeImage<itk::LSMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::LSMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 12
-  return writeImage<itk::MGHImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::MGHImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 13
-  return writeImage<itk::BioRadImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::BioRadImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 14
-  return writeImage<itk::GiplImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GiplImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 15
-  return writeImage<itk::GE4ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GE4ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 16
-  return writeImage<itk::GE5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GE5ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 17
-  return writeImage<itk::GEAdwImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GEAdwImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 18
-  return writeImage<itk::GDCMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::GDCMImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 19
-  return writeImage<itk::ScancoImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::ScancoImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 20
-  return writeImage<itk::FDFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::FDFImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 21
-  return writeImage<itk::WasmImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::WasmImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #elif IMAGE_IO_CLASS == 22
-  return writeImage<itk::WasmZstdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression);
+  return writeImage<itk::WasmZstdImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
+#elif IMAGE_IO_CLASS == 23
+  return writeImage<itk::WasmLz4ImageIO>(inputImageIO, couldWrite, outputFileName, informationOnly, useCompression, compressionOptions);
 #else
 #error "Unsupported IMAGE_IO_CLASS"
 #endif
@@ -0,0 +1,17 @@
+include(FetchContent)
+option(LZ4_BUILD_CLI "Build lz4 program" OFF)
+option(LZ4_BUILD_LEGACY_LZ4C "Build lz4c program with legacy argument support" OFF)
+option(BUILD_SHARED_LIBS "Build shared libraries" OFF)
+option(BUILD_STATIC_LIBS "Build static libraries" ON)
+set(lz4_GIT_REPOSITORY "https://github.com/lz4/lz4.git")
+set(lz4_GIT_TAG v1.9.4)
+FetchContent_Declare(
+  lz4_lib
+  GIT_REPOSITORY ${lz4_GIT_REPOSITORY}
+  GIT_TAG        ${lz4_GIT_TAG}
+)
+
+FetchContent_MakeAvailable(lz4_lib)
+set(lz4_lib_INCLUDE_DIR "${lz4_lib_SOURCE_DIR}/lib")
+include_directories(${lz4_lib_INCLUDE_DIR})
+add_subdirectory("${lz4_lib_SOURCE_DIR}/build/cmake" "${lz4_lib_BINARY_DIR}")
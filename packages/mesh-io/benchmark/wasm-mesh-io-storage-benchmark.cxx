@@ -0,0 +1,161 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMeshIO.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Size and load time of .iwm.cbor with quantized points and narrowed
+// cells, relative to the unchanged encoding. Load times are the best of
+// several full reads.
+//
+// Usage: wasm-mesh-io-storage-benchmark <output-directory> <point-precision> <input.iwm>...
+//
+// Inputs are .iwm directories or .iwm.cbor files, e.g. cow.iwm. Results
+// are printed as tab-separated values.
+namespace
+{
+
+struct StorageMode
+{
+  const char * name;
+  bool         quantizePoints;
+  bool         narrowCells;
+};
+
+struct MeshBuffers
+{
+  std::vector<char> points;
+  std::vector<char> cells;
+  std::vector<char> pointData;
+  std::vector<char> cellData;
+};
+
+void
+readMesh(itk::WasmMeshIO * meshIO, MeshBuffers & buffers)
+{
+  meshIO->ReadMeshInformation();
+  buffers.points.resize(meshIO->GetNumberOfPoints() * meshIO->GetPointDimension() *
+                        itk::ITKComponentSize(meshIO->GetPointComponentType()));
+  buffers.cells.resize(meshIO->GetCellBufferSize() * itk::ITKComponentSize(meshIO->GetCellComponentType()));
+  buffers.pointData.resize(meshIO->GetNumberOfPointPixels() * meshIO->GetNumberOfPointPixelComponents() *
+                           itk::ITKComponentSize(meshIO->GetPointPixelComponentType()));
+  buffers.cellData.resize(meshIO->GetNumberOfCellPixels() * meshIO->GetNumberOfCellPixelComponents() *
+                          itk::ITKComponentSize(meshIO->GetCellPixelComponentType()));
+  meshIO->ReadPoints(buffers.points.data());
+  meshIO->ReadCells(buffers.cells.data());
+  meshIO->ReadPointData(buffers.pointData.data());
+  meshIO->ReadCellData(buffers.cellData.data());
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> <point-precision> <input.iwm>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+  const double      pointPrecision = std::stod(argv[2]);
+
+  const std::vector<StorageMode> modes{ { "full", false, false },
+                                        { "narrowed-cells", false, true },
+                                        { "quantized-points", true, false },
+                                        { "compact", true, true } };
+  constexpr unsigned int loadRepetitions = 5;
+
+  std::cout << "mesh\tmode\tbytes\tratio\tload_seconds" << std::endl;
+  try
+  {
+    for (int ii = 3; ii < argc; ++ii)
+    {
+      const std::string inputFile = argv[ii];
+      auto inputIO = itk::WasmMeshIO::New();
+      inputIO->SetFileName(inputFile);
+      MeshBuffers buffers;
+      readMesh(inputIO, buffers);
+
+      double fullSize = 0.0;
+      for (const StorageMode & mode : modes)
+      {
+        const std::string outputFile = outputDirectory + "/" +
+          itksys::SystemTools::GetFilenameWithoutExtension(inputFile) + "-" + mode.name + ".iwm.cbor";
+
+        auto outputIO = itk::WasmMeshIO::New();
+        outputIO->SetFileName(outputFile);
+        outputIO->SetPointDimension(inputIO->GetPointDimension());
+        outputIO->SetPointComponentType(inputIO->GetPointComponentType());
+        outputIO->SetPointPixelType(inputIO->GetPointPixelType());
+        outputIO->SetPointPixelComponentType(inputIO->GetPointPixelComponentType());
+        outputIO->SetNumberOfPointPixelComponents(inputIO->GetNumberOfPointPixelComponents());
+        outputIO->SetCellComponentType(inputIO->GetCellComponentType());
+        outputIO->SetCellPixelType(inputIO->GetCellPixelType());
+        outputIO->SetCellPixelComponentType(inputIO->GetCellPixelComponentType());
+        outputIO->SetNumberOfCellPixelComponents(inputIO->GetNumberOfCellPixelComponents());
+        outputIO->SetNumberOfPoints(inputIO->GetNumberOfPoints());
+        outputIO->SetNumberOfPointPixels(inputIO->GetNumberOfPointPixels());
+        outputIO->SetNumberOfCells(inputIO->GetNumberOfCells());
+        outputIO->SetNumberOfCellPixels(inputIO->GetNumberOfCellPixels());
+        outputIO->SetCellBufferSize(inputIO->GetCellBufferSize());
+        outputIO->SetPointQuantizationPrecision(mode.quantizePoints ? pointPrecision : 0.0);
+        outputIO->SetNarrowCellComponentType(mode.narrowCells);
+
+        outputIO->WriteMeshInformation();
+        outputIO->WritePoints(buffers.points.data());
+        outputIO->WriteCells(buffers.cells.data());
+        outputIO->WritePointData(buffers.pointData.data());
+        outputIO->WriteCellData(buffers.cellData.data());
+        outputIO->Write();
+        const double size = static_cast<double>(itksys::SystemTools::FileLength(outputFile));
+        if (fullSize == 0.0)
+        {
+          fullSize = size;
+        }
+
+        double loadSeconds = 0.0;
+        for (unsigned int repetition = 0; repetition < loadRepetitions; ++repetition)
+        {
+          auto readIO = itk::WasmMeshIO::New();
+          readIO->SetFileName(outputFile);
+          MeshBuffers readBuffers;
+          const auto loadStart = std::chrono::steady_clock::now();
+          readMesh(readIO, readBuffers);
+          const std::chrono::duration<double> loadElapsed = std::chrono::steady_clock::now() - loadStart;
+          loadSeconds = repetition == 0 ? loadElapsed.count() : std::min(loadSeconds, loadElapsed.count());
+        }
+
+        std::cout << itksys::SystemTools::GetFilenameName(inputFile) << '\t' << mode.name << '\t' << size << '\t'
+                  << fullSize / size << '\t' << loadSeconds << std::endl;
+        itksys::SystemTools::RemoveFile(outputFile);
+      }
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMeshIO.h"
+#include "itkWasmMeshLocality.h"
+#include "itkWasmZstdMeshIO.h"
+#include "itksys/SystemTools.hxx"
+
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Render locality and .iwm.cbor.zst size of meshes in their stored order
+// and after vertex cache reordering with first-use point renumbering.
+//
+// Usage: wasm-mesh-locality-benchmark <output-directory> <input.iwm>...
+//
+// Inputs are .iwm directories or .iwm.cbor files, e.g. cow.iwm. Results
+// are printed as tab-separated values.
+namespace
+{
+
+struct MeshBuffers
+{
+  std::vector<char> points;
+  std::vector<char> cells;
+  std::vector<char> pointData;
+  std::vector<char> cellData;
+};
+
+void
+readMesh(itk::MeshIOBase * meshIO, MeshBuffers & buffers)
+{
+  meshIO->ReadMeshInformation();
+  buffers.points.resize(meshIO->GetNumberOfPoints() * meshIO->GetPointDimension() *
+                        itk::ITKComponentSize(meshIO->GetPointComponentType()));
+  buffers.cells.resize(meshIO->GetCellBufferSize() * itk::ITKComponentSize(meshIO->GetCellComponentType()));
+  buffers.pointData.resize(meshIO->GetNumberOfPointPixels() * meshIO->GetNumberOfPointPixelComponents() *
+                           itk::ITKComponentSize(meshIO->GetPointPixelComponentType()));
+  buffers.cellData.resize(meshIO->GetNumberOfCellPixels() * meshIO->GetNumberOfCellPixelComponents() *
+                          itk::ITKComponentSize(meshIO->GetCellPixelComponentType()));
+  meshIO->ReadPoints(buffers.points.data());
+  meshIO->ReadCells(buffers.cells.data());
+  meshIO->ReadPointData(buffers.pointData.data());
+  meshIO->ReadCellData(buffers.cellData.data());
+}
+
+double
+writeMesh(const itk::MeshIOBase * inputIO, const MeshBuffers & buffers, itk::MeshIOBase * outputIO,
+  const std::string & outputFile)
+{
+  outputIO->SetFileName(outputFile);
+  outputIO->SetPointDimension(inputIO->GetPointDimension());
+  outputIO->SetPointComponentType(inputIO->GetPointComponentType());
+  outputIO->SetPointPixelType(inputIO->GetPointPixelType());
+  outputIO->SetPointPixelComponentType(inputIO->GetPointPixelComponentType());
+  outputIO->SetNumberOfPointPixelComponents(inputIO->GetNumberOfPointPixelComponents());
+  outputIO->SetCellComponentType(inputIO->GetCellComponentType());
+  outputIO->SetCellPixelType(inputIO->GetCellPixelType());
+  outputIO->SetCellPixelComponentType(inputIO->GetCellPixelComponentType());
+  outputIO->SetNumberOfCellPixelComponents(inputIO->GetNumberOfCellPixelComponents());
+  outputIO->SetNumberOfPoints(inputIO->GetNumberOfPoints());
+  outputIO->SetNumberOfPointPixels(inputIO->GetNumberOfPointPixels());
+  outputIO->SetNumberOfCells(inputIO->GetNumberOfCells());
+  outputIO->SetNumberOfCellPixels(inputIO->GetNumberOfCellPixels());
+  outputIO->SetCellBufferSize(inputIO->GetCellBufferSize());
+
+  outputIO->WriteMeshInformation();
+  outputIO->WritePoints(const_cast<char *>(buffers.points.data()));
+  outputIO->WriteCells(const_cast<char *>(buffers.cells.data()));
+  outputIO->WritePointData(const_cast<char *>(buffers.pointData.data()));
+  outputIO->WriteCellData(const_cast<char *>(buffers.cellData.data()));
+  outputIO->Write();
+  const double size = static_cast<double>(itksys::SystemTools::FileLength(outputFile));
+  itksys::SystemTools::RemoveFile(outputFile);
+  return size;
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> <input.iwm>..." << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  std::cout << "mesh\torder\tacmr\tatvr\tpoint_id_span\tcbor_bytes\tzst_bytes\tzst_ratio" << std::endl;
+  try
+  {
+    for (int ii = 2; ii < argc; ++ii)
+    {
+      const std::string inputFile = argv[ii];
+      const std::string meshName = itksys::SystemTools::GetFilenameName(inputFile);
+      const std::string outputPrefix =
+        outputDirectory + "/" + itksys::SystemTools::GetFilenameWithoutExtension(inputFile);
+      auto inputIO = itk::WasmMeshIO::New();
+      inputIO->SetFileName(inputFile);
+      MeshBuffers buffers;
+      readMesh(inputIO, buffers);
+
+      const itk::WasmMeshCellPoints storedCellPoints = itk::cellPointsFromCellBuffer(
+        buffers.cells.data(), inputIO->GetCellComponentType(), inputIO->GetNumberOfCells(), inputIO->GetCellBufferSize());
+      const itk::WasmMeshLocalityOrder order =
+        itk::computeMeshLocalityOrder(storedCellPoints, inputIO->GetNumberOfPoints());
+      MeshBuffers reordered = buffers;
+      itk::applyMeshLocalityOrder(
+        inputIO, order, reordered.points, reordered.cells, reordered.pointData, reordered.cellData);
+
+      const std::pair<const char *, const MeshBuffers *> orders[] = { { "stored", &buffers },
+                                                                       { "reordered", &reordered } };
+      for (const auto & [orderName, orderBuffers] : orders)
+      {
+        const itk::WasmMeshLocalityMetrics metrics = itk::measureMeshLocality(itk::cellPointsFromCellBuffer(
+          orderBuffers->cells.data(), inputIO->GetCellComponentType(), inputIO->GetNumberOfCells(),
+          inputIO->GetCellBufferSize()));
+        const double cborSize =
+          writeMesh(inputIO, *orderBuffers, itk::WasmMeshIO::New(), outputPrefix + "-" + orderName + ".iwm.cbor");
+        const double zstSize = writeMesh(
+          inputIO, *orderBuffers, itk::WasmZstdMeshIO::New(), outputPrefix + "-" + orderName + ".iwm.cbor.zst");
+
+        std::cout << meshName << '\t' << orderName << '\t' << metrics.averageCacheMissRatio << '\t'
+                  << metrics.averageTransformedVertexRatio << '\t' << metrics.meanPointIdentifierSpan << '\t'
+                  << cborSize << '\t' << zstSize << '\t' << cborSize / zstSize << std::endl;
+      }
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
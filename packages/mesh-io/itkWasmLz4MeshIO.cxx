@@ -0,0 +1,237 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmLz4MeshIO.h"
+#include "lz4frame.h"
+
+#include <cstring>
+
+namespace itk
+{
+
+namespace
+{
+
+bool
+fileNameIsLz4(const std::string & path)
+{
+  const std::string::size_type lz4Pos = path.rfind(".lz4");
+  return lz4Pos != std::string::npos && lz4Pos == path.length() - 4;
+}
+
+} // end anonymous namespace
+
+
+WasmLz4MeshIO
+::WasmLz4MeshIO()
+{
+  this->AddSupportedWriteExtension(".iwm.cbor.lz4");
+  this->AddSupportedReadExtension(".iwm.cbor.lz4");
+}
+
+
+WasmLz4MeshIO
+::~WasmLz4MeshIO()
+{
+}
+
+
+int
+WasmLz4MeshIO
+::Lz4MaximumCompressionLevel()
+{
+  return LZ4F_compressionLevel_max();
+}
+
+
+void
+WasmLz4MeshIO
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+}
+
+
+bool
+WasmLz4MeshIO
+::CanReadFile(const char *filename)
+{
+  std::string fname = filename;
+
+  bool extensionFound = false;
+  std::string::size_type extensionPos = fname.rfind(".iwm");
+  if ( extensionPos != std::string::npos )
+    {
+    extensionFound = true;
+    }
+
+  if ( !extensionFound )
+    {
+    itkDebugMacro(<< "The filename extension is not recognized");
+    return false;
+    }
+
+  // WasmZstdMeshIO is required
+  if ( fname.rfind(".zst") != std::string::npos )
+    {
+    return false;
+    }
+
+  return true;
+}
+
+
+void
+WasmLz4MeshIO
+::ReadMeshInformation()
+{
+  this->SetByteOrderToLittleEndian();
+
+  const std::string path = this->GetFileName();
+
+  if ( fileNameIsLz4(path) )
+  {
+    std::ifstream dataStream;
+    this->OpenFileForReading( dataStream, this->GetFileName() );
+
+    std::ostringstream ostrm;
+    ostrm << dataStream.rdbuf();
+    const auto inputBinary = ostrm.str();
+
+    LZ4F_dctx * context = nullptr;
+    LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+    const auto contextDeleter = [](LZ4F_dctx * dctx) { LZ4F_freeDecompressionContext(dctx); };
+    std::unique_ptr< LZ4F_dctx, decltype(contextDeleter) > contextGuard( context, contextDeleter );
+
+    // The content size is recorded in the frame header on write
+    LZ4F_frameInfo_t frameInfo;
+    std::memset(&frameInfo, 0, sizeof(frameInfo));
+    size_t consumed = inputBinary.size();
+    size_t result = LZ4F_getFrameInfo(context, &frameInfo, inputBinary.data(), &consumed);
+    if ( LZ4F_isError(result) )
+    {
+      itkExceptionMacro("Could not decompress " << path << ": " << LZ4F_getErrorName(result));
+    }
+    std::vector< char > decompressedBinary( frameInfo.contentSize > 0 ? frameInfo.contentSize : 4 * inputBinary.size() );
+
+    size_t decompressedSize = 0;
+    size_t inputPosition = consumed;
+    while ( result != 0 )
+    {
+      if ( decompressedSize == decompressedBinary.size() )
+      {
+        decompressedBinary.resize( 2 * decompressedBinary.size() );
+      }
+      size_t outputCapacity = decompressedBinary.size() - decompressedSize;
+      size_t inputSize = inputBinary.size() - inputPosition;
+      result = LZ4F_decompress(context, decompressedBinary.data() + decompressedSize, &outputCapacity,
+                               inputBinary.data() + inputPosition, &inputSize, nullptr);
+      if ( LZ4F_isError(result) )
+      {
+        itkExceptionMacro("Could not decompress " << path << ": " << LZ4F_getErrorName(result));
+      }
+      if ( result != 0 && inputSize == 0 && outputCapacity == 0 )
+      {
+        itkExceptionMacro("Could not decompress " << path << ": truncated input");
+      }
+      inputPosition += inputSize;
+      decompressedSize += outputCapacity;
+    }
+    decompressedBinary.resize(decompressedSize);
+
+    this->ReadCBOR(std::move(decompressedBinary));
+    return;
+  }
+
+  Superclass::ReadMeshInformation();
+}
+
+
+bool
+WasmLz4MeshIO
+::CanWriteFile(const char *name)
+{
+  std::string filename = name;
+
+  if( filename == "" )
+    {
+    return false;
+    }
+
+  bool extensionFound = false;
+  std::string::size_type iwiPos = filename.rfind(".iwm");
+  if ( iwiPos != std::string::npos )
+    {
+    extensionFound = true;
+    }
+
+  if ( !extensionFound )
+    {
+    itkDebugMacro(<< "The filename extension is not recognized");
+    return false;
+    }
+
+  // WasmZstdMeshIO is required
+  if ( filename.rfind(".zst") != std::string::npos )
+    {
+    return false;
+    }
+
+  return true;
+}
+
+
+void
+WasmLz4MeshIO
+::Write()
+{
+  const std::string path(this->GetFileName());
+
+  if ( fileNameIsLz4(path) )
+  {
+    unsigned char* cborBuffer;
+    size_t cborBufferSize;
+    size_t length = cbor_serialize_alloc(this->m_CBORRoot, &cborBuffer, &cborBufferSize);
+
+    LZ4F_preferences_t preferences;
+    std::memset(&preferences, 0, sizeof(preferences));
+    preferences.frameInfo.blockSizeID = LZ4F_max1MB;
+    preferences.frameInfo.contentSize = length;
+    preferences.compressionLevel = m_CompressionLevel;
+
+    std::vector<char> compressedBinary(LZ4F_compressFrameBound(length, &preferences));
+    const size_t compressedSize = LZ4F_compressFrame(compressedBinary.data(), compressedBinary.size(), cborBuffer, length, &preferences);
+    free(cborBuffer);
+    cbor_decref(&(this->m_CBORRoot));
+    if (LZ4F_isError(compressedSize))
+    {
+      itkExceptionMacro("Could not compress " << path << ": " << LZ4F_getErrorName(compressedSize));
+    }
+
+    std::ofstream outputStream;
+    this->OpenFileForWriting( outputStream, path.c_str(), true, false );
+    outputStream.write( compressedBinary.data(), static_cast< std::streamsize >( compressedSize ) );
+    return;
+  }
+
+  Superclass::Write();
+}
+
+} // end namespace itk
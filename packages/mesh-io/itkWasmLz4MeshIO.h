@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWasmLz4MeshIO_h
+#define itkWasmLz4MeshIO_h
+#include "WebAssemblyInterfaceExport.h"
+
+#include "itkWasmMeshIO.h"
+
+namespace itk
+{
+/** \class WasmLz4MeshIO
+ *
+ * \brief Read and write an itk::Mesh in a web-friendly format.
+ *
+ * This format is intended to facilitate data exchange in itk-wasm.
+ * It reads and writes an itk-wasm Mesh object in a CBOR file on the
+ * filesystem with JSON files and binary files for TypedArray's.
+ *
+ * This class extends WasmMeshIO by adding support for LZ4 frame
+ * compression, which decompresses faster than zstd at a lower ratio.
+ *
+ * The file extensions used are .iwm, .iwm.cbor, and .iwm.cbor.lz4.
+ *
+ * \ingroup IOFilters
+ * \ingroup WebAssemblyInterface
+ */
+class WebAssemblyInterface_EXPORT WasmLz4MeshIO: public WasmMeshIO
+{
+public:
+  /** Standard class typedefs. */
+  typedef WasmLz4MeshIO        Self;
+  typedef WasmMeshIO           Superclass;
+  typedef SmartPointer< Self > Pointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WasmLz4MeshIO, WasmMeshIO);
+
+  /** Determine the file type. Returns true if this MeshIO can read the
+   * file specified. */
+  bool CanReadFile(const char *) override;
+
+  /** Set the spacing and dimension information for the set filename. */
+  void ReadMeshInformation() override;
+
+  /** Determine the file type. Returns true if this MeshIO can write the
+   * file specified. */
+  bool CanWriteFile(const char *) override;
+
+  void Write() override;
+
+  /** LZ4 compression level, 1 by default. Levels of 3 and above use
+   * LZ4HC, which compresses slower but decompresses just as fast. */
+  itkSetClampMacro(CompressionLevel, int, 1, Lz4MaximumCompressionLevel());
+  itkGetConstMacro(CompressionLevel, int);
+
+protected:
+  WasmLz4MeshIO();
+  ~WasmLz4MeshIO() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(WasmLz4MeshIO);
+
+  static int Lz4MaximumCompressionLevel();
+
+  int m_CompressionLevel{ 1 };
+};
+} // end namespace itk
+
+#endif // itkWasmLz4MeshIO_h
@@ -17,11 +17,203 @@
  *=========================================================================*/
 
 #include "itkWasmZstdMeshIO.h"
+#include "itkWasmCBORStream.h"
+#include "itkWasmMemoryStreamBuffer.h"
+#include "itkMultiThreaderBase.h"
 #include "zstd.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string_view>
+#include <vector>
+
 namespace itk
 {
 
+namespace
+{
+
+// zstd seekable format, see contrib/seekable_format in the zstd sources
+constexpr uint32_t zstdSkippableMagicNumber = 0x184D2A5E;
+constexpr uint32_t zstdSeekableMagicNumber = 0x8F92EAB1;
+constexpr size_t   zstdSeekTableFooterSize = 9;
+constexpr uint8_t  zstdSeekTableChecksumFlag = 0x80;
+// Frame sizes are stored as 32 bit values
+constexpr SizeValueType maximumSeekableFrameSize = 0x7FFFFFFF;
+
+bool
+fileNameIsZstd(const std::string & path)
+{
+  const std::string::size_type zstdPos = path.rfind(".zst");
+  return zstdPos != std::string::npos && zstdPos == path.length() - 4;
+}
+
+void
+writeLittleEndian32(std::ostream & stream, uint32_t value)
+{
+  const char bytes[4] = { static_cast< char >(value & 0xFF), static_cast< char >((value >> 8) & 0xFF),
+                          static_cast< char >((value >> 16) & 0xFF), static_cast< char >((value >> 24) & 0xFF) };
+  stream.write(bytes, 4);
+}
+
+uint32_t
+readLittleEndian32(const char * bytes)
+{
+  const auto * data = reinterpret_cast< const unsigned char * >(bytes);
+  return static_cast< uint32_t >(data[0]) | (static_cast< uint32_t >(data[1]) << 8) |
+         (static_cast< uint32_t >(data[2]) << 16) | (static_cast< uint32_t >(data[3]) << 24);
+}
+
+// Header items written by WasmMeshIO::WriteMeshInformation
+constexpr std::string_view cborHeaderKeys[] = { "meshType", "numberOfPoints", "numberOfPointPixels",
+                                                "numberOfCells", "numberOfCellPixels", "cellBufferSize" };
+
+bool
+isCBORArrayKey(std::string_view key)
+{
+  return key == "points" || key == "cells" || key == "pointData" || key == "cellData";
+}
+
+/** Read-only std::streambuf that decompresses a zstd stream only as far as
+ * it is read. Large reads are decompressed directly into the destination.
+ * Corrupt or truncated input results in a std::runtime_error. */
+class ZstdDecompressStreamBuffer : public std::streambuf
+{
+public:
+  ZstdDecompressStreamBuffer(std::istream & source, SizeValueType & numberOfDecompressedBytes)
+    : m_Source(source)
+    , m_NumberOfDecompressedBytes(numberOfDecompressedBytes)
+    , m_InputBuffer(ZSTD_DStreamInSize())
+    , m_OutputBuffer(ZSTD_DStreamOutSize())
+  {
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data());
+  }
+
+protected:
+  int_type
+  underflow() override
+  {
+    if (this->gptr() < this->egptr())
+    {
+      return traits_type::to_int_type(*this->gptr());
+    }
+    ZSTD_outBuffer output{ m_OutputBuffer.data(), m_OutputBuffer.size(), 0 };
+    this->Decompress(output);
+    if (output.pos == 0)
+    {
+      return traits_type::eof();
+    }
+    this->setg(m_OutputBuffer.data(), m_OutputBuffer.data(), m_OutputBuffer.data() + output.pos);
+    return traits_type::to_int_type(*this->gptr());
+  }
+
+  std::streamsize
+  xsgetn(char * destination, std::streamsize count) override
+  {
+    const std::streamsize buffered = std::min< std::streamsize >(count, this->egptr() - this->gptr());
+    std::memcpy(destination, this->gptr(), buffered);
+    this->gbump(static_cast< int >(buffered));
+    if (buffered == count)
+    {
+      return count;
+    }
+    ZSTD_outBuffer output{ destination + buffered, static_cast< size_t >(count - buffered), 0 };
+    this->Decompress(output);
+    return buffered + static_cast< std::streamsize >(output.pos);
+  }
+
+private:
+  /** Decompress until the output is full or the compressed input ends. */
+  void
+  Decompress(ZSTD_outBuffer & output)
+  {
+    const size_t initialPosition = output.pos;
+    while (output.pos < output.size)
+    {
+      if (m_Input.pos == m_Input.size && !m_SourceExhausted)
+      {
+        m_Source.read(m_InputBuffer.data(), static_cast< std::streamsize >(m_InputBuffer.size()));
+        m_Input = ZSTD_inBuffer{ m_InputBuffer.data(), static_cast< size_t >(m_Source.gcount()), 0 };
+        m_SourceExhausted = m_Input.size == 0;
+      }
+      const size_t outputPosition = output.pos;
+      const size_t result = ZSTD_decompressStream(m_Context.get(), &output, &m_Input);
+      if (ZSTD_isError(result))
+      {
+        throw std::runtime_error(ZSTD_getErrorName(result));
+      }
+      // Without more input, a call after the end of the last frame expects
+      // the header of another one
+      if (m_SourceExhausted && output.pos == outputPosition)
+      {
+        if (!m_FrameComplete)
+        {
+          throw std::runtime_error("truncated input");
+        }
+        break;
+      }
+      m_FrameComplete = result == 0;
+    }
+    m_NumberOfDecompressedBytes += output.pos - initialPosition;
+  }
+
+  struct ContextDeleter
+  {
+    void
+    operator()(ZSTD_DCtx * context) const
+    {
+      ZSTD_freeDCtx(context);
+    }
+  };
+
+  std::istream &  m_Source;
+  SizeValueType & m_NumberOfDecompressedBytes;
+  std::unique_ptr< ZSTD_DCtx, ContextDeleter > m_Context{ ZSTD_createDCtx() };
+  std::vector< char > m_InputBuffer;
+  std::vector< char > m_OutputBuffer;
+  ZSTD_inBuffer   m_Input{ nullptr, 0, 0 };
+  bool            m_SourceExhausted{ false };
+  bool            m_FrameComplete{ false };
+};
+
+/** Uncompressed input of a frame to be written. */
+struct FrameSource
+{
+  const char * data;
+  size_t       size;
+};
+
+} // end anonymous namespace
+
+
+/** The compressed file and the decoder of its decompressed CBOR, with the
+ * entry of the map it is positioned at. */
+struct WasmZstdMeshIO::SingleFrameReader
+{
+  explicit SingleFrameReader(SizeValueType & numberOfDecompressedBytes)
+    : buffer(compressedStream, numberOfDecompressedBytes)
+  {
+    // Propagate the decompression errors of the buffer
+    stream.exceptions(std::ios::badbit);
+  }
+
+  std::ifstream              compressedStream;
+  ZstdDecompressStreamBuffer buffer;
+  std::istream               stream{ &buffer };
+  WasmCBORStreamReader       reader{ stream };
+  uint64_t                   remainingEntries{ 0 };
+  // Array whose head was read, followed by its payload
+  std::string                arrayKey;
+  uint64_t                   arrayLength{ 0 };
+};
+
+
 WasmZstdMeshIO
 ::WasmZstdMeshIO()
 {
@@ -36,6 +228,30 @@ WasmZstdMeshIO
 }
 
 
+int
+WasmZstdMeshIO
+::ZstdMaximumCompressionLevel()
+{
+  return ZSTD_maxCLevel();
+}
+
+
+void
+WasmZstdMeshIO
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << m_CompressionLevel << std::endl;
+  os << indent << "NumberOfWorkers: " << m_NumberOfWorkers << std::endl;
+  os << indent << "LongDistanceMatching: " << (m_LongDistanceMatching ? "On" : "Off") << std::endl;
+  os << indent << "Seekable: " << (m_Seekable ? "On" : "Off") << std::endl;
+  os << indent << "SeekableFrameSize: " << m_SeekableFrameSize << std::endl;
+  os << indent << "SeekTable frames: " << m_SeekTable.size() << std::endl;
+  os << indent << "NumberOfDecompressedFrames: " << m_NumberOfDecompressedFrames << std::endl;
+}
+
+
 bool
 WasmZstdMeshIO
 ::CanReadFile(const char *filename)
@@ -55,6 +271,12 @@ WasmZstdMeshIO
     return false;
     }
 
+  // WasmLz4MeshIO is required
+  if ( fname.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
@@ -65,31 +287,374 @@ WasmZstdMeshIO
 ::ReadMeshInformation()
 {
   this->SetByteOrderToLittleEndian();
+  m_ArrayFrames.clear();
+  m_SingleFrameReader.reset();
 
   const std::string path = this->GetFileName();
 
-  std::string::size_type zstdPos = path.rfind(".zst");
-  if ( ( zstdPos != std::string::npos )
-       && ( zstdPos == path.length() - 4 ) )
+  if ( fileNameIsZstd(path) )
+  {
+    if ( this->ReadSeekTable() )
+    {
+      this->ReadSeekableInformation();
+      return;
+    }
+
+    this->ReadSingleFrameInformation();
+    return;
+  }
+
+  Superclass::ReadMeshInformation();
+}
+
+
+bool
+WasmZstdMeshIO
+::ReadSeekTable()
+{
+  m_SeekTable.clear();
+
+  std::ifstream inputStream;
+  this->OpenFileForReading( inputStream, this->GetFileName() );
+  inputStream.seekg( 0, std::ios::end );
+  const auto fileSize = static_cast< uint64_t >( inputStream.tellg() );
+  if ( fileSize < zstdSeekTableFooterSize + 8 )
+  {
+    return false;
+  }
+
+  char footer[zstdSeekTableFooterSize];
+  inputStream.seekg( fileSize - zstdSeekTableFooterSize );
+  inputStream.read( footer, zstdSeekTableFooterSize );
+  if ( !inputStream || readLittleEndian32( footer + 5 ) != zstdSeekableMagicNumber )
+  {
+    return false;
+  }
+  const uint32_t numberOfFrames = readLittleEndian32( footer );
+  const uint64_t entrySize = ( footer[4] & zstdSeekTableChecksumFlag ) ? 12 : 8;
+  const uint64_t tableSize = numberOfFrames * entrySize + zstdSeekTableFooterSize;
+  if ( numberOfFrames == 0 || fileSize < tableSize + 8 )
+  {
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  std::vector< char > table( tableSize + 8 );
+  inputStream.seekg( fileSize - table.size() );
+  inputStream.read( table.data(), table.size() );
+  if ( !inputStream || readLittleEndian32( table.data() ) != zstdSkippableMagicNumber ||
+       readLittleEndian32( table.data() + 4 ) != tableSize )
+  {
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
+
+  m_SeekTable.resize( numberOfFrames );
+  uint64_t compressedOffset = 0;
+  for ( uint32_t ii = 0; ii < numberOfFrames; ++ii )
+  {
+    const char * entry = table.data() + 8 + ii * entrySize;
+    SeekTableFrame & frame = m_SeekTable[ii];
+    frame.compressedOffset = compressedOffset;
+    frame.compressedSize = readLittleEndian32( entry );
+    frame.decompressedSize = readLittleEndian32( entry + 4 );
+    compressedOffset += frame.compressedSize;
+  }
+  if ( compressedOffset + table.size() != fileSize )
+  {
+    m_SeekTable.clear();
+    itkExceptionMacro("Invalid zstd seek table in " << this->GetFileName());
+  }
+  return true;
+}
+
+
+void
+WasmZstdMeshIO
+::ReadSeekableInformation()
+{
+  // The first frame holds the map head and the header items. Each array
+  // follows as a small frame with its key and bytestring head, then the
+  // frames of its payload. Only the small frames are decompressed here.
+  std::ifstream compressedStream;
+  this->OpenFileForReading( compressedStream, this->GetFileName() );
+  const auto contextDeleter = [](ZSTD_DCtx * context) { ZSTD_freeDCtx(context); };
+  std::unique_ptr< ZSTD_DCtx, decltype(contextDeleter) > context( ZSTD_createDCtx(), contextDeleter );
+  std::vector< char > compressed;
+  const auto decompressFrame = [&](size_t frameIndex) {
+    const SeekTableFrame & frame = m_SeekTable[frameIndex];
+    compressed.resize( frame.compressedSize );
+    compressedStream.seekg( frame.compressedOffset );
+    compressedStream.read( compressed.data(), compressed.size() );
+    if ( !compressedStream )
+    {
+      itkExceptionMacro("Could not read a zstd frame from " << this->GetFileName());
+    }
+    std::vector< char > decompressed( frame.decompressedSize );
+    const size_t result = ZSTD_decompressDCtx( context.get(), decompressed.data(), decompressed.size(),
+                                               compressed.data(), compressed.size() );
+    if ( ZSTD_isError( result ) || result != frame.decompressedSize )
+    {
+      itkExceptionMacro("Could not decompress a zstd frame from " << this->GetFileName());
+    }
+    ++m_NumberOfDecompressedFrames;
+    m_NumberOfDecompressedBytes += decompressed.size();
+    return decompressed;
+  };
+
+  try
+  {
+    const std::vector< char > header = decompressFrame( 0 );
+    WasmMemoryInputStream headerStream( header.data(), header.size() );
+    WasmCBORStreamReader headerReader( headerStream );
+    const uint64_t indexCount = headerReader.ReadMapHead();
+    uint64_t numberOfHeaderItems = 0;
+    while ( headerStream.peek() != std::char_traits< char >::eof() )
+    {
+      const std::string key = headerReader.ReadString();
+      const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+      std::unique_ptr< cbor_item_t, decltype(itemDeleter) > valueItem(headerReader.ReadItem(), itemDeleter);
+      this->ReadCBORHeaderItem( key, valueItem.get() );
+      ++numberOfHeaderItems;
+    }
+
+    size_t frameIndex = 1;
+    while ( frameIndex < m_SeekTable.size() )
+    {
+      const std::vector< char > arrayHead = decompressFrame( frameIndex );
+      WasmMemoryInputStream arrayHeadStream( arrayHead.data(), arrayHead.size() );
+      WasmCBORStreamReader arrayHeadReader( arrayHeadStream );
+      const std::string key = arrayHeadReader.ReadString();
+      ArrayFrames & arrayFrames = m_ArrayFrames[key];
+      arrayFrames.length = arrayHeadReader.ReadByteStringHead();
+      arrayFrames.firstFrame = ++frameIndex;
+      uint64_t payloadSize = 0;
+      while ( payloadSize < arrayFrames.length && frameIndex < m_SeekTable.size() )
+      {
+        payloadSize += m_SeekTable[frameIndex].decompressedSize;
+        ++frameIndex;
+      }
+      arrayFrames.numberOfFrames = frameIndex - arrayFrames.firstFrame;
+      if ( payloadSize != arrayFrames.length )
+      {
+        itkExceptionMacro("The zstd frames of " << key << " in " << this->GetFileName() << " do not match its length");
+      }
+    }
+    if ( numberOfHeaderItems + m_ArrayFrames.size() != indexCount )
+    {
+      itkExceptionMacro("Unexpected number of entries in " << this->GetFileName());
+    }
+  }
+  catch (const std::runtime_error & error)
   {
-    std::ifstream dataStream;
-    this->OpenFileForReading( dataStream, this->GetFileName() );
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+}
 
-    std::ostringstream ostrm;
-    ostrm << dataStream.rdbuf();
-    auto inputBinary = ostrm.str();
 
-    const size_t decompressedBufferSize = ZSTD_getFrameContentSize(inputBinary.data(), inputBinary.size());
-    std::vector<char> decompressedBinary(decompressedBufferSize);
+void
+WasmZstdMeshIO
+::OpenSingleFrame()
+{
+  m_SingleFrameReader = std::make_unique< SingleFrameReader >( m_NumberOfDecompressedBytes );
+  this->OpenFileForReading( m_SingleFrameReader->compressedStream, this->GetFileName() );
+  m_SingleFrameReader->remainingEntries = m_SingleFrameReader->reader.ReadMapHead();
+  ++m_NumberOfDecompressedFrames;
+}
 
-    const size_t decompressedSize = ZSTD_decompress(decompressedBinary.data(), decompressedBufferSize, inputBinary.data(), inputBinary.size());
-    decompressedBinary.resize(decompressedSize);
 
-    this->ReadCBOR(nullptr, reinterpret_cast< unsigned char *>(&(decompressedBinary.at(0))), decompressedSize);
+void
+WasmZstdMeshIO
+::ReadSingleFrameInformation()
+{
+  // WasmMeshIO writes the header items before the arrays, so decompression
+  // stops at the head of the first array. Arrays that precede a header
+  // item are skipped.
+  try
+  {
+    this->OpenSingleFrame();
+    SingleFrameReader & singleFrame = *m_SingleFrameReader;
+    size_t numberOfHeaderItems = 0;
+    while ( singleFrame.remainingEntries > 0 &&
+            ( singleFrame.arrayKey.empty() || numberOfHeaderItems < std::size(cborHeaderKeys) ) )
+    {
+      if ( !singleFrame.arrayKey.empty() )
+      {
+        singleFrame.reader.SkipBytes( singleFrame.arrayLength );
+        singleFrame.arrayKey.clear();
+      }
+      std::string key = singleFrame.reader.ReadString();
+      --singleFrame.remainingEntries;
+      if ( isCBORArrayKey(key) )
+      {
+        singleFrame.arrayLength = singleFrame.reader.ReadByteStringHead();
+        singleFrame.arrayKey = std::move(key);
+        continue;
+      }
+
+      const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+      std::unique_ptr< cbor_item_t, decltype(itemDeleter) > valueItem(singleFrame.reader.ReadItem(), itemDeleter);
+      this->ReadCBORHeaderItem( key, valueItem.get() );
+      if ( std::find( std::begin(cborHeaderKeys), std::end(cborHeaderKeys), key ) != std::end(cborHeaderKeys) )
+      {
+        ++numberOfHeaderItems;
+      }
+    }
+  }
+  catch (const std::runtime_error & error)
+  {
+    m_SingleFrameReader.reset();
+    itkExceptionMacro("Could not decompress " << this->GetFileName() << ": " << error.what());
+  }
+}
+
+
+void
+WasmZstdMeshIO
+::SeekSingleFrameArray(std::string_view dataName)
+{
+  // Arrays are usually read in the order they were written, which
+  // decompresses the file once. Otherwise decompression restarts from the
+  // beginning of the file.
+  bool reopened = false;
+  while ( m_SingleFrameReader->arrayKey != dataName )
+  {
+    SingleFrameReader & singleFrame = *m_SingleFrameReader;
+    if ( !singleFrame.arrayKey.empty() )
+    {
+      singleFrame.reader.SkipBytes( singleFrame.arrayLength );
+      singleFrame.arrayKey.clear();
+    }
+    if ( singleFrame.remainingEntries == 0 )
+    {
+      if ( reopened )
+      {
+        itkExceptionMacro("No " << dataName << " in " << this->GetFileName());
+      }
+      this->OpenSingleFrame();
+      reopened = true;
+      continue;
+    }
+
+    std::string key = singleFrame.reader.ReadString();
+    --singleFrame.remainingEntries;
+    if ( isCBORArrayKey(key) )
+    {
+      singleFrame.arrayLength = singleFrame.reader.ReadByteStringHead();
+      singleFrame.arrayKey = std::move(key);
+    }
+    else
+    {
+      // Header items were read with the information
+      singleFrame.reader.SkipItem();
+    }
+  }
+}
+
+
+void
+WasmZstdMeshIO
+::ReadCBORData(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead)
+{
+  if ( m_ArrayFrames.empty() && !m_SingleFrameReader )
+  {
+    Superclass::ReadCBORData(dataName, buffer, numberOfBytesToBeRead);
+    return;
+  }
+  if ( numberOfBytesToBeRead == 0 )
+  {
     return;
   }
 
-  Superclass::ReadMeshInformation();
+  if ( m_SingleFrameReader )
+  {
+    try
+    {
+      this->SeekSingleFrameArray( dataName );
+      SingleFrameReader & singleFrame = *m_SingleFrameReader;
+      if ( singleFrame.arrayLength < numberOfBytesToBeRead )
+      {
+        itkExceptionMacro("Read failed: Wanted " << numberOfBytesToBeRead << " bytes of " << dataName
+                          << ", but the file has " << singleFrame.arrayLength << " bytes.");
+      }
+      // The payload is decompressed directly into the caller's buffer
+      singleFrame.reader.ReadBytes( buffer, numberOfBytesToBeRead );
+      singleFrame.reader.SkipBytes( singleFrame.arrayLength - numberOfBytesToBeRead );
+      singleFrame.arrayKey.clear();
+    }
+    catch (const std::runtime_error & error)
+    {
+      m_SingleFrameReader.reset();
+      itkExceptionMacro("Could not decompress " << dataName << " from " << this->GetFileName() << ": " << error.what());
+    }
+    return;
+  }
+
+  const auto arrayFramesIt = m_ArrayFrames.find( dataName );
+  if ( arrayFramesIt == m_ArrayFrames.end() )
+  {
+    itkExceptionMacro("No " << dataName << " in " << this->GetFileName() << ", or its information was not read");
+  }
+  const ArrayFrames & arrayFrames = arrayFramesIt->second;
+  if ( arrayFrames.length < numberOfBytesToBeRead )
+  {
+    itkExceptionMacro("Read failed: Wanted " << numberOfBytesToBeRead << " bytes of " << dataName
+                      << ", but the file has " << arrayFrames.length << " bytes.");
+  }
+
+  // The payload frames are contiguous: read them with a single read
+  const SeekTableFrame & firstFrame = m_SeekTable[arrayFrames.firstFrame];
+  const SeekTableFrame & lastFrame = m_SeekTable[arrayFrames.firstFrame + arrayFrames.numberOfFrames - 1];
+  std::vector< char > compressed( lastFrame.compressedOffset + lastFrame.compressedSize - firstFrame.compressedOffset );
+  std::ifstream compressedStream;
+  this->OpenFileForReading( compressedStream, this->GetFileName() );
+  compressedStream.seekg( firstFrame.compressedOffset );
+  compressedStream.read( compressed.data(), compressed.size() );
+  if ( !compressedStream )
+  {
+    itkExceptionMacro("Could not read the zstd frames of " << dataName << " from " << this->GetFileName());
+  }
+
+  // Frames are decompressed in parallel, directly into the caller's buffer
+  // unless only part of the payload is requested
+  std::vector< char > payload;
+  char * destination = static_cast< char * >( buffer );
+  if ( numberOfBytesToBeRead < arrayFrames.length )
+  {
+    payload.resize( arrayFrames.length );
+    destination = payload.data();
+  }
+  std::vector< uint64_t > decompressedOffsets( arrayFrames.numberOfFrames );
+  uint64_t decompressedOffset = 0;
+  for ( size_t ii = 0; ii < arrayFrames.numberOfFrames; ++ii )
+  {
+    decompressedOffsets[ii] = decompressedOffset;
+    decompressedOffset += m_SeekTable[arrayFrames.firstFrame + ii].decompressedSize;
+  }
+  std::vector< size_t > results( arrayFrames.numberOfFrames );
+  MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+  multiThreader->ParallelizeArray(
+    0,
+    arrayFrames.numberOfFrames,
+    [&](SizeValueType ii) {
+      const SeekTableFrame & frame = m_SeekTable[arrayFrames.firstFrame + ii];
+      results[ii] = ZSTD_decompress( destination + decompressedOffsets[ii], frame.decompressedSize,
+                                     compressed.data() + ( frame.compressedOffset - firstFrame.compressedOffset ),
+                                     frame.compressedSize );
+    },
+    nullptr);
+  for ( size_t ii = 0; ii < arrayFrames.numberOfFrames; ++ii )
+  {
+    if ( ZSTD_isError( results[ii] ) || results[ii] != m_SeekTable[arrayFrames.firstFrame + ii].decompressedSize )
+    {
+      itkExceptionMacro("Could not decompress the zstd frames of " << dataName << " from " << this->GetFileName());
+    }
+  }
+  m_NumberOfDecompressedFrames += arrayFrames.numberOfFrames;
+  m_NumberOfDecompressedBytes += arrayFrames.length;
+
+  if ( destination != buffer )
+  {
+    std::memcpy( buffer, destination, numberOfBytesToBeRead );
+  }
 }
 
 
@@ -117,6 +682,12 @@ WasmZstdMeshIO
     return false;
     }
 
+  // WasmLz4MeshIO is required
+  if ( filename.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
@@ -127,9 +698,122 @@ WasmZstdMeshIO
 {
   const std::string path(this->GetFileName());
 
-  std::string::size_type cborPos = path.rfind(".zst");
-  if ( ( cborPos != std::string::npos )
-       && ( cborPos == path.length() - 4 ) )
+  if ( fileNameIsZstd(path) && m_Seekable )
+  {
+    // The item tree is released however the write ends
+    const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+    std::unique_ptr< cbor_item_t, decltype(itemDeleter) > root(this->m_CBORRoot, itemDeleter);
+    this->m_CBORRoot = nullptr;
+
+    // Encode the header items and the head of each array, pointing at the
+    // payloads held by the CBOR item tree rather than serializing it
+    const size_t indexCount = cbor_map_size(root.get());
+    const struct cbor_pair * indexHandle = cbor_map_handle(root.get());
+    std::ostringstream headerStream;
+    WasmCBORStreamWriter headerWriter(headerStream);
+    std::vector< std::string > arrayHeads;
+    std::vector< FrameSource > arrayPayloads;
+    try
+    {
+      headerWriter.WriteMapHead(indexCount);
+      for (size_t ii = 0; ii < indexCount; ++ii)
+      {
+        const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
+        const cbor_item_t * value = indexHandle[ii].value;
+        if ( key == "points" || key == "cells" || key == "pointData" || key == "cellData" )
+        {
+          cbor_item_t * dataItem = cbor_tag_item(value);
+          const FrameSource payload{ reinterpret_cast< const char * >(cbor_bytestring_handle(dataItem)),
+                                     cbor_bytestring_length(dataItem) };
+          cbor_decref(&dataItem);
+          std::ostringstream arrayHeadStream;
+          WasmCBORStreamWriter arrayHeadWriter(arrayHeadStream);
+          arrayHeadWriter.WriteString(key);
+          arrayHeadWriter.WriteTag(cbor_tag_value(value));
+          arrayHeadWriter.WriteByteStringHead(payload.size);
+          arrayHeads.push_back(arrayHeadStream.str());
+          arrayPayloads.push_back(payload);
+        }
+        else
+        {
+          headerWriter.WriteString(key);
+          headerWriter.WriteItem(value);
+        }
+      }
+    }
+    catch (const std::runtime_error & error)
+    {
+      itkExceptionMacro("Could not write " << path << ": " << error.what());
+    }
+    const std::string header = headerStream.str();
+
+    // Frames in file order: header, then the head and payload chunks of
+    // each array
+    const SizeValueType frameSize = std::max< SizeValueType >(std::min(m_SeekableFrameSize, maximumSeekableFrameSize), 1);
+    std::vector< FrameSource > frames;
+    frames.push_back(FrameSource{ header.data(), header.size() });
+    for (size_t ii = 0; ii < arrayHeads.size(); ++ii)
+    {
+      frames.push_back(FrameSource{ arrayHeads[ii].data(), arrayHeads[ii].size() });
+      const FrameSource & payload = arrayPayloads[ii];
+      for (size_t offset = 0; offset < payload.size; offset += frameSize)
+      {
+        frames.push_back(FrameSource{ payload.data + offset, std::min< size_t >(frameSize, payload.size - offset) });
+      }
+    }
+
+    std::vector< std::vector< char > > compressedFrames(frames.size());
+    std::vector< size_t > results(frames.size());
+    MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+    multiThreader->ParallelizeArray(
+      0,
+      frames.size(),
+      [&](SizeValueType ii) {
+        ZSTD_CCtx * context = ZSTD_createCCtx();
+        ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, m_CompressionLevel);
+        // The frames are already compressed in parallel; zstd workers
+        // would oversubscribe the threads of the pool
+        ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, 0);
+        ZSTD_CCtx_setParameter(context, ZSTD_c_enableLongDistanceMatching, m_LongDistanceMatching ? 1 : 0);
+        compressedFrames[ii].resize(ZSTD_compressBound(frames[ii].size));
+        results[ii] = ZSTD_compress2(context, compressedFrames[ii].data(), compressedFrames[ii].size(),
+                                     frames[ii].data, frames[ii].size);
+        ZSTD_freeCCtx(context);
+      },
+      nullptr);
+    // Only the frame sizes are used from here
+    root.reset();
+
+    std::ofstream outputStream;
+    this->OpenFileForWriting( outputStream, path.c_str(), true, false );
+    constexpr uint32_t entrySize = 8;
+    for (size_t ii = 0; ii < frames.size(); ++ii)
+    {
+      if (ZSTD_isError(results[ii]))
+      {
+        itkExceptionMacro("Could not compress " << path << ": " << ZSTD_getErrorName(results[ii]));
+      }
+      outputStream.write(compressedFrames[ii].data(), static_cast< std::streamsize >(results[ii]));
+    }
+    writeLittleEndian32(outputStream, zstdSkippableMagicNumber);
+    writeLittleEndian32(outputStream, static_cast< uint32_t >(frames.size() * entrySize + zstdSeekTableFooterSize));
+    for (size_t ii = 0; ii < frames.size(); ++ii)
+    {
+      writeLittleEndian32(outputStream, static_cast< uint32_t >(results[ii]));
+      writeLittleEndian32(outputStream, static_cast< uint32_t >(frames[ii].size));
+    }
+    writeLittleEndian32(outputStream, static_cast< uint32_t >(frames.size()));
+    const char descriptor = 0;
+    outputStream.write(&descriptor, 1);
+    writeLittleEndian32(outputStream, zstdSeekableMagicNumber);
+    if ( !outputStream )
+    {
+      itkExceptionMacro("Could not write " << path);
+    }
+    return;
+  }
+
+  if ( fileNameIsZstd(path) )
   {
     unsigned char* cborBuffer;
     size_t cborBufferSize;
@@ -138,10 +822,20 @@ WasmZstdMeshIO
     const size_t compressedBufferSize = ZSTD_compressBound(cborBufferSize);
     std::vector<char> compressedBinary(compressedBufferSize);
 
-    constexpr int compressionLevel = 3;
-    const size_t compressedSize = ZSTD_compress(compressedBinary.data(), compressedBufferSize, cborBuffer, cborBufferSize, compressionLevel);
+    ZSTD_CCtx * context = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, m_CompressionLevel);
+    // Fails without multithreading support, which leaves compression on
+    // the calling thread
+    ZSTD_CCtx_setParameter(context, ZSTD_c_nbWorkers, static_cast< int >(m_NumberOfWorkers));
+    ZSTD_CCtx_setParameter(context, ZSTD_c_enableLongDistanceMatching, m_LongDistanceMatching ? 1 : 0);
+    const size_t compressedSize = ZSTD_compress2(context, compressedBinary.data(), compressedBufferSize, cborBuffer, cborBufferSize);
+    ZSTD_freeCCtx(context);
     free(cborBuffer);
     cbor_decref(&(this->m_CBORRoot));
+    if (ZSTD_isError(compressedSize))
+    {
+      itkExceptionMacro("Could not compress " << path << ": " << ZSTD_getErrorName(compressedSize));
+    }
 
     compressedBinary.resize(compressedSize);
 
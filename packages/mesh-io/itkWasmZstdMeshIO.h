@@ -21,6 +21,12 @@
 
 #include "itkWasmMeshIO.h"
 
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <vector>
+
 namespace itk
 {
 /** \class WasmZstdMeshIO
@@ -34,6 +40,19 @@ namespace itk
  * This class extends WasmMeshIO by adding support for zstandard compression.
  *
  * The file extensions used are .iwm, .iwm.cbor, and .iwm.cbor.zst.
+ *
+ * Native builds can compress with worker threads, see SetNumberOfWorkers().
+ *
+ * By default .iwm.cbor.zst is written as a single zstd frame. It is
+ * decompressed incrementally as it is read, so the arrays after the last
+ * one read, e.g. the point data of a geometry-only read, are not
+ * decompressed. With
+ * SeekableOn() it is written in the zstd seekable format. The header, the head of each array and chunks of each array's payload are
+ * independently compressed frames, indexed by a seek table in a skippable
+ * frame. Frames are compressed and decompressed in parallel, and only the
+ * frames of the arrays that are read are decompressed, directly into the
+ * caller's buffer. The file remains a valid zstd stream of the .iwm.cbor
+ * encoding for any decoder.
  * 
  * \ingroup IOFilters
  * \ingroup WebAssemblyInterface
@@ -65,12 +84,99 @@ public:
 
   void Write() override;
 
+  /** Write .iwm.cbor.zst in the seekable format. Off by default, which
+   * writes a single frame, readable by older versions. */
+  itkSetMacro(Seekable, bool);
+  itkGetConstMacro(Seekable, bool);
+  itkBooleanMacro(Seekable);
+
+  /** Target uncompressed size, in bytes, of the payload frames of a
+   * seekable file. 4 MiB by default. */
+  itkSetMacro(SeekableFrameSize, SizeValueType);
+  itkGetConstMacro(SeekableFrameSize, SizeValueType);
+
+  /** Number of zstd frames decompressed by this object, to verify that
+   * arrays that are not read are skipped. */
+  itkGetConstMacro(NumberOfDecompressedFrames, SizeValueType);
+
+  /** Number of bytes decompressed by this object. */
+  itkGetConstMacro(NumberOfDecompressedBytes, SizeValueType);
+
+  /** zstd compression level, 3 by default. */
+  itkSetClampMacro(CompressionLevel, int, 1, ZstdMaximumCompressionLevel());
+  itkGetConstMacro(CompressionLevel, int);
+
+  /** Number of zstd worker threads used for compression. Zero, the
+   * default, compresses on the calling thread. Ignored when zstd was built
+   * without multithreading support, e.g. for WebAssembly, and for seekable
+   * files, whose frames are already compressed in parallel. */
+  itkSetMacro(NumberOfWorkers, unsigned int);
+  itkGetConstMacro(NumberOfWorkers, unsigned int);
+
+  /** Enable zstd long distance matching. Off by default. */
+  itkSetMacro(LongDistanceMatching, bool);
+  itkGetConstMacro(LongDistanceMatching, bool);
+  itkBooleanMacro(LongDistanceMatching);
+
 protected:
   WasmZstdMeshIO();
   ~WasmZstdMeshIO() override;
+  void PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Decompress only the frames of the requested array of a seekable
+   * file, or a single frame file up to the end of the requested array. */
+  void ReadCBORData(const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead) override;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(WasmZstdMeshIO);
+
+  static int ZstdMaximumCompressionLevel();
+
+  /** Read the seek table of the current file. Returns false if it has
+   * none. */
+  bool ReadSeekTable();
+
+  /** Index the header and array frames of a seekable file. */
+  void ReadSeekableInformation();
+
+  /** Decompress a single frame file up to its first array. */
+  void ReadSingleFrameInformation();
+
+  /** Start decompressing the single frame file from its beginning. */
+  void OpenSingleFrame();
+
+  /** Decompress the single frame file up to the payload of dataName. */
+  void SeekSingleFrameArray(std::string_view dataName);
+
+  /** Incremental decompression of a single frame file, defined with the
+   * implementation. */
+  struct SingleFrameReader;
+  std::unique_ptr< SingleFrameReader > m_SingleFrameReader;
+
+  struct SeekTableFrame
+  {
+    uint64_t compressedOffset;
+    uint64_t compressedSize;
+    uint64_t decompressedSize;
+  };
+  std::vector< SeekTableFrame > m_SeekTable;
+
+  /** Payload frames of an array in a seekable file. */
+  struct ArrayFrames
+  {
+    size_t   firstFrame{ 0 };
+    size_t   numberOfFrames{ 0 };
+    uint64_t length{ 0 };
+  };
+  std::map< std::string, ArrayFrames, std::less<> > m_ArrayFrames;
+
+  int           m_CompressionLevel{ 3 };
+  unsigned int  m_NumberOfWorkers{ 0 };
+  bool          m_LongDistanceMatching{ false };
+  bool          m_Seekable{ false };
+  SizeValueType m_SeekableFrameSize{ 4 * 1024 * 1024 };
+  SizeValueType m_NumberOfDecompressedFrames{ 0 };
+  SizeValueType m_NumberOfDecompressedBytes{ 0 };
 };
 } // end namespace itk
 
@@ -23,5 +23,7 @@ from .wasm_read_mesh_async import wasm_read_mesh_async
 from .wasm_write_mesh_async import wasm_write_mesh_async
 from .wasm_zstd_read_mesh_async import wasm_zstd_read_mesh_async
 from .wasm_zstd_write_mesh_async import wasm_zstd_write_mesh_async
+from .wasm_lz4_read_mesh_async import wasm_lz4_read_mesh_async
+from .wasm_lz4_write_mesh_async import wasm_lz4_write_mesh_async
 
 from ._version import __version__
@@ -12,5 +12,6 @@ extension_to_mesh_io = OrderedDict([
     ('.iwm', 'wasm'),
     ('.iwm.cbor', 'wasm'),
     ('.iwm.cbor.zst', 'wasmZstd'),
+    ('.iwm.cbor.lz4', 'wasmLz4'),
     ('.bmp', 'bmp'),
 ])
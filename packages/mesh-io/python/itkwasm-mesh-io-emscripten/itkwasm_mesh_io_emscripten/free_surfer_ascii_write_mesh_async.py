@@ -23,6 +23,11 @@ async def free_surfer_ascii_write_mesh_async(
     information_only: bool = False,
     use_compression: bool = False,
     binary_file_type: bool = False,
+    compression_level: int = -1,
+    number_of_workers: int = 0,
+    long_distance_matching: bool = False,
+    seekable: bool = False,
+    optimize_locality: bool = False,
 ) -> Tuple[Any]:
     """Write an itk-wasm file format converted to an mesh file format
 
@@ -41,6 +46,21 @@ async def free_surfer_ascii_write_mesh_async(
     :param binary_file_type: Use a binary file type in the written file, if supported
     :type  binary_file_type: bool
 
+    :param compression_level: Compression level, if supported. Defaults to the level of the file format.
+    :type  compression_level: int
+
+    :param number_of_workers: Number of compression worker threads, if supported. 0 compresses on the calling thread.
+    :type  number_of_workers: int
+
+    :param long_distance_matching: Use long distance matching for compression, if supported
+    :type  long_distance_matching: bool
+
+    :param seekable: Write frames with a seek table so that arrays can be read without decompressing the whole file, if supported
+    :type  seekable: bool
+
+    :param optimize_locality: Reorder cells for vertex cache efficiency and number points in first use order before writing
+    :type  optimize_locality: bool
+
     :return: Whether the input could be written. If false, the output mesh is not valid.
     :rtype:  Any
     """
@@ -54,6 +74,16 @@ async def free_surfer_ascii_write_mesh_async(
         kwargs["useCompression"] = to_js(use_compression)
     if binary_file_type:
         kwargs["binaryFileType"] = to_js(binary_file_type)
+    if compression_level:
+        kwargs["compressionLevel"] = to_js(compression_level)
+    if number_of_workers:
+        kwargs["numberOfWorkers"] = to_js(number_of_workers)
+    if long_distance_matching:
+        kwargs["longDistanceMatching"] = to_js(long_distance_matching)
+    if seekable:
+        kwargs["seekable"] = to_js(seekable)
+    if optimize_locality:
+        kwargs["optimizeLocality"] = to_js(optimize_locality)
 
     outputs = await js_module.freeSurferAsciiWriteMesh(to_js(mesh), to_js(serialized_mesh), webWorker=web_worker, noCopy=True, **kwargs)
 
@@ -1,13 +1,14 @@
 mesh_io_index = [
-    'vtk_poly_data',
+    'vtkPolyData',
     'byu',
-    'free_surfer_ascii',
-    'free_surfer_binary',
+    'freeSurferAscii',
+    'freeSurferBinary',
     'obj',
     'off',
     'stl',
     'swc',
     'wasm',
-    'wasm_zstd',
+    'wasmZstd',
+    'wasmLz4',
 ]
 
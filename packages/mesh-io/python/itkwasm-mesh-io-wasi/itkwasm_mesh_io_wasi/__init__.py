@@ -23,5 +23,7 @@ from .wasm_read_mesh import wasm_read_mesh
 from .wasm_write_mesh import wasm_write_mesh
 from .wasm_zstd_read_mesh import wasm_zstd_read_mesh
 from .wasm_zstd_write_mesh import wasm_zstd_write_mesh
+from .wasm_lz4_read_mesh import wasm_lz4_read_mesh
+from .wasm_lz4_write_mesh import wasm_lz4_write_mesh
 
 from ._version import __version__
@@ -12,5 +12,6 @@ extension_to_mesh_io = OrderedDict([
     ('.iwm', 'wasm'),
     ('.iwm.cbor', 'wasm'),
     ('.iwm.cbor.zst', 'wasm_zstd'),
+    ('.iwm.cbor.lz4', 'wasm_lz4'),
     ('.bmp', 'bmp'),
 ])
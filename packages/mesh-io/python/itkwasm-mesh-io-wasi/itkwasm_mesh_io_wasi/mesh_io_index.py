@@ -9,5 +9,6 @@ mesh_io_index = [
   'swc',
   'wasm',
   'wasm_zstd',
+  'wasm_lz4',
 ]
 
@@ -38,6 +38,18 @@ def test_write_mesh():
     mesh = read_mesh(test_output_file_path)
     verify_mesh(mesh)
 
+def test_write_mesh_compressed():
+    mesh = read_mesh(test_input_file_path)
+
+    for extension in [".iwm.cbor.zst", ".iwm.cbor.lz4"]:
+        output_file_path = test_output_path / f"read-write-cow{extension}"
+        write_mesh(mesh, output_file_path)
+
+        mesh_back = read_mesh(output_file_path)
+        verify_mesh(mesh_back)
+        assert np.array_equal(mesh_back.points, mesh.points)
+        assert np.array_equal(mesh_back.cells, mesh.cells)
+
 def test_meshwrite():
     mesh = meshread(test_input_file_path)
 
@@ -0,0 +1,8 @@
+# Generated file. To retain edits, remove this comment.
+
+from itkwasm_mesh_io_wasi import wasm_lz4_write_mesh
+
+from .common import test_input_path, test_output_path
+
+def test_wasm_lz4_write_mesh():
+    pass
@@ -45,5 +45,9 @@ from .wasm_zstd_read_mesh_async import wasm_zstd_read_mesh_async
 from .wasm_zstd_read_mesh import wasm_zstd_read_mesh
 from .wasm_zstd_write_mesh_async import wasm_zstd_write_mesh_async
 from .wasm_zstd_write_mesh import wasm_zstd_write_mesh
+from .wasm_lz4_read_mesh_async import wasm_lz4_read_mesh_async
+from .wasm_lz4_read_mesh import wasm_lz4_read_mesh
+from .wasm_lz4_write_mesh_async import wasm_lz4_write_mesh_async
+from .wasm_lz4_write_mesh import wasm_lz4_write_mesh
 
 from ._version import __version__
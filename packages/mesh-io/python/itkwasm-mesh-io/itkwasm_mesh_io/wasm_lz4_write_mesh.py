@@ -0,0 +1,61 @@
+# Generated file. Do not edit.
+
+import os
+from typing import Dict, Tuple, Optional, List, Any
+
+from itkwasm import (
+    environment_dispatch,
+    Mesh,
+    BinaryFile,
+)
+
+def wasm_lz4_write_mesh(
+    mesh: Mesh,
+    serialized_mesh: str,
+    information_only: bool = False,
+    use_compression: bool = False,
+    binary_file_type: bool = False,
+    compression_level: int = -1,
+    number_of_workers: int = 0,
+    long_distance_matching: bool = False,
+    seekable: bool = False,
+    optimize_locality: bool = False,
+) -> Tuple[Any]:
+    """Write an itk-wasm file format converted to an mesh file format
+
+    :param mesh: Input mesh
+    :type  mesh: Mesh
+
+    :param serialized_mesh: Output mesh
+    :type  serialized_mesh: str
+
+    :param information_only: Only write image metadata -- do not write pixel data.
+    :type  information_only: bool
+
+    :param use_compression: Use compression in the written file, if supported
+    :type  use_compression: bool
+
+    :param binary_file_type: Use a binary file type in the written file, if supported
+    :type  binary_file_type: bool
+
+    :param compression_level: Compression level, if supported. Defaults to the level of the file format.
+    :type  compression_level: int
+
+    :param number_of_workers: Number of compression worker threads, if supported. 0 compresses on the calling thread.
+    :type  number_of_workers: int
+
+    :param long_distance_matching: Use long distance matching for compression, if supported
+    :type  long_distance_matching: bool
+
+    :param seekable: Write frames with a seek table so that arrays can be read without decompressing the whole file, if supported
+    :type  seekable: bool
+
+    :param optimize_locality: Reorder cells for vertex cache efficiency and number points in first use order before writing
+    :type  optimize_locality: bool
+
+    :return: Whether the input could be written. If false, the output mesh is not valid.
+    :rtype:  Any
+    """
+    func = environment_dispatch("itkwasm_mesh_io", "wasm_lz4_write_mesh")
+    output = func(mesh, serialized_mesh, information_only=information_only, use_compression=use_compression, binary_file_type=binary_file_type, compression_level=compression_level, number_of_workers=number_of_workers, long_distance_matching=long_distance_matching, seekable=seekable, optimize_locality=optimize_locality)
+    return output
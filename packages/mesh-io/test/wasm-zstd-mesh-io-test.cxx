@@ -0,0 +1,242 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmZstdMeshIO.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkTriangleCell.h"
+#include "zstd.h"
+
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int
+main(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output.iwm.cbor.zst>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * meshFile = argv[1];
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = float;
+  using MeshType = itk::Mesh<PixelType, Dimension>;
+  using CellType = MeshType::CellType;
+  using TriangleType = itk::TriangleCell<CellType>;
+
+  // Large enough that the point data spans more than one zstd block
+  constexpr unsigned int gridSize = 256;
+  auto mesh = MeshType::New();
+  for (unsigned int jj = 0; jj < gridSize; ++jj)
+  {
+    for (unsigned int ii = 0; ii < gridSize; ++ii)
+    {
+      const MeshType::PointIdentifier pointId = jj * gridSize + ii;
+      MeshType::PointType point;
+      point[0] = ii * 0.5f;
+      point[1] = jj * 0.25f;
+      point[2] = static_cast<float>((ii * 7 + jj * 3) % 11);
+      mesh->SetPoint(pointId, point);
+      mesh->SetPointData(pointId, static_cast<PixelType>(pointId) * 0.125f);
+    }
+  }
+  MeshType::CellIdentifier cellId = 0;
+  for (unsigned int jj = 0; jj + 1 < gridSize; ++jj)
+  {
+    for (unsigned int ii = 0; ii + 1 < gridSize; ++ii)
+    {
+      const MeshType::PointIdentifier corner = jj * gridSize + ii;
+      CellType::CellAutoPointer cell;
+      cell.TakeOwnership(new TriangleType);
+      cell->SetPointId(0, corner);
+      cell->SetPointId(1, corner + 1);
+      cell->SetPointId(2, corner + gridSize);
+      mesh->SetCell(cellId++, cell);
+    }
+  }
+  const itk::SizeValueType numberOfPoints = mesh->GetNumberOfPoints();
+
+  try
+  {
+    // Small frames, so that each array spans several of them
+    constexpr itk::SizeValueType frameSize = 1024;
+    auto writeIO = itk::WasmZstdMeshIO::New();
+    writeIO->SeekableOn();
+    writeIO->SetSeekableFrameSize(frameSize);
+    using WriterType = itk::MeshFileWriter<MeshType>;
+    auto writer = WriterType::New();
+    writer->SetMeshIO(writeIO);
+    writer->SetFileName(meshFile);
+    writer->SetInput(mesh);
+    writer->Update();
+
+    // Reading the points and cells does not decompress the point data
+    auto meshIO = itk::WasmZstdMeshIO::New();
+    meshIO->SetFileName(meshFile);
+    meshIO->ReadMeshInformation();
+    if (meshIO->GetNumberOfPoints() != numberOfPoints || meshIO->GetNumberOfCells() != cellId)
+    {
+      std::cerr << "Unexpected mesh information" << std::endl;
+      return EXIT_FAILURE;
+    }
+    std::vector<float> points(numberOfPoints * Dimension);
+    meshIO->ReadPoints(points.data());
+    std::vector<char> cells(meshIO->GetCellBufferSize() * sizeof(uint64_t));
+    meshIO->ReadCells(cells.data());
+    for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      const MeshType::PointType expected = mesh->GetPoint(ii);
+      for (unsigned int dd = 0; dd < Dimension; ++dd)
+      {
+        if (points[ii * Dimension + dd] != expected[dd])
+        {
+          std::cerr << "Point mismatch at " << ii << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    const itk::SizeValueType pointDataBytes = numberOfPoints * sizeof(PixelType);
+    const itk::SizeValueType pointDataFrames = (pointDataBytes + frameSize - 1) / frameSize;
+    const itk::SizeValueType framesBeforePointData = meshIO->GetNumberOfDecompressedFrames();
+    std::vector<PixelType> pointData(numberOfPoints);
+    meshIO->ReadPointData(pointData.data());
+    if (meshIO->GetNumberOfDecompressedFrames() - framesBeforePointData != pointDataFrames)
+    {
+      std::cerr << "Expected the point data to be the only frames left, decompressed "
+                << meshIO->GetNumberOfDecompressedFrames() - framesBeforePointData << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      if (pointData[ii] != static_cast<PixelType>(ii) * 0.125f)
+      {
+        std::cerr << "Point data mismatch at " << ii << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A single frame file, as written by default and by older versions
+    writer->SetMeshIO(itk::WasmZstdMeshIO::New());
+    writer->Update();
+
+    // Reading the points and cells stops decompressing before the point data
+    auto singleFrameIO = itk::WasmZstdMeshIO::New();
+    singleFrameIO->SetFileName(meshFile);
+    singleFrameIO->ReadMeshInformation();
+    singleFrameIO->ReadPoints(points.data());
+    singleFrameIO->ReadCells(cells.data());
+    const itk::SizeValueType geometryBytes = singleFrameIO->GetNumberOfDecompressedBytes();
+    singleFrameIO->ReadPointData(pointData.data());
+    if (singleFrameIO->GetNumberOfDecompressedBytes() - geometryBytes < pointDataBytes / 2)
+    {
+      std::cerr << "Expected the point data to be decompressed last, decompressed "
+                << singleFrameIO->GetNumberOfDecompressedBytes() - geometryBytes << std::endl;
+      return EXIT_FAILURE;
+    }
+    // Reading out of order decompresses the file again
+    std::vector<float> rereadPoints(numberOfPoints * Dimension);
+    singleFrameIO->ReadPoints(rereadPoints.data());
+    if (rereadPoints != points)
+    {
+      std::cerr << "Points read again do not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    using ReaderType = itk::MeshFileReader<MeshType>;
+    auto reader = ReaderType::New();
+    reader->SetMeshIO(itk::WasmZstdMeshIO::New());
+    reader->SetFileName(meshFile);
+    reader->Update();
+    const MeshType * readMesh = reader->GetOutput();
+    if (readMesh->GetNumberOfPoints() != numberOfPoints || readMesh->GetNumberOfCells() != cellId)
+    {
+      std::cerr << "Single frame mesh does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      if (readMesh->GetPoint(ii) != mesh->GetPoint(ii))
+      {
+        std::cerr << "Single frame point mismatch at " << ii << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // A frame without its content size, as written by streaming encoders,
+    // is decompressed incrementally
+    std::string singleFrame;
+    {
+      std::ifstream singleFrameStream(meshFile, std::ios::binary);
+      singleFrame.assign(std::istreambuf_iterator<char>(singleFrameStream), std::istreambuf_iterator<char>());
+    }
+    std::vector<char> cbor(ZSTD_getFrameContentSize(singleFrame.data(), singleFrame.size()));
+    ZSTD_decompress(cbor.data(), cbor.size(), singleFrame.data(), singleFrame.size());
+    ZSTD_CCtx * context = ZSTD_createCCtx();
+    ZSTD_CCtx_setParameter(context, ZSTD_c_contentSizeFlag, 0);
+    std::vector<char> unknownSizeFrame(ZSTD_compressBound(cbor.size()));
+    unknownSizeFrame.resize(ZSTD_compress2(context, unknownSizeFrame.data(), unknownSizeFrame.size(), cbor.data(), cbor.size()));
+    ZSTD_freeCCtx(context);
+    if (ZSTD_getFrameContentSize(unknownSizeFrame.data(), unknownSizeFrame.size()) != ZSTD_CONTENTSIZE_UNKNOWN)
+    {
+      std::cerr << "Expected a frame without its content size" << std::endl;
+      return EXIT_FAILURE;
+    }
+    {
+      std::ofstream unknownSizeStream(meshFile, std::ios::binary);
+      unknownSizeStream.write(unknownSizeFrame.data(), static_cast<std::streamsize>(unknownSizeFrame.size()));
+    }
+    auto unknownSizeReader = ReaderType::New();
+    unknownSizeReader->SetMeshIO(itk::WasmZstdMeshIO::New());
+    unknownSizeReader->SetFileName(meshFile);
+    unknownSizeReader->Update();
+    const MeshType * unknownSizeMesh = unknownSizeReader->GetOutput();
+    if (unknownSizeMesh->GetNumberOfPoints() != numberOfPoints || unknownSizeMesh->GetNumberOfCells() != cellId)
+    {
+      std::cerr << "Frame without content size does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (itk::SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+    {
+      if (unknownSizeMesh->GetPoint(ii) != mesh->GetPoint(ii))
+      {
+        std::cerr << "Frame without content size point mismatch at " << ii << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    auto foreignCodecIO = itk::WasmZstdMeshIO::New();
+    if (foreignCodecIO->CanReadFile("mesh.iwm.cbor.lz4") || foreignCodecIO->CanWriteFile("mesh.iwm.cbor.lz4"))
+    {
+      std::cerr << "Expected .iwm.cbor.lz4 to require WasmLz4MeshIO" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
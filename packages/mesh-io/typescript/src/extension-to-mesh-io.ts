@@ -9,7 +9,8 @@ const extensionToMeshIo = new Map([
   ['swc', 'swc'],
   ['iwm', 'wasm'],
   ['iwm.cbor', 'wasm'],
-  ['iwm.cbor.zst', 'wasm-zstd']
+  ['iwm.cbor.zst', 'wasm-zstd'],
+  ['iwm.cbor.lz4', 'wasm-lz4']
 ])
 
 export default extensionToMeshIo
@@ -12,6 +12,21 @@ interface FreeSurferAsciiWriteMeshOptions extends WorkerPoolFunctionOption {
   /** Use a binary file type in the written file, if supported */
   binaryFileType?: boolean
 
+  /** Compression level, if supported. Defaults to the level of the file format. */
+  compressionLevel?: number
+
+  /** Number of compression worker threads, if supported. 0 compresses on the calling thread. */
+  numberOfWorkers?: number
+
+  /** Use long distance matching for compression, if supported */
+  longDistanceMatching?: boolean
+
+  /** Write frames with a seek table so that arrays can be read without decompressing the whole file, if supported */
+  seekable?: boolean
+
+  /** Reorder cells for vertex cache efficiency and number points in first use order before writing */
+  optimizeLocality?: boolean
+
 }
 
 export default FreeSurferAsciiWriteMeshOptions
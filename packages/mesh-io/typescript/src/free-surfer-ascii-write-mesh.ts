@@ -65,6 +65,23 @@ async function freeSurferAsciiWriteMesh(
   if (options.binaryFileType) {
     options.binaryFileType && args.push('--binary-file-type')
   }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.numberOfWorkers) {
+    args.push('--number-of-workers', options.numberOfWorkers.toString())
+
+  }
+  if (options.longDistanceMatching) {
+    options.longDistanceMatching && args.push('--long-distance-matching')
+  }
+  if (options.seekable) {
+    options.seekable && args.push('--seekable')
+  }
+  if (options.optimizeLocality) {
+    options.optimizeLocality && args.push('--optimize-locality')
+  }
 
   const pipelinePath = 'free-surfer-ascii-write-mesh'
 
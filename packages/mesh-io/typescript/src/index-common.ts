@@ -68,6 +68,12 @@ export type { WasmZstdReadMeshOptions }
 import WasmZstdWriteMeshOptions from './wasm-zstd-write-mesh-options.js'
 export type { WasmZstdWriteMeshOptions }
 
+import WasmLz4ReadMeshOptions from './wasm-lz4-read-mesh-options.js'
+export type { WasmLz4ReadMeshOptions }
+
+import WasmLz4WriteMeshOptions from './wasm-lz4-write-mesh-options.js'
+export type { WasmLz4WriteMeshOptions }
+
 
 export type { JsonCompatible } from 'itk-wasm'
 export type { Mesh } from 'itk-wasm'
@@ -144,3 +144,17 @@ export type { WasmZstdWriteMeshNodeResult }
 
 import wasmZstdWriteMeshNode from './wasm-zstd-write-mesh-node.js'
 export { wasmZstdWriteMeshNode }
+
+
+import WasmLz4ReadMeshNodeResult from './wasm-lz4-read-mesh-node-result.js'
+export type { WasmLz4ReadMeshNodeResult }
+
+import wasmLz4ReadMeshNode from './wasm-lz4-read-mesh-node.js'
+export { wasmLz4ReadMeshNode }
+
+
+import WasmLz4WriteMeshNodeResult from './wasm-lz4-write-mesh-node-result.js'
+export type { WasmLz4WriteMeshNodeResult }
+
+import wasmLz4WriteMeshNode from './wasm-lz4-write-mesh-node.js'
+export { wasmLz4WriteMeshNode }
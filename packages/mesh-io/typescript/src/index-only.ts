@@ -156,3 +156,17 @@ export type { WasmZstdWriteMeshResult }
 
 import wasmZstdWriteMesh from './wasm-zstd-write-mesh.js'
 export { wasmZstdWriteMesh }
+
+
+import WasmLz4ReadMeshResult from './wasm-lz4-read-mesh-result.js'
+export type { WasmLz4ReadMeshResult }
+
+import wasmLz4ReadMesh from './wasm-lz4-read-mesh.js'
+export { wasmLz4ReadMesh }
+
+
+import WasmLz4WriteMeshResult from './wasm-lz4-write-mesh-result.js'
+export type { WasmLz4WriteMeshResult }
+
+import wasmLz4WriteMesh from './wasm-lz4-write-mesh.js'
+export { wasmLz4WriteMesh }
@@ -10,6 +10,8 @@ import wasmReadMeshNode from './wasm-read-mesh-node.js'
 import wasmWriteMeshNode from './wasm-write-mesh-node.js'
 import wasmZstdReadMeshNode from './wasm-zstd-read-mesh-node.js'
 import wasmZstdWriteMeshNode from './wasm-zstd-write-mesh-node.js'
+import wasmLz4ReadMeshNode from './wasm-lz4-read-mesh-node.js'
+import wasmLz4WriteMeshNode from './wasm-lz4-write-mesh-node.js'
 import swcReadMeshNode from './swc-read-mesh-node.js'
 import swcWriteMeshNode from './swc-write-mesh-node.js'
 import byuReadMeshNode from './byu-read-mesh-node.js'
@@ -25,7 +27,8 @@ const meshIoIndexNode = new Map([
   ['stl', [stlReadMeshNode, stlWriteMeshNode]],
   ['off', [offReadMeshNode, offWriteMeshNode]],
   ['wasm', [wasmReadMeshNode, wasmWriteMeshNode]],
-  ['wasm-zst', [wasmZstdReadMeshNode, wasmZstdWriteMeshNode]],
+  ['wasm-zstd', [wasmZstdReadMeshNode, wasmZstdWriteMeshNode]],
+  ['wasm-lz4', [wasmLz4ReadMeshNode, wasmLz4WriteMeshNode]],
   ['swc', [swcReadMeshNode, swcWriteMeshNode]],
   ['byu', [byuReadMeshNode, byuWriteMeshNode]],
   ['free-surfer-ascii', [freeSurferAsciiReadMeshNode, freeSurferAsciiWriteMeshNode]],
@@ -10,6 +10,8 @@ import wasmReadMesh from './wasm-read-mesh.js'
 import wasmWriteMesh from './wasm-write-mesh.js'
 import wasmZstdReadMesh from './wasm-zstd-read-mesh.js'
 import wasmZstdWriteMesh from './wasm-zstd-write-mesh.js'
+import wasmLz4ReadMesh from './wasm-lz4-read-mesh.js'
+import wasmLz4WriteMesh from './wasm-lz4-write-mesh.js'
 import swcReadMesh from './swc-read-mesh.js'
 import swcWriteMesh from './swc-write-mesh.js'
 import byuReadMesh from './byu-read-mesh.js'
@@ -25,7 +27,8 @@ const meshIoIndex = new Map([
   ['stl', [stlReadMesh, stlWriteMesh]],
   ['off', [offReadMesh, offWriteMesh]],
   ['wasm', [wasmReadMesh, wasmWriteMesh]],
-  ['wasm-zst', [wasmZstdReadMesh, wasmZstdWriteMesh]],
+  ['wasm-zstd', [wasmZstdReadMesh, wasmZstdWriteMesh]],
+  ['wasm-lz4', [wasmLz4ReadMesh, wasmLz4WriteMesh]],
   ['swc', [swcReadMesh, swcWriteMesh]],
   ['byu', [byuReadMesh, byuWriteMesh]],
   ['free-surfer-ascii', [freeSurferAsciiReadMesh, freeSurferAsciiWriteMesh]],
@@ -0,0 +1,11 @@
+// Generated file. To retain edits, remove this comment.
+
+import { WorkerPoolFunctionOption } from 'itk-wasm'
+
+interface WasmLz4ReadMeshOptions extends WorkerPoolFunctionOption {
+  /** Only read image metadata -- do not read pixel data. */
+  informationOnly?: boolean
+
+}
+
+export default WasmLz4ReadMeshOptions
@@ -0,0 +1,12 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible } from 'itk-wasm'
+
+interface WasmLz4WriteMeshNodeResult {
+  /** Whether the input could be written. If false, the output mesh is not valid. */
+  couldWrite: JsonCompatible
+
+  /** Output mesh */
+}
+
+export default WasmLz4WriteMeshNodeResult
@@ -0,0 +1,102 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  Mesh,
+  JsonCompatible,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipelineNode
+} from 'itk-wasm'
+
+import WasmLz4WriteMeshNodeOptions from './wasm-lz4-write-mesh-node-options.js'
+import WasmLz4WriteMeshNodeResult from './wasm-lz4-write-mesh-node-result.js'
+
+import path from 'path'
+import { fileURLToPath } from 'url'
+
+/**
+ * Write an itk-wasm file format converted to an mesh file format
+ *
+ * @param {Mesh} mesh - Input mesh
+ * @param {string} serializedMesh - Output mesh
+ * @param {WasmLz4WriteMeshNodeOptions} options - options object
+ *
+ * @returns {Promise<WasmLz4WriteMeshNodeResult>} - result object
+ */
+async function wasmLz4WriteMeshNode(
+  mesh: Mesh,
+  serializedMesh: string,
+  options: WasmLz4WriteMeshNodeOptions = {}
+) : Promise<WasmLz4WriteMeshNodeResult> {
+
+  const mountDirs: Set<string> = new Set()
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+  ]
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Mesh, data: mesh },
+  ]
+
+  const args = []
+  // Inputs
+  const meshName = '0'
+  args.push(meshName)
+
+  // Outputs
+  const couldWriteName = '0'
+  args.push(couldWriteName)
+
+  const serializedMeshName = serializedMesh
+  args.push(serializedMeshName)
+  mountDirs.add(path.dirname(serializedMeshName))
+
+  // Options
+  args.push('--memory-io')
+  if (options.informationOnly) {
+    options.informationOnly && args.push('--information-only')
+  }
+  if (options.useCompression) {
+    options.useCompression && args.push('--use-compression')
+  }
+  if (options.binaryFileType) {
+    options.binaryFileType && args.push('--binary-file-type')
+  }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.numberOfWorkers) {
+    args.push('--number-of-workers', options.numberOfWorkers.toString())
+
+  }
+  if (options.longDistanceMatching) {
+    options.longDistanceMatching && args.push('--long-distance-matching')
+  }
+  if (options.seekable) {
+    options.seekable && args.push('--seekable')
+  }
+  if (options.optimizeLocality) {
+    options.optimizeLocality && args.push('--optimize-locality')
+  }
+
+  const pipelinePath = path.join(path.dirname(fileURLToPath(import.meta.url)), 'pipelines', 'wasm-lz4-write-mesh')
+
+  const {
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipelineNode(pipelinePath, args, desiredOutputs, inputs, mountDirs)
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    couldWrite: outputs[0]?.data as JsonCompatible,
+  }
+  return result
+}
+
+export default wasmLz4WriteMeshNode
@@ -0,0 +1,14 @@
+// Generated file. To retain edits, remove this comment.
+
+import { JsonCompatible, BinaryFile, WorkerPoolFunctionResult } from 'itk-wasm'
+
+interface WasmLz4WriteMeshResult extends WorkerPoolFunctionResult {
+  /** Whether the input could be written. If false, the output mesh is not valid. */
+  couldWrite: JsonCompatible
+
+  /** Output mesh */
+  serializedMesh: BinaryFile
+
+}
+
+export default WasmLz4WriteMeshResult
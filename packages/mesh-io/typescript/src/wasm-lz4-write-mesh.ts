@@ -0,0 +1,110 @@
+// Generated file. To retain edits, remove this comment.
+
+import {
+  Mesh,
+  JsonCompatible,
+  BinaryFile,
+  InterfaceTypes,
+  PipelineOutput,
+  PipelineInput,
+  runPipeline
+} from 'itk-wasm'
+
+import WasmLz4WriteMeshOptions from './wasm-lz4-write-mesh-options.js'
+import WasmLz4WriteMeshResult from './wasm-lz4-write-mesh-result.js'
+
+import { getPipelinesBaseUrl } from './pipelines-base-url.js'
+import { getPipelineWorkerUrl } from './pipeline-worker-url.js'
+
+import { getDefaultWebWorker } from './default-web-worker.js'
+
+/**
+ * Write an itk-wasm file format converted to an mesh file format
+ *
+ * @param {Mesh} mesh - Input mesh
+ * @param {string} serializedMesh - Output mesh
+ * @param {WasmLz4WriteMeshOptions} options - options object
+ *
+ * @returns {Promise<WasmLz4WriteMeshResult>} - result object
+ */
+async function wasmLz4WriteMesh(
+  mesh: Mesh,
+  serializedMesh: string,
+  options: WasmLz4WriteMeshOptions = {}
+) : Promise<WasmLz4WriteMeshResult> {
+
+  const desiredOutputs: Array<PipelineOutput> = [
+    { type: InterfaceTypes.JsonCompatible },
+    { type: InterfaceTypes.BinaryFile, data: { path: serializedMesh, data: new Uint8Array() }},
+  ]
+
+  const inputs: Array<PipelineInput> = [
+    { type: InterfaceTypes.Mesh, data: mesh },
+  ]
+
+  const args = []
+  // Inputs
+  const meshName = '0'
+  args.push(meshName)
+
+  // Outputs
+  const couldWriteName = '0'
+  args.push(couldWriteName)
+
+  const serializedMeshName = serializedMesh
+  args.push(serializedMeshName)
+
+  // Options
+  args.push('--memory-io')
+  if (options.informationOnly) {
+    options.informationOnly && args.push('--information-only')
+  }
+  if (options.useCompression) {
+    options.useCompression && args.push('--use-compression')
+  }
+  if (options.binaryFileType) {
+    options.binaryFileType && args.push('--binary-file-type')
+  }
+  if (options.compressionLevel) {
+    args.push('--compression-level', options.compressionLevel.toString())
+
+  }
+  if (options.numberOfWorkers) {
+    args.push('--number-of-workers', options.numberOfWorkers.toString())
+
+  }
+  if (options.longDistanceMatching) {
+    options.longDistanceMatching && args.push('--long-distance-matching')
+  }
+  if (options.seekable) {
+    options.seekable && args.push('--seekable')
+  }
+  if (options.optimizeLocality) {
+    options.optimizeLocality && args.push('--optimize-locality')
+  }
+
+  const pipelinePath = 'wasm-lz4-write-mesh'
+
+  let workerToUse = options?.webWorker
+  if (workerToUse === undefined) {
+    workerToUse = await getDefaultWebWorker()
+  }
+  const {
+    webWorker: usedWebWorker,
+    returnValue,
+    stderr,
+    outputs
+  } = await runPipeline(pipelinePath, args, desiredOutputs, inputs, { pipelineBaseUrl: getPipelinesBaseUrl(), pipelineWorkerUrl: getPipelineWorkerUrl(), webWorker: workerToUse, noCopy: options?.noCopy })
+  if (returnValue !== 0 && stderr !== "") {
+    throw new Error(stderr)
+  }
+
+  const result = {
+    webWorker: usedWebWorker as Worker,
+    couldWrite: outputs[0]?.data as JsonCompatible,
+    serializedMesh: outputs[1]?.data as BinaryFile,
+  }
+  return result
+}
+
+export default wasmLz4WriteMesh
@@ -44,6 +44,8 @@
 #elif MESH_IO_CLASS == 8
 #elif MESH_IO_CLASS == 9
 #include "itkWasmZstdMeshIO.h"
+#elif MESH_IO_CLASS == 10
+#include "itkWasmLz4MeshIO.h"
 #else
 #error "Unsupported MESH_IO_CLASS"
 #endif
@@ -55,10 +57,20 @@
 #include "itkPipeline.h"
 #include "itkOutputMesh.h"
 #include "itkWasmMeshIOBase.h"
+#include "itkWasmMeshLocality.h"
 #include "itkMeshIOBase.h"
 
+struct CompressionOptions
+{
+  // Negative keeps the default of the mesh IO
+  int compressionLevel = -1;
+  unsigned int numberOfWorkers = 0;
+  bool longDistanceMatching = false;
+  bool seekable = false;
+};
+
 template <typename TMeshIO>
-int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, bool binaryFileType)
+int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream & couldWrite, const std::string & outputFileName, bool informationOnly, bool useCompression, bool binaryFileType, const CompressionOptions & compressionOptions, bool optimizeLocality)
 {
   using MeshIOType = TMeshIO;
 
@@ -75,6 +87,20 @@ int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream
   }
 
   meshIO->SetUseCompression(useCompression);
+#if MESH_IO_CLASS == 9
+  if (compressionOptions.compressionLevel >= 0)
+  {
+    meshIO->SetCompressionLevel(compressionOptions.compressionLevel);
+  }
+  meshIO->SetNumberOfWorkers(compressionOptions.numberOfWorkers);
+  meshIO->SetLongDistanceMatching(compressionOptions.longDistanceMatching);
+  meshIO->SetSeekable(compressionOptions.seekable);
+#elif MESH_IO_CLASS == 10
+  if (compressionOptions.compressionLevel >= 0)
+  {
+    meshIO->SetCompressionLevel(compressionOptions.compressionLevel);
+  }
+#endif
   if (binaryFileType)
   {
     meshIO->SetFileTypeToBinary();
@@ -122,21 +148,55 @@ int writeMesh(itk::wasm::InputMeshIO & inputMeshIO, itk::wasm::OutputTextStream
 
   if (!informationOnly)
   {
+    char * points = meshIO->GetNumberOfPoints() ? const_cast< char * >(&(inputWasmMeshIOBase->GetPointsContainer()->at(0))) : nullptr;
+    char * cells = meshIO->GetNumberOfCells() ? const_cast< char * >(&(inputWasmMeshIOBase->GetCellsContainer()->at(0))) : nullptr;
+    char * pointData = meshIO->GetNumberOfPointPixels() ? const_cast< char * >(&(inputWasmMeshIOBase->GetPointDataContainer()->at(0))) : nullptr;
+    char * cellData = meshIO->GetNumberOfCellPixels() ? const_cast< char * >(&(inputWasmMeshIOBase->GetCellDataContainer()->at(0))) : nullptr;
+
+    // Reordered copies of the arrays, when the locality is optimized
+    std::vector< char > reorderedPoints;
+    std::vector< char > reorderedCells;
+    std::vector< char > reorderedPointData;
+    std::vector< char > reorderedCellData;
+    if (optimizeLocality && meshIO->GetNumberOfCells())
+    {
+      reorderedPoints = inputWasmMeshIOBase->GetPointsContainer()->CastToSTLConstContainer();
+      reorderedCells = inputWasmMeshIOBase->GetCellsContainer()->CastToSTLConstContainer();
+      reorderedPointData = inputWasmMeshIOBase->GetPointDataContainer()->CastToSTLConstContainer();
+      reorderedCellData = inputWasmMeshIOBase->GetCellDataContainer()->CastToSTLConstContainer();
+      try
+      {
+        const itk::WasmMeshCellPoints cellPoints = itk::cellPointsFromCellBuffer(reorderedCells.data(),
+          inputMeshIOBase->GetCellComponentType(), inputMeshIOBase->GetNumberOfCells(), inputMeshIOBase->GetCellBufferSize());
+        const itk::WasmMeshLocalityOrder order = itk::computeMeshLocalityOrder(cellPoints, inputMeshIOBase->GetNumberOfPoints());
+        itk::applyMeshLocalityOrder(inputMeshIOBase, order, reorderedPoints, reorderedCells, reorderedPointData, reorderedCellData);
+      }
+      catch (const std::runtime_error & error)
+      {
+        std::cerr << "Could not optimize the mesh locality: " << error.what() << std::endl;
+        return EXIT_FAILURE;
+      }
+      points = reorderedPoints.empty() ? nullptr : reorderedPoints.data();
+      cells = reorderedCells.data();
+      pointData = reorderedPointData.empty() ? nullptr : reorderedPointData.data();
+      cellData = reorderedCellData.empty() ? nullptr : reorderedCellData.data();
+    }
+
     if (meshIO->GetNumberOfPoints())
     {
-      meshIO->WritePoints( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetPointsContainer()->at(0))) ));
+      meshIO->WritePoints( reinterpret_cast< void * >( points ));
     }
     if (meshIO->GetNumberOfCells())
     {
-      meshIO->WriteCells( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetCellsContainer()->at(0))) ));
+      meshIO->WriteCells( reinterpret_cast< void * >( cells ));
     }
     if (meshIO->GetNumberOfPointPixels())
     {
-      meshIO->WritePointData( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetPointDataContainer()->at(0))) ));
+      meshIO->WritePointData( reinterpret_cast< void * >( pointData ));
     }
     if (meshIO->GetNumberOfCellPixels())
     {
-      meshIO->WriteCellData( reinterpret_cast< void * >( const_cast< char * >(&(inputWasmMeshIOBase->GetCellDataContainer()->at(0))) ));
+      meshIO->WriteCellData( reinterpret_cast< void * >( cellData ));
     }
 
     meshIO->Write();
@@ -168,28 +228,42 @@ int main (int argc, char * argv[])
   bool binaryFileType = false;
   pipeline.add_flag("-b,--binary-file-type", binaryFileType, "Use a binary file type in the written file, if supported");
 
+  CompressionOptions compressionOptions;
+  pipeline.add_option("--compression-level", compressionOptions.compressionLevel, "Compression level, if supported. Defaults to the level of the file format.");
+
+  pipeline.add_option("--number-of-workers", compressionOptions.numberOfWorkers, "Number of compression worker threads, if supported. 0 compresses on the calling thread.");
+
+  pipeline.add_flag("--long-distance-matching", compressionOptions.longDistanceMatching, "Use long distance matching for compression, if supported");
+
+  pipeline.add_flag("--seekable", compressionOptions.seekable, "Write frames with a seek table so that arrays can be read without decompressing the whole file, if supported");
+
+  bool optimizeLocality = false;
+  pipeline.add_flag("--optimize-locality", optimizeLocality, "Reorder cells for vertex cache efficiency and number points in first use order before writing");
+
   ITK_WASM_PARSE(pipeline);
 
 #if MESH_IO_CLASS == 0
-  return writeMesh<itk::BYUMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::BYUMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 1
-  return writeMesh<itk::FreeSurferAsciiMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::FreeSurferAsciiMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 2
-  return writeMesh<itk::FreeSurferBinaryMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::FreeSurferBinaryMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 3
-  return writeMesh<itk::VTKPolyDataMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::VTKPolyDataMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 4
-  return writeMesh<itk::OBJMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::OBJMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 5
-  return writeMesh<itk::OFFMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::OFFMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 6
-  return writeMesh<itk::STLMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::STLMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 7
-  return writeMesh<itk::SWCMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::SWCMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 8
-  return writeMesh<itk::WasmMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::WasmMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #elif MESH_IO_CLASS == 9
-  return writeMesh<itk::WasmZstdMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType);
+  return writeMesh<itk::WasmZstdMeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
+#elif MESH_IO_CLASS == 10
+  return writeMesh<itk::WasmLz4MeshIO>(inputMeshIO, couldWrite, outputFileName, informationOnly, useCompression, binaryFileType, compressionOptions, optimizeLocality);
 #else
 #error "Unsupported MESH_IO_CLASS"
 #endif
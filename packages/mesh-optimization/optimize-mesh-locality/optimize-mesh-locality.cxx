@@ -0,0 +1,229 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipeline.h"
+#include "itkInputMesh.h"
+#include "itkOutputMesh.h"
+#include "itkOutputTextStream.h"
+#include "itkSupportInputMeshTypes.h"
+#include "itkWasmMeshLocality.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <stdexcept>
+
+static rapidjson::Value
+localityMetricsObject(const itk::WasmMeshLocalityMetrics & metrics, rapidjson::Document::AllocatorType & allocator)
+{
+  rapidjson::Value metricsObject(rapidjson::kObjectType);
+  metricsObject.AddMember("averageCacheMissRatio", rapidjson::Value(metrics.averageCacheMissRatio), allocator);
+  metricsObject.AddMember("averageTransformedVertexRatio", rapidjson::Value(metrics.averageTransformedVertexRatio), allocator);
+  metricsObject.AddMember("meanPointIdentifierSpan", rapidjson::Value(metrics.meanPointIdentifierSpan), allocator);
+  return metricsObject;
+}
+
+template <typename TMesh>
+itk::WasmMeshCellPoints
+meshCellPoints(const TMesh * mesh)
+{
+  itk::WasmMeshCellPoints cellPoints;
+  const auto numberOfCells = mesh->GetNumberOfCells();
+  cellPoints.offsets.reserve(numberOfCells + 1);
+  for (typename TMesh::CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    typename TMesh::CellAutoPointer cell;
+    if (!mesh->GetCell(cellId, cell))
+    {
+      throw std::runtime_error("Cell identifiers are not contiguous");
+    }
+    cellPoints.pointIds.insert(cellPoints.pointIds.end(), cell->PointIdsBegin(), cell->PointIdsEnd());
+    cellPoints.offsets.push_back(cellPoints.pointIds.size());
+  }
+  return cellPoints;
+}
+
+template <typename TMesh>
+int
+optimizeMeshLocality(itk::wasm::Pipeline & pipeline, const TMesh * inputMesh)
+{
+  using MeshType = TMesh;
+
+  unsigned int cacheSize = 32;
+  pipeline.add_option("-c,--cache-size", cacheSize, "Number of points in the simulated post-transform vertex cache.");
+
+  itk::wasm::OutputMesh<MeshType> outputMesh;
+  pipeline.add_option("output-mesh", outputMesh, "Mesh with its cells reordered for vertex cache locality and its points renumbered in the order of first use.")->required()->type_name("OUTPUT_MESH");
+
+  itk::wasm::OutputTextStream metrics;
+  pipeline.add_option("metrics", metrics, "Locality metrics of the input and output meshes.")->required()->type_name("OUTPUT_JSON");
+
+  ITK_WASM_PARSE(pipeline);
+
+  const auto numberOfPoints = inputMesh->GetNumberOfPoints();
+  const auto numberOfCells = inputMesh->GetNumberOfCells();
+
+  itk::WasmMeshCellPoints cellPoints;
+  itk::WasmMeshLocalityOrder order;
+  try
+  {
+    cellPoints = meshCellPoints(inputMesh);
+    order = itk::computeMeshLocalityOrder(cellPoints, numberOfPoints, cacheSize);
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cerr << "Could not reorder the mesh: " << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  const itk::WasmMeshLocalityMetrics inputMetrics = itk::measureMeshLocality(cellPoints, cacheSize);
+
+  std::vector<typename MeshType::PointIdentifier> newPointIds(numberOfPoints);
+  for (typename MeshType::PointIdentifier newPointId = 0; newPointId < numberOfPoints; ++newPointId)
+  {
+    newPointIds[order.pointOrder[newPointId]] = newPointId;
+  }
+
+  auto mesh = MeshType::New();
+
+  auto points = MeshType::PointsContainer::New();
+  points->resize(numberOfPoints);
+  for (typename MeshType::PointIdentifier newPointId = 0; newPointId < numberOfPoints; ++newPointId)
+  {
+    typename MeshType::PointType point;
+    if (!inputMesh->GetPoint(order.pointOrder[newPointId], &point))
+    {
+      std::cerr << "Point identifiers are not contiguous" << std::endl;
+      return EXIT_FAILURE;
+    }
+    points->SetElement(newPointId, point);
+  }
+  mesh->SetPoints(points);
+
+  // Point data and cell data travel with their points and cells when there is one pixel for each
+  const typename MeshType::PointDataContainer * inputPointData = inputMesh->GetPointData();
+  if (inputPointData != nullptr)
+  {
+    auto pointData = MeshType::PointDataContainer::New();
+    if (inputPointData->Size() == numberOfPoints)
+    {
+      pointData->resize(numberOfPoints);
+      for (typename MeshType::PointIdentifier newPointId = 0; newPointId < numberOfPoints; ++newPointId)
+      {
+        pointData->SetElement(newPointId, inputPointData->GetElement(order.pointOrder[newPointId]));
+      }
+    }
+    else
+    {
+      pointData->CastToSTLContainer() = inputPointData->CastToSTLConstContainer();
+    }
+    mesh->SetPointData(pointData);
+  }
+
+  for (typename MeshType::CellIdentifier newCellId = 0; newCellId < numberOfCells; ++newCellId)
+  {
+    typename MeshType::CellAutoPointer inputCell;
+    inputMesh->GetCell(order.cellOrder[newCellId], inputCell);
+    typename MeshType::CellAutoPointer cell;
+    inputCell->MakeCopy(cell);
+    const auto cellPointIds = inputCell->PointIdsBegin();
+    for (unsigned int cellPoint = 0; cellPoint < inputCell->GetNumberOfPoints(); ++cellPoint)
+    {
+      cell->SetPointId(cellPoint, newPointIds[cellPointIds[cellPoint]]);
+    }
+    mesh->SetCell(newCellId, cell);
+  }
+
+  const typename MeshType::CellDataContainer * inputCellData = inputMesh->GetCellData();
+  if (inputCellData != nullptr)
+  {
+    auto cellData = MeshType::CellDataContainer::New();
+    if (inputCellData->Size() == numberOfCells)
+    {
+      cellData->resize(numberOfCells);
+      for (typename MeshType::CellIdentifier newCellId = 0; newCellId < numberOfCells; ++newCellId)
+      {
+        cellData->SetElement(newCellId, inputCellData->GetElement(order.cellOrder[newCellId]));
+      }
+    }
+    else
+    {
+      cellData->CastToSTLContainer() = inputCellData->CastToSTLConstContainer();
+    }
+    mesh->SetCellData(cellData);
+  }
+
+  itk::WasmMeshCellPoints outputCellPoints;
+  outputCellPoints.offsets = cellPoints.offsets;
+  outputCellPoints.pointIds.resize(cellPoints.pointIds.size());
+  for (typename MeshType::CellIdentifier newCellId = 0; newCellId < numberOfCells; ++newCellId)
+  {
+    const auto oldCellId = order.cellOrder[newCellId];
+    auto outputPointId = outputCellPoints.pointIds.begin() + outputCellPoints.offsets[newCellId];
+    for (auto index = cellPoints.offsets[oldCellId]; index < cellPoints.offsets[oldCellId + 1]; ++index)
+    {
+      *outputPointId++ = newPointIds[cellPoints.pointIds[index]];
+    }
+    outputCellPoints.offsets[newCellId + 1] = outputCellPoints.offsets[newCellId] + cellPoints.offsets[oldCellId + 1] - cellPoints.offsets[oldCellId];
+  }
+  const itk::WasmMeshLocalityMetrics outputMetrics = itk::measureMeshLocality(outputCellPoints, cacheSize);
+
+  outputMesh.Set(mesh);
+
+  rapidjson::Document metricsJson;
+  metricsJson.SetObject();
+  rapidjson::Document::AllocatorType &allocator = metricsJson.GetAllocator();
+  metricsJson.AddMember("cacheSize", rapidjson::Value(cacheSize), allocator);
+  metricsJson.AddMember("input", localityMetricsObject(inputMetrics, allocator), allocator);
+  metricsJson.AddMember("output", localityMetricsObject(outputMetrics, allocator), allocator);
+
+  rapidjson::StringBuffer stringBuffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+  metricsJson.Accept(writer);
+
+  metrics.Get() << std::string(stringBuffer.GetString(), stringBuffer.GetLength());
+
+  return EXIT_SUCCESS;
+}
+
+template <typename TMesh>
+class PipelineFunctor
+{
+public:
+  int operator()(itk::wasm::Pipeline &pipeline)
+  {
+    using MeshType = TMesh;
+
+    itk::wasm::InputMesh<MeshType> inputMesh;
+    pipeline.add_option("input-mesh", inputMesh, "The input mesh")->required()->type_name("INPUT_MESH");
+
+    ITK_WASM_PRE_PARSE(pipeline);
+
+    typename MeshType::ConstPointer inputMeshRef = inputMesh.Get();
+    return optimizeMeshLocality<MeshType>(pipeline, inputMeshRef);
+  }
+};
+
+int main(int argc, char *argv[])
+{
+  itk::wasm::Pipeline pipeline("optimize-mesh-locality", "Reorder mesh cells for post-transform vertex cache reuse and renumber points in the order of first use.", argc, argv);
+
+  return itk::wasm::SupportInputMeshTypes<PipelineFunctor,
+                                          uint8_t,
+                                          float,
+                                          double>::Dimensions<3U>("input-mesh", pipeline);
+}
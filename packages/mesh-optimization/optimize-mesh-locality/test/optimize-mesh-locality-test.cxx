@@ -0,0 +1,288 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshFileWriter.h"
+#include "itkTriangleCell.h"
+#include "itkWasmMeshIO.h"
+#include "itkWasmMeshLocality.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/istreamwrapper.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+// Checks of the optimize-mesh-locality pipeline.
+//
+// Usage:
+//   optimize-mesh-locality-test generate <input.iwm.cbor>
+//   optimize-mesh-locality-test verify <input.iwm.cbor> <output.iwm.cbor> <metrics.json>
+//
+// generate writes a triangulated grid with shuffled points and cells. The
+// point data and cell data of the grid are the identifiers of its points
+// and cells, so that verify can follow them through the reordering.
+namespace
+{
+
+constexpr unsigned int Dimension = 3;
+using PixelType = float;
+using MeshType = itk::Mesh<PixelType, Dimension>;
+using CellType = MeshType::CellType;
+using TriangleType = itk::TriangleCell<CellType>;
+
+int
+generate(const char * inputFile)
+{
+  constexpr unsigned int gridSize = 48;
+  constexpr unsigned int numberOfPoints = gridSize * gridSize;
+  std::mt19937 generator(20240917);
+
+  std::vector<MeshType::PointIdentifier> pointIds(numberOfPoints);
+  std::iota(pointIds.begin(), pointIds.end(), 0);
+  std::shuffle(pointIds.begin(), pointIds.end(), generator);
+
+  auto mesh = MeshType::New();
+  for (unsigned int gridPoint = 0; gridPoint < numberOfPoints; ++gridPoint)
+  {
+    MeshType::PointType point;
+    point[0] = static_cast<float>(gridPoint % gridSize);
+    point[1] = static_cast<float>(gridPoint / gridSize);
+    point[2] = static_cast<float>((gridPoint * 7) % 5);
+    mesh->SetPoint(pointIds[gridPoint], point);
+    mesh->SetPointData(pointIds[gridPoint], static_cast<PixelType>(pointIds[gridPoint]));
+  }
+
+  std::vector<std::array<MeshType::PointIdentifier, 3>> triangles;
+  for (unsigned int jj = 0; jj + 1 < gridSize; ++jj)
+  {
+    for (unsigned int ii = 0; ii + 1 < gridSize; ++ii)
+    {
+      const unsigned int corner = jj * gridSize + ii;
+      triangles.push_back({ pointIds[corner], pointIds[corner + 1], pointIds[corner + gridSize] });
+      triangles.push_back({ pointIds[corner + 1], pointIds[corner + gridSize + 1], pointIds[corner + gridSize] });
+    }
+  }
+  std::shuffle(triangles.begin(), triangles.end(), generator);
+  for (MeshType::CellIdentifier cellId = 0; cellId < triangles.size(); ++cellId)
+  {
+    CellType::CellAutoPointer cell;
+    cell.TakeOwnership(new TriangleType);
+    for (unsigned int cellPoint = 0; cellPoint < 3; ++cellPoint)
+    {
+      cell->SetPointId(cellPoint, triangles[cellId][cellPoint]);
+    }
+    mesh->SetCell(cellId, cell);
+    mesh->SetCellData(cellId, static_cast<PixelType>(cellId));
+  }
+
+  using WriterType = itk::MeshFileWriter<MeshType>;
+  auto writer = WriterType::New();
+  writer->SetMeshIO(itk::WasmMeshIO::New());
+  writer->SetFileName(inputFile);
+  writer->SetInput(mesh);
+  writer->Update();
+
+  return EXIT_SUCCESS;
+}
+
+MeshType::Pointer
+readMesh(const char * fileName)
+{
+  using ReaderType = itk::MeshFileReader<MeshType>;
+  auto reader = ReaderType::New();
+  reader->SetMeshIO(itk::WasmMeshIO::New());
+  reader->SetFileName(fileName);
+  reader->Update();
+  MeshType::Pointer mesh = reader->GetOutput();
+  mesh->DisconnectPipeline();
+  return mesh;
+}
+
+itk::WasmMeshCellPoints
+meshCellPoints(const MeshType * mesh)
+{
+  itk::WasmMeshCellPoints cellPoints;
+  for (MeshType::CellIdentifier cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    MeshType::CellAutoPointer cell;
+    mesh->GetCell(cellId, cell);
+    cellPoints.pointIds.insert(cellPoints.pointIds.end(), cell->PointIdsBegin(), cell->PointIdsEnd());
+    cellPoints.offsets.push_back(cellPoints.pointIds.size());
+  }
+  return cellPoints;
+}
+
+/** Whether the values are a permutation of 0 to values.size() - 1. */
+bool
+isPermutation(std::vector<itk::SizeValueType> values)
+{
+  std::sort(values.begin(), values.end());
+  for (itk::SizeValueType ii = 0; ii < values.size(); ++ii)
+  {
+    if (values[ii] != ii)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+verify(const char * inputFile, const char * outputFile, const char * metricsFile)
+{
+  const MeshType::Pointer inputMesh = readMesh(inputFile);
+  const MeshType::Pointer outputMesh = readMesh(outputFile);
+  const itk::SizeValueType numberOfPoints = inputMesh->GetNumberOfPoints();
+  const itk::SizeValueType numberOfCells = inputMesh->GetNumberOfCells();
+  if (outputMesh->GetNumberOfPoints() != numberOfPoints || outputMesh->GetNumberOfCells() != numberOfCells)
+  {
+    std::cerr << "Expected " << numberOfPoints << " points and " << numberOfCells << " cells, got "
+              << outputMesh->GetNumberOfPoints() << " and " << outputMesh->GetNumberOfCells() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The point data of a point is its input identifier
+  std::vector<itk::SizeValueType> pointOrder(numberOfPoints);
+  for (MeshType::PointIdentifier pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    PixelType inputPointId = 0;
+    outputMesh->GetPointData(pointId, &inputPointId);
+    pointOrder[pointId] = static_cast<itk::SizeValueType>(inputPointId);
+    if (pointOrder[pointId] >= numberOfPoints)
+    {
+      std::cerr << "Point data of point " << pointId << " is not a point identifier" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (outputMesh->GetPoint(pointId) != inputMesh->GetPoint(pointOrder[pointId]))
+    {
+      std::cerr << "Point " << pointId << " does not carry the point data of input point " << pointOrder[pointId]
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (!isPermutation(pointOrder))
+  {
+    std::cerr << "The output points are not a permutation of the input points" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The cell data of a cell is its input identifier
+  std::vector<itk::SizeValueType> cellOrder(numberOfCells);
+  for (MeshType::CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    PixelType inputCellId = 0;
+    outputMesh->GetCellData(cellId, &inputCellId);
+    cellOrder[cellId] = static_cast<itk::SizeValueType>(inputCellId);
+    if (cellOrder[cellId] >= numberOfCells)
+    {
+      std::cerr << "Cell data of cell " << cellId << " is not a cell identifier" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    MeshType::CellAutoPointer outputCell;
+    MeshType::CellAutoPointer inputCell;
+    outputMesh->GetCell(cellId, outputCell);
+    inputMesh->GetCell(cellOrder[cellId], inputCell);
+    if (outputCell->GetType() != inputCell->GetType() || outputCell->GetNumberOfPoints() != inputCell->GetNumberOfPoints())
+    {
+      std::cerr << "Cell " << cellId << " does not match input cell " << cellOrder[cellId] << std::endl;
+      return EXIT_FAILURE;
+    }
+    const auto outputPointIds = outputCell->PointIdsBegin();
+    const auto inputPointIds = inputCell->PointIdsBegin();
+    for (unsigned int cellPoint = 0; cellPoint < outputCell->GetNumberOfPoints(); ++cellPoint)
+    {
+      if (outputMesh->GetPoint(outputPointIds[cellPoint]) != inputMesh->GetPoint(inputPointIds[cellPoint]))
+      {
+        std::cerr << "Point " << cellPoint << " of cell " << cellId << " moved" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (!isPermutation(cellOrder))
+  {
+    std::cerr << "The output cells are not a permutation of the input cells" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream metricsStream(metricsFile);
+  rapidjson::IStreamWrapper metricsStreamWrapper(metricsStream);
+  rapidjson::Document metrics;
+  metrics.ParseStream(metricsStreamWrapper);
+  if (metrics.HasParseError() || !metrics.HasMember("input") || !metrics.HasMember("output"))
+  {
+    std::cerr << "Could not parse " << metricsFile << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned int cacheSize = metrics["cacheSize"].GetUint();
+  const itk::WasmMeshLocalityMetrics inputMetrics = itk::measureMeshLocality(meshCellPoints(inputMesh), cacheSize);
+  const itk::WasmMeshLocalityMetrics outputMetrics = itk::measureMeshLocality(meshCellPoints(outputMesh), cacheSize);
+  std::cout << "ACMR " << inputMetrics.averageCacheMissRatio << " -> " << outputMetrics.averageCacheMissRatio
+            << ", reported " << metrics["input"]["averageCacheMissRatio"].GetDouble() << " -> "
+            << metrics["output"]["averageCacheMissRatio"].GetDouble() << std::endl;
+  if (outputMetrics.averageCacheMissRatio > inputMetrics.averageCacheMissRatio)
+  {
+    std::cerr << "The average cache miss ratio got worse" << std::endl;
+    return EXIT_FAILURE;
+  }
+  constexpr double tolerance = 1e-9;
+  if (std::abs(metrics["output"]["averageCacheMissRatio"].GetDouble() - outputMetrics.averageCacheMissRatio) > tolerance ||
+      std::abs(metrics["input"]["averageCacheMissRatio"].GetDouble() - inputMetrics.averageCacheMissRatio) > tolerance)
+  {
+    std::cerr << "The reported average cache miss ratios do not match the meshes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+int
+main(int argc, char * argv[])
+{
+  const std::string mode = argc > 1 ? argv[1] : "";
+  try
+  {
+    if (mode == "generate" && argc == 3)
+    {
+      return generate(argv[2]);
+    }
+    if (mode == "verify" && argc == 5)
+    {
+      return verify(argv[2], argv[3], argv[4]);
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cerr << "Usage: " << argv[0] << " generate <input.iwm.cbor>" << std::endl;
+  std::cerr << "       " << argv[0] << " verify <input.iwm.cbor> <output.iwm.cbor> <metrics.json>" << std::endl;
+  return EXIT_FAILURE;
+}
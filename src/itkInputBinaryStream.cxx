@@ -16,8 +16,10 @@
  *
  *=========================================================================*/
 #include "itkInputBinaryStream.h"
+#include "itkWasmIOCommon.h"
 
 #include <string>
+#include <fstream>
 #ifndef ITK_WASM_NO_MEMORY_IO
 #include "itkWasmExports.h"
 #endif
@@ -27,17 +29,74 @@ namespace itk
 namespace wasm
 {
 
+InputBinaryStream
+::InputBinaryStream() = default;
+
+InputBinaryStream
+::~InputBinaryStream()
+{
+  this->DeleteIStream();
+}
+
+void
+InputBinaryStream
+::DeleteIStream()
+{
+  if (m_DeleteIStream && m_IStream != nullptr)
+  {
+    delete m_IStream;
+  }
+  m_IStream = nullptr;
+  m_DeleteIStream = false;
+  m_FileName.clear();
+  m_Span = {};
+  m_MappedFile.reset();
+}
+
+void
+InputBinaryStream
+::SetJSON(const std::string & json)
+{
+  this->DeleteIStream();
+  const std::string_view data = WasmStringStream::GetDataFromJSON(json.c_str());
+  m_Span = std::as_bytes(std::span<const char>(data.data(), data.size()));
+  m_IStream = new WasmMemoryInputStream(data.data(), data.size());
+  m_DeleteIStream = true;
+}
+
+void
+InputBinaryStream
+::SetFileName(const std::string & fileName)
+{
+  this->DeleteIStream();
+  m_IStream = new std::ifstream(fileName, std::ifstream::in | std::ifstream::binary);
+  m_DeleteIStream = true;
+  m_FileName = fileName;
+}
+
+std::span<const std::byte>
+InputBinaryStream
+::GetSpan()
+{
+  if (!m_MappedFile && !m_FileName.empty())
+  {
+    m_MappedFile = std::make_unique<WasmMemoryMappedFile>(m_FileName);
+    m_Span = std::as_bytes(std::span<const char>(m_MappedFile->GetData(), m_MappedFile->GetSize()));
+  }
+  return m_Span;
+}
+
 bool lexical_cast(const std::string &input, InputBinaryStream &inputStream)
 {
   if (input.empty())
   {
     return false;
   }
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputStream.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    const auto json = getMemoryStoreInputJSON(0, index);
+    const char * json = inputStream.GetMemoryContext()->GetInputJSON(index);
     inputStream.SetJSON(json);
 #else
     return false;
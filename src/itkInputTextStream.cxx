@@ -33,11 +33,11 @@ bool lexical_cast(const std::string &input, InputTextStream &inputStream)
   {
     return false;
   }
-  if (wasm::Pipeline::get_use_memory_io())
+  if (inputStream.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    const auto json = getMemoryStoreInputJSON(0, index);
+    const char * json = inputStream.GetMemoryContext()->GetInputJSON(index);
     inputStream.SetJSON(json);
 #else
     return false;
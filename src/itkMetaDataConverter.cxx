@@ -0,0 +1,76 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataConverterRegistry.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+namespace
+{
+
+void
+updateMatchedTypes(std::vector<std::type_index> & matchedTypes, const std::type_index & typeIndex, bool matched)
+{
+  matchedTypes.erase(std::remove(matchedTypes.begin(), matchedTypes.end(), typeIndex), matchedTypes.end());
+  if (matched)
+  {
+    matchedTypes.push_back(typeIndex);
+  }
+}
+
+} // end anonymous namespace
+
+MetaDataConverterRegistry::MetaDataConverterRegistry()
+{
+  addBuiltinJSONConversions(*this);
+  addBuiltinCBORConversions(*this);
+}
+
+MetaDataConverterRegistry &
+getMetaDataConverterRegistry()
+{
+  static MetaDataConverterRegistry registry;
+  return registry;
+}
+
+void RegisterMetaDataConverter(const std::type_info & valueType, MetaDataConverter converter)
+{
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::unique_lock<std::shared_mutex> lock(registry.mutex);
+  const std::type_index typeIndex(valueType);
+  updateMatchedTypes(registry.jsonMatchedTypes, typeIndex, converter.jsonMatcher && converter.jsonDecoder);
+  updateMatchedTypes(registry.cborMatchedTypes, typeIndex, converter.cborMatcher && converter.cborDecoder);
+  registry.converters.insert_or_assign(typeIndex, std::move(converter));
+}
+
+const MetaDataConverter * GetMetaDataConverter(const std::type_info & valueType)
+{
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+  const auto converter = registry.converters.find(std::type_index(valueType));
+  return converter == registry.converters.end() ? nullptr : &converter->second;
+}
+
+} // end namespace wasm
+} // end namespace itk
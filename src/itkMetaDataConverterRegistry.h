@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMetaDataConverterRegistry_h
+#define itkMetaDataConverterRegistry_h
+
+#include "itkMetaDataConverter.h"
+#include "itkArray.h"
+#include "itkMatrix.h"
+
+#include <shared_mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+/** Converters of the JSON and CBOR metadata representations, keyed by the
+ * value type. Private to the implementation of the conversions. */
+struct MetaDataConverterRegistry
+{
+  /** Registers the built-in converters. */
+  MetaDataConverterRegistry();
+
+  std::shared_mutex mutex;
+  std::unordered_map<std::type_index, MetaDataConverter> converters;
+  // Types of the converters with a matcher and a decoder, in registration order
+  std::vector<std::type_index> jsonMatchedTypes;
+  std::vector<std::type_index> cborMatchedTypes;
+};
+
+/** The registry, with the built-in converters. */
+MetaDataConverterRegistry &
+getMetaDataConverterRegistry();
+
+/** Add the JSON and CBOR conversions of the built-in value types. Defined
+ * with each representation. */
+void
+addBuiltinJSONConversions(MetaDataConverterRegistry & registry);
+void
+addBuiltinCBORConversions(MetaDataConverterRegistry & registry);
+
+template <typename... TValues>
+struct MetaDataTypeList
+{};
+
+template <typename... TElements>
+using MetaDataArrayTypes =
+  MetaDataTypeList<std::vector<TElements>..., std::vector<std::vector<TElements>>..., Array<TElements>...>;
+
+/** Value types that are converted without registration: the types ITK
+ * stores in dictionaries, see ITK/Modules/Core/Common/src/itkMetaDataObject.cxx,
+ * numeric std::vector and itk::Array values, and square float and double
+ * matrices of dimension 2, 3 and 4. */
+using BuiltinMetaDataScalarTypes = MetaDataTypeList<bool, char, signed char, unsigned char, short, unsigned short, int,
+                                                    unsigned int, long, unsigned long, long long, unsigned long long,
+                                                    float, double, std::string>;
+using BuiltinMetaDataArrayTypes = MetaDataArrayTypes<char, signed char, unsigned char, short, unsigned short, int,
+                                                     unsigned int, long, unsigned long, long long, unsigned long long,
+                                                     float, double>;
+using BuiltinMetaDataStringArrayTypes = MetaDataTypeList<std::vector<std::string>, std::vector<std::vector<std::string>>>;
+using BuiltinMetaDataMatrixTypes = MetaDataTypeList<Matrix<float, 2, 2>, Matrix<float, 3, 3>, Matrix<float, 4, 4>,
+                                                    Matrix<double, 2, 2>, Matrix<double, 3, 3>, Matrix<double, 4, 4>>;
+
+/** Call visitor with a std::type_identity of each built-in value type. */
+template <typename TVisitor>
+void
+visitBuiltinMetaDataTypes(TVisitor && visitor)
+{
+  const auto visitTypes = [&visitor]<typename... TValues>(MetaDataTypeList<TValues...>) {
+    (visitor(std::type_identity<TValues>{}), ...);
+  };
+  visitTypes(BuiltinMetaDataScalarTypes{});
+  visitTypes(BuiltinMetaDataArrayTypes{});
+  visitTypes(BuiltinMetaDataStringArrayTypes{});
+  visitTypes(BuiltinMetaDataMatrixTypes{});
+}
+
+} // end namespace wasm
+} // end namespace itk
+
+#endif
@@ -0,0 +1,581 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkMetaDataConverterRegistry.h"
+
+#include "itkMetaDataObject.h"
+#include "itkArray.h"
+#include "itkMatrix.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
+
+namespace itk
+{
+
+namespace wasm
+{
+
+namespace
+{
+
+constexpr uint8_t cborUnsignedIntegerType = 0;
+constexpr uint8_t cborNegativeIntegerType = 1;
+constexpr uint8_t cborArrayType = 4;
+constexpr uint8_t cborSimpleType = 7;
+constexpr uint8_t cborFalse = 20;
+constexpr uint8_t cborTrue = 21;
+constexpr uint8_t cborFloat32Head = 0xFA;
+constexpr uint8_t cborFloat64Head = 0xFB;
+
+// RFC 8746 multi-dimensional array, row-major order
+constexpr uint64_t cborMultiDimensionalArrayTag = 40;
+
+template <typename T>
+struct IsStdVector : std::false_type
+{};
+
+template <typename T>
+struct IsStdVector<std::vector<T>> : std::true_type
+{};
+
+/** RFC 8746 typed array tag of the element type, as used for the image data
+ * by cborTypedArrayTag. */
+template <typename T>
+constexpr uint64_t
+typedArrayTag()
+{
+  if constexpr (std::is_same_v<T, float>)
+  {
+    return 85;
+  }
+  else if constexpr (std::is_same_v<T, double>)
+  {
+    return 86;
+  }
+  else if constexpr (std::is_unsigned_v<T>)
+  {
+    return sizeof(T) == 1 ? 64 : sizeof(T) == 2 ? 69 : sizeof(T) == 4 ? 70 : 71;
+  }
+  else
+  {
+    return sizeof(T) == 1 ? 72 : sizeof(T) == 2 ? 73 : sizeof(T) == 4 ? 74 : 75;
+  }
+}
+
+/** Call visitor with a value of the element type of the typed array tag.
+ * Returns false for other tags. */
+template <typename TVisitor>
+bool
+visitTypedArrayElementType(uint64_t tag, TVisitor && visitor)
+{
+  switch (tag)
+  {
+    case 64:
+      visitor(uint8_t{});
+      return true;
+    case 72:
+      visitor(int8_t{});
+      return true;
+    case 69:
+      visitor(uint16_t{});
+      return true;
+    case 73:
+    case 77:
+      visitor(int16_t{});
+      return true;
+    case 70:
+      visitor(uint32_t{});
+      return true;
+    case 74:
+    case 78:
+      visitor(int32_t{});
+      return true;
+    case 71:
+      visitor(uint64_t{});
+      return true;
+    case 75:
+    case 79:
+      visitor(int64_t{});
+      return true;
+    case 85:
+      visitor(float{});
+      return true;
+    case 86:
+      visitor(double{});
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename TUnsigned>
+void
+writeFloat(WasmCBORStreamWriter & writer, uint8_t head, TUnsigned bits)
+{
+  unsigned char encoded[1 + sizeof(TUnsigned)];
+  encoded[0] = head;
+  for (unsigned int ii = 0; ii < sizeof(TUnsigned); ++ii)
+  {
+    encoded[1 + ii] = static_cast<unsigned char>(bits >> (8 * (sizeof(TUnsigned) - 1 - ii)));
+  }
+  writer.WriteBytes(encoded, sizeof(encoded));
+}
+
+template <typename T>
+void
+writeTypedArray(WasmCBORStreamWriter & writer, const T * values, size_t count)
+{
+  // Todo: support endianness, as for the image data
+  writer.WriteTag(typedArrayTag<T>());
+  writer.WriteByteStringHead(count * sizeof(T));
+  writer.WriteBytes(values, count * sizeof(T));
+}
+
+template <typename T>
+void
+writeValue(WasmCBORStreamWriter & writer, const T & value)
+{
+  if constexpr (std::is_same_v<T, bool>)
+  {
+    writer.WriteHead(cborSimpleType, value ? cborTrue : cborFalse);
+  }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    if constexpr (std::is_signed_v<T>)
+    {
+      if (value < 0)
+      {
+        writer.WriteHead(cborNegativeIntegerType, static_cast<uint64_t>(-(static_cast<int64_t>(value) + 1)));
+        return;
+      }
+    }
+    writer.WriteHead(cborUnsignedIntegerType, static_cast<uint64_t>(value));
+  }
+  else if constexpr (std::is_same_v<T, float>)
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeFloat(writer, cborFloat32Head, bits);
+  }
+  else if constexpr (std::is_floating_point_v<T>)
+  {
+    const double doubleValue = value;
+    uint64_t bits;
+    std::memcpy(&bits, &doubleValue, sizeof(bits));
+    writeFloat(writer, cborFloat64Head, bits);
+  }
+  else if constexpr (std::is_same_v<T, std::string>)
+  {
+    writer.WriteString(value);
+  }
+  else if constexpr (IsStdVector<T>::value && std::is_arithmetic_v<typename T::value_type>)
+  {
+    writeTypedArray(writer, value.data(), value.size());
+  }
+  else if constexpr (IsStdVector<T>::value)
+  {
+    writer.WriteHead(cborArrayType, value.size());
+    for (const auto & element : value)
+    {
+      writeValue(writer, element);
+    }
+  }
+  else
+  {
+    static_assert(!sizeof(T), "Unsupported metadata value type");
+  }
+}
+
+template <typename T>
+void
+writeValue(WasmCBORStreamWriter & writer, const Array<T> & value)
+{
+  writeTypedArray(writer, value.data_block(), value.Size());
+}
+
+template <typename T, unsigned int VRows, unsigned int VColumns>
+void
+writeValue(WasmCBORStreamWriter & writer, const Matrix<T, VRows, VColumns> & value)
+{
+  writer.WriteTag(cborMultiDimensionalArrayTag);
+  writer.WriteHead(cborArrayType, 2);
+  writer.WriteHead(cborArrayType, 2);
+  writeValue(writer, VRows);
+  writeValue(writer, VColumns);
+  writeTypedArray(writer, value.GetVnlMatrix().data_block(), VRows * VColumns);
+}
+
+/** Item tagged by tagItem, which keeps ownership. */
+const cbor_item_t *
+taggedItem(const cbor_item_t * tagItem)
+{
+  cbor_item_t * item = cbor_tag_item(tagItem);
+  cbor_intermediate_decref(item);
+  return item;
+}
+
+/** Bytestring and element type tag of an RFC 8746 typed array, or nullptr. */
+const cbor_item_t *
+typedArrayBytes(const cbor_item_t * item, uint64_t & tag)
+{
+  if (!cbor_isa_tag(item))
+  {
+    return nullptr;
+  }
+  tag = cbor_tag_value(item);
+  const cbor_item_t * bytes = taggedItem(item);
+  if (!cbor_isa_bytestring(bytes) || !cbor_bytestring_is_definite(bytes))
+  {
+    return nullptr;
+  }
+  return bytes;
+}
+
+template <typename T>
+std::vector<T>
+typedArrayValues(const cbor_item_t * bytes)
+{
+  std::vector<T> values(cbor_bytestring_length(bytes) / sizeof(T));
+  if (!values.empty())
+  {
+    // The bytestring is not necessarily aligned
+    std::memcpy(values.data(), cbor_bytestring_handle(bytes), values.size() * sizeof(T));
+  }
+  return values;
+}
+
+std::string
+stringValue(const cbor_item_t * item)
+{
+  return std::string(reinterpret_cast<const char *>(cbor_string_handle(item)), cbor_string_length(item));
+}
+
+bool
+isDefiniteString(const cbor_item_t * item)
+{
+  return cbor_isa_string(item) && cbor_string_is_definite(item);
+}
+
+/** Whether rows x columns is the shape of count values. Empty shapes are
+ * rejected, and the product is not formed, so that it cannot overflow. */
+bool
+isMatrixShape(uint64_t rows, uint64_t columns, size_t count)
+{
+  return rows > 0 && columns > 0 && rows <= count && columns <= count && count % columns == 0 &&
+         count / columns == rows;
+}
+
+template <typename T>
+void
+decodeMatrix(const std::string & key, const std::vector<T> & values, uint64_t rows, uint64_t columns,
+             MetaDataDictionary & dictionary)
+{
+  if (!isMatrixShape(rows, columns, values.size()))
+  {
+    return;
+  }
+  const auto encapsulateMatrix = [&](auto dimension) {
+    constexpr unsigned int Dimension = decltype(dimension)::value;
+    Matrix<T, Dimension, Dimension> matrix;
+    std::copy(values.begin(), values.end(), matrix.GetVnlMatrix().data_block());
+    EncapsulateMetaData(dictionary, key, matrix);
+  };
+  if constexpr (std::is_floating_point_v<T>)
+  {
+    if (rows == columns && rows == 2)
+    {
+      encapsulateMatrix(std::integral_constant<unsigned int, 2>{});
+      return;
+    }
+    if (rows == columns && rows == 3)
+    {
+      encapsulateMatrix(std::integral_constant<unsigned int, 3>{});
+      return;
+    }
+    if (rows == columns && rows == 4)
+    {
+      encapsulateMatrix(std::integral_constant<unsigned int, 4>{});
+      return;
+    }
+  }
+  std::vector<std::vector<T>> matrix(static_cast<size_t>(rows));
+  for (size_t ii = 0; ii < matrix.size(); ++ii)
+  {
+    const auto row = values.begin() + ii * columns;
+    matrix[ii].assign(row, row + columns);
+  }
+  EncapsulateMetaData(dictionary, key, matrix);
+}
+
+void
+decodeTagged(const std::string & key, const cbor_item_t * item, MetaDataDictionary & dictionary)
+{
+  uint64_t tag = 0;
+  if (const cbor_item_t * bytes = typedArrayBytes(item, tag))
+  {
+    visitTypedArrayElementType(tag, [&](auto element) {
+      EncapsulateMetaData(dictionary, key, typedArrayValues<decltype(element)>(bytes));
+    });
+    return;
+  }
+  if (cbor_tag_value(item) != cborMultiDimensionalArrayTag)
+  {
+    return;
+  }
+  const cbor_item_t * array = taggedItem(item);
+  if (!cbor_isa_array(array) || cbor_array_size(array) != 2)
+  {
+    return;
+  }
+  const cbor_item_t * dimensions = cbor_array_handle(array)[0];
+  if (!cbor_isa_array(dimensions) || cbor_array_size(dimensions) != 2 ||
+      !cbor_isa_uint(cbor_array_handle(dimensions)[0]) || !cbor_isa_uint(cbor_array_handle(dimensions)[1]))
+  {
+    return;
+  }
+  const uint64_t rows = cbor_get_int(cbor_array_handle(dimensions)[0]);
+  const uint64_t columns = cbor_get_int(cbor_array_handle(dimensions)[1]);
+  const cbor_item_t * bytes = typedArrayBytes(cbor_array_handle(array)[1], tag);
+  if (bytes == nullptr)
+  {
+    return;
+  }
+  visitTypedArrayElementType(tag, [&](auto element) {
+    decodeMatrix(key, typedArrayValues<decltype(element)>(bytes), rows, columns, dictionary);
+  });
+}
+
+void
+decodeArray(const std::string & key, const cbor_item_t * item, MetaDataDictionary & dictionary)
+{
+  const size_t size = cbor_array_size(item);
+  cbor_item_t ** elements = cbor_array_handle(item);
+  const auto allOf = [elements, size](auto predicate) { return std::all_of(elements, elements + size, predicate); };
+
+  if (allOf(isDefiniteString))
+  {
+    std::vector<std::string> value(size);
+    std::transform(elements, elements + size, value.begin(), stringValue);
+    EncapsulateMetaData(dictionary, key, value);
+    return;
+  }
+
+  uint64_t tag = 0;
+  if (typedArrayBytes(elements[0], tag) != nullptr)
+  {
+    uint64_t elementTag = 0;
+    if (!allOf([tag, &elementTag](const cbor_item_t * element) {
+          return typedArrayBytes(element, elementTag) != nullptr && elementTag == tag;
+        }))
+    {
+      return;
+    }
+    visitTypedArrayElementType(tag, [&](auto element) {
+      using ElementType = decltype(element);
+      std::vector<std::vector<ElementType>> value(size);
+      for (size_t ii = 0; ii < size; ++ii)
+      {
+        value[ii] = typedArrayValues<ElementType>(typedArrayBytes(elements[ii], elementTag));
+      }
+      EncapsulateMetaData(dictionary, key, value);
+    });
+    return;
+  }
+
+  const auto isStringArray = [](const cbor_item_t * element) {
+    return cbor_isa_array(element) && std::all_of(cbor_array_handle(element), cbor_array_handle(element) + cbor_array_size(element), isDefiniteString);
+  };
+  if (allOf(isStringArray))
+  {
+    std::vector<std::vector<std::string>> value(size);
+    for (size_t ii = 0; ii < size; ++ii)
+    {
+      const size_t rowSize = cbor_array_size(elements[ii]);
+      value[ii].resize(rowSize);
+      std::transform(cbor_array_handle(elements[ii]), cbor_array_handle(elements[ii]) + rowSize, value[ii].begin(), stringValue);
+    }
+    EncapsulateMetaData(dictionary, key, value);
+  }
+}
+
+void
+decodeValue(const std::string & key, const cbor_item_t * item, MetaDataDictionary & dictionary)
+{
+  switch (cbor_typeof(item))
+  {
+    case CBOR_TYPE_UINT:
+    {
+      const uint64_t value = cbor_get_int(item);
+      if (value <= static_cast<uint64_t>(std::numeric_limits<int>::max()))
+      {
+        EncapsulateMetaData<int>(dictionary, key, static_cast<int>(value));
+      }
+      else if (value <= std::numeric_limits<unsigned int>::max())
+      {
+        EncapsulateMetaData<unsigned int>(dictionary, key, static_cast<unsigned int>(value));
+      }
+      else if (value <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      {
+        EncapsulateMetaData<int64_t>(dictionary, key, static_cast<int64_t>(value));
+      }
+      else
+      {
+        EncapsulateMetaData<uint64_t>(dictionary, key, value);
+      }
+      break;
+    }
+    case CBOR_TYPE_NEGINT:
+    {
+      const uint64_t argument = cbor_get_int(item);
+      if (argument > static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+      {
+        break;
+      }
+      const int64_t value = -static_cast<int64_t>(argument) - 1;
+      if (value >= std::numeric_limits<int>::min())
+      {
+        EncapsulateMetaData<int>(dictionary, key, static_cast<int>(value));
+      }
+      else
+      {
+        EncapsulateMetaData<int64_t>(dictionary, key, value);
+      }
+      break;
+    }
+    case CBOR_TYPE_STRING:
+      if (cbor_string_is_definite(item))
+      {
+        EncapsulateMetaData<std::string>(dictionary, key, stringValue(item));
+      }
+      break;
+    case CBOR_TYPE_ARRAY:
+      if (cbor_array_size(item) == 0)
+      {
+        EncapsulateMetaData(dictionary, key, std::vector<std::string>());
+      }
+      else
+      {
+        decodeArray(key, item, dictionary);
+      }
+      break;
+    case CBOR_TYPE_TAG:
+      decodeTagged(key, item, dictionary);
+      break;
+    case CBOR_TYPE_FLOAT_CTRL:
+      if (cbor_float_get_width(item) == CBOR_FLOAT_32)
+      {
+        EncapsulateMetaData<float>(dictionary, key, cbor_float_get_float4(item));
+      }
+      else if (cbor_is_float(item))
+      {
+        EncapsulateMetaData<double>(dictionary, key, cbor_float_get_float(item));
+      }
+      else if (cbor_is_bool(item))
+      {
+        EncapsulateMetaData<bool>(dictionary, key, cbor_get_bool(item));
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+} // end anonymous namespace
+
+void
+addBuiltinCBORConversions(MetaDataConverterRegistry & registry)
+{
+  visitBuiltinMetaDataTypes([&registry](auto valueType) {
+    using T = typename decltype(valueType)::type;
+    registry.converters[std::type_index(typeid(T))].cborEncoder = [](const MetaDataObjectBase & object, WasmCBORStreamWriter & writer) {
+      writeValue(writer, static_cast<const MetaDataObject<T> &>(object).GetMetaDataObjectValue());
+    };
+  });
+}
+
+void ConvertMetaDataDictionaryToCBOR(const itk::MetaDataDictionary & dictionary, WasmCBORStreamWriter & writer)
+{
+  struct EncodedEntry
+  {
+    const std::string * key;
+    const MetaDataObjectBase * object;
+    const MetaDataConverter::CBOREncoderType * encoder;
+  };
+
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+
+  // The map head needs the number of entries with a CBOR encoder
+  std::vector<EncodedEntry> entries;
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    const MetaDataObjectBase * object = itr->second.GetPointer();
+    const auto converter = registry.converters.find(std::type_index(object->GetMetaDataObjectTypeInfo()));
+    if (converter != registry.converters.end() && converter->second.cborEncoder)
+    {
+      entries.push_back({ &itr->first, object, &converter->second.cborEncoder });
+    }
+  }
+
+  writer.WriteMapHead(entries.size());
+  for (const EncodedEntry & entry : entries)
+  {
+    writer.WriteString(*entry.key);
+    (*entry.encoder)(*entry.object, writer);
+  }
+}
+
+void ConvertCBORToMetaDataDictionary(const cbor_item_t * metadataItem, itk::MetaDataDictionary & dictionary)
+{
+  if (!cbor_isa_map(metadataItem))
+  {
+    return;
+  }
+
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+  const size_t entryCount = cbor_map_size(metadataItem);
+  const struct cbor_pair * entries = cbor_map_handle(metadataItem);
+  for (size_t ii = 0; ii < entryCount; ++ii)
+  {
+    if (!isDefiniteString(entries[ii].key))
+    {
+      continue;
+    }
+    const std::string key = stringValue(entries[ii].key);
+    const cbor_item_t * value = entries[ii].value;
+    const auto matchedType = std::find_if(registry.cborMatchedTypes.rbegin(), registry.cborMatchedTypes.rend(),
+      [&registry, value](const std::type_index & typeIndex) { return registry.converters.at(typeIndex).cborMatcher(value); });
+    if (matchedType != registry.cborMatchedTypes.rend())
+    {
+      registry.converters.at(*matchedType).cborDecoder(key, value, dictionary);
+      continue;
+    }
+    decodeValue(key, value, dictionary);
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -16,6 +16,13 @@
  *
  *=========================================================================*/
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkMetaDataConverterRegistry.h"
+
+#include <algorithm>
+#include <mutex>
+#include <type_traits>
+#include <typeindex>
+#include <vector>
 
 namespace itk
 {
@@ -23,781 +30,356 @@ namespace itk
 namespace wasm
 {
 
-void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator)
+namespace
 {
-  auto itr = dictionary.Begin();
-  auto end = dictionary.End();
-  while (itr != end)
-  {
-    // rapidjson types
-    using MetaDataBoolType = MetaDataObject<bool>;
-    using MetaDataIntType = MetaDataObject<int>;
-    using MetaDataUintType = MetaDataObject<unsigned int>;
-    using MetaDataInt64Type = MetaDataObject<int64_t>;
-    using MetaDataUint64Type = MetaDataObject<uint64_t>;
-    using MetaDataFloatType = MetaDataObject<float>;
-    using MetaDataDoubleType = MetaDataObject<double>;
-    using MetaDataStringType = MetaDataObject<std::string>;
-    using MetaDataVectorIntType = MetaDataObject<std::vector<int>>;
-    using MetaDataVectorUintType = MetaDataObject<std::vector<unsigned int>>;
-    using MetaDataVectorInt64Type = MetaDataObject<std::vector<int64_t>>;
-    using MetaDataVectorUint64Type = MetaDataObject<std::vector<uint64_t>>;
-    using MetaDataVectorFloatType = MetaDataObject<std::vector<float>>;
-    using MetaDataVectorDoubleType = MetaDataObject<std::vector<double>>;
-    using MetaDataVectorStringType = MetaDataObject<std::vector<std::string>>;
-    using MetaDataVectorVectorIntType = MetaDataObject<std::vector<std::vector<int>>>;
-    using MetaDataVectorVectorUintType = MetaDataObject<std::vector<std::vector<unsigned int>>>;
-    using MetaDataVectorVectorInt64Type = MetaDataObject<std::vector<std::vector<int64_t>>>;
-    using MetaDataVectorVectorUint64Type = MetaDataObject<std::vector<std::vector<uint64_t>>>;
-    using MetaDataVectorVectorFloatType = MetaDataObject<std::vector<std::vector<float>>>;
-    using MetaDataVectorVectorDoubleType = MetaDataObject<std::vector<std::vector<double>>>;
 
-    // Additional ITK used MetaDataDictionary types
-    // see ITK/Modules/Core/Common/src/itkMetaDataObject.cxx
-    using MetaDataUcharType = MetaDataObject<unsigned char>;
-    using MetaDataCharType = MetaDataObject<char>;
-    using MetaDataSignedCharType = MetaDataObject<signed char>;
-    using MetaDataUshortType = MetaDataObject<unsigned short>;
-    using MetaDataShortType = MetaDataObject<short>;
-    using MetaDataUlongType = MetaDataObject<unsigned long>;
-    using MetaDataLongType = MetaDataObject<long>;
-    using MetaDataUlongLongType = MetaDataObject<unsigned long long>;
-    using MetaDataLongLongType = MetaDataObject<long long>;
-    using MetaDataArrayCharType = MetaDataObject<Array<char>>;
-    using MetaDataArrayIntType = MetaDataObject<Array<int>>;
-    using MetaDataArrayFloatType = MetaDataObject<Array<float>>;
-    using MetaDataArrayDoubleType = MetaDataObject<Array<double>>;
-    using MetaDataMatrixFloat44Type = MetaDataObject<Matrix<float, 4, 4>>;
-    using MetaDataMatrixDoubleType = MetaDataObject<Matrix<double>>;
+using AllocatorType = rapidjson::Document::AllocatorType;
 
-    MetaDataObjectBase::Pointer entry = itr->second;
-    rapidjson::Value entryJson(rapidjson::kArrayType);
-    const std::string key = itr->first;
-    entryJson.PushBack(rapidjson::Value().SetString(key.c_str(), allocator), allocator);
+template <typename T>
+struct IsStdVector : std::false_type
+{};
 
-    const auto boolValue = dynamic_cast<MetaDataBoolType *>(entry.GetPointer());
-    if (boolValue)
-    {
-      const bool value = boolValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetBool(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto intValue = dynamic_cast<MetaDataIntType *>(entry.GetPointer());
-    if (intValue)
-    {
-      const int value = intValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uintValue = dynamic_cast<MetaDataUintType *>(entry.GetPointer());
-    if (uintValue)
-    {
-      const unsigned int value = uintValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto int64Value = dynamic_cast<MetaDataInt64Type *>(entry.GetPointer());
-    if (int64Value)
-    {
-      const int64_t value = int64Value->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uint64Value = dynamic_cast<MetaDataUint64Type *>(entry.GetPointer());
-    if (uint64Value)
-    {
-      const uint64_t value = uint64Value->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto doubleValue = dynamic_cast<MetaDataDoubleType *>(entry.GetPointer());
-    if (doubleValue)
-    {
-      const double value = doubleValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetDouble(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto floatValue = dynamic_cast<MetaDataFloatType *>(entry.GetPointer());
-    if (floatValue)
+template <typename T>
+struct IsStdVector<std::vector<T>> : std::true_type
+{};
+
+template <typename T>
+void
+valueToJSON(const T & value, rapidjson::Value & json, AllocatorType & allocator)
+{
+  if constexpr (std::is_same_v<T, bool>)
+  {
+    json.SetBool(value);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= sizeof(int))
+  {
+    json.SetInt(value);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) <= sizeof(unsigned int))
+  {
+    json.SetUint(value);
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+  {
+    json.SetInt64(value);
+  }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    json.SetUint64(value);
+  }
+  else if constexpr (std::is_same_v<T, float>)
+  {
+    json.SetFloat(value);
+  }
+  else if constexpr (std::is_floating_point_v<T>)
+  {
+    json.SetDouble(value);
+  }
+  else if constexpr (std::is_same_v<T, std::string>)
+  {
+    json.SetString(value.c_str(), static_cast<rapidjson::SizeType>(value.size()), allocator);
+  }
+  else
+  {
+    // std::vector, itk::Array
+    json.SetArray();
+    json.Reserve(static_cast<rapidjson::SizeType>(value.size()), allocator);
+    for (const auto & element : value)
     {
-      const float value = floatValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetFloat(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      rapidjson::Value elementJson;
+      valueToJSON(element, elementJson, allocator);
+      json.PushBack(elementJson, allocator);
     }
-    const auto stringValue = dynamic_cast<MetaDataStringType *>(entry.GetPointer());
-    if (stringValue)
+  }
+}
+
+template <typename T, unsigned int VRows, unsigned int VColumns>
+void
+valueToJSON(const Matrix<T, VRows, VColumns> & value, rapidjson::Value & json, AllocatorType & allocator)
+{
+  json.SetArray();
+  for (unsigned int ii = 0; ii < VRows; ++ii)
+  {
+    rapidjson::Value rowJson(rapidjson::kArrayType);
+    for (unsigned int jj = 0; jj < VColumns; ++jj)
     {
-      const std::string value = stringValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetString(value.c_str(), allocator), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      rapidjson::Value elementJson;
+      valueToJSON(value(ii, jj), elementJson, allocator);
+      rowJson.PushBack(elementJson, allocator);
     }
+    json.PushBack(rowJson, allocator);
+  }
+}
 
-    const auto intVectorValue = dynamic_cast<MetaDataVectorIntType *>(entry.GetPointer());
-    if (intVectorValue)
+template <typename T>
+T
+valueFromJSON(const rapidjson::Value & json)
+{
+  if constexpr (std::is_same_v<T, bool>)
+  {
+    return json.GetBool();
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= sizeof(int))
+  {
+    return static_cast<T>(json.GetInt());
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) <= sizeof(unsigned int))
+  {
+    return static_cast<T>(json.GetUint());
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+  {
+    return static_cast<T>(json.GetInt64());
+  }
+  else if constexpr (std::is_integral_v<T>)
+  {
+    return static_cast<T>(json.GetUint64());
+  }
+  else if constexpr (std::is_floating_point_v<T>)
+  {
+    return static_cast<T>(json.GetDouble());
+  }
+  else if constexpr (std::is_same_v<T, std::string>)
+  {
+    return std::string(json.GetString(), json.GetStringLength());
+  }
+  else
+  {
+    static_assert(IsStdVector<T>::value, "Unsupported metadata value type");
+    T value;
+    value.reserve(json.Size());
+    for (const auto & elementJson : json.GetArray())
     {
-      const std::vector<int> value = intVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      value.push_back(valueFromJSON<typename T::value_type>(elementJson));
     }
-    const auto uintVectorValue = dynamic_cast<MetaDataVectorUintType *>(entry.GetPointer());
-    if (uintVectorValue)
-    {
-      const std::vector<unsigned int> value = uintVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
+    return value;
+  }
+}
+
+/** Narrowest of int, unsigned int, int64_t, uint64_t and double that holds
+ * every number of the JSON values, or nullptr if one is not a number. */
+template <typename TVisitNumbers>
+const std::type_info *
+inferNumberType(TVisitNumbers visitNumbers)
+{
+  bool isNumber = true;
+  bool isInt = true;
+  bool isUint = true;
+  bool isInt64 = true;
+  bool isUint64 = true;
+  visitNumbers([&](const rapidjson::Value & json) {
+    isNumber = isNumber && json.IsNumber();
+    isInt = isInt && json.IsInt();
+    isUint = isUint && json.IsUint();
+    isInt64 = isInt64 && json.IsInt64();
+    isUint64 = isUint64 && json.IsUint64();
+  });
+  if (!isNumber)
+  {
+    return nullptr;
+  }
+  if (isInt)
+  {
+    return &typeid(int);
+  }
+  if (isUint)
+  {
+    return &typeid(unsigned int);
+  }
+  if (isInt64)
+  {
+    return &typeid(int64_t);
+  }
+  if (isUint64)
+  {
+    return &typeid(uint64_t);
+  }
+  return &typeid(double);
+}
+
+/** Value type of a JSON metadata value, or nullptr if it is not supported. */
+const std::type_info *
+inferValueType(const rapidjson::Value & json)
+{
+  if (json.IsBool())
+  {
+    return &typeid(bool);
+  }
+  if (json.IsNumber())
+  {
+    return inferNumberType([&json](auto visit) { visit(json); });
+  }
+  if (json.IsString())
+  {
+    return &typeid(std::string);
+  }
+  if (!json.IsArray())
+  {
+    return nullptr;
+  }
+  if (json.Empty() || json[0].IsString())
+  {
+    return &typeid(std::vector<std::string>);
+  }
+  if (json[0].IsNumber())
+  {
+    const std::type_info * elementType = inferNumberType([&json](auto visit) {
+      for (const auto & element : json.GetArray())
       {
-        valueJson.PushBack(rapidjson::Value().SetUint(vv), allocator);
+        visit(element);
       }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto int64VectorValue = dynamic_cast<MetaDataVectorInt64Type *>(entry.GetPointer());
-    if (int64VectorValue)
+    });
+    if (elementType == nullptr)
     {
-      const std::vector<int64_t> value = int64VectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt64(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return nullptr;
     }
-    const auto uint64VectorValue = dynamic_cast<MetaDataVectorUint64Type *>(entry.GetPointer());
-    if (uint64VectorValue)
+    if (*elementType == typeid(int))
     {
-      const std::vector<uint64_t> value = uint64VectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetUint64(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<int>);
     }
-    const auto doubleVectorValue = dynamic_cast<MetaDataVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorValue)
+    if (*elementType == typeid(unsigned int))
     {
-      const std::vector<double> value = doubleVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetDouble(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<unsigned int>);
     }
-    const auto floatVectorValue = dynamic_cast<MetaDataVectorFloatType *>(entry.GetPointer());
-    if (floatVectorValue)
+    if (*elementType == typeid(int64_t))
     {
-      const std::vector<float> value = floatVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetFloat(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<int64_t>);
     }
-    const auto stringVectorValue = dynamic_cast<MetaDataVectorStringType *>(entry.GetPointer());
-    if (stringVectorValue)
+    if (*elementType == typeid(uint64_t))
     {
-      const std::vector<std::string> value = stringVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetString(vv.c_str(), allocator), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<uint64_t>);
     }
-
-    const auto intVectorVectorValue = dynamic_cast<MetaDataVectorVectorIntType *>(entry.GetPointer());
-    if (intVectorVectorValue)
-    {
-      const std::vector<std::vector<int>> value = intVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetInt(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uintVectorVectorValue = dynamic_cast<MetaDataVectorVectorUintType *>(entry.GetPointer());
-    if (uintVectorVectorValue)
-    {
-      const std::vector<std::vector<unsigned int>> value = uintVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetUint(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto int64VectorVectorValue = dynamic_cast<MetaDataVectorVectorInt64Type *>(entry.GetPointer());
-    if (int64VectorVectorValue)
-    {
-      const std::vector<std::vector<int64_t>> value = int64VectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetInt64(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto uint64VectorVectorValue = dynamic_cast<MetaDataVectorVectorUint64Type *>(entry.GetPointer());
-    if (int64VectorVectorValue)
+    return &typeid(std::vector<double>);
+  }
+  if (json[0].IsArray())
+  {
+    for (const auto & row : json.GetArray())
     {
-      const std::vector<std::vector<uint64_t>> value = uint64VectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
+      if (!row.IsArray())
       {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetUint64(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
+        return nullptr;
       }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
     }
-    const auto doubleVectorVectorValue = dynamic_cast<MetaDataVectorVectorDoubleType *>(entry.GetPointer());
-    if (doubleVectorVectorValue)
+    const auto firstRow =
+      std::find_if(json.Begin(), json.End(), [](const rapidjson::Value & row) { return !row.Empty(); });
+    if (firstRow == json.End() || (*firstRow)[0].IsString())
     {
-      const std::vector<std::vector<double>> value = doubleVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
-        {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetDouble(uu), allocator);
-          }
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<std::vector<std::string>>);
     }
-    const auto floatVectorVectorValue = dynamic_cast<MetaDataVectorVectorFloatType *>(entry.GetPointer());
-    if (floatVectorVectorValue)
-    {
-      const std::vector<std::vector<float>> value = floatVectorVectorValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto aa: value)
+    const std::type_info * elementType = inferNumberType([&json](auto visit) {
+      for (const auto & row : json.GetArray())
       {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(auto vv: value)
+        for (const auto & element : row.GetArray())
         {
-          for(auto uu: vv)
-          {
-          vvJson.PushBack(rapidjson::Value().SetFloat(uu), allocator);
-          }
+          visit(element);
         }
-        valueJson.PushBack(vvJson, allocator);
       }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-
-    const auto ucharValue = dynamic_cast<MetaDataUcharType *>(entry.GetPointer());
-    if (ucharValue)
+    });
+    if (elementType == nullptr)
     {
-      const unsigned char value = ucharValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return nullptr;
     }
-    const auto charValue = dynamic_cast<MetaDataCharType *>(entry.GetPointer());
-    if (charValue)
+    if (*elementType == typeid(int))
     {
-      const char value = charValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<std::vector<int>>);
     }
-    const auto signedCharValue = dynamic_cast<MetaDataSignedCharType *>(entry.GetPointer());
-    if (signedCharValue)
+    if (*elementType == typeid(unsigned int))
     {
-      const signed char value = signedCharValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<std::vector<unsigned int>>);
     }
-    const auto ushortValue = dynamic_cast<MetaDataUshortType *>(entry.GetPointer());
-    if (ushortValue)
+    if (*elementType == typeid(int64_t))
     {
-      const unsigned short value = ushortValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<std::vector<int64_t>>);
     }
-    const auto shortValue = dynamic_cast<MetaDataShortType *>(entry.GetPointer());
-    if (shortValue)
+    if (*elementType == typeid(uint64_t))
     {
-      const short value = shortValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto ulongValue = dynamic_cast<MetaDataUlongType *>(entry.GetPointer());
-    if (ulongValue)
-    {
-      const unsigned long value = ulongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto longValue = dynamic_cast<MetaDataLongType *>(entry.GetPointer());
-    if (longValue)
-    {
-      const long value = longValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
+      return &typeid(std::vector<std::vector<uint64_t>>);
     }
-    const auto ulongLongValue = dynamic_cast<MetaDataUlongLongType *>(entry.GetPointer());
-    if (ulongLongValue)
-    {
-      const unsigned long long value = ulongLongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetUint64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto longLongValue = dynamic_cast<MetaDataLongLongType *>(entry.GetPointer());
-    if (longLongValue)
-    {
-      const long long value = longLongValue->GetMetaDataObjectValue();
-      entryJson.PushBack(rapidjson::Value().SetInt64(value), allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
-      continue;
-    }
-    const auto arrayCharValue = dynamic_cast<MetaDataArrayCharType *>(entry.GetPointer());
-    if (arrayCharValue)
+    return &typeid(std::vector<std::vector<double>>);
+  }
+  return nullptr;
+}
+
+} // end anonymous namespace
+
+void
+addBuiltinJSONConversions(MetaDataConverterRegistry & registry)
+{
+  visitBuiltinMetaDataTypes([&registry](auto valueType) {
+    using T = typename decltype(valueType)::type;
+    MetaDataConverter & converter = registry.converters[std::type_index(typeid(T))];
+    converter.jsonEncoder = [](const MetaDataObjectBase & object, rapidjson::Value & valueJson, AllocatorType & allocator) {
+      valueToJSON(static_cast<const MetaDataObject<T> &>(object).GetMetaDataObjectValue(), valueJson, allocator);
+    };
+    if constexpr (std::is_arithmetic_v<T> || std::is_same_v<T, std::string> || IsStdVector<T>::value)
+    {
+      converter.jsonDecoder = [](const std::string & key, const rapidjson::Value & valueJson, MetaDataDictionary & dictionary) {
+        EncapsulateMetaData<T>(dictionary, key, valueFromJSON<T>(valueJson));
+      };
+    }
+  });
+}
+
+void ConvertMetaDataDictionaryToJSON(const itk::MetaDataDictionary & dictionary, rapidjson::Value & metadataJson, rapidjson::Document::AllocatorType& allocator)
+{
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+  for (auto itr = dictionary.Begin(); itr != dictionary.End(); ++itr)
+  {
+    const MetaDataObjectBase * entry = itr->second.GetPointer();
+    const auto converter = registry.converters.find(std::type_index(entry->GetMetaDataObjectTypeInfo()));
+    if (converter == registry.converters.end() || !converter->second.jsonEncoder)
     {
-      const Array<char> value = arrayCharValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetInt(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto arrayFloatValue = dynamic_cast<MetaDataArrayFloatType *>(entry.GetPointer());
-    if (arrayFloatValue)
+
+    rapidjson::Value valueJson;
+    converter->second.jsonEncoder(*entry, valueJson, allocator);
+    const std::string & key = itr->first;
+    rapidjson::Value entryJson(rapidjson::kArrayType);
+    entryJson.Reserve(2, allocator);
+    entryJson.PushBack(rapidjson::Value().SetString(key.c_str(), static_cast<rapidjson::SizeType>(key.size()), allocator), allocator);
+    entryJson.PushBack(valueJson, allocator);
+    metadataJson.PushBack(entryJson, allocator);
+  }
+}
+
+void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary)
+{
+  if (!metadataJson.IsArray())
+  {
+    return;
+  }
+
+  MetaDataConverterRegistry & registry = getMetaDataConverterRegistry();
+  const std::shared_lock<std::shared_mutex> lock(registry.mutex);
+  for (const auto & entry : metadataJson.GetArray())
+  {
+    if (!entry.IsArray() || entry.Size() < 2 || !entry[0].IsString())
     {
-      const Array<float> value = arrayFloatValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetFloat(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto arrayDoubleValue = dynamic_cast<MetaDataArrayDoubleType *>(entry.GetPointer());
-    if (arrayDoubleValue)
+    const std::string key(entry[0].GetString(), entry[0].GetStringLength());
+    const rapidjson::Value & value = entry[1];
+    const auto matchedType = std::find_if(registry.jsonMatchedTypes.rbegin(), registry.jsonMatchedTypes.rend(),
+      [&registry, &value](const std::type_index & typeIndex) { return registry.converters.at(typeIndex).jsonMatcher(value); });
+    if (matchedType != registry.jsonMatchedTypes.rend())
     {
-      const Array<double> value = arrayDoubleValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(auto vv: value)
-      {
-        valueJson.PushBack(rapidjson::Value().SetDouble(vv), allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
+      registry.converters.at(*matchedType).jsonDecoder(key, value, dictionary);
       continue;
     }
-    const auto matrixFloat44Value = dynamic_cast<MetaDataMatrixFloat44Type *>(entry.GetPointer());
-    if (matrixFloat44Value)
+
+    const std::type_info * valueType = inferValueType(value);
+    if (valueType == nullptr)
     {
-      const Matrix<float, 4, 4> value = matrixFloat44Value->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(unsigned int ii = 0; ii < 4; ii++)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(unsigned int jj = 0; jj < 4; jj++)
-        {
-          vvJson.PushBack(rapidjson::Value().SetFloat(value(ii, jj)), allocator);
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-    const auto matrixDoubleValue = dynamic_cast<MetaDataMatrixDoubleType *>(entry.GetPointer());
-    if (matrixDoubleValue)
+    const auto converter = registry.converters.find(std::type_index(*valueType));
+    if (converter == registry.converters.end() || !converter->second.jsonDecoder)
     {
-      const Matrix<double, 3, 3> value = matrixDoubleValue->GetMetaDataObjectValue();
-      rapidjson::Value valueJson(rapidjson::kArrayType);
-      for(unsigned int ii = 0; ii < 3; ii++)
-      {
-        rapidjson::Value vvJson(rapidjson::kArrayType);
-        for(unsigned int jj = 0; jj < 3; jj++)
-        {
-          vvJson.PushBack(rapidjson::Value().SetDouble(value(ii, jj)), allocator);
-        }
-        valueJson.PushBack(vvJson, allocator);
-      }
-      entryJson.PushBack(valueJson, allocator);
-      metadataJson.PushBack(entryJson, allocator);
-      ++itr;
       continue;
     }
-
-    ++itr;
-  }
-
-}
-
-void ConvertJSONToMetaDataDictionary(const rapidjson::Value & metadataJson, itk::MetaDataDictionary & dictionary)
-{
-  if (metadataJson.IsArray())
-  {
-    for(rapidjson::SizeType ii = 0; ii < metadataJson.Size(); ++ii)
-      {
-      const rapidjson::Value & entry = metadataJson[ii];
-      const auto key = entry[0].GetString();
-      std::cout << "Read key: " << key << std::endl;
-      const rapidjson::Value & value = entry[1];
-      if (value.IsBool())
-        {
-        EncapsulateMetaData<bool>(dictionary, key, value.GetBool());
-        }
-      else if (value.IsInt())
-        {
-        EncapsulateMetaData<int>(dictionary, key, value.GetInt());
-        }
-      else if (value.IsUint())
-        {
-        EncapsulateMetaData<unsigned int>(dictionary, key, value.GetUint());
-        }
-      else if (value.IsInt64())
-        {
-        EncapsulateMetaData<int64_t>(dictionary, key, value.GetInt64());
-        }
-      else if (value.IsUint64())
-        {
-        EncapsulateMetaData<uint64_t>(dictionary, key, value.GetUint64());
-        }
-      else if (value.IsDouble())
-        {
-        EncapsulateMetaData<double>(dictionary, key, value.GetDouble());
-        }
-      else if (value.IsFloat())
-        {
-        EncapsulateMetaData<float>(dictionary, key, value.GetFloat());
-        }
-      else if (value.IsString())
-        {
-          std::cout << "encapsulating: " << key << " , "  << value.GetString() << std::endl;
-        EncapsulateMetaData<std::string>(dictionary, key, value.GetString());
-        }
-      else if (value.IsArray())
-        {
-        if (value.Size() == 0)
-        {
-          using ValueType = std::vector<std::string>;
-          ValueType val;
-          EncapsulateMetaData<ValueType>(dictionary, key, val);
-          continue;
-        }
-        if (value[0].IsString())
-          {
-          using ValueType = std::vector<std::string>;
-          ValueType val;
-          for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-            {
-            val.push_back(value[jj].GetString());
-            }
-          EncapsulateMetaData<ValueType>(dictionary, key, val);
-          }
-        else if (value[0].IsNumber())
-          {
-          if (value[0].IsArray())
-            {
-            if (value[0].Size() == 0 || value[0][0].IsString())
-              {
-              using ValueType = std::vector<std::vector<std::string>>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                {
-                std::vector<std::string> ve;
-                for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                  {
-                  ve.push_back(value[jj][kk].GetString());
-                  }
-                val.push_back(ve);
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value[0][0].IsNumber())
-              {
-              if (value.IsInt())
-                {
-                using ValueType = std::vector<std::vector<int>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<int> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetInt());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsUint())
-                {
-                using ValueType = std::vector<std::vector<unsigned int>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<unsigned int> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetUint());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsInt64())
-                {
-                using ValueType = std::vector<std::vector<int64_t>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<int64_t> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetInt64());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsUint64())
-                {
-                using ValueType = std::vector<std::vector<uint64_t>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<uint64_t> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetUint64());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsDouble())
-                {
-                using ValueType = std::vector<std::vector<double>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<double> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetDouble());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              else if (value.IsFloat())
-                {
-                using ValueType = std::vector<std::vector<float>>;
-                ValueType val;
-                for(rapidjson::SizeType jj = 0; jj < value[jj].Size(); ++jj)
-                  {
-                  std::vector<float> ve;
-                  for(rapidjson::SizeType kk = 0; kk < value[jj][kk].Size(); ++kk)
-                    {
-                    ve.push_back(value[jj][kk].GetFloat());
-                    }
-                  val.push_back(ve);
-                  }
-                EncapsulateMetaData<ValueType>(dictionary, key, val);
-                }
-              }
-            }
-          else
-            {
-            if (value.IsInt())
-              {
-              using ValueType = std::vector<int>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetInt());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsUint())
-              {
-              using ValueType = std::vector<unsigned int>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetUint());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsInt64())
-              {
-              using ValueType = std::vector<int64_t>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetInt64());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsUint64())
-              {
-              using ValueType = std::vector<uint64_t>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetUint64());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsDouble())
-              {
-              using ValueType = std::vector<double>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetDouble());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsFloat())
-              {
-              using ValueType = std::vector<float>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetFloat());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            else if (value.IsString())
-              {
-              using ValueType = std::vector<std::string>;
-              ValueType val;
-              for(rapidjson::SizeType jj = 0; jj < value.Size(); ++jj)
-                {
-                val.push_back(value[jj].GetString());
-                }
-              EncapsulateMetaData<ValueType>(dictionary, key, val);
-              }
-            }
-          }
-        }
-      }
+    converter->second.jsonDecoder(key, value, dictionary);
   }
 }
 
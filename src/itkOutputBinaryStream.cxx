@@ -33,7 +33,7 @@ namespace wasm
 OutputBinaryStream
 ::~OutputBinaryStream()
 {
-  if(wasm::Pipeline::get_use_memory_io())
+  if(this->m_MemoryContext->GetUseMemoryIO())
   {
     if (this->m_Identifier.empty())
       {
@@ -41,12 +41,13 @@ OutputBinaryStream
       }
 #ifndef ITK_WASM_NO_MEMORY_IO
     const auto index = std::stoi(this->m_Identifier);
-    setMemoryStoreOutputDataObject(0, index, this->m_WasmStringStream);
+    this->m_WasmStringStream->UpdateOutputJSON();
+    this->m_MemoryContext->SetOutputDataObject(index, this->m_WasmStringStream);
 
-    const std::string & string = this->m_WasmStringStream->GetString();
-    const auto dataAddress = reinterpret_cast< size_t >( string.data() );
-    const auto dataSize = string.size();
-    setMemoryStoreOutputArray(0, index, 0, dataAddress, dataSize);
+    const std::string_view data = this->m_WasmStringStream->GetOutputData();
+    const auto dataAddress = reinterpret_cast< size_t >( data.data() );
+    const auto dataSize = data.size();
+    this->m_MemoryContext->SetOutputArray(index, 0, dataAddress, dataSize);
 #else
     std::cerr << "Memory IO not supported" << std::endl;
     abort();
@@ -69,7 +70,7 @@ OutputBinaryStream
 
 bool lexical_cast(const std::string &output, OutputBinaryStream &outputStream)
 {
-  if (wasm::Pipeline::get_use_memory_io())
+  if (outputStream.GetMemoryContext()->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     outputStream.SetIdentifier(output);
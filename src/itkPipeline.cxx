@@ -29,9 +29,53 @@ namespace itk
 namespace wasm
 {
 
+namespace
+{
+
+// The context given, otherwise the context of the --memory-io-context
+// argument. It is resolved before parsing, since inputs and outputs capture
+// the current context when they are constructed.
+WasmMemoryContext *
+memoryContextFromArguments(int argc, char ** argv, WasmMemoryContext * context)
+{
+  if (context != nullptr)
+  {
+    return context;
+  }
+  const std::string option("--memory-io-context");
+  for (int ii = 0; ii < argc; ++ii)
+  {
+    const std::string arg(argv[ii]);
+    std::string index;
+    if (arg == option && ii + 1 < argc)
+    {
+      index = argv[ii + 1];
+    }
+    else if (arg.rfind(option + "=", 0) == 0)
+    {
+      index = arg.substr(option.size() + 1);
+    }
+    else
+    {
+      continue;
+    }
+    WasmMemoryContext * indexed = WasmMemoryContext::GetContext(static_cast<uint32_t>(std::stoul(index)));
+    if (indexed == nullptr)
+    {
+      throw std::runtime_error("Unknown memory IO context: " + index);
+    }
+    return indexed;
+  }
+  return WasmMemoryContext::GetDefault();
+}
+
+} // end anonymous namespace
+
 Pipeline
-::Pipeline(std::string name, std::string description, int argc, char **argv):
+::Pipeline(std::string name, std::string description, int argc, char **argv, WasmMemoryContext * context):
   App(description, name),
+  m_MemoryContext(memoryContextFromArguments(argc, argv, context)),
+  m_PreviousMemoryContext(WasmMemoryContext::SetCurrent(m_MemoryContext)),
   m_argc(argc),
   m_argv(argv),
   m_Version("0.1.0")
@@ -41,9 +85,10 @@ Pipeline
   this->positionals_at_end(false);
 
   this->add_flag("--memory-io", m_UseMemoryIO, "Use itk-wasm memory IO")->group("");
+  this->add_option("--memory-io-context", m_MemoryContextIndex, "Index of the itk-wasm memory IO context")->group("");
   this->set_version_flag("--version", m_Version);
 
-  // Set m_UseMemoryIO before it is used by other memory parsers
+  // Set the memory IO flag of the context before it is used by other memory parsers
   this->preparse_callback([this](size_t arg)
    {
    m_UseMemoryIO = false;
@@ -55,6 +100,7 @@ Pipeline
         m_UseMemoryIO = true;
       }
     }
+   m_MemoryContext->SetUseMemoryIO(m_UseMemoryIO);
    });
 
 #ifndef ITK_WASM_NO_FILESYSTEM_IO
@@ -279,7 +325,7 @@ Pipeline
 Pipeline
 ::~Pipeline()
 {
-
+  WasmMemoryContext::SetCurrent(m_PreviousMemoryContext);
 }
 
 void
@@ -314,7 +360,8 @@ Pipeline
     option.AddMember("description", optionDescription.Move(), allocator);
 
     auto singleName = opt->get_single_name();
-    if (singleName == "help")
+    // The memory IO context is chosen by the host, not a pipeline parameter
+    if (singleName == "help" || singleName == "memory-io-context")
     {
       continue;
     }
@@ -387,7 +434,5 @@ Pipeline
   std::cout << std::endl;
 }
 
-bool Pipeline::m_UseMemoryIO{false};
-
 } // end namespace wasm
 } // end namespace itk
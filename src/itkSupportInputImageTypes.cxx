@@ -28,13 +28,24 @@ namespace wasm
 
 bool lexical_cast(const std::string &input, InterfaceImageType & imageType)
 {
-  if (wasm::Pipeline::get_use_memory_io())
+  // Interface types are parsed by the pipeline on its thread
+  const WasmMemoryContext * context = WasmMemoryContext::GetCurrent();
+  if (context->GetUseMemoryIO())
   {
 #ifndef ITK_WASM_NO_MEMORY_IO
     const unsigned int index = std::stoi(input);
-    auto json = getMemoryStoreInputJSON(0, index);
+    if (const auto * header = context->GetInputDescriptor(index))
+    {
+      const auto * descriptor = castWasmDescriptor<WasmImageDescriptor>(header);
+      imageType.dimension = descriptor->dimension;
+      imageType.componentType = WasmComponentTypeFromIOComponentEnum(static_cast<IOComponentEnum>(descriptor->componentType));
+      imageType.pixelType = WasmPixelTypeFromIOPixelEnum(static_cast<IOPixelEnum>(descriptor->pixelType));
+      imageType.components = descriptor->components;
+      return true;
+    }
+    const char * json = context->GetInputJSON(index);
     rapidjson::Document document;
-    if (document.Parse(json.c_str()).HasParseError())
+    if (document.Parse(json).HasParseError())
       {
       throw std::runtime_error("Could not parse JSON");
       }
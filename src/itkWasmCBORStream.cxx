@@ -0,0 +1,465 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmCBORStream.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+constexpr uint8_t cborByteStringType = 2;
+constexpr uint8_t cborTextStringType = 3;
+constexpr uint8_t cborArrayType = 4;
+constexpr uint8_t cborMapType = 5;
+constexpr uint8_t cborTagType = 6;
+constexpr uint8_t cborIndefiniteLength = 31;
+constexpr uint8_t cborBreak = 0xFF;
+} // end anonymous namespace
+
+uint8_t
+WasmCBORStreamReader
+::ReadByte()
+{
+  const auto byte = m_Stream.get();
+  if (byte == std::istream::traits_type::eof())
+  {
+    throw std::runtime_error("Data seem to be missing -- is the CBOR input complete?");
+  }
+  return static_cast< uint8_t >(byte);
+}
+
+
+uint64_t
+WasmCBORStreamReader
+::RemainingBytes()
+{
+  const std::streamoff position = m_Stream.tellg();
+  if (position < 0)
+  {
+    return std::numeric_limits< uint64_t >::max();
+  }
+  if (!m_StreamEndKnown)
+  {
+    m_StreamEndKnown = true;
+    if (m_Stream.seekg(0, std::ios::end))
+    {
+      m_StreamEnd = m_Stream.tellg();
+    }
+    m_Stream.clear();
+    m_Stream.seekg(position);
+  }
+  if (m_StreamEnd < position)
+  {
+    // Not seekable, e.g. a decompressing stream
+    return std::numeric_limits< uint64_t >::max();
+  }
+  return static_cast< uint64_t >(m_StreamEnd - position);
+}
+
+
+void
+WasmCBORStreamReader
+::CheckLength(uint64_t length, uint64_t bytesPerItem, const char * description)
+{
+  const uint64_t remaining = this->RemainingBytes();
+  if (length > remaining / bytesPerItem)
+  {
+    std::ostringstream ostrm;
+    ostrm << "CBOR " << description << " length of " << length << " exceeds the " << remaining
+          << " bytes remaining in the input -- is the CBOR input complete?";
+    throw std::runtime_error(ostrm.str());
+  }
+}
+
+
+void
+WasmCBORStreamReader
+::AppendBytes(std::vector< unsigned char > & buffer, uint64_t numberOfBytes)
+{
+  // Without a known stream size, grow the buffer with the data that is read
+  constexpr uint64_t chunkSize = uint64_t{ 1 } << 20;
+  const uint64_t step = this->RemainingBytes() == std::numeric_limits< uint64_t >::max() ? chunkSize : numberOfBytes;
+  while (numberOfBytes > 0)
+  {
+    const uint64_t count = std::min(numberOfBytes, step);
+    const size_t offset = buffer.size();
+    buffer.resize(offset + count);
+    this->ReadBytes(buffer.data() + offset, count);
+    numberOfBytes -= count;
+  }
+}
+
+
+uint64_t
+WasmCBORStreamReader
+::ReadArgument(uint8_t additionalInformation, std::vector< unsigned char > * encoded)
+{
+  if (additionalInformation < 24)
+  {
+    return additionalInformation;
+  }
+  if (additionalInformation > 27)
+  {
+    throw std::runtime_error("Unsupported or malformed CBOR data item head");
+  }
+  const unsigned int numberOfBytes = 1u << (additionalInformation - 24);
+  uint64_t argument = 0;
+  for (unsigned int ii = 0; ii < numberOfBytes; ++ii)
+  {
+    const uint8_t byte = this->ReadByte();
+    if (encoded != nullptr)
+    {
+      encoded->push_back(byte);
+    }
+    argument = (argument << 8) | byte;
+  }
+  return argument;
+}
+
+
+uint64_t
+WasmCBORStreamReader
+::ReadHead(uint8_t & majorType)
+{
+  const uint8_t initialByte = this->ReadByte();
+  majorType = initialByte >> 5;
+  return this->ReadArgument(initialByte & 0x1f, nullptr);
+}
+
+
+uint64_t
+WasmCBORStreamReader
+::ReadMapHead()
+{
+  uint8_t majorType = 0;
+  const uint64_t count = this->ReadHead(majorType);
+  if (majorType != cborMapType)
+  {
+    throw std::runtime_error("Expected a definite-length CBOR map");
+  }
+  return count;
+}
+
+
+std::string
+WasmCBORStreamReader
+::ReadString()
+{
+  uint8_t majorType = 0;
+  const uint64_t length = this->ReadHead(majorType);
+  if (majorType != cborTextStringType)
+  {
+    throw std::runtime_error("Expected a definite-length CBOR text string");
+  }
+  this->CheckLength(length, 1, "text string");
+  std::vector< unsigned char > bytes;
+  this->AppendBytes(bytes, length);
+  return std::string(bytes.begin(), bytes.end());
+}
+
+
+uint64_t
+WasmCBORStreamReader
+::ReadByteStringHead(uint64_t * tag)
+{
+  uint8_t majorType = 0;
+  uint64_t argument = this->ReadHead(majorType);
+  if (majorType == cborTagType)
+  {
+    if (tag != nullptr)
+    {
+      *tag = argument;
+    }
+    argument = this->ReadHead(majorType);
+  }
+  if (majorType != cborByteStringType)
+  {
+    throw std::runtime_error("Expected a definite-length CBOR bytestring");
+  }
+  return argument;
+}
+
+
+void
+WasmCBORStreamReader
+::ReadBytes(void * buffer, uint64_t numberOfBytes)
+{
+  char * destination = static_cast< char * >(buffer);
+  constexpr uint64_t maximumRead = std::numeric_limits< std::streamsize >::max();
+  while (numberOfBytes > 0)
+  {
+    const std::streamsize count = static_cast< std::streamsize >(std::min(numberOfBytes, maximumRead));
+    m_Stream.read(destination, count);
+    if (m_Stream.gcount() != count)
+    {
+      std::ostringstream ostrm;
+      ostrm << "Data seem to be missing -- wanted " << count << " bytes, but read " << m_Stream.gcount() << " bytes";
+      throw std::runtime_error(ostrm.str());
+    }
+    destination += count;
+    numberOfBytes -= count;
+  }
+}
+
+
+void
+WasmCBORStreamReader
+::SkipBytes(uint64_t numberOfBytes)
+{
+  constexpr uint64_t maximumSkip = std::numeric_limits< std::streamoff >::max();
+  if (numberOfBytes <= maximumSkip && m_Stream.seekg(static_cast< std::streamoff >(numberOfBytes), std::ios::cur))
+  {
+    return;
+  }
+  // Not seekable, e.g. a decompressing stream
+  m_Stream.clear();
+  while (numberOfBytes > 0)
+  {
+    const std::streamsize count = static_cast< std::streamsize >(std::min(numberOfBytes, static_cast< uint64_t >(1) << 30));
+    m_Stream.ignore(count);
+    if (m_Stream.gcount() != count)
+    {
+      throw std::runtime_error("Data seem to be missing -- is the CBOR input complete?");
+    }
+    numberOfBytes -= count;
+  }
+}
+
+
+void
+WasmCBORStreamReader
+::WalkItem(std::vector< unsigned char > * encoded)
+{
+  const uint8_t initialByte = this->ReadByte();
+  if (encoded != nullptr)
+  {
+    encoded->push_back(initialByte);
+  }
+  const uint8_t majorType = initialByte >> 5;
+  const uint8_t additionalInformation = initialByte & 0x1f;
+
+  if (additionalInformation == cborIndefiniteLength)
+  {
+    if (majorType < cborByteStringType || majorType > cborMapType)
+    {
+      throw std::runtime_error("Malformed indefinite-length CBOR data item");
+    }
+    while (m_Stream.peek() != cborBreak)
+    {
+      this->WalkItem(encoded);
+    }
+    const uint8_t breakByte = this->ReadByte();
+    if (encoded != nullptr)
+    {
+      encoded->push_back(breakByte);
+    }
+    return;
+  }
+
+  const uint64_t argument = this->ReadArgument(additionalInformation, encoded);
+  switch (majorType)
+  {
+    case cborByteStringType:
+    case cborTextStringType:
+      this->CheckLength(argument, 1, majorType == cborByteStringType ? "bytestring" : "text string");
+      if (encoded != nullptr)
+      {
+        this->AppendBytes(*encoded, argument);
+      }
+      else
+      {
+        this->SkipBytes(argument);
+      }
+      break;
+    case cborArrayType:
+      this->CheckLength(argument, 1, "array");
+      for (uint64_t ii = 0; ii < argument; ++ii)
+      {
+        this->WalkItem(encoded);
+      }
+      break;
+    case cborMapType:
+      // A key and a value per entry
+      this->CheckLength(argument, 2, "map");
+      for (uint64_t ii = 0; ii < 2 * argument; ++ii)
+      {
+        this->WalkItem(encoded);
+      }
+      break;
+    case cborTagType:
+      this->WalkItem(encoded);
+      break;
+    default:
+      // Integers, simple values and floats are fully encoded in their head
+      break;
+  }
+}
+
+
+cbor_item_t *
+WasmCBORStreamReader
+::ReadItem()
+{
+  std::vector< unsigned char > encoded;
+  this->WalkItem(&encoded);
+
+  struct cbor_load_result result;
+  cbor_item_t * item = cbor_load(encoded.data(), encoded.size(), &result);
+  if (result.error.code != CBOR_ERR_NONE)
+  {
+    std::ostringstream ostrm;
+    ostrm << "There was an error while decoding a CBOR item near byte " << result.error.position;
+    throw std::runtime_error(ostrm.str());
+  }
+  return item;
+}
+
+
+void
+WasmCBORStreamReader
+::SkipItem()
+{
+  this->WalkItem(nullptr);
+}
+
+
+
+void
+WasmCBORStreamWriter
+::WriteHead(uint8_t majorType, uint64_t argument)
+{
+  unsigned char head[9];
+  size_t headSize = 1;
+  const uint8_t initialByte = majorType << 5;
+  if (argument < 24)
+  {
+    head[0] = initialByte | static_cast< uint8_t >(argument);
+  }
+  else
+  {
+    unsigned int numberOfBytes = 8;
+    uint8_t additionalInformation = 27;
+    if (argument <= 0xFF)
+    {
+      numberOfBytes = 1;
+      additionalInformation = 24;
+    }
+    else if (argument <= 0xFFFF)
+    {
+      numberOfBytes = 2;
+      additionalInformation = 25;
+    }
+    else if (argument <= 0xFFFFFFFF)
+    {
+      numberOfBytes = 4;
+      additionalInformation = 26;
+    }
+    head[0] = initialByte | additionalInformation;
+    for (unsigned int ii = 0; ii < numberOfBytes; ++ii)
+    {
+      head[1 + ii] = static_cast< unsigned char >(argument >> (8 * (numberOfBytes - 1 - ii)));
+    }
+    headSize += numberOfBytes;
+  }
+  this->WriteBytes(head, headSize);
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteMapHead(uint64_t numberOfEntries)
+{
+  this->WriteHead(cborMapType, numberOfEntries);
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteString(std::string_view string)
+{
+  this->WriteHead(cborTextStringType, string.size());
+  this->WriteBytes(string.data(), string.size());
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteTag(uint64_t tag)
+{
+  this->WriteHead(cborTagType, tag);
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteByteStringHead(uint64_t numberOfBytes)
+{
+  this->WriteHead(cborByteStringType, numberOfBytes);
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteBytes(const void * buffer, uint64_t numberOfBytes)
+{
+  const char * source = static_cast< const char * >(buffer);
+  constexpr uint64_t maximumWrite = std::numeric_limits< std::streamsize >::max();
+  while (numberOfBytes > 0)
+  {
+    const std::streamsize count = static_cast< std::streamsize >(std::min(numberOfBytes, maximumWrite));
+    if (!m_Stream.write(source, count))
+    {
+      throw std::runtime_error("Could not write the CBOR output");
+    }
+    source += count;
+    numberOfBytes -= count;
+  }
+}
+
+
+void
+WasmCBORStreamWriter
+::WriteItem(const cbor_item_t * item)
+{
+  unsigned char * encoded = nullptr;
+  size_t encodedBufferSize = 0;
+  const size_t encodedSize = cbor_serialize_alloc(item, &encoded, &encodedBufferSize);
+  if (encodedSize == 0)
+  {
+    free(encoded);
+    throw std::runtime_error("Could not serialize CBOR item");
+  }
+  try
+  {
+    this->WriteBytes(encoded, encodedSize);
+  }
+  catch (...)
+  {
+    free(encoded);
+    throw;
+  }
+  free(encoded);
+}
+
+} // end namespace itk
@@ -17,14 +17,32 @@
  *=========================================================================*/
 #include "itkWasmDataObject.h"
 
+#include <cstring>
+
 namespace itk
 {
 
+void
+WasmDataObject::SetDescriptor(const wasm::WasmDescriptorHeader * descriptor)
+{
+  if (descriptor == nullptr)
+  {
+    this->m_Descriptor.clear();
+  }
+  else
+  {
+    this->m_Descriptor.assign((descriptor->size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    std::memcpy(this->m_Descriptor.data(), descriptor, descriptor->size);
+  }
+  this->Modified();
+}
+
 void
 WasmDataObject::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "JSON: " << this->m_JSON << std::endl;
+  os << indent << "Descriptor size: " << this->GetDescriptorSize() << std::endl;
   os << indent << "DataObject: ";
   if (this->m_DataObject)
   {
@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmDescriptor.h"
+#include "itkIOComponentEnumFromWasmComponentType.h"
+#include "itkIOPixelEnumFromWasmPixelType.h"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+constexpr size_t addressPrefixLength = 35; // data:application/vnd.itk.address,0:
+
+uint64_t
+addressFromJSON(const rapidjson::Value & json, const char * name)
+{
+  const auto member = json.FindMember(name);
+  if (member == json.MemberEnd() || !member->value.IsString() ||
+      member->value.GetStringLength() <= addressPrefixLength)
+  {
+    return 0;
+  }
+  return std::strtoull(member->value.GetString() + addressPrefixLength, nullptr, 10);
+}
+
+uint64_t
+countFromJSON(const rapidjson::Value & json, const char * name)
+{
+  const auto member = json.FindMember(name);
+  if (member == json.MemberEnd() || !member->value.IsNumber())
+  {
+    return 0;
+  }
+  return member->value.IsUint64() ? member->value.GetUint64() : static_cast<uint64_t>(member->value.GetDouble());
+}
+
+uint32_t
+componentTypeFromJSON(const rapidjson::Value & json, const char * name)
+{
+  const auto member = json.FindMember(name);
+  if (member == json.MemberEnd() || !member->value.IsString())
+  {
+    return 0;
+  }
+  return descriptorComponentType(std::string_view(member->value.GetString(), member->value.GetStringLength()));
+}
+
+uint32_t
+pixelTypeFromJSON(const rapidjson::Value & json, const char * name)
+{
+  const auto member = json.FindMember(name);
+  if (member == json.MemberEnd() || !member->value.IsString())
+  {
+    return 0;
+  }
+  return descriptorPixelType(std::string_view(member->value.GetString(), member->value.GetStringLength()));
+}
+
+const rapidjson::Value &
+objectFromJSON(const rapidjson::Value & json, const char * name)
+{
+  const auto member = json.FindMember(name);
+  if (member == json.MemberEnd() || !member->value.IsObject())
+  {
+    throw std::runtime_error(std::string("Missing ") + name);
+  }
+  return member->value;
+}
+
+} // end anonymous namespace
+
+void
+checkWasmDescriptor(const void * descriptor, size_t size, WasmDescriptorKind kind, size_t kindSize)
+{
+  if (descriptor == nullptr || size < sizeof(WasmDescriptorHeader))
+  {
+    throw std::runtime_error("Descriptor is too small");
+  }
+  const auto * header = static_cast<const WasmDescriptorHeader *>(descriptor);
+  if (header->magic != WasmDescriptorMagic)
+  {
+    throw std::runtime_error("Not a descriptor");
+  }
+  if (header->version != WasmDescriptorVersion)
+  {
+    throw std::runtime_error("Unsupported descriptor version");
+  }
+  if (header->kind != static_cast<uint16_t>(kind))
+  {
+    throw std::runtime_error("Unexpected descriptor kind");
+  }
+  if (header->size < kindSize || header->size > size)
+  {
+    throw std::runtime_error("Unexpected descriptor size");
+  }
+}
+
+WasmImageDescriptor
+imageDescriptorFromJSON(const rapidjson::Value & json)
+{
+  auto descriptor = makeWasmDescriptor<WasmImageDescriptor>();
+
+  const rapidjson::Value & imageType = objectFromJSON(json, "imageType");
+  descriptor.dimension = static_cast<uint32_t>(countFromJSON(imageType, "dimension"));
+  if (descriptor.dimension > WasmDescriptorMaximumDimension)
+  {
+    throw std::runtime_error("Unsupported image dimension");
+  }
+  descriptor.componentType = componentTypeFromJSON(imageType, "componentType");
+  descriptor.pixelType = pixelTypeFromJSON(imageType, "pixelType");
+  descriptor.components = static_cast<uint32_t>(countFromJSON(imageType, "components"));
+
+  const auto copyArray = [&json, &descriptor](const char * name, auto * values) {
+    const auto member = json.FindMember(name);
+    if (member == json.MemberEnd() || !member->value.IsArray() || member->value.Size() != descriptor.dimension)
+    {
+      throw std::runtime_error(std::string("Unexpected image ") + name);
+    }
+    using ValueType = std::remove_pointer_t<decltype(values)>;
+    for (rapidjson::SizeType ii = 0; ii < descriptor.dimension; ++ii)
+    {
+      const rapidjson::Value & value = member->value[ii];
+      values[ii] = value.IsUint64() ? static_cast<ValueType>(value.GetUint64()) : static_cast<ValueType>(value.GetDouble());
+    }
+  };
+  copyArray("origin", descriptor.origin);
+  copyArray("spacing", descriptor.spacing);
+  copyArray("size", descriptor.size);
+
+  descriptor.direction = addressFromJSON(json, "direction");
+  descriptor.data = addressFromJSON(json, "data");
+  return descriptor;
+}
+
+WasmMeshDescriptor
+meshDescriptorFromJSON(const rapidjson::Value & json)
+{
+  auto descriptor = makeWasmDescriptor<WasmMeshDescriptor>();
+
+  const rapidjson::Value & meshType = objectFromJSON(json, "meshType");
+  descriptor.dimension = static_cast<uint32_t>(countFromJSON(meshType, "dimension"));
+  descriptor.pointComponentType = componentTypeFromJSON(meshType, "pointComponentType");
+  descriptor.pointPixelComponentType = componentTypeFromJSON(meshType, "pointPixelComponentType");
+  descriptor.pointPixelType = pixelTypeFromJSON(meshType, "pointPixelType");
+  descriptor.pointPixelComponents = static_cast<uint32_t>(countFromJSON(meshType, "pointPixelComponents"));
+  descriptor.cellComponentType = componentTypeFromJSON(meshType, "cellComponentType");
+  descriptor.cellPixelComponentType = componentTypeFromJSON(meshType, "cellPixelComponentType");
+  descriptor.cellPixelType = pixelTypeFromJSON(meshType, "cellPixelType");
+  descriptor.cellPixelComponents = static_cast<uint32_t>(countFromJSON(meshType, "cellPixelComponents"));
+
+  descriptor.numberOfPoints = countFromJSON(json, "numberOfPoints");
+  descriptor.numberOfPointPixels = countFromJSON(json, "numberOfPointPixels");
+  descriptor.numberOfCells = countFromJSON(json, "numberOfCells");
+  descriptor.numberOfCellPixels = countFromJSON(json, "numberOfCellPixels");
+  descriptor.cellBufferSize = countFromJSON(json, "cellBufferSize");
+  descriptor.points = addressFromJSON(json, "points");
+  descriptor.cells = addressFromJSON(json, "cells");
+  descriptor.pointData = addressFromJSON(json, "pointData");
+  descriptor.cellData = addressFromJSON(json, "cellData");
+  return descriptor;
+}
+
+WasmPolyDataDescriptor
+polyDataDescriptorFromJSON(const rapidjson::Value & json)
+{
+  auto descriptor = makeWasmDescriptor<WasmPolyDataDescriptor>();
+
+  const rapidjson::Value & polyDataType = objectFromJSON(json, "polyDataType");
+  descriptor.pointPixelComponentType = componentTypeFromJSON(polyDataType, "pointPixelComponentType");
+  descriptor.pointPixelType = pixelTypeFromJSON(polyDataType, "pointPixelType");
+  descriptor.pointPixelComponents = static_cast<uint32_t>(countFromJSON(polyDataType, "pointPixelComponents"));
+  descriptor.cellPixelComponentType = componentTypeFromJSON(polyDataType, "cellPixelComponentType");
+  descriptor.cellPixelType = pixelTypeFromJSON(polyDataType, "cellPixelType");
+  descriptor.cellPixelComponents = static_cast<uint32_t>(countFromJSON(polyDataType, "cellPixelComponents"));
+
+  descriptor.numberOfPoints = countFromJSON(json, "numberOfPoints");
+  descriptor.verticesBufferSize = countFromJSON(json, "verticesBufferSize");
+  descriptor.linesBufferSize = countFromJSON(json, "linesBufferSize");
+  descriptor.polygonsBufferSize = countFromJSON(json, "polygonsBufferSize");
+  descriptor.triangleStripsBufferSize = countFromJSON(json, "triangleStripsBufferSize");
+  descriptor.numberOfPointPixels = countFromJSON(json, "numberOfPointPixels");
+  descriptor.numberOfCellPixels = countFromJSON(json, "numberOfCellPixels");
+  descriptor.points = addressFromJSON(json, "points");
+  descriptor.vertices = addressFromJSON(json, "vertices");
+  descriptor.lines = addressFromJSON(json, "lines");
+  descriptor.polygons = addressFromJSON(json, "polygons");
+  descriptor.triangleStrips = addressFromJSON(json, "triangleStrips");
+  descriptor.pointData = addressFromJSON(json, "pointData");
+  descriptor.cellData = addressFromJSON(json, "cellData");
+  return descriptor;
+}
+
+uint32_t
+descriptorComponentType(const std::string_view & wasmComponentType)
+{
+  return static_cast<uint32_t>(IOComponentEnumFromWasmComponentType(std::string(wasmComponentType)));
+}
+
+uint32_t
+descriptorPixelType(const std::string_view & wasmPixelType)
+{
+  return static_cast<uint32_t>(IOPixelEnumFromWasmPixelType(std::string(wasmPixelType)));
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -20,121 +20,165 @@
 
 #ifndef ITK_WASM_NO_MEMORY_IO
 
-#include <map>
-#include <utility>
-#include <vector>
+#include <stdexcept>
 
 namespace itk
 {
 namespace wasm
 {
 
-static InputArrayStoreType inputArrayStore;
+namespace
+{
 
-// index
-using InputJSONStoreType = std::map<uint32_t, std::string>;
-static InputJSONStoreType inputJSONStore;
+WasmMemoryContext *
+contextFromIndex(uint32_t memoryIndex)
+{
+  auto * context = WasmMemoryContext::GetContext(memoryIndex);
+  if (context == nullptr)
+  {
+    throw std::runtime_error("Unknown memory IO context: " + std::to_string(memoryIndex));
+  }
+  return context;
+}
+
+} // end anonymous namespace
 
-const std::string & getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index)
+const char * getMemoryStoreInputJSON(uint32_t memoryIndex, uint32_t index)
 {
-  return inputJSONStore[index];
+  return contextFromIndex(memoryIndex)->GetInputJSON(index);
 }
 
-const InputArrayStoreType & getMemoryInputArrayStore()
+const InputArrayStoreType & getMemoryInputArrayStore(uint32_t memoryIndex)
 {
-  return inputArrayStore;
+  return contextFromIndex(memoryIndex)->GetInputArrayStore();
 }
 
-using OutputWasmDataObjectStoreType = std::map<uint32_t, WasmDataObject::ConstPointer>;
-static OutputWasmDataObjectStoreType outputWasmDataObjectStore;
+const WasmDescriptorHeader * getMemoryStoreInputDescriptor(uint32_t memoryIndex, uint32_t index)
+{
+  return contextFromIndex(memoryIndex)->GetInputDescriptor(index);
+}
 
-void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject)
+bool getMemoryStoreUseOutputJSON(uint32_t memoryIndex)
 {
-  WasmDataObject::ConstPointer smartPointer(dataObject);
-  outputWasmDataObjectStore[index] = smartPointer;
+  return contextFromIndex(memoryIndex)->GetUseOutputJSON();
 }
 
-// dataset index, array index
-using OutputArrayStoreKeyType = std::pair<uint32_t, uint32_t>;
-// address, size
-using OutputArrayStoreValueType = std::pair<size_t, size_t>;
-using OutputArrayStoreType = std::map<OutputArrayStoreKeyType, OutputArrayStoreValueType>;
-static OutputArrayStoreType outputArrayStore;
+void setMemoryStoreOutputDataObject(uint32_t memoryIndex, uint32_t index, const WasmDataObject * dataObject)
+{
+  contextFromIndex(memoryIndex)->SetOutputDataObject(index, dataObject);
+}
 
 void setMemoryStoreOutputArray(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t address, size_t size)
 {
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = std::make_pair(address, size);
-  outputArrayStore[key] = value;
+  contextFromIndex(memoryIndex)->SetOutputArray(index, subIndex, address, size);
 }
 
 } // end namespace wasm
 } // end namespace itk
 
+// The exports return 0 for an unknown memoryIndex rather than unwinding
+// into the host.
+
 size_t itk_wasm_input_array_alloc(uint32_t memoryIndex, uint32_t index, uint32_t subIndex, size_t size)
 {
-  using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  if (inputArrayStore.count(key))
-  {
-    inputArrayStore[key] = InputArrayStoreValueType(size);
-  }
-  else
-  {
-    inputArrayStore[key].resize(size);
-  }
-  return reinterpret_cast< size_t >(inputArrayStore[key].data());
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  return context ? context->AllocateInputArray(index, subIndex, size) : 0;
 }
 
 size_t itk_wasm_input_json_alloc(uint32_t memoryIndex, uint32_t index, size_t size)
 {
-  using namespace itk::wasm;
-  if (inputJSONStore.count(index))
-  {
-    inputJSONStore[index] = std::string(size, ' ');
-  }
-  else
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  return context ? context->AllocateInputJSON(index, size) : 0;
+}
+
+size_t itk_wasm_input_descriptor_alloc(uint32_t memoryIndex, uint32_t index, size_t size)
+{
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  return context ? context->AllocateInputDescriptor(index, size) : 0;
+}
+
+uint32_t itk_wasm_descriptor_version()
+{
+  return itk::wasm::WasmDescriptorVersion;
+}
+
+void itk_wasm_set_output_json(uint32_t memoryIndex, uint32_t enabled)
+{
+  if (auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex))
   {
-    inputJSONStore[index].resize(size);
+    context->SetUseOutputJSON(enabled != 0);
   }
-  return reinterpret_cast< size_t >(inputJSONStore[index].data());
 }
 
 size_t itk_wasm_output_json_address(uint32_t memoryIndex, uint32_t index)
 {
-  using namespace itk::wasm;
-  return reinterpret_cast< size_t >(outputWasmDataObjectStore[index]->GetJSON().data());
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  const auto * dataObject = context ? context->GetOutputDataObject(index) : nullptr;
+  return dataObject ? reinterpret_cast< size_t >(dataObject->GetJSON().data()) : 0;
 }
 
 size_t itk_wasm_output_json_size(uint32_t memoryIndex, uint32_t index)
 {
-  using namespace itk::wasm;
-  return outputWasmDataObjectStore[index]->GetJSON().size();
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  const auto * dataObject = context ? context->GetOutputDataObject(index) : nullptr;
+  return dataObject ? dataObject->GetJSON().size() : 0;
+}
+
+size_t itk_wasm_output_descriptor_address(uint32_t memoryIndex, uint32_t index)
+{
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  const auto * dataObject = context ? context->GetOutputDataObject(index) : nullptr;
+  return dataObject ? reinterpret_cast< size_t >(dataObject->GetDescriptor()) : 0;
+}
+
+size_t itk_wasm_output_descriptor_size(uint32_t memoryIndex, uint32_t index)
+{
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  const auto * dataObject = context ? context->GetOutputDataObject(index) : nullptr;
+  return dataObject ? dataObject->GetDescriptorSize() : 0;
 }
 
 size_t itk_wasm_output_array_address(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
 {
-  using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
-  return value.first;
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  return context ? context->GetOutputArray(index, subIndex).first : 0;
 }
 
 size_t itk_wasm_output_array_size(uint32_t memoryIndex, uint32_t index, uint32_t subIndex)
 {
-  using namespace itk::wasm;
-  const auto key = std::make_pair(index, subIndex);
-  const auto value = outputArrayStore[key];
-  return value.second;
+  auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  return context ? context->GetOutputArray(index, subIndex).second : 0;
 }
 
 void itk_wasm_free_all()
 {
-  using namespace itk::wasm;
-  inputJSONStore.clear();
-  inputArrayStore.clear();
-  outputWasmDataObjectStore.clear();
-  outputArrayStore.clear();
+  itk::wasm::WasmMemoryContext::GetDefault()->FreeAll();
+}
+
+void itk_wasm_trim()
+{
+  itk::wasm::WasmMemoryContext::GetDefault()->Trim();
+}
+
+uint32_t itk_wasm_context_create()
+{
+  return (new itk::wasm::WasmMemoryContext)->GetIndex();
+}
+
+void itk_wasm_context_free_all(uint32_t memoryIndex)
+{
+  if (auto * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex))
+  {
+    context->FreeAll();
+  }
+}
+
+void itk_wasm_context_delete(uint32_t memoryIndex)
+{
+  if (memoryIndex != 0)
+  {
+    delete itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  }
 }
 
 #endif // ITK_WASM_NO_MEMORY_IO
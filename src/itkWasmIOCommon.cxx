@@ -23,6 +23,17 @@
 #include <sstream>
 #include <cstring>
 
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif !defined(__wasi__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ITK_WASM_HAVE_MMAP
+#endif
+
 #include "cbor.h"
 
 namespace itk
@@ -167,56 +178,49 @@ readCBORBuffer(const cbor_item_t * index, const char * dataName, void * buffer,
   }
 }
 
-void
-writeCBORBuffer(cbor_item_t * index, const char * dataName, const void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent)
+uint64_t
+cborTypedArrayTag(IOComponentEnum ioComponent)
 {
-  if (index == nullptr) {
-    throw std::logic_error("Call write information before writing the data buffer");
-  }
-  cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-  uint64_t tag = 0;
   // Todo: support endianness
   // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
   switch (ioComponent) {
     case IOComponentEnum::CHAR:
-      tag = 64;
-      break;
+      return 64;
     case IOComponentEnum::UCHAR:
-      tag = 64;
-      break;
+      return 64;
     case IOComponentEnum::SHORT:
-      tag = 73;
-      break;
+      return 73;
     case IOComponentEnum::USHORT:
-      tag = 69;
-      break;
+      return 69;
     case IOComponentEnum::INT:
-      tag = 74;
-      break;
+      return 74;
     case IOComponentEnum::UINT:
-      tag = 70;
-      break;
+      return 70;
     case IOComponentEnum::LONG:
-      tag = 75;
-      break;
+      return 75;
     case IOComponentEnum::ULONG:
-      tag = 71;
-      break;
+      return 71;
     case IOComponentEnum::LONGLONG:
-      tag = 75;
-      break;
+      return 75;
     case IOComponentEnum::ULONGLONG:
-      tag = 71;
-      break;
+      return 71;
     case IOComponentEnum::FLOAT:
-      tag = 85;
-      break;
+      return 85;
     case IOComponentEnum::DOUBLE:
-      tag = 86;
-      break;
+      return 86;
     default:
       throw std::logic_error("Unexpected component type");
   }
+}
+
+void
+writeCBORBuffer(cbor_item_t * index, const char * dataName, const void * buffer, SizeValueType numberOfBytesToWrite, IOComponentEnum ioComponent)
+{
+  if (index == nullptr) {
+    throw std::logic_error("Call write information before writing the data buffer");
+  }
+  const uint64_t tag = cborTypedArrayTag(ioComponent);
+  cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
   cbor_item_t * dataTag = cbor_new_tag(tag);
   cbor_tag_set_item(dataTag, cbor_move(dataItem));
   cbor_map_add(index,
@@ -271,4 +275,110 @@ ITKComponentSize(const CommonEnums::IOComponent itkComponentType)
     }
 }
 
+
+WasmMemoryMappedFile
+::WasmMemoryMappedFile(const std::string & fileName)
+{
+  if ( fileName.empty() )
+    {
+    throw std::runtime_error( "A FileName must be specified." );
+    }
+
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if ( file == INVALID_HANDLE_VALUE )
+    {
+    throw std::runtime_error( "Could not open file: " + fileName + " for memory mapping." );
+    }
+  m_FileHandle = file;
+  LARGE_INTEGER fileSize;
+  if ( !GetFileSizeEx(file, &fileSize) )
+    {
+    CloseHandle(file);
+    throw std::runtime_error( "Could not determine the size of: " + fileName );
+    }
+  m_Size = static_cast< SizeValueType >( fileSize.QuadPart );
+  if ( m_Size == 0 )
+    {
+    return;
+    }
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if ( mapping == nullptr )
+    {
+    CloseHandle(file);
+    throw std::runtime_error( "Could not memory map file: " + fileName );
+    }
+  m_MappingHandle = mapping;
+  m_Data = static_cast< const char * >( MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) );
+  if ( m_Data == nullptr )
+    {
+    CloseHandle(mapping);
+    CloseHandle(file);
+    throw std::runtime_error( "Could not memory map file: " + fileName );
+    }
+#elif defined(ITK_WASM_HAVE_MMAP)
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if ( fd < 0 )
+    {
+    throw std::runtime_error( "Could not open file: " + fileName + " for memory mapping." );
+    }
+  struct stat fileStat;
+  if ( fstat(fd, &fileStat) != 0 )
+    {
+    close(fd);
+    throw std::runtime_error( "Could not determine the size of: " + fileName );
+    }
+  m_Size = static_cast< SizeValueType >( fileStat.st_size );
+  if ( m_Size == 0 )
+    {
+    close(fd);
+    return;
+    }
+  void * data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping keeps its own reference to the file
+  close(fd);
+  if ( data == MAP_FAILED )
+    {
+    throw std::runtime_error( "Could not memory map file: " + fileName );
+    }
+  m_Data = static_cast< const char * >( data );
+#else
+  std::ifstream inputStream;
+  openFileForReading(inputStream, fileName);
+  inputStream.seekg(0, std::ios::end);
+  m_Size = static_cast< SizeValueType >( inputStream.tellg() );
+  inputStream.seekg(0, std::ios::beg);
+  m_Buffer.resize(m_Size);
+  if ( !readBufferAsBinary(inputStream, m_Buffer.data(), m_Size) )
+    {
+    throw std::runtime_error( "Could not read file: " + fileName );
+    }
+  m_Data = m_Buffer.data();
+#endif
+}
+
+WasmMemoryMappedFile
+::~WasmMemoryMappedFile()
+{
+#if defined(_WIN32)
+  if ( m_Data != nullptr )
+    {
+    UnmapViewOfFile(m_Data);
+    }
+  if ( m_MappingHandle != nullptr )
+    {
+    CloseHandle(m_MappingHandle);
+    }
+  if ( m_FileHandle != nullptr )
+    {
+    CloseHandle(m_FileHandle);
+    }
+#elif defined(ITK_WASM_HAVE_MMAP)
+  if ( m_Data != nullptr )
+    {
+    munmap(const_cast< char * >( m_Data ), m_Size);
+    }
+#endif
+}
+
 } // end namespace itk
@@ -23,7 +23,10 @@
 #include "itkWasmPixelTypeFromIOPixelEnum.h"
 #include "itkIOPixelEnumFromWasmPixelType.h"
 #include "itkMetaDataDictionaryJSON.h"
+#include "itkMetaDataDictionaryCBOR.h"
 #include "itkWasmIOCommon.h"
+#include "itkWasmCBORStream.h"
+#include "itkWasmMemoryStreamBuffer.h"
 
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
@@ -36,9 +39,179 @@
 
 #include "cbor.h"
 
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <sstream>
+
 namespace itk
 {
 
+namespace
+{
+
+/** Pixel index bounds of an N-D block: the requested region, a chunk, or
+ * their overlap. */
+struct BlockBounds
+{
+  std::vector< IndexValueType > index;
+  std::vector< SizeValueType > size;
+};
+
+BlockBounds
+blockBoundsFromIORegion(const ImageIORegion & ioRegion, unsigned int dimension)
+{
+  BlockBounds bounds;
+  bounds.index.resize(dimension, 0);
+  bounds.size.resize(dimension, 1);
+  const unsigned int regionDimension = std::min(dimension, ioRegion.GetImageDimension());
+  for (unsigned int dim = 0; dim < regionDimension; ++dim)
+  {
+    bounds.index[dim] = ioRegion.GetIndex(dim);
+    bounds.size[dim] = ioRegion.GetSize(dim);
+  }
+  return bounds;
+}
+
+SizeValueType
+numberOfPixels(const BlockBounds & bounds)
+{
+  SizeValueType count = 1;
+  for (const auto size : bounds.size)
+  {
+    count *= size;
+  }
+  return count;
+}
+
+std::string
+chunkFileName(const std::string & path, const std::vector< SizeValueType > & gridIndex)
+{
+  std::ostringstream ostrm;
+  ostrm << path << "/data/chunks/";
+  for (size_t dim = 0; dim < gridIndex.size(); ++dim)
+  {
+    if (dim > 0)
+    {
+      ostrm << '.';
+    }
+    ostrm << gridIndex[dim];
+  }
+  ostrm << ".raw";
+  return ostrm.str();
+}
+
+std::vector< SizeValueType >
+chunkSizeFromJSON(const rapidjson::Document & document)
+{
+  std::vector< SizeValueType > chunkSize;
+  if (document.HasMember("chunkSize"))
+  {
+    const rapidjson::Value & chunkSizeJson = document["chunkSize"];
+    for( rapidjson::Value::ConstValueIterator itr = chunkSizeJson.Begin(); itr != chunkSizeJson.End(); ++itr )
+    {
+      chunkSize.push_back( itr->GetUint64() );
+    }
+  }
+  return chunkSize;
+}
+
+/** Copy the rows of the overlap block from a buffer laid out over the
+ * source block into a buffer laid out over the destination block. */
+void
+copyOverlap(const char * source, const BlockBounds & sourceBounds,
+  char * destination, const BlockBounds & destinationBounds,
+  const BlockBounds & overlap, SizeValueType pixelSize)
+{
+  const size_t dimension = overlap.size.size();
+  const SizeValueType rowBytes = overlap.size[0] * pixelSize;
+  std::vector< SizeValueType > position(dimension, 0);
+  while (true)
+  {
+    SizeValueType sourceOffset = 0;
+    SizeValueType destinationOffset = 0;
+    for (size_t dim = dimension; dim-- > 0;)
+    {
+      const IndexValueType index = overlap.index[dim] + static_cast< IndexValueType >(position[dim]);
+      sourceOffset = sourceOffset * sourceBounds.size[dim] + static_cast< SizeValueType >(index - sourceBounds.index[dim]);
+      destinationOffset = destinationOffset * destinationBounds.size[dim] + static_cast< SizeValueType >(index - destinationBounds.index[dim]);
+    }
+    std::memcpy(destination + destinationOffset * pixelSize, source + sourceOffset * pixelSize, rowBytes);
+
+    size_t dim = 1;
+    for (; dim < dimension; ++dim)
+    {
+      if (++position[dim] < overlap.size[dim])
+      {
+        break;
+      }
+      position[dim] = 0;
+    }
+    if (dim >= dimension)
+    {
+      break;
+    }
+  }
+}
+
+/** Call function(gridIndex, chunk, overlap) for every chunk in the grid
+ * that overlaps the region. */
+template< typename TFunction >
+void
+forEachOverlappingChunk(const std::vector< SizeValueType > & imageSize, const std::vector< SizeValueType > & chunkSize,
+  const BlockBounds & region, TFunction && function)
+{
+  const size_t dimension = imageSize.size();
+  if (numberOfPixels(region) == 0)
+  {
+    return;
+  }
+  std::vector< SizeValueType > first(dimension);
+  std::vector< SizeValueType > last(dimension);
+  for (size_t dim = 0; dim < dimension; ++dim)
+  {
+    first[dim] = static_cast< SizeValueType >(region.index[dim]) / chunkSize[dim];
+    last[dim] = (static_cast< SizeValueType >(region.index[dim]) + region.size[dim] - 1) / chunkSize[dim];
+  }
+
+  std::vector< SizeValueType > gridIndex(first);
+  BlockBounds chunk;
+  chunk.index.resize(dimension);
+  chunk.size.resize(dimension);
+  BlockBounds overlap(chunk);
+  while (true)
+  {
+    for (size_t dim = 0; dim < dimension; ++dim)
+    {
+      const SizeValueType chunkStart = gridIndex[dim] * chunkSize[dim];
+      chunk.index[dim] = static_cast< IndexValueType >(chunkStart);
+      chunk.size[dim] = std::min(chunkSize[dim], imageSize[dim] - chunkStart);
+      const IndexValueType overlapStart = std::max(region.index[dim], chunk.index[dim]);
+      const IndexValueType overlapEnd = std::min(region.index[dim] + static_cast< IndexValueType >(region.size[dim]),
+        chunk.index[dim] + static_cast< IndexValueType >(chunk.size[dim]));
+      overlap.index[dim] = overlapStart;
+      overlap.size[dim] = static_cast< SizeValueType >(overlapEnd - overlapStart);
+    }
+    function(gridIndex, chunk, overlap);
+
+    size_t dim = 0;
+    for (; dim < dimension; ++dim)
+    {
+      if (++gridIndex[dim] <= last[dim])
+      {
+        break;
+      }
+      gridIndex[dim] = first[dim];
+    }
+    if (dim >= dimension)
+    {
+      break;
+    }
+  }
+}
+
+} // end anonymous namespace
+
 WasmImageIO
 ::WasmImageIO()
 {
@@ -69,6 +242,69 @@ WasmImageIO
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "ChunkSize: [";
+  for (size_t dim = 0; dim < m_ChunkSize.size(); ++dim)
+  {
+    os << (dim > 0 ? ", " : "") << m_ChunkSize[dim];
+  }
+  os << "]" << std::endl;
+  os << indent << "UseMemoryMapping: " << (m_UseMemoryMapping ? "On" : "Off") << std::endl;
+  os << indent << "PayloadFilter: " << m_PayloadFilter << std::endl;
+}
+
+
+bool
+WasmImageIO
+::CanStreamRead()
+{
+  return !fileNameIsCBOR(this->GetFileName());
+}
+
+
+bool
+WasmImageIO
+::CanStreamWrite()
+{
+  return !fileNameIsCBOR(this->GetFileName());
+}
+
+
+ImageIORegion
+WasmImageIO
+::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requested) const
+{
+  if (fileNameIsCBOR(this->GetFileName()))
+  {
+    return ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requested);
+  }
+  return Superclass::GenerateStreamableReadRegionFromRequestedRegion(requested);
+}
+
+
+unsigned int
+WasmImageIO
+::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion)
+{
+  if (!this->CanStreamWrite())
+  {
+    return ImageIOBase::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  // StreamingImageIOBase removes a previous file before streaming a new
+  // image, but the .iwi format is a directory.
+  if (pasteRegion == largestPossibleRegion && numberOfRequestedSplits != 1 &&
+      itksys::SystemTools::FileIsDirectory(this->GetFileName()))
+  {
+    if (!itksys::SystemTools::RemoveADirectory(this->GetFileName()))
+    {
+      itkExceptionMacro("Unable to remove directory for streaming: " << this->GetFileName());
+    }
+  }
+
+  return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
 }
 
 
@@ -98,6 +334,12 @@ WasmImageIO
     return false;
     }
 
+  // WasmLz4ImageIO is required
+  if ( fname.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
@@ -140,7 +382,7 @@ WasmImageIO
   count = 0;
   for( rapidjson::Value::ConstValueIterator itr = size.Begin(); itr != size.End(); ++itr )
     {
-    this->SetDimensions( count, itr->GetInt() );
+    this->SetDimensions( count, itr->GetUint64() );
     ++count;
     }
 
@@ -158,179 +400,302 @@ void
 WasmImageIO
 ::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
 {
-  bool cborBufferAllocated = false;
-  size_t length = cborBufferLength;
   if (cborBuffer == nullptr)
   {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
-    }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
-    {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
-    }
-    fclose(file);
+    std::ifstream inputStream;
+    this->OpenFileForReading( inputStream, this->GetFileName() );
+    this->ReadCBOR(buffer, inputStream);
   }
-
-  struct cbor_load_result result;
-  cbor_item_t* index = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  else
   {
-    free(cborBuffer);
-  }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
-      }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
-      }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
-      }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
-      }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
-      }
-      case CBOR_ERR_NONE: {
-        break;
-      }
-    }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
+    WasmMemoryInputStream inputStream(reinterpret_cast< const char * >(cborBuffer), cborBufferLength);
+    this->ReadCBOR(buffer, inputStream);
   }
+}
+
 
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
+SizeValueType
+WasmImageIO
+::ReadCBOR( void *buffer, std::istream & inputStream )
+{
+  m_PayloadFilter = WasmPayloadFilterEnum::None;
+  WasmCBORStreamReader reader(inputStream);
+  try
   {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
-    if (key == "imageType")
+    const uint64_t indexCount = reader.ReadMapHead();
+    for (uint64_t ii = 0; ii < indexCount; ++ii)
     {
-      const cbor_item_t * imageTypeItem = indexHandle[ii].value;
-      const size_t imageTypeCount = cbor_map_size(imageTypeItem);
-      const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem);
-      for (size_t jj = 0; jj < imageTypeCount; ++jj)
+      const std::string key = reader.ReadString();
+      if (key == "data")
       {
-        const std::string_view imageTypeKey(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].key)), cbor_string_length(imageTypeHandle[jj].key));
-        if (imageTypeKey == "dimension")
-        {
-          const auto dimension = cbor_get_uint32(imageTypeHandle[jj].value);
-          this->SetNumberOfDimensions( dimension );
-        }
-        else if (imageTypeKey == "componentType")
+        // Stream the pixel payload directly into the destination buffer
+        const uint64_t dataLength = reader.ReadByteStringHead();
+        if( buffer != nullptr )
         {
-          const std::string componentType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
-          const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
-          this->SetComponentType( ioComponentType );
+          this->ReadCBORData(buffer, inputStream, dataLength);
         }
-        else if (imageTypeKey == "pixelType")
+        else if (ii + 1 == indexCount)
         {
-          const std::string pixelType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
-          const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
-          this->SetPixelType( ioPixelType );
-        }
-        else if (imageTypeKey == "components")
-        {
-          const auto components = cbor_get_uint32(imageTypeHandle[jj].value);
-          this->SetNumberOfComponents( components );
+          // Information only: the payload is the last entry, so stop
+          // without touching it
+          return dataLength;
         }
         else
         {
-          itkExceptionMacro("Unexpected imageType cbor map key: " << imageTypeKey);
+          reader.SkipBytes(dataLength);
         }
+        continue;
       }
-    }
-    else if (key == "origin")
-    {
-      const auto originHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t originSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < originSize; ++dim )
-        {
-        const auto item = originHandle[dim];
-        this->SetOrigin( dim, cbor_float_get_float(item) );
-        }
-    }
-    else if (key == "spacing")
-    {
-      const auto spacingHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t spacingSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < spacingSize; ++dim )
+      if (key == "metadata" && buffer != nullptr)
+      {
+        // Decoded with the image information
+        reader.SkipItem();
+        continue;
+      }
+
+      const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+      std::unique_ptr< cbor_item_t, decltype(itemDeleter) > valueItem(reader.ReadItem(), itemDeleter);
+      if (key == "imageType")
+      {
+        const cbor_item_t * imageTypeItem = valueItem.get();
+        const size_t imageTypeCount = cbor_map_size(imageTypeItem);
+        const struct cbor_pair * imageTypeHandle = cbor_map_handle(imageTypeItem);
+        for (size_t jj = 0; jj < imageTypeCount; ++jj)
         {
-        const auto item = spacingHandle[dim];
-        this->SetSpacing( dim, cbor_float_get_float(item) );
+          const std::string_view imageTypeKey(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].key)), cbor_string_length(imageTypeHandle[jj].key));
+          if (imageTypeKey == "dimension")
+          {
+            const auto dimension = cbor_get_uint32(imageTypeHandle[jj].value);
+            this->SetNumberOfDimensions( dimension );
+          }
+          else if (imageTypeKey == "componentType")
+          {
+            const std::string componentType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
+            const ImageIOBase::IOComponentEnum ioComponentType = IOComponentEnumFromWasmComponentType( componentType );
+            this->SetComponentType( ioComponentType );
+          }
+          else if (imageTypeKey == "pixelType")
+          {
+            const std::string pixelType(reinterpret_cast<char *>(cbor_string_handle(imageTypeHandle[jj].value)), cbor_string_length(imageTypeHandle[jj].value));
+            const IOPixelEnum ioPixelType = IOPixelEnumFromWasmPixelType( pixelType );
+            this->SetPixelType( ioPixelType );
+          }
+          else if (imageTypeKey == "components")
+          {
+            const auto components = cbor_get_uint32(imageTypeHandle[jj].value);
+            this->SetNumberOfComponents( components );
+          }
+          else
+          {
+            itkExceptionMacro("Unexpected imageType cbor map key: " << imageTypeKey);
+          }
         }
+      }
+      else if (key == "origin")
+      {
+        const auto originHandle = cbor_array_handle(valueItem.get());
+        const size_t originSize = cbor_array_size(valueItem.get());
+        for( int dim = 0; dim < originSize; ++dim )
+          {
+          const auto item = originHandle[dim];
+          this->SetOrigin( dim, cbor_float_get_float(item) );
+          }
+      }
+      else if (key == "spacing")
+      {
+        const auto spacingHandle = cbor_array_handle(valueItem.get());
+        const size_t spacingSize = cbor_array_size(valueItem.get());
+        for( int dim = 0; dim < spacingSize; ++dim )
+          {
+          const auto item = spacingHandle[dim];
+          this->SetSpacing( dim, cbor_float_get_float(item) );
+          }
+      }
+      else if (key == "size")
+      {
+        const auto sizeHandle = cbor_array_handle(valueItem.get());
+        const size_t sizeSize = cbor_array_size(valueItem.get());
+        for( int dim = 0; dim < sizeSize; ++dim )
+          {
+          const auto item = sizeHandle[dim];
+          this->SetDimensions( dim, cbor_get_int(item) );
+          }
+      }
+      else if (key == "direction")
+      {
+        cbor_item_t * directionItem = cbor_tag_item(valueItem.get());
+        const double * directionHandle = reinterpret_cast< double * >( cbor_bytestring_handle(directionItem) );
+        const size_t directionSize = cbor_bytestring_length(directionItem);
+        const unsigned int dimension = std::sqrt( directionSize / sizeof(double) );
+        for( unsigned int jj = 0; jj < dimension; ++jj )
+          {
+          std::vector< double > direction( dimension );
+          for( unsigned int kk = 0; kk < dimension; ++kk )
+            {
+            direction[kk] = directionHandle[kk + jj*dimension];
+            }
+          this->SetDirection( jj, direction );
+          }
+      }
+      else if (key == "metadata")
+      {
+        auto dictionary = this->GetMetaDataDictionary();
+        wasm::ConvertCBORToMetaDataDictionary(valueItem.get(), dictionary);
+        this->SetMetaDataDictionary(dictionary);
+      }
+      else if (key == "payloadFilter")
+      {
+        const std::string payloadFilter(reinterpret_cast<char *>(cbor_string_handle(valueItem.get())), cbor_string_length(valueItem.get()));
+        m_PayloadFilter = payloadFilterFromString(payloadFilter);
+      }
+      else
+      {
+        itkExceptionMacro("Unexpected cbor map key: " << key);
+      }
     }
-    else if (key == "size")
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("There was an error while reading " << this->GetFileName() << ": " << error.what());
+  }
+  return 0;
+}
+
+
+void
+WasmImageIO
+::ReadCBORData( void *buffer, std::istream & inputStream, SizeValueType dataLength )
+{
+  const SizeValueType numberOfBytesToBeRead =
+    static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+  if (dataLength < numberOfBytesToBeRead)
+  {
+    itkExceptionMacro(<< "Read failed: Wanted "
+                      << numberOfBytesToBeRead
+                      << " bytes, but the data bytestring has "
+                      << dataLength << " bytes.");
+  }
+  WasmCBORStreamReader reader(inputStream);
+  try
+  {
+    if (m_PayloadFilter == WasmPayloadFilterEnum::None)
     {
-      const auto sizeHandle = cbor_array_handle(indexHandle[ii].value);
-      const size_t sizeSize = cbor_array_size(indexHandle[ii].value);
-      for( int dim = 0; dim < sizeSize; ++dim )
-        {
-        const auto item = sizeHandle[dim];
-        this->SetDimensions( dim, cbor_get_uint64(item) );
-        }
+      reader.ReadBytes(buffer, numberOfBytesToBeRead);
     }
-    else if (key == "direction")
+    else
     {
-      cbor_item_t * directionItem = cbor_tag_item(indexHandle[ii].value);
-      const double * directionHandle = reinterpret_cast< double * >( cbor_bytestring_handle(directionItem) );
-      const size_t directionSize = cbor_bytestring_length(directionItem);
-      const unsigned int dimension = std::sqrt( directionSize / sizeof(double) );
-      for( unsigned int jj = 0; jj < dimension; ++jj )
-        {
-        std::vector< double > direction( dimension );
-        for( unsigned int kk = 0; kk < dimension; ++kk )
-          {
-          direction[kk] = directionHandle[kk + jj*dimension];
-          }
-        this->SetDirection( jj, direction );
-        }
+      std::vector< char > filtered(numberOfBytesToBeRead);
+      reader.ReadBytes(filtered.data(), numberOfBytesToBeRead);
+      reversePayloadFilter(m_PayloadFilter, this->GetPayloadLayout(), filtered.data(), buffer, numberOfBytesToBeRead);
     }
-    else if (key == "data")
+    reader.SkipBytes(dataLength - numberOfBytesToBeRead);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("There was an error while reading " << this->GetFileName() << ": " << error.what());
+  }
+}
+
+
+WasmPayloadLayout
+WasmImageIO
+::GetPayloadLayout() const
+{
+  WasmPayloadLayout layout;
+  layout.componentSize = static_cast< unsigned int >( this->GetComponentSize() );
+  layout.numberOfComponents = this->GetNumberOfComponents();
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  layout.rowLength = dimension > 0 ? this->GetDimensions(0) : 1;
+  layout.blockSize = static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+  if (dimension > 1 && this->GetDimensions(dimension - 1) > 0)
+  {
+    layout.blockSize /= this->GetDimensions(dimension - 1);
+  }
+  return layout;
+}
+
+
+void
+WasmImageIO
+::CopyRegion( const void * source, const ImageIORegion & sourceRegion,
+  void * destination, const ImageIORegion & destinationRegion ) const
+{
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  const BlockBounds sourceBounds = blockBoundsFromIORegion(sourceRegion, dimension);
+  const BlockBounds destinationBounds = blockBoundsFromIORegion(destinationRegion, dimension);
+  BlockBounds overlap(sourceBounds);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    const IndexValueType overlapStart = std::max(sourceBounds.index[dim], destinationBounds.index[dim]);
+    const IndexValueType overlapEnd = std::min(sourceBounds.index[dim] + static_cast< IndexValueType >(sourceBounds.size[dim]),
+      destinationBounds.index[dim] + static_cast< IndexValueType >(destinationBounds.size[dim]));
+    if (overlapEnd <= overlapStart)
     {
-      if( buffer != nullptr )
-      {
-        const SizeValueType numberOfBytesToBeRead =
-          static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-        const cbor_item_t * dataItem = cbor_tag_item(indexHandle[ii].value);
-        const char * dataHandle = reinterpret_cast< char * >( cbor_bytestring_handle(dataItem) );
-        std::memcpy(buffer, dataHandle, numberOfBytesToBeRead);
-      }
+      return;
     }
-    else if (key == "metadata")
+    overlap.index[dim] = overlapStart;
+    overlap.size[dim] = static_cast< SizeValueType >(overlapEnd - overlapStart);
+  }
+  const SizeValueType pixelSize = this->GetPixelSize();
+  copyOverlap(static_cast< const char * >(source), sourceBounds,
+    static_cast< char * >(destination), destinationBounds, overlap, pixelSize);
+}
+
+void
+WasmImageIO
+::WriteCBOR(const void *buffer)
+{
+  std::ofstream outputStream;
+  this->OpenFileForWriting( outputStream, this->GetFileName(), true, false );
+  this->WriteCBOR(buffer, outputStream);
+}
+
+
+void
+WasmImageIO
+::WriteCBOR(const void *buffer, std::ostream & outputStream)
+{
+  this->WriteCBORHeader(outputStream, buffer != nullptr);
+  if( buffer != nullptr )
+  {
+    this->WriteCBORData(buffer, outputStream);
+  }
+}
+
+
+void
+WasmImageIO
+::WriteCBORData(const void *buffer, std::ostream & outputStream)
+{
+  const SizeValueType numberOfBytesToWrite = static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+  WasmCBORStreamWriter writer(outputStream);
+  try
+  {
+    if (m_PayloadFilter == WasmPayloadFilterEnum::None)
     {
-      // todo
+      writer.WriteBytes(buffer, numberOfBytesToWrite);
     }
     else
     {
-      itkExceptionMacro("Unexpected cbor map key: " << key);
+      std::vector< char > filtered(numberOfBytesToWrite);
+      applyPayloadFilter(m_PayloadFilter, this->GetPayloadLayout(), buffer, filtered.data(), numberOfBytesToWrite);
+      writer.WriteBytes(filtered.data(), numberOfBytesToWrite);
     }
   }
-
-  cbor_decref(&index);
+  catch (const std::exception & error)
+  {
+    itkExceptionMacro("There was an error while writing " << this->GetFileName() << ": " << error.what());
+  }
 }
 
-size_t
+
+void
 WasmImageIO
-::WriteCBOR(const void *buffer, unsigned char ** cborBufferPtr, bool allocateCBORBuffer )
+::WriteCBORHeader(std::ostream & outputStream, bool withData)
 {
-  cbor_item_t * index  = cbor_new_definite_map(7);
+  // Header items are small and built with libcbor. The metadata and the
+  // pixel data are written afterwards directly into the stream.
+  cbor_item_t * index  = cbor_new_definite_map(6);
 
   cbor_item_t * imageTypeItem = cbor_new_definite_map(4);
   cbor_map_add(imageTypeItem,
@@ -405,88 +770,47 @@ WasmImageIO
       cbor_move(cbor_build_string("size")),
       cbor_move(sizeItem)});
 
-  cbor_item_t * metaDataItem = cbor_new_definite_map(0);
-  cbor_map_add(index,
-    cbor_pair{
-      cbor_move(cbor_build_string("metadata")),
-      cbor_move(metaDataItem)});
-
-  if( buffer != nullptr )
+  if( withData && m_PayloadFilter != WasmPayloadFilterEnum::None )
   {
-    const SizeValueType numberOfBytesToWrite =
-      static_cast< SizeValueType >( this->GetImageSizeInBytes() );
-    cbor_item_t * dataItem = cbor_build_bytestring(reinterpret_cast< const unsigned char *>(buffer), numberOfBytesToWrite);
-    uint64_t tag = 0;
-    // Todo: support endianness
-    // https://www.iana.org/assignments/cbor-tags/cbor-tags.xhtml
-    switch (this->GetComponentType()) {
-      case IOComponentEnum::CHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::UCHAR:
-        tag = 64;
-        break;
-      case IOComponentEnum::SHORT:
-        tag = 73;
-        break;
-      case IOComponentEnum::USHORT:
-        tag = 69;
-        break;
-      case IOComponentEnum::INT:
-        tag = 74;
-        break;
-      case IOComponentEnum::UINT:
-        tag = 70;
-        break;
-      case IOComponentEnum::LONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::LONGLONG:
-        tag = 75;
-        break;
-      case IOComponentEnum::ULONGLONG:
-        tag = 71;
-        break;
-      case IOComponentEnum::FLOAT:
-        tag = 85;
-        break;
-      case IOComponentEnum::DOUBLE:
-        tag = 86;
-        break;
-      default:
-        itkExceptionMacro("Unexpected component type");
-    }
-    cbor_item_t * dataTag = cbor_new_tag(tag);
-    cbor_tag_set_item(dataTag, cbor_move(dataItem));
     cbor_map_add(index,
       cbor_pair{
-        cbor_move(cbor_build_string("data")),
-        cbor_move(dataTag)});
+        cbor_move(cbor_build_string("payloadFilter")),
+        cbor_move(cbor_build_string(payloadFilterToString(m_PayloadFilter).c_str()))});
   }
 
-  size_t cborBufferSize;
-  size_t length;
-  unsigned char * cborBuffer;
-
-  if (allocateCBORBuffer)
+  WasmCBORStreamWriter writer(outputStream);
+  try
   {
-    length = cbor_serialize_alloc(index, cborBufferPtr, &cborBufferSize);
+    const size_t headerCount = cbor_map_size(index);
+    writer.WriteMapHead(headerCount + 1 + (withData ? 1 : 0));
+    const struct cbor_pair * indexHandle = cbor_map_handle(index);
+    for (size_t ii = 0; ii < headerCount; ++ii)
+    {
+      writer.WriteItem(indexHandle[ii].key);
+      writer.WriteItem(indexHandle[ii].value);
+    }
+
+    // The metadata may hold large numeric arrays, so it is encoded
+    // directly into the stream
+    writer.WriteString("metadata");
+    wasm::ConvertMetaDataDictionaryToCBOR(this->GetMetaDataDictionary(), writer);
+
+    // The data entry is written last so that information-only reads can
+    // stop after the header
+    if( withData )
+    {
+      writer.WriteString("data");
+      writer.WriteTag(cborTypedArrayTag(this->GetComponentType()));
+      writer.WriteByteStringHead(static_cast< SizeValueType >( this->GetImageSizeInBytes() ));
+    }
   }
-  else
+  catch (const std::exception & error)
   {
-    length = cbor_serialize_alloc(index, &cborBuffer, &cborBufferSize);
-    FILE* file = fopen(this->GetFileName(), "wb");
-    fwrite(cborBuffer, 1, length, file);
-    free(cborBuffer);
-    fclose(file);
+    cbor_decref(&index);
+    itkExceptionMacro("There was an error while writing " << this->GetFileName() << ": " << error.what());
   }
 
   cbor_decref(&index);
-  
-  return length;
 }
 
 
@@ -518,6 +842,7 @@ WasmImageIO
     return;
     }
   this->SetJSON(document);
+  m_ChunkSize = chunkSizeFromJSON(document);
 
   const unsigned int dimension = this->GetNumberOfDimensions();
   const auto dataPath = path + "/data";
@@ -554,6 +879,40 @@ WasmImageIO
     return;
   }
 
+  if (this->IsChunked())
+  {
+    this->ReadChunks(buffer);
+    return;
+  }
+
+  if (this->GetUseMemoryMapping())
+  {
+    const auto mapping = this->MapPixelData();
+    const SizeValueType numberOfBytesToBeRead =
+      static_cast< SizeValueType >( this->GetImageSizeInBytes() );
+    if (mapping->GetSize() < numberOfBytesToBeRead)
+    {
+      itkExceptionMacro(<< "Read failed: Wanted "
+                        << numberOfBytesToBeRead
+                        << " bytes, but the pixel data file has "
+                        << mapping->GetSize() << " bytes.");
+    }
+    const unsigned int dimension = this->GetNumberOfDimensions();
+    BlockBounds image;
+    image.index.resize(dimension, 0);
+    image.size.resize(dimension);
+    for (unsigned int dim = 0; dim < dimension; ++dim)
+    {
+      image.size[dim] = this->GetDimensions(dim);
+    }
+    const BlockBounds region = blockBoundsFromIORegion(this->GetIORegion(), dimension);
+    if (numberOfPixels(region) > 0)
+    {
+      copyOverlap(mapping->GetData(), image, static_cast< char * >(buffer), region, region, this->GetPixelSize());
+    }
+    return;
+  }
+
   const std::string dataFile = (path + "/data/data.raw").c_str();
   std::ifstream dataStream;
   this->OpenFileForReading( dataStream, dataFile.c_str() );
@@ -610,6 +969,12 @@ WasmImageIO
     return false;
     }
 
+  // WasmLz4ImageIO is required
+  if ( filename.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
@@ -663,11 +1028,29 @@ WasmImageIO
   rapidjson::Value size(rapidjson::kArrayType);
   for( unsigned int ii = 0; ii < dimension; ++ii )
     {
-    size.PushBack(rapidjson::Value().SetInt( this->GetDimensions( ii ) ), allocator);
+    size.PushBack(rapidjson::Value().SetUint64( this->GetDimensions( ii ) ), allocator);
     }
   document.AddMember( "size", size.Move(), allocator );
 
   std::string dataFileString( "data:application/vnd.itk.path,data/data.raw" );
+  if (this->IsChunked())
+  {
+    if (m_ChunkSize.size() != dimension)
+    {
+      itkExceptionMacro("ChunkSize dimension " << m_ChunkSize.size() << " does not match the image dimension " << dimension);
+    }
+    rapidjson::Value chunkSize(rapidjson::kArrayType);
+    for( unsigned int ii = 0; ii < dimension; ++ii )
+      {
+      if (m_ChunkSize[ii] == 0)
+        {
+        itkExceptionMacro("ChunkSize must be greater than zero");
+        }
+      chunkSize.PushBack(rapidjson::Value().SetUint64( m_ChunkSize[ii] ), allocator);
+      }
+    document.AddMember( "chunkSize", chunkSize.Move(), allocator );
+    dataFileString = "data:application/vnd.itk.path,data/chunks";
+  }
   rapidjson::Value dataFile;
   dataFile.SetString( dataFileString.c_str(), allocator );
   document.AddMember( "data", dataFile, allocator );
@@ -706,6 +1089,12 @@ WasmImageIO
   rapidjson::Document document = this->GetJSON();
   const unsigned int dimension = this->GetNumberOfDimensions();
 
+  const auto chunksPath = dataPath + "/chunks";
+  if ( this->IsChunked() && !itksys::SystemTools::FileExists(chunksPath, false) )
+    {
+      itksys::SystemTools::MakeDirectory(chunksPath);
+    }
+
   const auto directionPath = dataPath + "/direction.raw";
   if ( !itksys::SystemTools::FileExists(dataPath, false) )
     {
@@ -749,19 +1138,43 @@ WasmImageIO
 
   if (this->RequestedToStream())
   {
-    if (!itksys::SystemTools::FileExists(path.c_str()))
+    if (itksys::SystemTools::FileExists(path.c_str()))
+    {
+      // Pasting into an existing image uses its chunk layout
+      rapidjson::Document document;
+      std::ifstream inputStream;
+      const auto indexPath = path + "/index.json";
+      this->OpenFileForReading( inputStream, indexPath.c_str(), true );
+      std::string str((std::istreambuf_iterator<char>(inputStream)),
+                        std::istreambuf_iterator<char>());
+      if (document.Parse(str.c_str()).HasParseError())
+        {
+        itkExceptionMacro("Could not parse JSON");
+        }
+      m_ChunkSize = chunkSizeFromJSON(document);
+    }
+    else
     {
       this->WriteImageInformation();
-      std::ofstream file;
-      this->OpenFileForWriting(file, fileName, false);
+      if (!this->IsChunked())
+      {
+        std::ofstream file;
+        this->OpenFileForWriting(file, fileName, false);
+
+        // write one byte at the end of the file to allocate (this is a
+        // nifty trick which should not write the entire size of the file
+        // just allocate it, if the system supports sparse files)
+        std::streampos seekPos = this->GetImageSizeInBytes();
+        file.seekp(seekPos, std::ios::cur);
+        file.write("\0", 1);
+        file.seekp(0);
+      }
+    }
 
-      // write one byte at the end of the file to allocate (this is a
-      // nifty trick which should not write the entire size of the file
-      // just allocate it, if the system supports sparse files)
-      std::streampos seekPos = this->GetImageSizeInBytes();
-      file.seekp(seekPos, std::ios::cur);
-      file.write("\0", 1);
-      file.seekp(0);
+    if (this->IsChunked())
+    {
+      this->WriteChunks(buffer);
+      return;
     }
 
     std::ofstream file;
@@ -773,6 +1186,12 @@ WasmImageIO
   else
   {
     this->WriteImageInformation();
+    if (this->IsChunked())
+    {
+      this->WriteChunks(buffer);
+      return;
+    }
+
     std::ofstream outputStream;
     this->OpenFileForWriting( outputStream, fileName, true, false );
     const SizeValueType numberOfBytes = this->GetImageSizeInBytes();
@@ -780,4 +1199,125 @@ WasmImageIO
   }
 }
 
+
+std::shared_ptr< const WasmMemoryMappedFile >
+WasmImageIO
+::MapPixelData()
+{
+  if (fileNameIsCBOR(this->GetFileName()) || this->IsChunked())
+  {
+    return nullptr;
+  }
+  const std::string dataFile(std::string(this->GetFileName()) + "/data/data.raw");
+  try
+  {
+    return std::make_shared< const WasmMemoryMappedFile >(dataFile);
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro(<< error.what());
+  }
+}
+
+
+void
+WasmImageIO
+::ReadChunks( void *buffer )
+{
+  const std::string path(this->GetFileName());
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  if (m_ChunkSize.size() != dimension)
+  {
+    itkExceptionMacro("ChunkSize dimension " << m_ChunkSize.size() << " does not match the image dimension " << dimension);
+  }
+  std::vector< SizeValueType > imageSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    imageSize[dim] = this->GetDimensions(dim);
+  }
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const BlockBounds region = blockBoundsFromIORegion(this->GetIORegion(), dimension);
+
+  std::vector< char > chunkBuffer;
+  forEachOverlappingChunk(imageSize, m_ChunkSize, region,
+    [&](const std::vector< SizeValueType > & gridIndex, const BlockBounds & chunk, const BlockBounds & overlap)
+    {
+      const SizeValueType numberOfBytesToBeRead = numberOfPixels(chunk) * pixelSize;
+      chunkBuffer.resize(numberOfBytesToBeRead);
+      const std::string chunkPath = chunkFileName(path, gridIndex);
+      if (itksys::SystemTools::FileExists(chunkPath, true))
+      {
+        std::ifstream chunkStream;
+        this->OpenFileForReading( chunkStream, chunkPath.c_str() );
+        if ( !readBufferAsBinary( chunkStream, chunkBuffer.data(), numberOfBytesToBeRead ) )
+          {
+          itkExceptionMacro(<< "Read failed: Wanted "
+                            << numberOfBytesToBeRead
+                            << " bytes, but read "
+                            << chunkStream.gcount() << " bytes from " << chunkPath);
+          }
+      }
+      else
+      {
+        // Chunks that have not been written yet, e.g. while streaming, are empty
+        std::fill(chunkBuffer.begin(), chunkBuffer.end(), 0);
+      }
+      copyOverlap(chunkBuffer.data(), chunk, static_cast< char * >(buffer), region, overlap, pixelSize);
+    });
+}
+
+
+void
+WasmImageIO
+::WriteChunks( const void *buffer )
+{
+  const std::string path(this->GetFileName());
+  const unsigned int dimension = this->GetNumberOfDimensions();
+  if (m_ChunkSize.size() != dimension)
+  {
+    itkExceptionMacro("ChunkSize dimension " << m_ChunkSize.size() << " does not match the image dimension " << dimension);
+  }
+  std::vector< SizeValueType > imageSize(dimension);
+  for (unsigned int dim = 0; dim < dimension; ++dim)
+  {
+    imageSize[dim] = this->GetDimensions(dim);
+  }
+  const SizeValueType pixelSize = this->GetPixelSize();
+  const BlockBounds region = blockBoundsFromIORegion(this->GetIORegion(), dimension);
+
+  std::vector< char > chunkBuffer;
+  forEachOverlappingChunk(imageSize, m_ChunkSize, region,
+    [&](const std::vector< SizeValueType > & gridIndex, const BlockBounds & chunk, const BlockBounds & overlap)
+    {
+      const SizeValueType numberOfBytes = numberOfPixels(chunk) * pixelSize;
+      chunkBuffer.resize(numberOfBytes);
+      const std::string chunkPath = chunkFileName(path, gridIndex);
+      // A chunk only partially covered by the region keeps its other pixels
+      if (overlap.size != chunk.size)
+      {
+        if (itksys::SystemTools::FileExists(chunkPath, true))
+        {
+          std::ifstream chunkStream;
+          this->OpenFileForReading( chunkStream, chunkPath.c_str() );
+          if ( !readBufferAsBinary( chunkStream, chunkBuffer.data(), numberOfBytes ) )
+            {
+            itkExceptionMacro(<< "Read failed: Wanted "
+                              << numberOfBytes
+                              << " bytes, but read "
+                              << chunkStream.gcount() << " bytes from " << chunkPath);
+            }
+        }
+        else
+        {
+          std::fill(chunkBuffer.begin(), chunkBuffer.end(), 0);
+        }
+      }
+      copyOverlap(static_cast< const char * >(buffer), region, chunkBuffer.data(), chunk, overlap, pixelSize);
+
+      std::ofstream chunkStream;
+      this->OpenFileForWriting( chunkStream, chunkPath, true, false );
+      chunkStream.write(chunkBuffer.data(), numberOfBytes);
+    });
+}
+
 } // end namespace itk
@@ -83,10 +83,25 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
     ioRegion.SetSize(dim, imageIO->GetDimensions( dim ));
     }
   imageIO->SetIORegion( ioRegion );
-  this->m_PixelDataContainer->resize( imageIO->GetImageSizeInBytes() );
-  imageIO->Read( reinterpret_cast< void * >( &(this->m_PixelDataContainer->at(0)) ));
+  this->m_ImportedPixelData = nullptr;
+  this->m_ImportedPixelDataSize = 0;
+  auto * mappableImageIO = dynamic_cast< WasmImageIO * >( imageIO );
+  if (mappableImageIO != nullptr && mappableImageIO->GetUseMemoryMapping())
+  {
+    this->m_PixelDataMapping = mappableImageIO->MapPixelData();
+  }
+  if (this->m_PixelDataMapping && this->m_PixelDataMapping->GetSize() >= imageIO->GetImageSizeInBytes())
+  {
+    this->m_PixelDataContainer->clear();
+  }
+  else
+  {
+    this->m_PixelDataMapping.reset();
+    this->m_PixelDataContainer->resize( imageIO->GetImageSizeInBytes() );
+    imageIO->Read( reinterpret_cast< void * >( &(this->m_PixelDataContainer->at(0)) ));
+  }
 
-  const auto pixelDataAddress = reinterpret_cast< size_t >( &(this->m_PixelDataContainer->at(0)) );
+  const auto pixelDataAddress = reinterpret_cast< size_t >( this->GetPixelData() );
   std::ostringstream dataStream;
   dataStream << "data:application/vnd.itk.address,0:";
   dataStream << pixelDataAddress;
@@ -101,6 +116,15 @@ WasmImageIOBase::SetImageIO(ImageIOBase * imageIO, bool readImage)
   this->SetJSON(stringBuffer.GetString());
 }
 
+void
+WasmImageIOBase::ImportPixelData(const char * data, SizeValueType size)
+{
+  this->m_PixelDataMapping.reset();
+  this->m_PixelDataContainer->clear();
+  this->m_ImportedPixelData = data;
+  this->m_ImportedPixelDataSize = size;
+}
+
 void
 WasmImageIOBase::PrintSelf(std::ostream & os, Indent indent) const
 {
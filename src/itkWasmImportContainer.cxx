@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmImportContainer.h"
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define ITK_WASM_IMPORT_CONTAINER_SIMD128
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ITK_WASM_IMPORT_CONTAINER_SSE2
+#endif
+
+namespace itk
+{
+
+void
+convertComponents(const float * input, double * output, SizeValueType numberOfComponents)
+{
+  SizeValueType ii = 0;
+#if defined(ITK_WASM_IMPORT_CONTAINER_SIMD128)
+  for (; ii + 4 <= numberOfComponents; ii += 4)
+  {
+    const v128_t v = wasm_v128_load(input + ii);
+    wasm_v128_store(output + ii, wasm_f64x2_promote_low_f32x4(v));
+    wasm_v128_store(output + ii + 2, wasm_f64x2_promote_low_f32x4(wasm_i32x4_shuffle(v, v, 2, 3, 0, 1)));
+  }
+#elif defined(ITK_WASM_IMPORT_CONTAINER_SSE2)
+  for (; ii + 4 <= numberOfComponents; ii += 4)
+  {
+    const __m128 v = _mm_loadu_ps(input + ii);
+    _mm_storeu_pd(output + ii, _mm_cvtps_pd(v));
+    _mm_storeu_pd(output + ii + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+  }
+#endif
+  for (; ii < numberOfComponents; ++ii)
+  {
+    output[ii] = static_cast<double>(input[ii]);
+  }
+}
+
+void
+convertComponents(const double * input, float * output, SizeValueType numberOfComponents)
+{
+  SizeValueType ii = 0;
+#if defined(ITK_WASM_IMPORT_CONTAINER_SIMD128)
+  for (; ii + 4 <= numberOfComponents; ii += 4)
+  {
+    const v128_t low = wasm_f32x4_demote_f64x2_zero(wasm_v128_load(input + ii));
+    const v128_t high = wasm_f32x4_demote_f64x2_zero(wasm_v128_load(input + ii + 2));
+    wasm_v128_store(output + ii, wasm_i32x4_shuffle(low, high, 0, 1, 4, 5));
+  }
+#elif defined(ITK_WASM_IMPORT_CONTAINER_SSE2)
+  for (; ii + 4 <= numberOfComponents; ii += 4)
+  {
+    const __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(input + ii));
+    const __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(input + ii + 2));
+    _mm_storeu_ps(output + ii, _mm_movelh_ps(low, high));
+  }
+#endif
+  for (; ii < numberOfComponents; ++ii)
+  {
+    output[ii] = static_cast<float>(input[ii]);
+  }
+}
+
+} // end namespace itk
@@ -0,0 +1,132 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMemoryArena.h"
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+namespace itk
+{
+
+WasmMemoryArena
+::~WasmMemoryArena()
+{
+  this->Reset();
+  this->Trim();
+}
+
+size_t
+WasmMemoryArena
+::SizeClass(size_t size)
+{
+  if (size <= Alignment)
+  {
+    return Alignment;
+  }
+  size_t powerOfTwo = 1;
+  while (powerOfTwo <= (size - 1) / 2)
+  {
+    powerOfTwo *= 2;
+  }
+  const size_t step = std::max(Alignment, powerOfTwo / 4);
+  return (size + step - 1) / step * step;
+}
+
+void *
+WasmMemoryArena
+::Allocate(size_t size)
+{
+  const size_t sizeClass = SizeClass(size);
+  void * block = nullptr;
+  auto released = m_ReleasedBlocks.find(sizeClass);
+  if (released != m_ReleasedBlocks.end() && !released->second.empty())
+  {
+    block = released->second.back();
+    released->second.pop_back();
+  }
+  else
+  {
+    // Released blocks of other classes that could hold this one are not
+    // reused; return them rather than holding both.
+    if (m_ReservedSize - m_InUseSize >= sizeClass)
+    {
+      this->Trim();
+    }
+    block = ::operator new(sizeClass, std::align_val_t(Alignment));
+    m_ReservedSize += sizeClass;
+  }
+  m_InUseBlocks.emplace(block, sizeClass);
+  m_InUseSize += sizeClass;
+  return block;
+}
+
+void
+WasmMemoryArena
+::Release(void * block)
+{
+  const auto inUse = m_InUseBlocks.find(block);
+  if (inUse == m_InUseBlocks.end())
+  {
+    throw std::runtime_error("Block was not allocated by this arena");
+  }
+  m_ReleasedBlocks[inUse->second].push_back(block);
+  m_InUseSize -= inUse->second;
+  m_InUseBlocks.erase(inUse);
+}
+
+void
+WasmMemoryArena
+::Reset()
+{
+  for (const auto & inUse : m_InUseBlocks)
+  {
+    m_ReleasedBlocks[inUse.second].push_back(const_cast<void *>(inUse.first));
+  }
+  m_InUseBlocks.clear();
+  m_InUseSize = 0;
+}
+
+void
+WasmMemoryArena
+::Trim()
+{
+  for (auto & released : m_ReleasedBlocks)
+  {
+    for (void * block : released.second)
+    {
+      ::operator delete(block, std::align_val_t(Alignment));
+      m_ReservedSize -= released.first;
+    }
+  }
+  m_ReleasedBlocks.clear();
+}
+
+size_t
+WasmMemoryArena
+::GetBlockSize(const void * block) const
+{
+  const auto inUse = m_InUseBlocks.find(block);
+  if (inUse == m_InUseBlocks.end())
+  {
+    throw std::runtime_error("Block was not allocated by this arena");
+  }
+  return inUse->second;
+}
+
+} // end namespace itk
@@ -0,0 +1,239 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMemoryContext.h"
+
+#include <iterator>
+#include <mutex>
+
+namespace itk
+{
+namespace wasm
+{
+
+namespace
+{
+
+// Registered contexts other than the default context
+std::mutex registryMutex;
+std::map<uint32_t, WasmMemoryContext *> registry;
+uint32_t nextIndex = 1;
+
+thread_local WasmMemoryContext * currentContext = nullptr;
+
+} // end anonymous namespace
+
+WasmMemoryContext
+::WasmMemoryContext()
+{
+  std::lock_guard<std::mutex> lock(registryMutex);
+  m_Index = nextIndex++;
+  registry[m_Index] = this;
+}
+
+WasmMemoryContext
+::WasmMemoryContext(uint32_t index)
+  : m_Index(index)
+{}
+
+WasmMemoryContext
+::~WasmMemoryContext()
+{
+  if (currentContext == this)
+  {
+    currentContext = nullptr;
+  }
+  if (m_Index != 0)
+  {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.erase(m_Index);
+  }
+}
+
+WasmMemoryContext *
+WasmMemoryContext
+::GetDefault()
+{
+  static WasmMemoryContext defaultContext(0);
+  return &defaultContext;
+}
+
+WasmMemoryContext *
+WasmMemoryContext
+::GetContext(uint32_t index)
+{
+  if (index == 0)
+  {
+    return GetDefault();
+  }
+  std::lock_guard<std::mutex> lock(registryMutex);
+  const auto context = registry.find(index);
+  return context == registry.end() ? nullptr : context->second;
+}
+
+WasmMemoryContext *
+WasmMemoryContext
+::GetCurrent()
+{
+  return currentContext != nullptr ? currentContext : GetDefault();
+}
+
+WasmMemoryContext *
+WasmMemoryContext
+::SetCurrent(WasmMemoryContext * context)
+{
+  WasmMemoryContext * previous = GetCurrent();
+  currentContext = context;
+  return previous;
+}
+
+size_t
+WasmMemoryContext
+::AllocateInputArray(uint32_t index, uint32_t subIndex, size_t size)
+{
+  auto & array = m_InputArrayStore[std::make_pair(index, subIndex)];
+  if (array.first != 0 && WasmMemoryArena::SizeClass(size) != m_InputArena.GetBlockSize(reinterpret_cast< void * >(array.first)))
+  {
+    m_InputArena.Release(reinterpret_cast< void * >(array.first));
+    array.first = 0;
+  }
+  if (array.first == 0)
+  {
+    array.first = reinterpret_cast< size_t >(m_InputArena.Allocate(size));
+  }
+  array.second = size;
+  return array.first;
+}
+
+size_t
+WasmMemoryContext
+::AllocateInputJSON(uint32_t index, size_t size)
+{
+  // The buffer of a previous execution is reused when it is large enough,
+  // and neither is zero filled
+  auto & json = m_InputJSONStore[index];
+  if (size + 1 > json.capacity)
+  {
+    json.buffer.reset(new char[size + 1]);
+    json.capacity = size + 1;
+  }
+  json.size = size;
+  json.buffer[size] = '\0';
+  return reinterpret_cast< size_t >(json.buffer.get());
+}
+
+size_t
+WasmMemoryContext
+::AllocateInputDescriptor(uint32_t index, size_t size)
+{
+  auto & descriptor = m_InputDescriptorStore[index];
+  descriptor.first.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+  descriptor.second = size;
+  return reinterpret_cast< size_t >(descriptor.first.data());
+}
+
+const char *
+WasmMemoryContext
+::GetInputJSON(uint32_t index) const
+{
+  const auto json = m_InputJSONStore.find(index);
+  return json == m_InputJSONStore.end() || json->second.capacity == 0 ? "" : json->second.buffer.get();
+}
+
+const WasmDescriptorHeader *
+WasmMemoryContext
+::GetInputDescriptor(uint32_t index) const
+{
+  const auto descriptor = m_InputDescriptorStore.find(index);
+  if (descriptor == m_InputDescriptorStore.end() || descriptor->second.second < sizeof(WasmDescriptorHeader))
+  {
+    return nullptr;
+  }
+  const auto * header = reinterpret_cast<const WasmDescriptorHeader *>(descriptor->second.first.data());
+  if (header->magic != WasmDescriptorMagic || header->size > descriptor->second.second)
+  {
+    return nullptr;
+  }
+  return header;
+}
+
+void
+WasmMemoryContext
+::SetOutputDataObject(uint32_t index, const WasmDataObject * dataObject)
+{
+  m_OutputDataObjectStore[index] = dataObject;
+}
+
+const WasmDataObject *
+WasmMemoryContext
+::GetOutputDataObject(uint32_t index) const
+{
+  const auto dataObject = m_OutputDataObjectStore.find(index);
+  return dataObject == m_OutputDataObjectStore.end() ? nullptr : dataObject->second.GetPointer();
+}
+
+void
+WasmMemoryContext
+::SetOutputArray(uint32_t index, uint32_t subIndex, size_t address, size_t size)
+{
+  m_OutputArrayStore[std::make_pair(index, subIndex)] = std::make_pair(address, size);
+}
+
+std::pair<size_t, size_t>
+WasmMemoryContext
+::GetOutputArray(uint32_t index, uint32_t subIndex) const
+{
+  const auto array = m_OutputArrayStore.find(std::make_pair(index, subIndex));
+  return array == m_OutputArrayStore.end() ? std::make_pair(size_t{ 0 }, size_t{ 0 }) : array->second;
+}
+
+void
+WasmMemoryContext
+::FreeAll()
+{
+  for (auto & json : m_InputJSONStore)
+  {
+    json.second.size = 0;
+    json.second.buffer[0] = '\0';
+  }
+  m_InputArrayStore.clear();
+  m_InputArena.Reset();
+  for (auto & descriptor : m_InputDescriptorStore)
+  {
+    descriptor.second.second = 0;
+  }
+  m_OutputDataObjectStore.clear();
+  m_OutputArrayStore.clear();
+}
+
+void
+WasmMemoryContext
+::Trim()
+{
+  m_InputArena.Trim();
+  for (auto json = m_InputJSONStore.begin(); json != m_InputJSONStore.end();)
+  {
+    json = json->second.size == 0 ? m_InputJSONStore.erase(json) : std::next(json);
+  }
+  for (auto descriptor = m_InputDescriptorStore.begin(); descriptor != m_InputDescriptorStore.end();)
+  {
+    descriptor = descriptor->second.second == 0 ? m_InputDescriptorStore.erase(descriptor) : std::next(descriptor);
+  }
+}
+
+} // end namespace wasm
+} // end namespace itk
@@ -23,6 +23,9 @@
 #include "itkWasmPixelTypeFromIOPixelEnum.h"
 #include "itkIOPixelEnumFromWasmPixelType.h"
 #include "itkWasmIOCommon.h"
+#include "itkWasmCBORStream.h"
+#include "itkWasmMemoryStreamBuffer.h"
+#include "itkWasmVisitComponentType.h"
 
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
@@ -36,9 +39,119 @@
 
 #include "cbor.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 namespace itk
 {
 
+namespace
+{
+
+struct cbor_pair *
+findCBORMapPair(cbor_item_t * map, std::string_view key)
+{
+  const size_t count = cbor_map_size(map);
+  struct cbor_pair * handle = cbor_map_handle(map);
+  for (size_t ii = 0; ii < count; ++ii)
+  {
+    const std::string_view pairKey(reinterpret_cast<char *>(cbor_string_handle(handle[ii].key)), cbor_string_length(handle[ii].key));
+    if (pairKey == key)
+    {
+      return &handle[ii];
+    }
+  }
+  return nullptr;
+}
+
+cbor_item_t *
+buildCBORFloatArray(const std::vector< double > & values)
+{
+  cbor_item_t * array = cbor_new_definite_array(values.size());
+  for (const double value : values)
+  {
+    cbor_array_push(array, cbor_move(cbor_build_float8(value)));
+  }
+  return array;
+}
+
+std::vector< double >
+cborFloatArray(const cbor_item_t * array)
+{
+  const size_t count = cbor_array_size(array);
+  cbor_item_t ** handle = cbor_array_handle(array);
+  std::vector< double > values(count);
+  for (size_t ii = 0; ii < count; ++ii)
+  {
+    values[ii] = cbor_float_get_float(handle[ii]);
+  }
+  return values;
+}
+
+/** Call the functor with a value of the C++ type of a float32 or float64
+ * coordinate component. */
+template< typename TFunctor >
+void
+visitCoordinateComponent(CommonEnums::IOComponent componentType, TFunctor && functor)
+{
+  switch ( componentType )
+    {
+    case CommonEnums::IOComponent::FLOAT:
+      functor( float{} );
+      return;
+    case CommonEnums::IOComponent::DOUBLE:
+      functor( double{} );
+      return;
+    default:
+      throw std::runtime_error("Points are not float32 or float64");
+    }
+}
+
+template< typename TQuantized, typename TCoordinate >
+void
+quantizePoints(const TCoordinate * points, SizeValueType numberOfComponents, const std::vector< double > & minimum,
+               const std::vector< double > & maximum, TQuantized * quantizedPoints)
+{
+  constexpr double maximumLevel = std::numeric_limits< TQuantized >::max();
+  const size_t dimension = minimum.size();
+  std::vector< double > scale(dimension);
+  for (size_t dd = 0; dd < dimension; ++dd)
+  {
+    const double extent = maximum[dd] - minimum[dd];
+    scale[dd] = extent > 0.0 ? maximumLevel / extent : 0.0;
+  }
+  for (SizeValueType ii = 0; ii < numberOfComponents; ++ii)
+  {
+    const size_t dd = ii % dimension;
+    const double level = std::round( ( static_cast< double >( points[ii] ) - minimum[dd] ) * scale[dd] );
+    quantizedPoints[ii] = static_cast< TQuantized >( std::clamp( level, 0.0, maximumLevel ) );
+  }
+}
+
+template< typename TCoordinate, typename TQuantized >
+void
+dequantizePoints(const TQuantized * quantizedPoints, SizeValueType numberOfComponents, const std::vector< double > & minimum,
+                 const std::vector< double > & maximum, TCoordinate * points)
+{
+  constexpr double maximumLevel = std::numeric_limits< TQuantized >::max();
+  const size_t dimension = minimum.size();
+  std::vector< double > step(dimension);
+  for (size_t dd = 0; dd < dimension; ++dd)
+  {
+    step[dd] = ( maximum[dd] - minimum[dd] ) / maximumLevel;
+  }
+  for (SizeValueType ii = 0; ii < numberOfComponents; ++ii)
+  {
+    const size_t dd = ii % dimension;
+    points[ii] = static_cast< TCoordinate >( minimum[dd] + quantizedPoints[ii] * step[dd] );
+  }
+}
+
+} // end anonymous namespace
+
 WasmMeshIO
 ::WasmMeshIO()
 {
@@ -60,6 +173,10 @@ WasmMeshIO
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseMemoryMapping: " << (m_UseMemoryMapping ? "On" : "Off") << std::endl;
+  os << indent << "PointQuantizationPrecision: " << m_PointQuantizationPrecision << std::endl;
+  os << indent << "NarrowCellComponentType: " << (m_NarrowCellComponentType ? "On" : "Off") << std::endl;
 }
 
 
@@ -85,188 +202,290 @@ WasmMeshIO
     return false;
     }
 
+  // WasmZstdMeshIO is required
+  if ( fname.rfind(".zst") != std::string::npos )
+    {
+    return false;
+    }
+
+  // WasmLz4MeshIO is required
+  if ( fname.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
 
 void
 WasmMeshIO
-::ReadCBOR( void *buffer, unsigned char * cborBuffer, size_t cborBufferLength )
+::ReadCBOR()
 {
-  bool cborBufferAllocated = false;
-  size_t length = cborBufferLength;
-  if (cborBuffer == nullptr)
-  {
-    FILE* file = fopen(this->GetFileName(), "rb");
-    if (file == NULL) {
-      itkExceptionMacro("Could not read file: " << this->GetFileName());
-    }
-    fseek(file, 0, SEEK_END);
-    length = (size_t)ftell(file);
-    fseek(file, 0, SEEK_SET);
-    cborBuffer = static_cast< unsigned char *>(malloc(length));
-    cborBufferAllocated = true;
-    if (!fread(cborBuffer, length, 1, file))
-    {
-      itkExceptionMacro("Could not successfully read " << this->GetFileName());
+  std::ifstream inputStream;
+  openFileForReading( inputStream, this->GetFileName() );
+  m_CBORBuffer = std::vector< char >();
+  m_MemoryMappedFile.reset();
+  this->ReadCBORIndex( inputStream );
+}
+
+
+void
+WasmMeshIO
+::ReadCBOR( std::vector< char > && cborBuffer )
+{
+  m_CBORBuffer = std::move( cborBuffer );
+  m_MemoryMappedFile.reset();
+  WasmMemoryInputStream inputStream( m_CBORBuffer.data(), m_CBORBuffer.size() );
+  this->ReadCBORIndex( inputStream );
+}
 
-    }
-    fclose(file);
-  }
 
+void
+WasmMeshIO
+::ReadCBORIndex( std::istream & inputStream )
+{
+  // Only the header items are decoded. The typed array payloads are
+  // skipped and their locations recorded for ReadCBORData().
   if (this->m_CBORRoot != nullptr) {
     cbor_decref(&(this->m_CBORRoot));
   }
-  struct cbor_load_result result;
-  this->m_CBORRoot = cbor_load(cborBuffer, length, &result);
-  if (cborBufferAllocated)
+  m_CBORDataLocations.clear();
+
+  WasmCBORStreamReader reader( inputStream );
+  try
   {
-    free(cborBuffer);
+    const uint64_t indexCount = reader.ReadMapHead();
+    for (uint64_t ii = 0; ii < indexCount; ++ii)
+    {
+      const std::string key = reader.ReadString();
+      if (key == "points" || key == "cells" || key == "pointData" || key == "cellData")
+      {
+        CBORDataLocation & location = m_CBORDataLocations[key];
+        location.length = reader.ReadByteStringHead();
+        location.offset = static_cast< SizeValueType >( inputStream.tellg() );
+        reader.SkipBytes( location.length );
+        continue;
+      }
+
+      const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+      std::unique_ptr< cbor_item_t, decltype(itemDeleter) > valueItem(reader.ReadItem(), itemDeleter);
+      this->ReadCBORHeaderItem( key, valueItem.get() );
+    }
   }
-  if (result.error.code != CBOR_ERR_NONE) {
-    std::string errorDescription;
-    switch (result.error.code) {
-      case CBOR_ERR_MALFORMATED: {
-        errorDescription = "Malformed data\n";
-        break;
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not read " << this->GetFileName() << ": " << error.what());
+  }
+}
+
+
+void
+WasmMeshIO
+::ReadCBORHeaderItem( std::string_view key, const cbor_item_t * value )
+{
+  if (key == "meshType")
+  {
+    m_PointQuantization = PointQuantization();
+    CommonEnums::IOComponent quantizedPointComponentType = CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE;
+    const cbor_item_t * meshTypeItem = value;
+    const size_t meshTypeCount = cbor_map_size(meshTypeItem);
+    const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem);
+    for (size_t jj = 0; jj < meshTypeCount; ++jj)
+    {
+      const std::string_view meshTypeKey(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].key)), cbor_string_length(meshTypeHandle[jj].key));
+      if (meshTypeKey == "dimension")
+      {
+        const auto dimension = cbor_get_uint32(meshTypeHandle[jj].value);
+        this->SetPointDimension( dimension );
       }
-      case CBOR_ERR_MEMERROR: {
-        errorDescription = "Memory error -- perhaps the input is too large?\n";
-        break;
+      else if (meshTypeKey == "pointComponentType")
+      {
+        const std::string pointComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent pointIOComponentType = IOComponentEnumFromWasmComponentType( pointComponentType );
+        this->SetPointComponentType( pointIOComponentType );
       }
-      case CBOR_ERR_NODATA: {
-        errorDescription = "The input is empty\n";
-        break;
+      else if (meshTypeKey == "pointPixelType")
+      {
+        const std::string pointPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOPixel pointIOPixelType = IOPixelEnumFromWasmPixelType( pointPixelType );
+        this->SetPointPixelType( pointIOPixelType );
       }
-      case CBOR_ERR_NOTENOUGHDATA: {
-        errorDescription = "Data seem to be missing -- is the input complete?\n";
-        break;
+      else if (meshTypeKey == "pointPixelComponentType")
+      {
+        const std::string pointPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent pointPixelIOComponentType = IOComponentEnumFromWasmComponentType( pointPixelComponentType );
+        this->SetPointPixelComponentType( pointPixelIOComponentType );
       }
-      case CBOR_ERR_SYNTAXERROR: {
-        errorDescription = 
-            "Syntactically malformed data -- see https://tools.ietf.org/html/rfc7049\n";
-        break;
+      else if (meshTypeKey == "pointPixelComponents")
+      {
+        const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
+        this->SetNumberOfPointPixelComponents( components );
       }
-      case CBOR_ERR_NONE: {
-        break;
+      else if (meshTypeKey == "cellComponentType")
+      {
+        const std::string cellComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent cellIOComponentType = IOComponentEnumFromWasmComponentType( cellComponentType );
+        this->SetCellComponentType( cellIOComponentType );
       }
-    }
-    itkExceptionMacro("" << errorDescription << "There was an error while reading the input near byte " << result.error.position << " (read " << result.read << " bytes in total): ");
-  }
-
-  cbor_item_t * index = this->m_CBORRoot;
-  const size_t indexCount = cbor_map_size(index);
-  const struct cbor_pair * indexHandle = cbor_map_handle(index);
-  for (size_t ii = 0; ii < indexCount; ++ii)
-  {
-    const std::string_view key(reinterpret_cast<char *>(cbor_string_handle(indexHandle[ii].key)), cbor_string_length(indexHandle[ii].key));
-    if (key == "meshType")
-    {
-      const cbor_item_t * meshTypeItem = indexHandle[ii].value;
-      const size_t meshTypeCount = cbor_map_size(meshTypeItem);
-      const struct cbor_pair * meshTypeHandle = cbor_map_handle(meshTypeItem);
-      for (size_t jj = 0; jj < meshTypeCount; ++jj)
+      else if (meshTypeKey == "cellPixelType")
       {
-        const std::string_view meshTypeKey(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].key)), cbor_string_length(meshTypeHandle[jj].key));
-        if (meshTypeKey == "dimension")
-        {
-          const auto dimension = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetPointDimension( dimension );
-        }
-        else if (meshTypeKey == "pointComponentType")
-        {
-          const std::string pointComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent pointIOComponentType = IOComponentEnumFromWasmComponentType( pointComponentType );
-          this->SetPointComponentType( pointIOComponentType );
-        }
-        else if (meshTypeKey == "pointPixelType")
-        {
-          const std::string pointPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOPixel pointIOPixelType = IOPixelEnumFromWasmPixelType( pointPixelType );
-          this->SetPointPixelType( pointIOPixelType );
-        }
-        else if (meshTypeKey == "pointPixelComponentType")
-        {
-          const std::string pointPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent pointPixelIOComponentType = IOComponentEnumFromWasmComponentType( pointPixelComponentType );
-          this->SetPointPixelComponentType( pointPixelIOComponentType );
-        }
-        else if (meshTypeKey == "pointPixelComponents")
-        {
-          const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetNumberOfPointPixelComponents( components );
-        }
-        else if (meshTypeKey == "cellComponentType")
-        {
-          const std::string cellComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent cellIOComponentType = IOComponentEnumFromWasmComponentType( cellComponentType );
-          this->SetCellComponentType( cellIOComponentType );
-        }
-        else if (meshTypeKey == "cellPixelType")
-        {
-          const std::string cellPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOPixel cellIOPixelType = IOPixelEnumFromWasmPixelType( cellPixelType );
-          this->SetCellPixelType( cellIOPixelType );
-        }
-        else if (meshTypeKey == "cellPixelComponentType")
-        {
-          const std::string cellPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
-          const CommonEnums::IOComponent cellPixelIOComponentType = IOComponentEnumFromWasmComponentType( cellPixelComponentType );
-          this->SetCellPixelComponentType( cellPixelIOComponentType );
-        }
-        else if (meshTypeKey == "cellPixelComponents")
-        {
-          const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
-          this->SetNumberOfCellPixelComponents( components );
-        }
-        else
-        {
-          itkExceptionMacro("Unexpected meshType cbor map key: " << meshTypeKey);
-        }
+        const std::string cellPixelType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOPixel cellIOPixelType = IOPixelEnumFromWasmPixelType( cellPixelType );
+        this->SetCellPixelType( cellIOPixelType );
       }
-    }
-    else if (key == "numberOfPoints")
-    {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfPoints( components );
-      if ( components )
+      else if (meshTypeKey == "cellPixelComponentType")
+      {
+        const std::string cellPixelComponentType(reinterpret_cast<char *>(cbor_string_handle(meshTypeHandle[jj].value)), cbor_string_length(meshTypeHandle[jj].value));
+        const CommonEnums::IOComponent cellPixelIOComponentType = IOComponentEnumFromWasmComponentType( cellPixelComponentType );
+        this->SetCellPixelComponentType( cellPixelIOComponentType );
+      }
+      else if (meshTypeKey == "cellPixelComponents")
+      {
+        const auto components = cbor_get_uint32(meshTypeHandle[jj].value);
+        this->SetNumberOfCellPixelComponents( components );
+      }
+      else if (meshTypeKey == "pointQuantization")
+      {
+        const cbor_item_t * quantizationItem = meshTypeHandle[jj].value;
+        const size_t quantizationCount = cbor_map_size(quantizationItem);
+        const struct cbor_pair * quantizationHandle = cbor_map_handle(quantizationItem);
+        for (size_t kk = 0; kk < quantizationCount; ++kk)
         {
-        this->m_UpdatePoints = true;
+          const std::string_view quantizationKey(reinterpret_cast<char *>(cbor_string_handle(quantizationHandle[kk].key)), cbor_string_length(quantizationHandle[kk].key));
+          if (quantizationKey == "componentType")
+          {
+            const std::string componentType(reinterpret_cast<char *>(cbor_string_handle(quantizationHandle[kk].value)), cbor_string_length(quantizationHandle[kk].value));
+            quantizedPointComponentType = IOComponentEnumFromWasmComponentType( componentType );
+          }
+          else if (quantizationKey == "minimum")
+          {
+            m_PointQuantization.minimum = cborFloatArray( quantizationHandle[kk].value );
+          }
+          else if (quantizationKey == "maximum")
+          {
+            m_PointQuantization.maximum = cborFloatArray( quantizationHandle[kk].value );
+          }
+          else
+          {
+            itkExceptionMacro("Unexpected pointQuantization cbor map key: " << quantizationKey);
+          }
         }
+      }
+      else
+      {
+        itkExceptionMacro("Unexpected meshType cbor map key: " << meshTypeKey);
+      }
     }
-    else if (key == "numberOfPointPixels")
+    if ( quantizedPointComponentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE )
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfPointPixels( components );
-      if ( components )
-        {
-        this->m_UpdatePointData = true;
-        }
+      // The pointComponentType is the stored unsigned integer type
+      m_PointQuantization.componentType = this->GetPointComponentType();
+      this->SetPointComponentType( quantizedPointComponentType );
     }
-    else if (key == "numberOfCells")
+  }
+  else if (key == "numberOfPoints")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfPoints( components );
+    if ( components )
+      {
+      this->m_UpdatePoints = true;
+      }
+  }
+  else if (key == "numberOfPointPixels")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfPointPixels( components );
+    if ( components )
+      {
+      this->m_UpdatePointData = true;
+      }
+  }
+  else if (key == "numberOfCells")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfCells( components );
+    if ( components )
+      {
+      this->m_UpdateCells = true;
+      }
+  }
+  else if (key == "numberOfCellPixels")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetNumberOfCellPixels( components );
+    if ( components )
+      {
+      this->m_UpdateCellData = true;
+      }
+  }
+  else if (key == "cellBufferSize")
+  {
+    const auto components = cbor_get_int(value);
+    this->SetCellBufferSize( components );
+  }
+}
+
+
+void
+WasmMeshIO
+::ReadCBORData( const char * dataName, void * buffer, SizeValueType numberOfBytesToBeRead )
+{
+  if ( numberOfBytesToBeRead == 0 )
+  {
+    return;
+  }
+  const auto locationIt = m_CBORDataLocations.find( dataName );
+  if ( locationIt == m_CBORDataLocations.end() )
+  {
+    itkExceptionMacro("No " << dataName << " in " << this->GetFileName() << ", or its information was not read");
+  }
+  const CBORDataLocation & location = locationIt->second;
+  if ( location.length < numberOfBytesToBeRead )
+  {
+    itkExceptionMacro("Read failed: Wanted " << numberOfBytesToBeRead << " bytes of " << dataName
+                      << ", but the file has " << location.length << " bytes.");
+  }
+
+  if ( !m_CBORBuffer.empty() )
+  {
+    std::memcpy( buffer, m_CBORBuffer.data() + location.offset, numberOfBytesToBeRead );
+    return;
+  }
+
+  if ( m_UseMemoryMapping )
+  {
+    if ( !m_MemoryMappedFile )
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfCells( components );
-      if ( components )
-        {
-        this->m_UpdateCells = true;
-        }
+      try
+      {
+        m_MemoryMappedFile = std::make_unique< const WasmMemoryMappedFile >( this->GetFileName() );
+      }
+      catch (const std::runtime_error & error)
+      {
+        itkExceptionMacro("Could not map " << this->GetFileName() << ": " << error.what());
+      }
     }
-    else if (key == "numberOfCellPixels")
+    if ( location.offset + numberOfBytesToBeRead > m_MemoryMappedFile->GetSize() )
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetNumberOfCellPixels( components );
-      if ( components )
-        {
-        this->m_UpdateCellData = true;
-        }
+      itkExceptionMacro("Read failed: " << this->GetFileName() << " is truncated");
     }
-    else if (key == "cellBufferSize")
+    std::memcpy( buffer, m_MemoryMappedFile->GetData() + location.offset, numberOfBytesToBeRead );
+    return;
+  }
+
+  // Positioned read straight into the caller's buffer
+  std::ifstream dataStream;
+  openFileForReading( dataStream, this->GetFileName() );
+  dataStream.seekg( static_cast< std::streamoff >( location.offset ) );
+  if ( !readBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
     {
-      const auto components = cbor_get_uint64(indexHandle[ii].value);
-      this->SetCellBufferSize( components );
+    itkExceptionMacro(<< "Read failed: Wanted "
+                      << numberOfBytesToBeRead
+                      << " bytes, but read "
+                      << dataStream.gcount() << " bytes.");
     }
- }
 }
 
 rapidjson::Document
@@ -283,7 +502,10 @@ WasmMeshIO
   const unsigned int dimension = this->GetPointDimension();
   meshType.AddMember("dimension", rapidjson::Value(dimension).Move(), allocator );
 
-  const std::string pointComponentString = WasmComponentTypeFromIOComponentEnum( this->GetPointComponentType() );
+  // Quantized points are stored with their unsigned integer type, so that
+  // readers unaware of the pointQuantization do not take them for floats
+  const bool quantizedPoints = m_PointQuantization.componentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE;
+  const std::string pointComponentString = WasmComponentTypeFromIOComponentEnum( quantizedPoints ? m_PointQuantization.componentType : this->GetPointComponentType() );
   rapidjson::Value pointComponentType;
   pointComponentType.SetString( pointComponentString.c_str(), allocator );
   meshType.AddMember("pointComponentType", pointComponentType.Move(), allocator );
@@ -299,7 +521,30 @@ WasmMeshIO
 
   meshType.AddMember("pointPixelComponents", rapidjson::Value( this->GetNumberOfPointPixelComponents() ).Move(), allocator );
 
-  const std::string cellComponentString = WasmComponentTypeFromIOComponentEnum( this->GetCellComponentType() );
+  if ( quantizedPoints )
+  {
+    rapidjson::Value pointQuantization;
+    pointQuantization.SetObject();
+    rapidjson::Value quantizedComponentType;
+    quantizedComponentType.SetString( WasmComponentTypeFromIOComponentEnum( this->GetPointComponentType() ).c_str(), allocator );
+    pointQuantization.AddMember("componentType", quantizedComponentType.Move(), allocator );
+    rapidjson::Value minimum;
+    minimum.SetArray();
+    rapidjson::Value maximum;
+    maximum.SetArray();
+    for (unsigned int dd = 0; dd < m_PointQuantization.minimum.size(); ++dd)
+    {
+      minimum.PushBack( m_PointQuantization.minimum[dd], allocator );
+      maximum.PushBack( m_PointQuantization.maximum[dd], allocator );
+    }
+    pointQuantization.AddMember("minimum", minimum.Move(), allocator );
+    pointQuantization.AddMember("maximum", maximum.Move(), allocator );
+    meshType.AddMember("pointQuantization", pointQuantization.Move(), allocator );
+  }
+
+  const CommonEnums::IOComponent writtenCellComponentType = m_WrittenCellComponentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE ?
+    m_WrittenCellComponentType : this->GetCellComponentType();
+  const std::string cellComponentString = WasmComponentTypeFromIOComponentEnum( writtenCellComponentType );
   rapidjson::Value cellComponentType;
   cellComponentType.SetString( cellComponentString.c_str(), allocator );
   meshType.AddMember("cellComponentType", cellComponentType.Move(), allocator );
@@ -318,23 +563,23 @@ WasmMeshIO
   document.AddMember( "meshType", meshType.Move(), allocator );
 
   rapidjson::Value numberOfPoints;
-  numberOfPoints.SetInt( this->GetNumberOfPoints() );
+  numberOfPoints.SetUint64( this->GetNumberOfPoints() );
   document.AddMember( "numberOfPoints", numberOfPoints.Move(), allocator );
 
   rapidjson::Value numberOfPointPixels;
-  numberOfPointPixels.SetInt( this->GetNumberOfPointPixels() );
+  numberOfPointPixels.SetUint64( this->GetNumberOfPointPixels() );
   document.AddMember( "numberOfPointPixels", numberOfPointPixels.Move(), allocator );
 
   rapidjson::Value numberOfCells;
-  numberOfCells.SetInt( this->GetNumberOfCells() );
+  numberOfCells.SetUint64( this->GetNumberOfCells() );
   document.AddMember( "numberOfCells", numberOfCells.Move(), allocator );
 
   rapidjson::Value numberOfCellPixels;
-  numberOfCellPixels.SetInt( this->GetNumberOfCellPixels() );
+  numberOfCellPixels.SetUint64( this->GetNumberOfCellPixels() );
   document.AddMember( "numberOfCellPixels", numberOfCellPixels.Move(), allocator );
 
   rapidjson::Value cellBufferSize;
-  cellBufferSize.SetInt( this->GetCellBufferSize() );
+  cellBufferSize.SetUint64( this->GetCellBufferSize() );
   document.AddMember( "cellBufferSize", cellBufferSize.Move(), allocator );
 
   std::string pointsDataFileString( "data:application/vnd.itk.path,data/points.raw" );
@@ -397,20 +642,38 @@ WasmMeshIO
 
   this->SetNumberOfCellPixelComponents( meshType["cellPixelComponents"].GetInt() );
 
+  m_PointQuantization = PointQuantization();
+  if ( meshType.HasMember("pointQuantization") )
+  {
+    const rapidjson::Value & pointQuantization = meshType["pointQuantization"];
+    const std::string componentType( pointQuantization["componentType"].GetString() );
+    // The pointComponentType is the stored unsigned integer type
+    m_PointQuantization.componentType = this->GetPointComponentType();
+    this->SetPointComponentType( IOComponentEnumFromWasmComponentType( componentType ) );
+    for (const auto & minimum : pointQuantization["minimum"].GetArray())
+    {
+      m_PointQuantization.minimum.push_back( minimum.GetDouble() );
+    }
+    for (const auto & maximum : pointQuantization["maximum"].GetArray())
+    {
+      m_PointQuantization.maximum.push_back( maximum.GetDouble() );
+    }
+  }
+
   const rapidjson::Value & numberOfPoints = document["numberOfPoints"];
-  this->SetNumberOfPoints( numberOfPoints.GetInt() );
+  this->SetNumberOfPoints( numberOfPoints.GetUint64() );
 
   const rapidjson::Value & numberOfPointPixels = document["numberOfPointPixels"];
-  this->SetNumberOfPointPixels( numberOfPointPixels.GetInt() );
+  this->SetNumberOfPointPixels( numberOfPointPixels.GetUint64() );
 
   const rapidjson::Value & numberOfCells = document["numberOfCells"];
-  this->SetNumberOfCells( numberOfCells.GetInt() );
+  this->SetNumberOfCells( numberOfCells.GetUint64() );
 
   const rapidjson::Value & numberOfCellPixels = document["numberOfCellPixels"];
-  this->SetNumberOfCellPixels( numberOfCellPixels.GetInt() );
+  this->SetNumberOfCellPixels( numberOfCellPixels.GetUint64() );
 
   const rapidjson::Value & cellBufferSize = document["cellBufferSize"];
-  this->SetCellBufferSize( cellBufferSize.GetInt() );
+  this->SetCellBufferSize( cellBufferSize.GetUint64() );
 }
 
 
@@ -424,7 +687,8 @@ WasmMeshIO
   this->m_CBORRoot = cbor_new_definite_map(10);
 
   cbor_item_t * index = this->m_CBORRoot;
-  cbor_item_t * meshTypeItem = cbor_new_definite_map(9);
+  // One spare entry for the pointQuantization added by WritePoints
+  cbor_item_t * meshTypeItem = cbor_new_definite_map(10);
   cbor_map_add(meshTypeItem,
     cbor_pair{
       cbor_move(cbor_build_string("dimension")),
@@ -569,27 +833,74 @@ void
 WasmMeshIO
 ::ReadPoints( void *buffer )
 {
-  const SizeValueType numberOfBytesToBeRead =
+  SizeValueType numberOfBytesToBeRead =
     static_cast< SizeValueType >( this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( this->GetPointComponentType() ) );
 
+  // Quantized points are read into a temporary buffer and expanded
+  const bool quantized = m_PointQuantization.componentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE;
+  std::vector< char > quantizedPoints;
+  void * readBuffer = buffer;
+  if ( quantized )
+  {
+    numberOfBytesToBeRead =
+      static_cast< SizeValueType >( this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( m_PointQuantization.componentType ) );
+    quantizedPoints.resize( numberOfBytesToBeRead );
+    readBuffer = quantizedPoints.data();
+  }
+
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "points", buffer, numberOfBytesToBeRead);
-    return;
+    this->ReadCBORData("points", readBuffer, numberOfBytesToBeRead);
   }
+  else
+  {
+    std::ifstream dataStream;
+    const std::string path(this->GetFileName());
+    const std::string dataFile = path + "/data/points.raw";
+    openFileForReading( dataStream, dataFile.c_str() );
 
-  std::ifstream dataStream;
-  const std::string path(this->GetFileName());
-  const std::string dataFile = path + "/data/points.raw";
-  openFileForReading( dataStream, dataFile.c_str() );
+    if ( !readBufferAsBinary( dataStream, readBuffer, numberOfBytesToBeRead ) )
+      {
+      itkExceptionMacro(<< "Read failed: Wanted "
+                        << numberOfBytesToBeRead
+                        << " bytes, but read "
+                        << dataStream.gcount() << " bytes.");
+      }
+  }
 
-  if ( !readBufferAsBinary( dataStream, buffer, numberOfBytesToBeRead ) )
-    {
-    itkExceptionMacro(<< "Read failed: Wanted "
-                      << numberOfBytesToBeRead
-                      << " bytes, but read "
-                      << dataStream.gcount() << " bytes.");
-    }
+  if ( quantized )
+  {
+    this->DequantizePoints( quantizedPoints.data(), buffer );
+  }
+}
+
+
+void
+WasmMeshIO
+::DequantizePoints( const void * quantizedPoints, void * points ) const
+{
+  const unsigned int dimension = this->GetPointDimension();
+  if ( m_PointQuantization.minimum.size() != dimension || m_PointQuantization.maximum.size() != dimension )
+  {
+    itkExceptionMacro("The pointQuantization bounding box of " << this->GetFileName() << " does not match the point dimension");
+  }
+  const SizeValueType numberOfComponents = this->GetNumberOfPoints() * dimension;
+
+  try
+  {
+    visitCoordinateComponent( this->GetPointComponentType(), [&](auto coordinate) {
+      using CoordinateType = decltype(coordinate);
+      wasm::visitUnsignedComponent( m_PointQuantization.componentType, [&](auto level) {
+        using QuantizedType = decltype(level);
+        dequantizePoints( static_cast< const QuantizedType * >( quantizedPoints ), numberOfComponents,
+                          m_PointQuantization.minimum, m_PointQuantization.maximum, static_cast< CoordinateType * >( points ) );
+      });
+    });
+  }
+  catch (const std::runtime_error & error)
+  {
+    itkExceptionMacro("Could not expand the quantized points of " << this->GetFileName() << ": " << error.what());
+  }
 }
 
 
@@ -602,7 +913,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "cells", buffer, numberOfBytesToBeRead);
+    this->ReadCBORData("cells", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -631,7 +942,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "pointData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORData("pointData", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -660,7 +971,7 @@ WasmMeshIO
 
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
-    readCBORBuffer(this->m_CBORRoot, "cellData", buffer, numberOfBytesToBeRead);
+    this->ReadCBORData("cellData", buffer, numberOfBytesToBeRead);
     return;
   }
 
@@ -704,6 +1015,18 @@ WasmMeshIO
     return false;
     }
 
+  // WasmZstdMeshIO is required
+  if ( filename.rfind(".zst") != std::string::npos )
+    {
+    return false;
+    }
+
+  // WasmLz4MeshIO is required
+  if ( filename.rfind(".lz4") != std::string::npos )
+    {
+    return false;
+    }
+
   return true;
 }
 
@@ -712,6 +1035,9 @@ void
 WasmMeshIO
 ::WriteMeshInformation()
 {
+  m_PointQuantization = PointQuantization();
+  m_WrittenCellComponentType = CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE;
+
   if ( fileNameIsCBOR(this->GetFileName()) )
   {
     this->WriteCBOR();
@@ -719,7 +1045,6 @@ WasmMeshIO
   }
 
   const std::string path = this->GetFileName();
-  const auto indexPath = path + "/index.json";
   const auto dataPath = path + "/data";
   if ( !itksys::SystemTools::FileExists(path, false) )
     {
@@ -730,8 +1055,6 @@ WasmMeshIO
       itksys::SystemTools::MakeDirectory(dataPath);
     }
 
-  rapidjson::Document document = this->GetJSON();
-
   if ( this->GetNumberOfPoints() )
     {
     this->m_UpdatePoints = true;
@@ -752,6 +1075,19 @@ WasmMeshIO
     this->m_UpdateCellData = true;
     }
 
+  this->WriteJSONIndex();
+}
+
+
+void
+WasmMeshIO
+::WriteJSONIndex()
+{
+  const std::string path = this->GetFileName();
+  const auto indexPath = path + "/index.json";
+
+  rapidjson::Document document = this->GetJSON();
+
   std::ofstream outputStream;
   openFileForWriting( outputStream, indexPath.c_str(), true, true );
   rapidjson::OStreamWrapper ostreamWrapper( outputStream );
@@ -765,11 +1101,48 @@ void
 WasmMeshIO
 ::WritePoints( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( this->GetPointComponentType() );
+  SizeValueType numberOfBytes = this->GetNumberOfPoints() * this->GetPointDimension() * ITKComponentSize( this->GetPointComponentType() );
+  CommonEnums::IOComponent componentType = this->GetPointComponentType();
+
+  std::vector< char > quantizedPoints;
+  if ( this->QuantizePoints( buffer, quantizedPoints ) )
+  {
+    buffer = quantizedPoints.data();
+    numberOfBytes = quantizedPoints.size();
+    componentType = m_PointQuantization.componentType;
+  }
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "points", buffer, numberOfBytes, this->GetPointComponentType() );
+    writeCBORBuffer(this->m_CBORRoot, "points", buffer, numberOfBytes, componentType );
+    if ( componentType != this->GetPointComponentType() )
+    {
+      // As in the JSON index, the pointComponentType is the stored type and
+      // the pointQuantization holds the type the points are expanded to
+      cbor_item_t * meshTypeItem = findCBORMapPair(this->m_CBORRoot, "meshType")->value;
+      struct cbor_pair * componentTypePair = findCBORMapPair(meshTypeItem, "pointComponentType");
+      cbor_decref(&(componentTypePair->value));
+      componentTypePair->value = cbor_build_string(WasmComponentTypeFromIOComponentEnum( componentType ).c_str());
+
+      cbor_item_t * quantizationItem = cbor_new_definite_map(3);
+      const std::string pointComponentString = WasmComponentTypeFromIOComponentEnum( this->GetPointComponentType() );
+      cbor_map_add(quantizationItem,
+        cbor_pair{
+          cbor_move(cbor_build_string("componentType")),
+          cbor_move(cbor_build_string(pointComponentString.c_str()))});
+      cbor_map_add(quantizationItem,
+        cbor_pair{
+          cbor_move(cbor_build_string("minimum")),
+          cbor_move(buildCBORFloatArray(m_PointQuantization.minimum))});
+      cbor_map_add(quantizationItem,
+        cbor_pair{
+          cbor_move(cbor_build_string("maximum")),
+          cbor_move(buildCBORFloatArray(m_PointQuantization.maximum))});
+      cbor_map_add(meshTypeItem,
+        cbor_pair{
+          cbor_move(cbor_build_string("pointQuantization")),
+          cbor_move(quantizationItem)});
+    }
     return;
   }
 
@@ -793,11 +1166,27 @@ void
 WasmMeshIO
 ::WriteCells( void *buffer )
 {
-  const SizeValueType numberOfBytes = this->GetCellBufferSize() * ITKComponentSize( this->GetCellComponentType() );
+  SizeValueType numberOfBytes = this->GetCellBufferSize() * ITKComponentSize( this->GetCellComponentType() );
+  CommonEnums::IOComponent componentType = this->GetCellComponentType();
+
+  std::vector< char > narrowedCells;
+  if ( this->NarrowCells( buffer, narrowedCells ) )
+  {
+    buffer = narrowedCells.data();
+    numberOfBytes = narrowedCells.size();
+    componentType = m_WrittenCellComponentType;
+  }
 
   if (fileNameIsCBOR(this->GetFileName()))
   {
-    writeCBORBuffer(this->m_CBORRoot, "cells", buffer, numberOfBytes, this->GetCellComponentType() );
+    writeCBORBuffer(this->m_CBORRoot, "cells", buffer, numberOfBytes, componentType );
+    if ( componentType != this->GetCellComponentType() )
+    {
+      // The map holds the only reference to the replaced value
+      struct cbor_pair * componentTypePair = findCBORMapPair(findCBORMapPair(this->m_CBORRoot, "meshType")->value, "cellComponentType");
+      cbor_decref(&(componentTypePair->value));
+      componentTypePair->value = cbor_build_string(WasmComponentTypeFromIOComponentEnum( componentType ).c_str());
+    }
     return;
   }
 
@@ -889,6 +1278,148 @@ WasmMeshIO
 
     cbor_decref(&(this->m_CBORRoot));
     }
+  else if ( m_PointQuantization.componentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE ||
+            m_WrittenCellComponentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE )
+    {
+    // The index was written before the points and cells were encoded
+    this->WriteJSONIndex();
+    }
+}
+
+
+bool
+WasmMeshIO
+::QuantizePoints( const void * points, std::vector< char > & quantizedPoints )
+{
+  const CommonEnums::IOComponent coordinateType = this->GetPointComponentType();
+  if ( m_PointQuantizationPrecision <= 0.0 || this->GetNumberOfPoints() == 0 ||
+       ( coordinateType != CommonEnums::IOComponent::FLOAT && coordinateType != CommonEnums::IOComponent::DOUBLE ) )
+  {
+    return false;
+  }
+  const unsigned int dimension = this->GetPointDimension();
+  const SizeValueType numberOfComponents = this->GetNumberOfPoints() * dimension;
+
+  PointQuantization quantization;
+  quantization.minimum.assign( dimension, std::numeric_limits< double >::max() );
+  quantization.maximum.assign( dimension, std::numeric_limits< double >::lowest() );
+  bool finite = true;
+  visitCoordinateComponent( coordinateType, [&](auto coordinate) {
+    using CoordinateType = decltype(coordinate);
+    const auto * coordinates = static_cast< const CoordinateType * >( points );
+    for (SizeValueType ii = 0; ii < numberOfComponents; ++ii)
+    {
+      const double value = coordinates[ii];
+      finite = finite && std::isfinite( value );
+      const unsigned int dd = ii % dimension;
+      quantization.minimum[dd] = std::min( quantization.minimum[dd], value );
+      quantization.maximum[dd] = std::max( quantization.maximum[dd], value );
+    }
+  });
+  if ( !finite )
+  {
+    itkWarningMacro("Points of " << this->GetFileName() << " are not finite and are not quantized");
+    return false;
+  }
+
+  // Every axis is resolved to the precision when the largest one is
+  double largestExtent = 0.0;
+  for (unsigned int dd = 0; dd < dimension; ++dd)
+  {
+    largestExtent = std::max( largestExtent, quantization.maximum[dd] - quantization.minimum[dd] );
+  }
+  const double levels = std::ceil( largestExtent / m_PointQuantizationPrecision );
+  if ( levels <= std::numeric_limits< uint8_t >::max() )
+  {
+    quantization.componentType = CommonEnums::IOComponent::UCHAR;
+  }
+  else if ( levels <= std::numeric_limits< uint16_t >::max() )
+  {
+    quantization.componentType = CommonEnums::IOComponent::USHORT;
+  }
+  else if ( levels <= std::numeric_limits< uint32_t >::max() )
+  {
+    quantization.componentType = CommonEnums::IOComponent::UINT;
+  }
+  if ( quantization.componentType == CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE ||
+       ITKComponentSize( quantization.componentType ) >= ITKComponentSize( coordinateType ) )
+  {
+    return false;
+  }
+
+  quantizedPoints.resize( numberOfComponents * ITKComponentSize( quantization.componentType ) );
+  visitCoordinateComponent( coordinateType, [&](auto coordinate) {
+    using CoordinateType = decltype(coordinate);
+    wasm::visitUnsignedComponent( quantization.componentType, [&](auto level) {
+      using QuantizedType = decltype(level);
+      quantizePoints( static_cast< const CoordinateType * >( points ), numberOfComponents,
+                      quantization.minimum, quantization.maximum, reinterpret_cast< QuantizedType * >( quantizedPoints.data() ) );
+    });
+  });
+  m_PointQuantization = std::move( quantization );
+  return true;
+}
+
+
+bool
+WasmMeshIO
+::NarrowCells( const void * cells, std::vector< char > & narrowedCells )
+{
+  const CommonEnums::IOComponent cellComponentType = this->GetCellComponentType();
+  const SizeValueType cellBufferSize = this->GetCellBufferSize();
+  if ( !m_NarrowCellComponentType || cellBufferSize == 0 ||
+       cellComponentType == CommonEnums::IOComponent::FLOAT || cellComponentType == CommonEnums::IOComponent::DOUBLE ||
+       cellComponentType == CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE )
+  {
+    return false;
+  }
+
+  wasm::visitIntegerComponent( cellComponentType, [&](auto cellValue) {
+    using CellValueType = decltype(cellValue);
+    const auto * values = static_cast< const CellValueType * >( cells );
+    CellValueType largest = 0;
+    for (SizeValueType ii = 0; ii < cellBufferSize; ++ii)
+    {
+      if constexpr ( std::is_signed_v< CellValueType > )
+      {
+        if ( values[ii] < 0 )
+        {
+          return;
+        }
+      }
+      largest = std::max( largest, values[ii] );
+    }
+
+    const auto largestValue = static_cast< uint64_t >( largest );
+    CommonEnums::IOComponent narrowedType = CommonEnums::IOComponent::ULONGLONG;
+    if ( largestValue <= std::numeric_limits< uint8_t >::max() )
+    {
+      narrowedType = CommonEnums::IOComponent::UCHAR;
+    }
+    else if ( largestValue <= std::numeric_limits< uint16_t >::max() )
+    {
+      narrowedType = CommonEnums::IOComponent::USHORT;
+    }
+    else if ( largestValue <= std::numeric_limits< uint32_t >::max() )
+    {
+      narrowedType = CommonEnums::IOComponent::UINT;
+    }
+    if ( ITKComponentSize( narrowedType ) >= sizeof( CellValueType ) )
+    {
+      return;
+    }
+
+    narrowedCells.resize( cellBufferSize * ITKComponentSize( narrowedType ) );
+    wasm::visitUnsignedComponent( narrowedType, [&](auto narrowedValue) {
+      using NarrowedType = decltype(narrowedValue);
+      auto * narrowed = reinterpret_cast< NarrowedType * >( narrowedCells.data() );
+      std::transform( values, values + cellBufferSize, narrowed,
+                      [](CellValueType value) { return static_cast< NarrowedType >( value ); } );
+    });
+    m_WrittenCellComponentType = narrowedType;
+  });
+
+  return m_WrittenCellComponentType != CommonEnums::IOComponent::UNKNOWNCOMPONENTTYPE;
 }
 
 } // end namespace itk
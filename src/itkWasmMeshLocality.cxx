@@ -0,0 +1,417 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmMeshLocality.h"
+#include "itkWasmIOCommon.h"
+#include "itkWasmVisitComponentType.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace itk
+{
+
+namespace
+{
+
+constexpr SizeValueType invalidIdentifier = std::numeric_limits< SizeValueType >::max();
+
+// Scoring of Forsyth, "Linear-Speed Vertex Cache Optimisation", 2006
+constexpr double cacheDecayPower = 1.5;
+constexpr double lastCellScore = 0.75;
+constexpr int    lastCellSize = 3;
+constexpr double valenceBoostScale = 2.0;
+constexpr double valenceBoostPower = 0.5;
+
+double
+pointScore(int cachePosition, SizeValueType remainingCells, unsigned int cacheSize)
+{
+  if (remainingCells == 0)
+  {
+    return -1.0;
+  }
+  double score = 0.0;
+  if (cachePosition >= 0)
+  {
+    if (cachePosition < lastCellSize)
+    {
+      score = lastCellScore;
+    }
+    else
+    {
+      const double scaler = 1.0 / (cacheSize - lastCellSize);
+      score = std::pow(1.0 - (cachePosition - lastCellSize) * scaler, cacheDecayPower);
+    }
+  }
+  return score + valenceBoostScale * std::pow(static_cast< double >(remainingCells), -valenceBoostPower);
+}
+
+void
+permuteRecords(std::vector< char > & records, SizeValueType recordSize, const std::vector< SizeValueType > & order)
+{
+  if (records.size() < order.size() * recordSize)
+  {
+    throw std::runtime_error("Mesh array is smaller than its number of records");
+  }
+  std::vector< char > permuted(records.size());
+  for (SizeValueType ii = 0; ii < order.size(); ++ii)
+  {
+    std::memcpy(permuted.data() + ii * recordSize, records.data() + order[ii] * recordSize, recordSize);
+  }
+  // Trailing bytes beyond the records are kept
+  std::copy(records.begin() + order.size() * recordSize, records.end(), permuted.begin() + order.size() * recordSize);
+  records.swap(permuted);
+}
+
+} // end anonymous namespace
+
+
+WasmMeshCellPoints
+cellPointsFromCellBuffer(const void * cells, IOComponentEnum componentType, SizeValueType numberOfCells,
+  SizeValueType cellBufferSize)
+{
+  WasmMeshCellPoints cellPoints;
+  cellPoints.offsets.reserve(numberOfCells + 1);
+  wasm::visitIntegerComponent(componentType, [&](auto cellValue) {
+    using CellValueType = decltype(cellValue);
+    const auto * values = static_cast< const CellValueType * >(cells);
+    SizeValueType index = 0;
+    for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      if (index + 2 > cellBufferSize)
+      {
+        throw std::runtime_error("Cell buffer is truncated");
+      }
+      const auto numberOfCellPoints = static_cast< SizeValueType >(values[index + 1]);
+      index += 2;
+      if (index + numberOfCellPoints > cellBufferSize)
+      {
+        throw std::runtime_error("Cell buffer is truncated");
+      }
+      for (SizeValueType ii = 0; ii < numberOfCellPoints; ++ii)
+      {
+        cellPoints.pointIds.push_back(static_cast< SizeValueType >(values[index + ii]));
+      }
+      index += numberOfCellPoints;
+      cellPoints.offsets.push_back(cellPoints.pointIds.size());
+    }
+  });
+  return cellPoints;
+}
+
+
+WasmMeshLocalityOrder
+computeMeshLocalityOrder(const WasmMeshCellPoints & cellPoints, SizeValueType numberOfPoints, unsigned int cacheSize)
+{
+  cacheSize = std::max(cacheSize, static_cast< unsigned int >(lastCellSize + 1));
+  const SizeValueType numberOfCells = cellPoints.GetNumberOfCells();
+  const auto &        offsets = cellPoints.offsets;
+  const auto &        pointIds = cellPoints.pointIds;
+
+  // Cells of each point. The cells still to be emitted are the first
+  // remainingCells[pointId] of its range.
+  std::vector< SizeValueType > adjacencyOffsets(numberOfPoints + 1, 0);
+  for (const SizeValueType pointId : pointIds)
+  {
+    if (pointId >= numberOfPoints)
+    {
+      throw std::runtime_error("Cell point identifier exceeds the number of points");
+    }
+    ++adjacencyOffsets[pointId + 1];
+  }
+  std::vector< SizeValueType > remainingCells(numberOfPoints);
+  for (SizeValueType pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    remainingCells[pointId] = adjacencyOffsets[pointId + 1];
+    adjacencyOffsets[pointId + 1] += adjacencyOffsets[pointId];
+  }
+  std::vector< SizeValueType > adjacency(pointIds.size());
+  {
+    std::vector< SizeValueType > cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      for (SizeValueType ii = offsets[cellId]; ii < offsets[cellId + 1]; ++ii)
+      {
+        adjacency[cursor[pointIds[ii]]++] = cellId;
+      }
+    }
+  }
+
+  std::vector< int >    cachePosition(numberOfPoints, -1);
+  std::vector< double > pointScores(numberOfPoints);
+  for (SizeValueType pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    pointScores[pointId] = pointScore(-1, remainingCells[pointId], cacheSize);
+  }
+  const auto cellScore = [&](SizeValueType cellId) {
+    double score = 0.0;
+    for (SizeValueType ii = offsets[cellId]; ii < offsets[cellId + 1]; ++ii)
+    {
+      score += pointScores[pointIds[ii]];
+    }
+    return score;
+  };
+  std::vector< double > cellScores(numberOfCells);
+  SizeValueType         bestCell = invalidIdentifier;
+  for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    cellScores[cellId] = cellScore(cellId);
+    if (bestCell == invalidIdentifier || cellScores[cellId] > cellScores[bestCell])
+    {
+      bestCell = cellId;
+    }
+  }
+
+  WasmMeshLocalityOrder order;
+  order.cellOrder.reserve(numberOfCells);
+  std::vector< bool >          emitted(numberOfCells, false);
+  std::vector< SizeValueType > cache;
+  std::vector< SizeValueType > nextCache;
+  std::vector< SizeValueType > stamp(numberOfPoints, invalidIdentifier);
+  SizeValueType                scanCursor = 0;
+  for (SizeValueType emittedCount = 0; emittedCount < numberOfCells; ++emittedCount)
+  {
+    if (bestCell == invalidIdentifier)
+    {
+      // No cell shares a cached point: continue with the next one in the
+      // previous order
+      while (emitted[scanCursor])
+      {
+        ++scanCursor;
+      }
+      bestCell = scanCursor;
+    }
+    const SizeValueType cellId = bestCell;
+    emitted[cellId] = true;
+    order.cellOrder.push_back(cellId);
+
+    // The points of the cell move to the front of the cache
+    nextCache.clear();
+    for (SizeValueType ii = offsets[cellId]; ii < offsets[cellId + 1]; ++ii)
+    {
+      const SizeValueType pointId = pointIds[ii];
+      const SizeValueType begin = adjacencyOffsets[pointId];
+      SizeValueType &     remaining = remainingCells[pointId];
+      for (SizeValueType jj = begin; jj < begin + remaining; ++jj)
+      {
+        if (adjacency[jj] == cellId)
+        {
+          std::swap(adjacency[jj], adjacency[begin + remaining - 1]);
+          --remaining;
+          break;
+        }
+      }
+      if (stamp[pointId] != emittedCount)
+      {
+        stamp[pointId] = emittedCount;
+        nextCache.push_back(pointId);
+      }
+    }
+    for (const SizeValueType pointId : cache)
+    {
+      if (stamp[pointId] != emittedCount)
+      {
+        stamp[pointId] = emittedCount;
+        nextCache.push_back(pointId);
+      }
+    }
+
+    // Rescore the points that were or are cached, and their cells
+    for (SizeValueType ii = 0; ii < nextCache.size(); ++ii)
+    {
+      const SizeValueType pointId = nextCache[ii];
+      cachePosition[pointId] = ii < cacheSize ? static_cast< int >(ii) : -1;
+      pointScores[pointId] = pointScore(cachePosition[pointId], remainingCells[pointId], cacheSize);
+    }
+    bestCell = invalidIdentifier;
+    for (const SizeValueType pointId : nextCache)
+    {
+      const SizeValueType begin = adjacencyOffsets[pointId];
+      for (SizeValueType jj = begin; jj < begin + remainingCells[pointId]; ++jj)
+      {
+        const SizeValueType adjacentCell = adjacency[jj];
+        cellScores[adjacentCell] = cellScore(adjacentCell);
+        if (bestCell == invalidIdentifier || cellScores[adjacentCell] > cellScores[bestCell])
+        {
+          bestCell = adjacentCell;
+        }
+      }
+    }
+    if (nextCache.size() > cacheSize)
+    {
+      nextCache.resize(cacheSize);
+    }
+    cache.swap(nextCache);
+  }
+
+  // Number the points in the order of their first use
+  order.pointOrder.reserve(numberOfPoints);
+  std::vector< bool > numbered(numberOfPoints, false);
+  for (const SizeValueType cellId : order.cellOrder)
+  {
+    for (SizeValueType ii = offsets[cellId]; ii < offsets[cellId + 1]; ++ii)
+    {
+      const SizeValueType pointId = pointIds[ii];
+      if (!numbered[pointId])
+      {
+        numbered[pointId] = true;
+        order.pointOrder.push_back(pointId);
+      }
+    }
+  }
+  for (SizeValueType pointId = 0; pointId < numberOfPoints; ++pointId)
+  {
+    if (!numbered[pointId])
+    {
+      order.pointOrder.push_back(pointId);
+    }
+  }
+
+  return order;
+}
+
+
+WasmMeshLocalityMetrics
+measureMeshLocality(const WasmMeshCellPoints & cellPoints, unsigned int cacheSize)
+{
+  WasmMeshLocalityMetrics metrics;
+  const SizeValueType numberOfCells = cellPoints.GetNumberOfCells();
+  if (numberOfCells == 0 || cellPoints.pointIds.empty())
+  {
+    return metrics;
+  }
+
+  const SizeValueType numberOfPoints = *std::max_element(cellPoints.pointIds.begin(), cellPoints.pointIds.end()) + 1;
+  // A point is cached while fewer than cacheSize points were inserted
+  // after it
+  std::vector< SizeValueType > insertedAt(numberOfPoints, invalidIdentifier);
+  SizeValueType                insertions = 0;
+  SizeValueType                misses = 0;
+  SizeValueType                referencedPoints = 0;
+  double                       spanSum = 0.0;
+  for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+  {
+    SizeValueType smallest = invalidIdentifier;
+    SizeValueType largest = 0;
+    for (SizeValueType ii = cellPoints.offsets[cellId]; ii < cellPoints.offsets[cellId + 1]; ++ii)
+    {
+      const SizeValueType pointId = cellPoints.pointIds[ii];
+      smallest = std::min(smallest, pointId);
+      largest = std::max(largest, pointId);
+      if (insertedAt[pointId] == invalidIdentifier)
+      {
+        ++referencedPoints;
+      }
+      else if (insertions - insertedAt[pointId] < cacheSize)
+      {
+        continue;
+      }
+      insertedAt[pointId] = insertions++;
+      ++misses;
+    }
+    if (smallest != invalidIdentifier)
+    {
+      spanSum += static_cast< double >(largest - smallest);
+    }
+  }
+
+  metrics.averageCacheMissRatio = static_cast< double >(misses) / numberOfCells;
+  metrics.averageTransformedVertexRatio = static_cast< double >(misses) / referencedPoints;
+  metrics.meanPointIdentifierSpan = spanSum / numberOfCells;
+  return metrics;
+}
+
+
+void
+applyMeshLocalityOrder(const MeshIOBase * meshInformation, const WasmMeshLocalityOrder & order,
+  std::vector< char > & points, std::vector< char > & cells, std::vector< char > & pointData,
+  std::vector< char > & cellData)
+{
+  const SizeValueType numberOfPoints = meshInformation->GetNumberOfPoints();
+  const SizeValueType numberOfCells = meshInformation->GetNumberOfCells();
+  if (order.pointOrder.size() != numberOfPoints || order.cellOrder.size() != numberOfCells)
+  {
+    throw std::runtime_error("Mesh locality order does not match the mesh");
+  }
+
+  permuteRecords(points,
+    meshInformation->GetPointDimension() * ITKComponentSize(meshInformation->GetPointComponentType()),
+    order.pointOrder);
+  if (meshInformation->GetNumberOfPointPixels() == numberOfPoints)
+  {
+    permuteRecords(pointData,
+      meshInformation->GetNumberOfPointPixelComponents() * ITKComponentSize(meshInformation->GetPointPixelComponentType()),
+      order.pointOrder);
+  }
+  if (meshInformation->GetNumberOfCellPixels() == numberOfCells)
+  {
+    permuteRecords(cellData,
+      meshInformation->GetNumberOfCellPixelComponents() * ITKComponentSize(meshInformation->GetCellPixelComponentType()),
+      order.cellOrder);
+  }
+
+  std::vector< SizeValueType > newPointIds(numberOfPoints);
+  for (SizeValueType ii = 0; ii < numberOfPoints; ++ii)
+  {
+    newPointIds[order.pointOrder[ii]] = ii;
+  }
+  const SizeValueType cellBufferSize = meshInformation->GetCellBufferSize();
+  wasm::visitIntegerComponent(meshInformation->GetCellComponentType(), [&](auto cellValue) {
+    using CellValueType = decltype(cellValue);
+    if (cells.size() < cellBufferSize * sizeof(CellValueType))
+    {
+      throw std::runtime_error("Cell buffer is truncated");
+    }
+    const auto * values = reinterpret_cast< const CellValueType * >(cells.data());
+    std::vector< SizeValueType > cellStarts(numberOfCells);
+    SizeValueType index = 0;
+    for (SizeValueType cellId = 0; cellId < numberOfCells; ++cellId)
+    {
+      cellStarts[cellId] = index;
+      if (index + 2 > cellBufferSize)
+      {
+        throw std::runtime_error("Cell buffer is truncated");
+      }
+      index += 2 + static_cast< SizeValueType >(values[index + 1]);
+      if (index > cellBufferSize)
+      {
+        throw std::runtime_error("Cell buffer is truncated");
+      }
+    }
+
+    std::vector< char > reordered(cells.size());
+    auto * output = reinterpret_cast< CellValueType * >(reordered.data());
+    for (const SizeValueType cellId : order.cellOrder)
+    {
+      const CellValueType * cell = values + cellStarts[cellId];
+      const auto numberOfCellPoints = static_cast< SizeValueType >(cell[1]);
+      *output++ = cell[0];
+      *output++ = cell[1];
+      for (SizeValueType ii = 0; ii < numberOfCellPoints; ++ii)
+      {
+        *output++ = static_cast< CellValueType >(newPointIds[static_cast< SizeValueType >(cell[2 + ii])]);
+      }
+    }
+    cells.swap(reordered);
+  });
+}
+
+} // end namespace itk
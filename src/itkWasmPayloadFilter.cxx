@@ -0,0 +1,586 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWasmPayloadFilter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define ITK_WASM_PAYLOAD_FILTER_SIMD128
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ITK_WASM_PAYLOAD_FILTER_SSE2
+#endif
+
+namespace itk
+{
+
+namespace
+{
+
+/** Vectorized shuffle of the first elements, returns the number handled. */
+SizeValueType
+shuffleKernel(const unsigned char * input, unsigned char * output, SizeValueType numberOfElements, unsigned int elementSize)
+{
+  SizeValueType ii = 0;
+#if defined(ITK_WASM_PAYLOAD_FILTER_SIMD128)
+  if (elementSize == 2)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const v128_t v0 = wasm_v128_load(input + 2 * ii);
+      const v128_t v1 = wasm_v128_load(input + 2 * ii + 16);
+      wasm_v128_store(output + ii,
+        wasm_i8x16_shuffle(v0, v1, 0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30));
+      wasm_v128_store(output + numberOfElements + ii,
+        wasm_i8x16_shuffle(v0, v1, 1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31));
+    }
+  }
+  else if (elementSize == 4)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const v128_t v0 = wasm_v128_load(input + 4 * ii);
+      const v128_t v1 = wasm_v128_load(input + 4 * ii + 16);
+      const v128_t v2 = wasm_v128_load(input + 4 * ii + 32);
+      const v128_t v3 = wasm_v128_load(input + 4 * ii + 48);
+      // Bytes 0 and 1, then bytes 2 and 3, of elements 0-7 and 8-15
+      const v128_t t0 = wasm_i8x16_shuffle(v0, v1, 0, 4, 8, 12, 16, 20, 24, 28, 1, 5, 9, 13, 17, 21, 25, 29);
+      const v128_t t1 = wasm_i8x16_shuffle(v0, v1, 2, 6, 10, 14, 18, 22, 26, 30, 3, 7, 11, 15, 19, 23, 27, 31);
+      const v128_t t2 = wasm_i8x16_shuffle(v2, v3, 0, 4, 8, 12, 16, 20, 24, 28, 1, 5, 9, 13, 17, 21, 25, 29);
+      const v128_t t3 = wasm_i8x16_shuffle(v2, v3, 2, 6, 10, 14, 18, 22, 26, 30, 3, 7, 11, 15, 19, 23, 27, 31);
+      wasm_v128_store(output + ii,
+        wasm_i8x16_shuffle(t0, t2, 0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23));
+      wasm_v128_store(output + numberOfElements + ii,
+        wasm_i8x16_shuffle(t0, t2, 8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31));
+      wasm_v128_store(output + 2 * numberOfElements + ii,
+        wasm_i8x16_shuffle(t1, t3, 0, 1, 2, 3, 4, 5, 6, 7, 16, 17, 18, 19, 20, 21, 22, 23));
+      wasm_v128_store(output + 3 * numberOfElements + ii,
+        wasm_i8x16_shuffle(t1, t3, 8, 9, 10, 11, 12, 13, 14, 15, 24, 25, 26, 27, 28, 29, 30, 31));
+    }
+  }
+#elif defined(ITK_WASM_PAYLOAD_FILTER_SSE2)
+  if (elementSize == 2)
+  {
+    const __m128i lowMask = _mm_set1_epi16(0x00FF);
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 2 * ii));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 2 * ii + 16));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + ii),
+        _mm_packus_epi16(_mm_and_si128(v0, lowMask), _mm_and_si128(v1, lowMask)));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + numberOfElements + ii),
+        _mm_packus_epi16(_mm_srli_epi16(v0, 8), _mm_srli_epi16(v1, 8)));
+    }
+  }
+  else if (elementSize == 4)
+  {
+    const __m128i byteMask = _mm_set1_epi32(0xFF);
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const __m128i v0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 4 * ii));
+      const __m128i v1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 4 * ii + 16));
+      const __m128i v2 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 4 * ii + 32));
+      const __m128i v3 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 4 * ii + 48));
+      // Each byte is isolated in a 32 bit lane, then narrowed without
+      // saturating since it is at most 255
+      const auto storeByte = [&](const int shift, unsigned char * destination) {
+        const __m128i b0 = _mm_and_si128(_mm_srli_epi32(v0, shift), byteMask);
+        const __m128i b1 = _mm_and_si128(_mm_srli_epi32(v1, shift), byteMask);
+        const __m128i b2 = _mm_and_si128(_mm_srli_epi32(v2, shift), byteMask);
+        const __m128i b3 = _mm_and_si128(_mm_srli_epi32(v3, shift), byteMask);
+        _mm_storeu_si128(reinterpret_cast< __m128i * >(destination),
+          _mm_packus_epi16(_mm_packs_epi32(b0, b1), _mm_packs_epi32(b2, b3)));
+      };
+      storeByte(0, output + ii);
+      storeByte(8, output + numberOfElements + ii);
+      storeByte(16, output + 2 * numberOfElements + ii);
+      storeByte(24, output + 3 * numberOfElements + ii);
+    }
+  }
+#else
+  (void)input;
+  (void)output;
+  (void)numberOfElements;
+  (void)elementSize;
+#endif
+  return ii;
+}
+
+/** Vectorized unshuffle of the first elements, returns the number handled. */
+SizeValueType
+unshuffleKernel(const unsigned char * input, unsigned char * output, SizeValueType numberOfElements, unsigned int elementSize)
+{
+  SizeValueType ii = 0;
+#if defined(ITK_WASM_PAYLOAD_FILTER_SIMD128)
+  if (elementSize == 2)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const v128_t low = wasm_v128_load(input + ii);
+      const v128_t high = wasm_v128_load(input + numberOfElements + ii);
+      wasm_v128_store(output + 2 * ii,
+        wasm_i8x16_shuffle(low, high, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23));
+      wasm_v128_store(output + 2 * ii + 16,
+        wasm_i8x16_shuffle(low, high, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31));
+    }
+  }
+  else if (elementSize == 4)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const v128_t b0 = wasm_v128_load(input + ii);
+      const v128_t b1 = wasm_v128_load(input + numberOfElements + ii);
+      const v128_t b2 = wasm_v128_load(input + 2 * numberOfElements + ii);
+      const v128_t b3 = wasm_v128_load(input + 3 * numberOfElements + ii);
+      const v128_t b01Low = wasm_i8x16_shuffle(b0, b1, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+      const v128_t b01High = wasm_i8x16_shuffle(b0, b1, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+      const v128_t b23Low = wasm_i8x16_shuffle(b2, b3, 0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23);
+      const v128_t b23High = wasm_i8x16_shuffle(b2, b3, 8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31);
+      wasm_v128_store(output + 4 * ii,
+        wasm_i8x16_shuffle(b01Low, b23Low, 0, 1, 16, 17, 2, 3, 18, 19, 4, 5, 20, 21, 6, 7, 22, 23));
+      wasm_v128_store(output + 4 * ii + 16,
+        wasm_i8x16_shuffle(b01Low, b23Low, 8, 9, 24, 25, 10, 11, 26, 27, 12, 13, 28, 29, 14, 15, 30, 31));
+      wasm_v128_store(output + 4 * ii + 32,
+        wasm_i8x16_shuffle(b01High, b23High, 0, 1, 16, 17, 2, 3, 18, 19, 4, 5, 20, 21, 6, 7, 22, 23));
+      wasm_v128_store(output + 4 * ii + 48,
+        wasm_i8x16_shuffle(b01High, b23High, 8, 9, 24, 25, 10, 11, 26, 27, 12, 13, 28, 29, 14, 15, 30, 31));
+    }
+  }
+#elif defined(ITK_WASM_PAYLOAD_FILTER_SSE2)
+  if (elementSize == 2)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const __m128i low = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + ii));
+      const __m128i high = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + numberOfElements + ii));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 2 * ii), _mm_unpacklo_epi8(low, high));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 2 * ii + 16), _mm_unpackhi_epi8(low, high));
+    }
+  }
+  else if (elementSize == 4)
+  {
+    for (; ii + 16 <= numberOfElements; ii += 16)
+    {
+      const __m128i b0 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + ii));
+      const __m128i b1 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + numberOfElements + ii));
+      const __m128i b2 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 2 * numberOfElements + ii));
+      const __m128i b3 = _mm_loadu_si128(reinterpret_cast< const __m128i * >(input + 3 * numberOfElements + ii));
+      const __m128i b01Low = _mm_unpacklo_epi8(b0, b1);
+      const __m128i b01High = _mm_unpackhi_epi8(b0, b1);
+      const __m128i b23Low = _mm_unpacklo_epi8(b2, b3);
+      const __m128i b23High = _mm_unpackhi_epi8(b2, b3);
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 4 * ii), _mm_unpacklo_epi16(b01Low, b23Low));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 4 * ii + 16), _mm_unpackhi_epi16(b01Low, b23Low));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 4 * ii + 32), _mm_unpacklo_epi16(b01High, b23High));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(output + 4 * ii + 48), _mm_unpackhi_epi16(b01High, b23High));
+    }
+  }
+#else
+  (void)input;
+  (void)output;
+  (void)numberOfElements;
+  (void)elementSize;
+#endif
+  return ii;
+}
+
+void
+shuffleBlock(const unsigned char * input, unsigned char * output, SizeValueType numberOfBytes, unsigned int elementSize)
+{
+  const SizeValueType numberOfElements = numberOfBytes / elementSize;
+  for (SizeValueType ii = shuffleKernel(input, output, numberOfElements, elementSize); ii < numberOfElements; ++ii)
+  {
+    for (unsigned int byte = 0; byte < elementSize; ++byte)
+    {
+      output[byte * numberOfElements + ii] = input[ii * elementSize + byte];
+    }
+  }
+  const SizeValueType filteredBytes = numberOfElements * elementSize;
+  std::memcpy(output + filteredBytes, input + filteredBytes, numberOfBytes - filteredBytes);
+}
+
+void
+unshuffleBlock(const unsigned char * input, unsigned char * output, SizeValueType numberOfBytes, unsigned int elementSize)
+{
+  const SizeValueType numberOfElements = numberOfBytes / elementSize;
+  for (SizeValueType ii = unshuffleKernel(input, output, numberOfElements, elementSize); ii < numberOfElements; ++ii)
+  {
+    for (unsigned int byte = 0; byte < elementSize; ++byte)
+    {
+      output[ii * elementSize + byte] = input[byte * numberOfElements + ii];
+    }
+  }
+  const SizeValueType filteredBytes = numberOfElements * elementSize;
+  std::memcpy(output + filteredBytes, input + filteredBytes, numberOfBytes - filteredBytes);
+}
+
+/** Vectorized delta coding of the elements in [begin, end), which all have
+ * a preceding pixel in the row, returns the first element not handled. */
+template< typename TElement >
+SizeValueType
+deltaEncodeKernel(const TElement * in, TElement * out, SizeValueType begin, SizeValueType end, unsigned int stride)
+{
+  SizeValueType ii = begin;
+#if defined(ITK_WASM_PAYLOAD_FILTER_SIMD128)
+  constexpr SizeValueType lanes = 16 / sizeof(TElement);
+  if constexpr (sizeof(TElement) == 2 || sizeof(TElement) == 4)
+  {
+    for (; ii + lanes <= end; ii += lanes)
+    {
+      const v128_t current = wasm_v128_load(in + ii);
+      const v128_t previous = wasm_v128_load(in + ii - stride);
+      wasm_v128_store(out + ii, sizeof(TElement) == 2 ? wasm_i16x8_sub(current, previous) : wasm_i32x4_sub(current, previous));
+    }
+  }
+#elif defined(ITK_WASM_PAYLOAD_FILTER_SSE2)
+  constexpr SizeValueType lanes = 16 / sizeof(TElement);
+  if constexpr (sizeof(TElement) == 2 || sizeof(TElement) == 4)
+  {
+    for (; ii + lanes <= end; ii += lanes)
+    {
+      const __m128i current = _mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii));
+      const __m128i previous = _mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii - stride));
+      _mm_storeu_si128(reinterpret_cast< __m128i * >(out + ii),
+        sizeof(TElement) == 2 ? _mm_sub_epi16(current, previous) : _mm_sub_epi32(current, previous));
+    }
+  }
+#else
+  (void)in;
+  (void)out;
+  (void)end;
+  (void)stride;
+#endif
+  return ii;
+}
+
+/** Vectorized delta decoding of the elements in [begin, end), which all have
+ * a preceding pixel in the row, returns the first element not handled.
+ * A stride of one is a prefix sum within each vector. A stride of at least
+ * a vector has no dependency within the vector. Other strides are left to
+ * the scalar loop. */
+template< typename TElement >
+SizeValueType
+deltaDecodeKernel(const TElement * in, TElement * out, SizeValueType begin, SizeValueType end, unsigned int stride)
+{
+  SizeValueType ii = begin;
+#if defined(ITK_WASM_PAYLOAD_FILTER_SIMD128)
+  constexpr SizeValueType lanes = 16 / sizeof(TElement);
+  if constexpr (sizeof(TElement) == 2)
+  {
+    if (stride == 1)
+    {
+      const v128_t zero = wasm_i16x8_splat(0);
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        v128_t sum = wasm_v128_load(in + ii);
+        sum = wasm_i16x8_add(sum, wasm_i16x8_shuffle(zero, sum, 0, 8, 9, 10, 11, 12, 13, 14));
+        sum = wasm_i16x8_add(sum, wasm_i16x8_shuffle(zero, sum, 0, 1, 8, 9, 10, 11, 12, 13));
+        sum = wasm_i16x8_add(sum, wasm_i16x8_shuffle(zero, sum, 0, 1, 2, 3, 8, 9, 10, 11));
+        wasm_v128_store(out + ii, wasm_i16x8_add(sum, wasm_i16x8_splat(out[ii - 1])));
+      }
+    }
+    else if (stride >= lanes)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        wasm_v128_store(out + ii, wasm_i16x8_add(wasm_v128_load(in + ii), wasm_v128_load(out + ii - stride)));
+      }
+    }
+  }
+  else if constexpr (sizeof(TElement) == 4)
+  {
+    if (stride == 1)
+    {
+      const v128_t zero = wasm_i32x4_splat(0);
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        v128_t sum = wasm_v128_load(in + ii);
+        sum = wasm_i32x4_add(sum, wasm_i32x4_shuffle(zero, sum, 0, 4, 5, 6));
+        sum = wasm_i32x4_add(sum, wasm_i32x4_shuffle(zero, sum, 0, 1, 4, 5));
+        wasm_v128_store(out + ii, wasm_i32x4_add(sum, wasm_i32x4_splat(out[ii - 1])));
+      }
+    }
+    else if (stride >= lanes)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        wasm_v128_store(out + ii, wasm_i32x4_add(wasm_v128_load(in + ii), wasm_v128_load(out + ii - stride)));
+      }
+    }
+  }
+#elif defined(ITK_WASM_PAYLOAD_FILTER_SSE2)
+  constexpr SizeValueType lanes = 16 / sizeof(TElement);
+  if constexpr (sizeof(TElement) == 2)
+  {
+    if (stride == 1)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        __m128i sum = _mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii));
+        sum = _mm_add_epi16(sum, _mm_slli_si128(sum, 2));
+        sum = _mm_add_epi16(sum, _mm_slli_si128(sum, 4));
+        sum = _mm_add_epi16(sum, _mm_slli_si128(sum, 8));
+        _mm_storeu_si128(reinterpret_cast< __m128i * >(out + ii),
+          _mm_add_epi16(sum, _mm_set1_epi16(static_cast< short >(out[ii - 1]))));
+      }
+    }
+    else if (stride >= lanes)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        _mm_storeu_si128(reinterpret_cast< __m128i * >(out + ii),
+          _mm_add_epi16(_mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii)),
+            _mm_loadu_si128(reinterpret_cast< const __m128i * >(out + ii - stride))));
+      }
+    }
+  }
+  else if constexpr (sizeof(TElement) == 4)
+  {
+    if (stride == 1)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        __m128i sum = _mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii));
+        sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 4));
+        sum = _mm_add_epi32(sum, _mm_slli_si128(sum, 8));
+        _mm_storeu_si128(reinterpret_cast< __m128i * >(out + ii),
+          _mm_add_epi32(sum, _mm_set1_epi32(static_cast< int >(out[ii - 1]))));
+      }
+    }
+    else if (stride >= lanes)
+    {
+      for (; ii + lanes <= end; ii += lanes)
+      {
+        _mm_storeu_si128(reinterpret_cast< __m128i * >(out + ii),
+          _mm_add_epi32(_mm_loadu_si128(reinterpret_cast< const __m128i * >(in + ii)),
+            _mm_loadu_si128(reinterpret_cast< const __m128i * >(out + ii - stride))));
+      }
+    }
+  }
+#else
+  (void)in;
+  (void)out;
+  (void)end;
+  (void)stride;
+#endif
+  return ii;
+}
+
+/** Delta code rows of rowElements elements, with a stride of one pixel. */
+template< typename TElement >
+void
+deltaEncodeRows(const void * input, void * output, SizeValueType numberOfElements, SizeValueType rowElements, unsigned int stride)
+{
+  const auto * in = static_cast< const TElement * >(input);
+  auto * out = static_cast< TElement * >(output);
+  for (SizeValueType row = 0; row < numberOfElements; row += rowElements)
+  {
+    const SizeValueType rowEnd = std::min(row + rowElements, numberOfElements);
+    const SizeValueType firstPixelEnd = std::min(row + stride, rowEnd);
+    for (SizeValueType ii = row; ii < firstPixelEnd; ++ii)
+    {
+      out[ii] = in[ii];
+    }
+    for (SizeValueType ii = deltaEncodeKernel(in, out, firstPixelEnd, rowEnd, stride); ii < rowEnd; ++ii)
+    {
+      out[ii] = static_cast< TElement >(in[ii] - in[ii - stride]);
+    }
+  }
+}
+
+template< typename TElement >
+void
+deltaDecodeRows(const void * input, void * output, SizeValueType numberOfElements, SizeValueType rowElements, unsigned int stride)
+{
+  const auto * in = static_cast< const TElement * >(input);
+  auto * out = static_cast< TElement * >(output);
+  for (SizeValueType row = 0; row < numberOfElements; row += rowElements)
+  {
+    const SizeValueType rowEnd = std::min(row + rowElements, numberOfElements);
+    const SizeValueType firstPixelEnd = std::min(row + stride, rowEnd);
+    for (SizeValueType ii = row; ii < firstPixelEnd; ++ii)
+    {
+      out[ii] = in[ii];
+    }
+    for (SizeValueType ii = deltaDecodeKernel(in, out, firstPixelEnd, rowEnd, stride); ii < rowEnd; ++ii)
+    {
+      out[ii] = static_cast< TElement >(in[ii] + out[ii - stride]);
+    }
+  }
+}
+
+void
+deltaRows(bool encode, const WasmPayloadLayout & layout, const void * input, void * output, SizeValueType numberOfBytes)
+{
+  const SizeValueType numberOfElements = numberOfBytes / layout.componentSize;
+  const unsigned int stride = std::max(layout.numberOfComponents, 1u);
+  const SizeValueType rowElements = std::max< SizeValueType >(layout.rowLength * stride, 1);
+  switch (layout.componentSize)
+  {
+    case 1:
+      encode ? deltaEncodeRows< uint8_t >(input, output, numberOfElements, rowElements, stride)
+             : deltaDecodeRows< uint8_t >(input, output, numberOfElements, rowElements, stride);
+      break;
+    case 2:
+      encode ? deltaEncodeRows< uint16_t >(input, output, numberOfElements, rowElements, stride)
+             : deltaDecodeRows< uint16_t >(input, output, numberOfElements, rowElements, stride);
+      break;
+    case 4:
+      encode ? deltaEncodeRows< uint32_t >(input, output, numberOfElements, rowElements, stride)
+             : deltaDecodeRows< uint32_t >(input, output, numberOfElements, rowElements, stride);
+      break;
+    case 8:
+      encode ? deltaEncodeRows< uint64_t >(input, output, numberOfElements, rowElements, stride)
+             : deltaDecodeRows< uint64_t >(input, output, numberOfElements, rowElements, stride);
+      break;
+    default:
+      throw std::runtime_error("Delta coding is not supported for component size " + std::to_string(layout.componentSize));
+  }
+  // Trailing bytes that do not form a whole element are kept as is
+  const SizeValueType filteredBytes = numberOfElements * layout.componentSize;
+  std::memcpy(static_cast< char * >(output) + filteredBytes, static_cast< const char * >(input) + filteredBytes,
+    numberOfBytes - filteredBytes);
+}
+
+void
+shuffleBlocks(bool shuffle, const WasmPayloadLayout & layout, const void * input, void * output, SizeValueType numberOfBytes)
+{
+  const auto * in = static_cast< const unsigned char * >(input);
+  auto * out = static_cast< unsigned char * >(output);
+  const SizeValueType blockSize = layout.blockSize > 0 ? layout.blockSize : numberOfBytes;
+  for (SizeValueType offset = 0; offset < numberOfBytes; offset += blockSize)
+  {
+    const SizeValueType bytes = std::min(blockSize, numberOfBytes - offset);
+    if (layout.componentSize <= 1)
+    {
+      std::memcpy(out + offset, in + offset, bytes);
+    }
+    else if (shuffle)
+    {
+      shuffleBlock(in + offset, out + offset, bytes, layout.componentSize);
+    }
+    else
+    {
+      unshuffleBlock(in + offset, out + offset, bytes, layout.componentSize);
+    }
+  }
+}
+
+} // end anonymous namespace
+
+std::ostream &
+operator<<(std::ostream & out, const WasmPayloadFilterEnum value)
+{
+  return out << payloadFilterToString(value);
+}
+
+std::string
+payloadFilterToString(WasmPayloadFilterEnum filter)
+{
+  switch (filter)
+  {
+    case WasmPayloadFilterEnum::None:
+      return "none";
+    case WasmPayloadFilterEnum::Shuffle:
+      return "shuffle";
+    case WasmPayloadFilterEnum::Delta:
+      return "delta";
+    case WasmPayloadFilterEnum::DeltaShuffle:
+      return "delta-shuffle";
+  }
+  return "none";
+}
+
+WasmPayloadFilterEnum
+payloadFilterFromString(const std::string & name)
+{
+  if (name == "none")
+  {
+    return WasmPayloadFilterEnum::None;
+  }
+  if (name == "shuffle")
+  {
+    return WasmPayloadFilterEnum::Shuffle;
+  }
+  if (name == "delta")
+  {
+    return WasmPayloadFilterEnum::Delta;
+  }
+  if (name == "delta-shuffle")
+  {
+    return WasmPayloadFilterEnum::DeltaShuffle;
+  }
+  throw std::runtime_error("Unknown payload filter: " + name);
+}
+
+void
+applyPayloadFilter(WasmPayloadFilterEnum filter, const WasmPayloadLayout & layout,
+  const void * input, void * output, SizeValueType numberOfBytes)
+{
+  switch (filter)
+  {
+    case WasmPayloadFilterEnum::None:
+      std::memcpy(output, input, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::Shuffle:
+      shuffleBlocks(true, layout, input, output, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::Delta:
+      deltaRows(true, layout, input, output, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::DeltaShuffle:
+    {
+      std::vector< unsigned char > delta(numberOfBytes);
+      deltaRows(true, layout, input, delta.data(), numberOfBytes);
+      shuffleBlocks(true, layout, delta.data(), output, numberOfBytes);
+      break;
+    }
+  }
+}
+
+void
+reversePayloadFilter(WasmPayloadFilterEnum filter, const WasmPayloadLayout & layout,
+  const void * input, void * output, SizeValueType numberOfBytes)
+{
+  switch (filter)
+  {
+    case WasmPayloadFilterEnum::None:
+      std::memcpy(output, input, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::Shuffle:
+      shuffleBlocks(false, layout, input, output, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::Delta:
+      deltaRows(false, layout, input, output, numberOfBytes);
+      break;
+    case WasmPayloadFilterEnum::DeltaShuffle:
+    {
+      std::vector< unsigned char > delta(numberOfBytes);
+      shuffleBlocks(false, layout, input, delta.data(), numberOfBytes);
+      deltaRows(false, layout, delta.data(), output, numberOfBytes);
+      break;
+    }
+  }
+}
+
+} // end namespace itk
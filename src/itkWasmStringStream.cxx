@@ -26,7 +26,7 @@ WasmStringStream::PrintSelf(std::ostream & os, Indent indent) const
   // Skip WasmDataObject since we do not have a DataObject
   Superclass::Superclass::PrintSelf(os, indent);
   os << indent << "JSON: " << this->m_JSON << std::endl;
-  os << indent << "String: " << this->m_StringStream.str() << std::endl;
+  os << indent << "String: " << this->GetOutputData() << std::endl;
 }
 
 } // end namespace itk
@@ -334,12 +334,12 @@ WasmTransformIOTemplate<TParametersValueType>::ReadCBOR()
       }
       else if (key == "numberOfFixedParameters")
       {
-        const auto numberOfFixedParameters = cbor_get_uint64(transformHandle[jj].value);
+        const auto numberOfFixedParameters = cbor_get_int(transformHandle[jj].value);
         transformJSON.numberOfFixedParameters = numberOfFixedParameters;
       }
       else if (key == "numberOfParameters")
       {
-        const auto numberOfParameters = cbor_get_uint64(transformHandle[jj].value);
+        const auto numberOfParameters = cbor_get_int(transformHandle[jj].value);
         transformJSON.numberOfParameters = numberOfParameters;
       }
       else if (key == "name")
@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Per-object marshal cost of many small images, as with patch based
+// inference, through the JSON interface and the binary descriptor.
+//
+// Usage: itk-wasm-descriptor-benchmark [patch-count] [patch-size]
+//
+// Results are printed as tab-separated values.
+namespace
+{
+
+using ImageType = itk::Image<float, 2>;
+using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+
+double
+marshalMicroseconds(const ImageType * patch, unsigned int patchCount, bool useJSON)
+{
+  auto imageToWasmImage = ImageToWasmImageFilterType::New();
+  imageToWasmImage->SetGenerateJSON(useJSON);
+  auto wasmImageToImage = WasmImageToImageFilterType::New();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (unsigned int ii = 0; ii < patchCount; ++ii)
+  {
+    imageToWasmImage->SetInput(patch);
+    imageToWasmImage->Modified();
+    imageToWasmImage->Update();
+
+    // Import from a fresh data object, as an input from a host would be
+    auto wasmImage = WasmImageToImageFilterType::WasmImageType::New();
+    if (useJSON)
+    {
+      wasmImage->SetJSON(imageToWasmImage->GetOutput()->GetJSON());
+    }
+    else
+    {
+      wasmImage->SetDescriptor(imageToWasmImage->GetOutput()->GetDescriptor());
+    }
+    wasmImageToImage->SetInput(wasmImage);
+    wasmImageToImage->Update();
+  }
+  const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / patchCount;
+}
+
+} // namespace
+
+int
+main(int argc, char * argv[])
+{
+  const unsigned int patchCount = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const unsigned int patchSize = argc > 2 ? std::stoul(argv[2]) : 64;
+
+  auto patch = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize(0, patchSize);
+  region.SetSize(1, patchSize);
+  patch->SetRegions(region);
+  patch->Allocate();
+  patch->FillBuffer(1.0f);
+
+  std::cout << "interface\tpatches\tpatch_size\tmicroseconds_per_patch" << std::endl;
+  try
+  {
+    for (const bool useJSON : { true, false })
+    {
+      const double microseconds = marshalMicroseconds(patch, patchCount, useJSON);
+      std::cout << (useJSON ? "json" : "descriptor") << '\t' << patchCount << '\t' << patchSize << '\t'
+                << microseconds << std::endl;
+    }
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << "Error: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
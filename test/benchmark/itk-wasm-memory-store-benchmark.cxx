@@ -0,0 +1,70 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmExports.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Call-to-call overhead of the memory IO input stores when a warm module
+// is invoked repeatedly with inputs of the same shape.
+//
+// Usage: itk-wasm-memory-store-benchmark [invocations] [array-MB] [arrays]
+//
+// Results are printed as tab-separated values.
+int
+main(int argc, char * argv[])
+{
+  const unsigned int invocations = argc > 1 ? std::stoul(argv[1]) : 100;
+  const size_t arraySize = (argc > 2 ? std::stoul(argv[2]) : 128) * 1024 * 1024;
+  const unsigned int arrays = argc > 3 ? std::stoul(argv[3]) : 2;
+
+  std::cout << "invocation\tarrays\tarray_MB\tmicroseconds" << std::endl;
+  double warmMicroseconds = 0.0;
+  for (unsigned int invocation = 0; invocation < invocations; ++invocation)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (unsigned int index = 0; index < arrays; ++index)
+    {
+      itk_wasm_input_json_alloc(0, index, 512);
+      const size_t address = itk_wasm_input_array_alloc(0, index, 0, arraySize);
+      // The host writes the first bytes of the input
+      std::memset(reinterpret_cast<void *>(address), 1, 64);
+    }
+    itk_wasm_free_all();
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    if (invocation == 0)
+    {
+      std::cout << "first\t" << arrays << '\t' << arraySize / (1024 * 1024) << '\t' << elapsed.count() << std::endl;
+    }
+    else
+    {
+      warmMicroseconds += elapsed.count();
+    }
+  }
+  if (invocations > 1)
+  {
+    std::cout << "warm\t" << arrays << '\t' << arraySize / (1024 * 1024) << '\t'
+              << warmMicroseconds / (invocations - 1) << std::endl;
+  }
+  itk_wasm_trim();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMeshToWasmMeshFilter.h"
+#include "itkWasmMeshToMeshFilter.h"
+#include "itkWasmMeshCellBuffer.h"
+#include "itkMesh.h"
+#include "itkTriangleCell.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Cell import cost of a large triangle mesh, with cells allocated and set one
+// by one and with packed cells, and cell buffer export cost with
+// Mesh::GetCellsArray(), with a parallel build and with the cached buffer.
+//
+// Usage: itk-wasm-mesh-cells-benchmark [grid-size] [iterations]
+//
+// The mesh is a triangulated grid of grid-size x grid-size quadrilaterals.
+// Results are printed as tab-separated values.
+namespace
+{
+
+using MeshType = itk::Mesh<float, 3>;
+using MeshToWasmMeshFilterType = itk::MeshToWasmMeshFilter<MeshType>;
+using WasmMeshToMeshFilterType = itk::WasmMeshToMeshFilter<MeshType>;
+
+MeshType::Pointer
+makeGridMesh(unsigned int gridSize)
+{
+  auto mesh = MeshType::New();
+  const unsigned int rowPoints = gridSize + 1;
+  mesh->GetPoints()->Reserve(rowPoints * rowPoints);
+  for (unsigned int jj = 0; jj < rowPoints; ++jj)
+  {
+    for (unsigned int ii = 0; ii < rowPoints; ++ii)
+    {
+      MeshType::PointType point;
+      point[0] = ii;
+      point[1] = jj;
+      point[2] = 0.0f;
+      mesh->SetPoint(jj * rowPoints + ii, point);
+    }
+  }
+
+  using TriangleCellType = itk::TriangleCell<MeshType::CellType>;
+  MeshType::CellIdentifier cellId = 0;
+  const auto addTriangle = [&mesh, &cellId](MeshType::PointIdentifier a, MeshType::PointIdentifier b, MeshType::PointIdentifier c) {
+    MeshType::CellAutoPointer cell;
+    cell.TakeOwnership(new TriangleCellType);
+    cell->SetPointId(0, a);
+    cell->SetPointId(1, b);
+    cell->SetPointId(2, c);
+    mesh->SetCell(cellId++, cell);
+  };
+  for (unsigned int jj = 0; jj < gridSize; ++jj)
+  {
+    for (unsigned int ii = 0; ii < gridSize; ++ii)
+    {
+      const MeshType::PointIdentifier corner = jj * rowPoints + ii;
+      addTriangle(corner, corner + 1, corner + rowPoints);
+      addTriangle(corner + 1, corner + rowPoints + 1, corner + rowPoints);
+    }
+  }
+  return mesh;
+}
+
+double
+importMilliseconds(const WasmMeshToMeshFilterType::WasmMeshType * wasmMesh, unsigned int iterations, bool packCells)
+{
+  double total = 0.0;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    // A fresh filter per iteration also includes releasing the cells
+    const auto start = std::chrono::steady_clock::now();
+    {
+      auto wasmMeshToMesh = WasmMeshToMeshFilterType::New();
+      wasmMeshToMesh->SetPackCells(packCells);
+      wasmMeshToMesh->SetInput(wasmMesh);
+      wasmMeshToMesh->Update();
+    }
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+  }
+  return total / iterations;
+}
+
+template <typename TFunction>
+double
+averageMilliseconds(unsigned int iterations, TFunction function)
+{
+  double total = 0.0;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    total += elapsed.count();
+  }
+  return total / iterations;
+}
+
+} // namespace
+
+int
+main(int argc, char * argv[])
+{
+  const unsigned int gridSize = argc > 1 ? std::stoul(argv[1]) : 1000;
+  const unsigned int iterations = argc > 2 ? std::stoul(argv[2]) : 5;
+
+  std::cout << "operation\tnumber_of_cells\tmilliseconds" << std::endl;
+  try
+  {
+    const MeshType::Pointer mesh = makeGridMesh(gridSize);
+    auto meshToWasmMesh = MeshToWasmMeshFilterType::New();
+    meshToWasmMesh->SetInput(mesh);
+    meshToWasmMesh->Update();
+
+    for (const bool packCells : { false, true })
+    {
+      const double milliseconds = importMilliseconds(meshToWasmMesh->GetOutput(), iterations, packCells);
+      std::cout << (packCells ? "packed" : "cell-by-cell") << '\t' << mesh->GetNumberOfCells() << '\t'
+                << milliseconds << std::endl;
+    }
+
+    const double cellsArrayMilliseconds = averageMilliseconds(iterations, [&mesh]() { mesh->GetCellsArray(); });
+    std::cout << "export-cells-array" << '\t' << mesh->GetNumberOfCells() << '\t' << cellsArrayMilliseconds << std::endl;
+    const double buildMilliseconds = averageMilliseconds(
+      iterations, [&mesh]() { itk::WasmMeshCellBuffer<MeshType>::BuildCellBuffer(mesh); });
+    std::cout << "export-parallel-build" << '\t' << mesh->GetNumberOfCells() << '\t' << buildMilliseconds << std::endl;
+    const double cachedMilliseconds = averageMilliseconds(iterations, [&mesh]() {
+      auto cachedMeshToWasmMesh = MeshToWasmMeshFilterType::New();
+      cachedMeshToWasmMesh->SetInput(mesh);
+      cachedMeshToWasmMesh->Update();
+    });
+    std::cout << "export-cached" << '\t' << mesh->GetNumberOfCells() << '\t' << cachedMilliseconds << std::endl;
+  }
+  catch (const itk::ExceptionObject & error)
+  {
+    std::cerr << "Error: " << error << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (const std::exception & error)
+  {
+    std::cerr << "Error: " << error.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkMetaDataDictionaryJSON.h"
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// Cost of serializing a large metadata dictionary, as read from DICOM tags,
+// as JSON text and as CBOR, in each direction.
+//
+// Usage: itk-wasm-metadata-benchmark [entry-count] [iterations]
+//
+// Results are printed as tab-separated values.
+namespace
+{
+
+itk::MetaDataDictionary
+makeDictionary(unsigned int entryCount)
+{
+  itk::MetaDataDictionary dictionary;
+  for (unsigned int ii = 0; ii < entryCount; ++ii)
+  {
+    const std::string key = "tag" + std::to_string(ii);
+    switch (ii % 8)
+    {
+      case 0:
+        itk::EncapsulateMetaData<std::string>(dictionary, key, "value " + std::to_string(ii));
+        break;
+      case 1:
+        itk::EncapsulateMetaData<int>(dictionary, key, static_cast<int>(ii));
+        break;
+      case 2:
+        itk::EncapsulateMetaData<double>(dictionary, key, ii * 0.5);
+        break;
+      case 3:
+        itk::EncapsulateMetaData<unsigned short>(dictionary, key, static_cast<unsigned short>(ii));
+        break;
+      case 4:
+        itk::EncapsulateMetaData<std::vector<double>>(dictionary, key, std::vector<double>(64, ii * 0.125));
+        break;
+      case 5:
+        itk::EncapsulateMetaData<std::vector<std::string>>(dictionary, key, { "ORIGINAL", "PRIMARY", "AXIAL" });
+        break;
+      case 6:
+        itk::EncapsulateMetaData<itk::Array<double>>(dictionary, key, itk::Array<double>(3, 0.5));
+        break;
+      default:
+        itk::EncapsulateMetaData<float>(dictionary, key, ii * 0.25f);
+        break;
+    }
+  }
+  return dictionary;
+}
+
+std::string
+toJSON(const itk::MetaDataDictionary & dictionary)
+{
+  rapidjson::Document document;
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  rapidjson::StringBuffer stringBuffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+  document.Accept(writer);
+  return stringBuffer.GetString();
+}
+
+itk::MetaDataDictionary
+fromJSON(const std::string & json)
+{
+  rapidjson::Document document;
+  document.Parse(json.c_str());
+  itk::MetaDataDictionary dictionary;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, dictionary);
+  return dictionary;
+}
+
+std::string
+toCBOR(const itk::MetaDataDictionary & dictionary)
+{
+  std::ostringstream outputStream;
+  itk::WasmCBORStreamWriter writer(outputStream);
+  itk::wasm::ConvertMetaDataDictionaryToCBOR(dictionary, writer);
+  return outputStream.str();
+}
+
+itk::MetaDataDictionary
+fromCBOR(const std::string & cbor)
+{
+  std::istringstream inputStream(cbor);
+  itk::WasmCBORStreamReader reader(inputStream);
+  const auto itemDeleter = [](cbor_item_t * item) { cbor_decref(&item); };
+  std::unique_ptr<cbor_item_t, decltype(itemDeleter)> item(reader.ReadItem(), itemDeleter);
+  itk::MetaDataDictionary dictionary;
+  itk::wasm::ConvertCBORToMetaDataDictionary(item.get(), dictionary);
+  return dictionary;
+}
+
+template <typename TEncode, typename TDecode>
+bool
+benchmark(const char * format, const itk::MetaDataDictionary & dictionary, unsigned int iterations, TEncode encode,
+          TDecode decode)
+{
+  const size_t entryCount = dictionary.GetKeys().size();
+  double encodeMilliseconds = 0.0;
+  double decodeMilliseconds = 0.0;
+  size_t encodedSize = 0;
+  for (unsigned int ii = 0; ii < iterations; ++ii)
+  {
+    auto start = std::chrono::steady_clock::now();
+    const std::string encoded = encode(dictionary);
+    const std::chrono::duration<double, std::milli> encodeElapsed = std::chrono::steady_clock::now() - start;
+    encodeMilliseconds += encodeElapsed.count();
+    encodedSize = encoded.size();
+
+    start = std::chrono::steady_clock::now();
+    const itk::MetaDataDictionary decoded = decode(encoded);
+    const std::chrono::duration<double, std::milli> decodeElapsed = std::chrono::steady_clock::now() - start;
+    decodeMilliseconds += decodeElapsed.count();
+
+    if (decoded.GetKeys().size() != entryCount)
+    {
+      std::cerr << "Error: decoded " << decoded.GetKeys().size() << " of " << entryCount << " entries from "
+                << format << std::endl;
+      return false;
+    }
+  }
+
+  std::cout << format << "\tencode\t" << entryCount << '\t' << encodedSize << '\t' << encodeMilliseconds / iterations
+            << std::endl;
+  std::cout << format << "\tdecode\t" << entryCount << '\t' << encodedSize << '\t' << decodeMilliseconds / iterations
+            << std::endl;
+  return true;
+}
+
+} // namespace
+
+int
+main(int argc, char * argv[])
+{
+  const unsigned int entryCount = argc > 1 ? std::stoul(argv[1]) : 5000;
+  const unsigned int iterations = argc > 2 ? std::stoul(argv[2]) : 20;
+
+  const itk::MetaDataDictionary dictionary = makeDictionary(entryCount);
+
+  std::cout << "format\tdirection\tentries\tbytes\tmilliseconds" << std::endl;
+  if (!benchmark("json", dictionary, iterations, toJSON, fromJSON) ||
+      !benchmark("cbor", dictionary, iterations, toCBOR, fromCBOR))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataDictionaryCBOR.h"
+#include "itkMetaDataDictionaryJSON.h"
+#include "itkTestingMacros.h"
+
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+
+constexpr uint8_t cborUnsignedIntegerType = 0;
+constexpr uint8_t cborArrayType = 4;
+
+struct Landmark
+{
+  std::string name;
+  unsigned int index;
+};
+
+std::ostream &
+operator<<(std::ostream & os, const Landmark & landmark)
+{
+  return os << landmark.name << ' ' << landmark.index;
+}
+
+/** Dictionary decoded from the CBOR encoding written by write. */
+template <typename TWrite>
+itk::MetaDataDictionary
+decodeCBOR(TWrite write)
+{
+  std::ostringstream stream;
+  itk::WasmCBORStreamWriter writer(stream);
+  write(writer);
+  const std::string encoded = stream.str();
+
+  struct cbor_load_result result;
+  cbor_item_t * item = cbor_load(reinterpret_cast<const unsigned char *>(encoded.data()), encoded.size(), &result);
+  itk::MetaDataDictionary dictionary;
+  if (item != nullptr)
+  {
+    itk::wasm::ConvertCBORToMetaDataDictionary(item, dictionary);
+    cbor_decref(&item);
+  }
+  return dictionary;
+}
+
+itk::MetaDataDictionary
+roundTripCBOR(const itk::MetaDataDictionary & dictionary)
+{
+  return decodeCBOR(
+    [&dictionary](itk::WasmCBORStreamWriter & writer) { itk::wasm::ConvertMetaDataDictionaryToCBOR(dictionary, writer); });
+}
+
+} // namespace
+
+int
+itkMetaDataDictionaryCBORTest(int, char *[])
+{
+  itk::MetaDataDictionary dictionary;
+  itk::EncapsulateMetaData<int>(dictionary, "int", -3);
+  itk::EncapsulateMetaData<std::string>(dictionary, "string", "0008|0060");
+  itk::EncapsulateMetaData<std::vector<float>>(dictionary, "vector", { 1.5f, 2.0f, -4.0f });
+  itk::Matrix<float, 4, 4> floatMatrix;
+  itk::Matrix<double, 3, 3> doubleMatrix;
+  itk::Matrix<double, 2, 2> smallMatrix;
+  for (unsigned int ii = 0; ii < 4; ++ii)
+  {
+    for (unsigned int jj = 0; jj < 4; ++jj)
+    {
+      floatMatrix(ii, jj) = static_cast<float>(ii * 4 + jj);
+      if (ii < 3 && jj < 3)
+      {
+        doubleMatrix(ii, jj) = ii * 3 + jj + 0.5;
+      }
+      if (ii < 2 && jj < 2)
+      {
+        smallMatrix(ii, jj) = ii * 2.0 - jj;
+      }
+    }
+  }
+  itk::EncapsulateMetaData(dictionary, "floatMatrix", floatMatrix);
+  itk::EncapsulateMetaData(dictionary, "doubleMatrix", doubleMatrix);
+  itk::EncapsulateMetaData(dictionary, "smallMatrix", smallMatrix);
+  itk::EncapsulateMetaData<Landmark>(dictionary, "landmark", { "apex", 3 });
+
+  // The custom type has no converter yet
+  itk::MetaDataDictionary decoded = roundTripCBOR(dictionary);
+  ITK_TEST_EXPECT_EQUAL(decoded.GetKeys().size(), dictionary.GetKeys().size() - 1);
+  int intValue = 0;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "int", intValue) && intValue == -3);
+  std::string stringValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "string", stringValue) && stringValue == "0008|0060");
+  std::vector<float> vectorValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "vector", vectorValue) &&
+                       vectorValue == std::vector<float>({ 1.5f, 2.0f, -4.0f }));
+
+  // The same matrices are encoded in both representations
+  itk::Matrix<float, 4, 4> floatMatrixValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "floatMatrix", floatMatrixValue) && floatMatrixValue == floatMatrix);
+  itk::Matrix<double, 3, 3> doubleMatrixValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "doubleMatrix", doubleMatrixValue) &&
+                       doubleMatrixValue == doubleMatrix);
+  itk::Matrix<double, 2, 2> smallMatrixValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "smallMatrix", smallMatrixValue) && smallMatrixValue == smallMatrix);
+  rapidjson::Document document;
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  ITK_TEST_EXPECT_EQUAL(document.Size(), dictionary.GetKeys().size() - 1);
+  itk::MetaDataDictionary decodedJSON;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, decodedJSON);
+  std::vector<std::vector<double>> smallMatrixJSON;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decodedJSON, "smallMatrix", smallMatrixJSON) &&
+                       smallMatrixJSON == std::vector<std::vector<double>>({ { 0.0, -1.0 }, { 2.0, 1.0 } }));
+
+  // One registration converts a custom type in both representations
+  itk::wasm::MetaDataValueConverter<Landmark> convertLandmark;
+  convertLandmark.encodeJSON = [](const Landmark & landmark, rapidjson::Value & valueJson,
+                                  rapidjson::Document::AllocatorType & allocator) {
+    valueJson.SetObject();
+    valueJson.AddMember("name", rapidjson::Value(landmark.name.c_str(), allocator), allocator);
+    valueJson.AddMember("index", landmark.index, allocator);
+  };
+  convertLandmark.decodeJSON = [](const rapidjson::Value & valueJson) {
+    return Landmark{ valueJson["name"].GetString(), valueJson["index"].GetUint() };
+  };
+  convertLandmark.matchJSON = [](const rapidjson::Value & valueJson) {
+    return valueJson.IsObject() && valueJson.HasMember("name") && valueJson.HasMember("index");
+  };
+  // A two element array of a text string and an unsigned integer
+  convertLandmark.encodeCBOR = [](const Landmark & landmark, itk::WasmCBORStreamWriter & writer) {
+    writer.WriteHead(cborArrayType, 2);
+    writer.WriteString(landmark.name);
+    writer.WriteHead(cborUnsignedIntegerType, landmark.index);
+  };
+  convertLandmark.decodeCBOR = [](const cbor_item_t * item) {
+    const cbor_item_t * name = cbor_array_handle(item)[0];
+    return Landmark{ std::string(reinterpret_cast<const char *>(cbor_string_handle(name)), cbor_string_length(name)),
+                     static_cast<unsigned int>(cbor_get_int(cbor_array_handle(item)[1])) };
+  };
+  convertLandmark.matchCBOR = [](const cbor_item_t * item) {
+    return cbor_isa_array(item) && cbor_array_size(item) == 2 && cbor_isa_string(cbor_array_handle(item)[0]) &&
+           cbor_string_is_definite(cbor_array_handle(item)[0]) && cbor_isa_uint(cbor_array_handle(item)[1]);
+  };
+  itk::wasm::RegisterMetaDataConverter(convertLandmark);
+
+  decoded = roundTripCBOR(dictionary);
+  ITK_TEST_EXPECT_EQUAL(decoded.GetKeys().size(), dictionary.GetKeys().size());
+  Landmark landmarkValue{ "", 0 };
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "landmark", landmarkValue));
+  ITK_TEST_EXPECT_EQUAL(landmarkValue.name, std::string("apex"));
+  ITK_TEST_EXPECT_EQUAL(landmarkValue.index, 3u);
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "int", intValue) && intValue == -3);
+
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  decodedJSON = itk::MetaDataDictionary();
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, decodedJSON);
+  landmarkValue = Landmark{ "", 0 };
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decodedJSON, "landmark", landmarkValue));
+  ITK_TEST_EXPECT_EQUAL(landmarkValue.name, std::string("apex"));
+  ITK_TEST_EXPECT_EQUAL(landmarkValue.index, 3u);
+
+  // Matrices whose shape does not match their values are skipped
+  const auto writeMatrix = [](itk::WasmCBORStreamWriter & writer, uint64_t rows, uint64_t columns) {
+    constexpr uint64_t multiDimensionalArrayTag = 40;
+    constexpr uint64_t float64TypedArrayTag = 86;
+    writer.WriteTag(multiDimensionalArrayTag);
+    writer.WriteHead(cborArrayType, 2);
+    writer.WriteHead(cborArrayType, 2);
+    writer.WriteHead(cborUnsignedIntegerType, rows);
+    writer.WriteHead(cborUnsignedIntegerType, columns);
+    writer.WriteTag(float64TypedArrayTag);
+    writer.WriteByteStringHead(0);
+  };
+  const itk::MetaDataDictionary malformed = decodeCBOR([&writeMatrix](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteMapHead(3);
+    // rows * columns overflows to 0
+    writer.WriteString("overflow");
+    writeMatrix(writer, uint64_t{ 1 } << 32, uint64_t{ 1 } << 32);
+    writer.WriteString("noColumns");
+    writeMatrix(writer, uint64_t{ 1 } << 40, 0);
+    writer.WriteString("int");
+    writer.WriteHead(cborUnsignedIntegerType, 5);
+  });
+  ITK_TEST_EXPECT_TRUE(!malformed.HasKey("overflow"));
+  ITK_TEST_EXPECT_TRUE(!malformed.HasKey("noColumns"));
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(malformed, "int", intValue) && intValue == 5);
+
+  return EXIT_SUCCESS;
+}
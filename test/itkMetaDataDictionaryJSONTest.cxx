@@ -0,0 +1,124 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMetaDataDictionaryJSON.h"
+#include "itkTestingMacros.h"
+
+#include <iostream>
+
+namespace
+{
+
+struct FrameOfReference
+{
+  std::string uid;
+  int index;
+};
+
+std::ostream &
+operator<<(std::ostream & os, const FrameOfReference & frame)
+{
+  return os << frame.uid << ' ' << frame.index;
+}
+
+} // namespace
+
+int
+itkMetaDataDictionaryJSONTest(int, char *[])
+{
+  itk::MetaDataDictionary dictionary;
+  itk::EncapsulateMetaData<bool>(dictionary, "bool", true);
+  itk::EncapsulateMetaData<int>(dictionary, "int", -3);
+  itk::EncapsulateMetaData<double>(dictionary, "double", 2.5);
+  itk::EncapsulateMetaData<std::string>(dictionary, "string", "0008|0060");
+  itk::EncapsulateMetaData<std::vector<double>>(dictionary, "vector", { 1.5, 2.0, -4.0 });
+  itk::EncapsulateMetaData<std::vector<std::vector<int>>>(dictionary, "vectorVector", { { 1, 2 }, { 3 } });
+  itk::EncapsulateMetaData<std::vector<std::string>>(dictionary, "stringVector", { "a", "b" });
+  itk::EncapsulateMetaData<FrameOfReference>(dictionary, "frame", { "1.2.840", 7 });
+
+  rapidjson::Document document;
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  // The custom type has no converter yet
+  ITK_TEST_EXPECT_EQUAL(document.Size(), dictionary.GetKeys().size() - 1);
+
+  itk::MetaDataDictionary decoded;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, decoded);
+
+  bool boolValue = false;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "bool", boolValue) && boolValue);
+  int intValue = 0;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "int", intValue) && intValue == -3);
+  double doubleValue = 0.0;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "double", doubleValue) && doubleValue == 2.5);
+  std::string stringValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "string", stringValue) && stringValue == "0008|0060");
+  std::vector<double> vectorValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "vector", vectorValue) &&
+                       vectorValue == std::vector<double>({ 1.5, 2.0, -4.0 }));
+  std::vector<std::vector<int>> vectorVectorValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "vectorVector", vectorVectorValue) &&
+                       vectorVectorValue == std::vector<std::vector<int>>({ { 1, 2 }, { 3 } }));
+  std::vector<std::string> stringVectorValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decoded, "stringVector", stringVectorValue) &&
+                       stringVectorValue == std::vector<std::string>({ "a", "b" }));
+
+  // Custom types are converted once registered
+  itk::wasm::MetaDataValueConverter<FrameOfReference> encodeFrame;
+  encodeFrame.encodeJSON = [](const FrameOfReference & frame, rapidjson::Value & valueJson,
+                              rapidjson::Document::AllocatorType & allocator) {
+    valueJson.SetString((frame.uid + '#' + std::to_string(frame.index)).c_str(), allocator);
+  };
+  itk::wasm::RegisterMetaDataConverter(encodeFrame);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::GetMetaDataConverter(typeid(FrameOfReference)) != nullptr);
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  ITK_TEST_EXPECT_EQUAL(document.Size(), dictionary.GetKeys().size());
+  itk::MetaDataDictionary decodedFrame;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, decodedFrame);
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(decodedFrame, "frame", stringValue) && stringValue == "1.2.840#7");
+
+  // Custom types round trip with a matcher of their JSON values
+  itk::wasm::MetaDataValueConverter<FrameOfReference> convertFrame;
+  convertFrame.encodeJSON = [](const FrameOfReference & frame, rapidjson::Value & valueJson,
+                               rapidjson::Document::AllocatorType & allocator) {
+    valueJson.SetObject();
+    valueJson.AddMember("uid", rapidjson::Value(frame.uid.c_str(), allocator), allocator);
+    valueJson.AddMember("index", frame.index, allocator);
+  };
+  convertFrame.decodeJSON = [](const rapidjson::Value & valueJson) {
+    return FrameOfReference{ valueJson["uid"].GetString(), valueJson["index"].GetInt() };
+  };
+  convertFrame.matchJSON = [](const rapidjson::Value & valueJson) {
+    return valueJson.IsObject() && valueJson.HasMember("uid") && valueJson["uid"].IsString() &&
+           valueJson.HasMember("index") && valueJson["index"].IsInt();
+  };
+  itk::wasm::RegisterMetaDataConverter(convertFrame);
+  document.SetArray();
+  itk::wasm::ConvertMetaDataDictionaryToJSON(dictionary, document, document.GetAllocator());
+  itk::MetaDataDictionary roundTripFrame;
+  itk::wasm::ConvertJSONToMetaDataDictionary(document, roundTripFrame);
+  FrameOfReference frameValue{ "", 0 };
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(roundTripFrame, "frame", frameValue));
+  ITK_TEST_EXPECT_EQUAL(frameValue.uid, std::string("1.2.840"));
+  ITK_TEST_EXPECT_EQUAL(frameValue.index, 7);
+  // Values the matcher rejects are still inferred
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(roundTripFrame, "int", intValue) && intValue == -3);
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(roundTripFrame, "string", stringValue) && stringValue == "0008|0060");
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,177 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkTestingMacros.h"
+#include "itkPipeline.h"
+#include "itkImage.h"
+#include "itkInputImage.h"
+#include "itkOutputImage.h"
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmExports.h"
+#include "itkImageRegionIterator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using PixelType = float;
+using ImageType = itk::Image<PixelType, Dimension>;
+constexpr unsigned int PatchSize = 64;
+
+// Adds one to the input image, like a pipeline executable would. The
+// context is passed to the pipeline, or by index as a host would.
+int
+runPipeline(itk::wasm::WasmMemoryContext & context, PixelType value, bool contextArgument = false)
+{
+  auto patch = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize(0, PatchSize);
+  region.SetSize(1, PatchSize);
+  patch->SetRegions(region);
+  patch->Allocate();
+  patch->FillBuffer(value);
+
+  // The host provides the input through the context's store
+  auto imageToWasmImageFilter = itk::ImageToWasmImageFilter<ImageType>::New();
+  imageToWasmImageFilter->SetInput(patch);
+  imageToWasmImageFilter->Update();
+  const std::string & patchJSON = imageToWasmImageFilter->GetOutput()->GetJSON();
+  const size_t jsonAddress = context.AllocateInputJSON(0, patchJSON.size());
+  std::memcpy(reinterpret_cast< void * >(jsonAddress), patchJSON.data(), patchJSON.size());
+
+  const std::string contextIndex = std::to_string(context.GetIndex());
+  const char * mockArgv[] = { "itkPipelineMemoryIOConcurrencyTest", "--memory-io", "0", "0", "--memory-io-context", contextIndex.c_str(), NULL };
+  const int mockArgc = contextArgument ? 6 : 4;
+  itk::wasm::Pipeline pipeline("concurrency-test", "A concurrent ITK Wasm Pipeline", mockArgc, const_cast< char ** >(mockArgv), contextArgument ? nullptr : &context);
+
+  itk::wasm::InputImage<ImageType> inputImage;
+  pipeline.add_option("input-image", inputImage, "The input image")->required()->type_name("INPUT_IMAGE");
+
+  itk::wasm::OutputImage<ImageType> outputImage;
+  pipeline.add_option("output-image", outputImage, "The output image")->required()->type_name("OUTPUT_IMAGE");
+
+  ITK_WASM_PARSE(pipeline);
+
+  auto output = ImageType::New();
+  output->CopyInformation(inputImage.Get());
+  output->SetRegions(inputImage.Get()->GetBufferedRegion());
+  output->Allocate();
+  itk::ImageRegionConstIterator<ImageType> inputIt(inputImage.Get(), inputImage.Get()->GetBufferedRegion());
+  itk::ImageRegionIterator<ImageType> outputIt(output, output->GetBufferedRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    outputIt.Set(inputIt.Get() + 1.0f);
+  }
+  outputImage.Set(output);
+
+  return EXIT_SUCCESS;
+}
+
+bool
+outputIsExpected(const itk::wasm::WasmMemoryContext & context, PixelType value)
+{
+  const auto outputArray = context.GetOutputArray(0, 0);
+  if (outputArray.second != PatchSize * PatchSize * sizeof(PixelType))
+  {
+    return false;
+  }
+  const auto * pixels = reinterpret_cast< const PixelType * >(outputArray.first);
+  for (unsigned int ii = 0; ii < PatchSize * PatchSize; ++ii)
+  {
+    if (pixels[ii] != value + 1.0f)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int
+itkPipelineMemoryIOConcurrencyTest(int argc, char * argv[])
+{
+  constexpr unsigned int iterations = 20;
+  const unsigned int threadCount = std::max(4u, std::thread::hardware_concurrency());
+
+  std::atomic<unsigned int> failures{ 0 };
+  std::vector<std::thread> threads;
+  for (unsigned int threadId = 0; threadId < threadCount; ++threadId)
+  {
+    threads.emplace_back([threadId, &failures]() {
+      // One context per worker, reused across requests as a service would
+      itk::wasm::WasmMemoryContext context;
+      for (unsigned int iteration = 0; iteration < iterations; ++iteration)
+      {
+        const PixelType value = threadId * iterations + iteration;
+        try
+        {
+          if (runPipeline(context, value) != EXIT_SUCCESS || !outputIsExpected(context, value))
+          {
+            ++failures;
+          }
+        }
+        catch (const std::exception & error)
+        {
+          std::cerr << "Thread " << threadId << ": " << error.what() << std::endl;
+          ++failures;
+        }
+        context.FreeAll();
+      }
+    });
+  }
+  for (auto & thread : threads)
+  {
+    thread.join();
+  }
+  ITK_TEST_EXPECT_EQUAL(failures.load(), 0u);
+
+  // The default context is left untouched, and is current again
+  itk::wasm::WasmMemoryContext * defaultContext = itk::wasm::WasmMemoryContext::GetDefault();
+  ITK_TEST_EXPECT_EQUAL(defaultContext->GetOutputArray(0, 0).first, 0u);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::WasmMemoryContext::GetCurrent(), defaultContext);
+
+  // Contexts are addressed by the memoryIndex of the exports
+  const uint32_t memoryIndex = itk_wasm_context_create();
+  ITK_TEST_EXPECT_TRUE(memoryIndex != 0);
+  itk::wasm::WasmMemoryContext * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  ITK_TEST_EXPECT_TRUE(context != nullptr);
+  ITK_TEST_EXPECT_EQUAL(runPipeline(*context, 3.0f), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(outputIsExpected(*context, 3.0f));
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_address(memoryIndex, 0, 0), context->GetOutputArray(0, 0).first);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_output_array_address(0, 0, 0), 0u);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::WasmMemoryContext::GetCurrent(), defaultContext);
+
+  // Hosts bind a pipeline to the context with --memory-io-context
+  context->FreeAll();
+  ITK_TEST_EXPECT_EQUAL(runPipeline(*context, 5.0f, true), EXIT_SUCCESS);
+  ITK_TEST_EXPECT_TRUE(outputIsExpected(*context, 5.0f));
+  ITK_TEST_EXPECT_EQUAL(defaultContext->GetOutputArray(0, 0).first, 0u);
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::WasmMemoryContext::GetCurrent(), defaultContext);
+  itk_wasm_context_delete(memoryIndex);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::WasmMemoryContext::GetContext(memoryIndex) == nullptr);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_json_alloc(memoryIndex, 0, 16), 0u);
+
+  return EXIT_SUCCESS;
+}
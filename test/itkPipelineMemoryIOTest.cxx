@@ -19,6 +19,7 @@
 #include "itkPipeline.h"
 #include "itkImage.h"
 #include "itkInputImage.h"
+#include "itkInputImageIO.h"
 #include "itkOutputImage.h"
 #include "itkInputTextStream.h"
 #include "itkOutputTextStream.h"
@@ -195,6 +196,10 @@ itkPipelineMemoryIOTest(int argc, char * argv[])
   const std::string inputBinaryStreamContent{ std::istreambuf_iterator<char>(inputBinaryStream.Get()),
                                             std::istreambuf_iterator<char>() };
   ITK_TEST_EXPECT_TRUE(inputBinaryStreamContent == "test 123\n");
+  const auto inputBinarySpan = inputBinaryStream.GetSpan();
+  ITK_TEST_EXPECT_TRUE(std::string_view(reinterpret_cast< const char * >(inputBinarySpan.data()), inputBinarySpan.size()) == "test 123\n");
+  // The input array is viewed in place
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast< size_t >(inputBinaryStream.GetSpan().data()), textStreamInputAddress);
 
   outputBinaryStream.Get() << inputBinaryStreamContent;
 
@@ -202,5 +207,14 @@ itkPipelineMemoryIOTest(int argc, char * argv[])
 
   outputPolyData.Set(inputPolyData.Get());
 
+  // The pixel buffer of an image IO input is mapped in place, not copied
+  itk::wasm::InputImageIO inputImageIO;
+  ITK_TEST_EXPECT_TRUE(itk::wasm::lexical_cast("0", inputImageIO));
+  const itk::WasmImageIOBase * inputWasmImageIOBase = inputImageIO.Get();
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast< const void * >(inputWasmImageIOBase->GetPixelData()),
+                        reinterpret_cast< const void * >(readWasmImage->GetImage()->GetBufferPointer()));
+  ITK_TEST_EXPECT_EQUAL(inputWasmImageIOBase->GetPixelDataSize(), readWasmImageDataSize * sizeof(PixelType));
+  ITK_TEST_EXPECT_EQUAL(inputWasmImageIOBase->GetPixelDataContainer()->Size(), 0u);
+
   return EXIT_SUCCESS;
 }
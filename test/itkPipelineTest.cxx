@@ -109,6 +109,8 @@ itkPipelineTest(int argc, char * argv[])
   const std::string inputBinaryStreamContent{ std::istreambuf_iterator<char>(inputBinaryStream.Get()),
                                             std::istreambuf_iterator<char>() };
   ITK_TEST_EXPECT_TRUE(inputBinaryStreamContent == "test 123\n");
+  const auto inputBinarySpan = inputBinaryStream.GetSpan();
+  ITK_TEST_EXPECT_TRUE(std::string_view(reinterpret_cast< const char * >(inputBinarySpan.data()), inputBinarySpan.size()) == "test 123\n");
 
   outputBinaryStream.Get() << inputBinaryStreamContent;
 
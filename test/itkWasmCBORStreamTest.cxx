@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmCBORStream.h"
+#include "itkTestingMacros.h"
+
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+
+constexpr uint8_t cborByteStringType = 2;
+constexpr uint8_t cborTextStringType = 3;
+constexpr uint8_t cborArrayType = 4;
+constexpr uint8_t cborMapType = 5;
+
+/** A stream buffer that cannot seek, like a decompressing stream. */
+class ForwardStreamBuffer : public std::stringbuf
+{
+public:
+  explicit ForwardStreamBuffer(const std::string & data)
+    : std::stringbuf(data, std::ios::in)
+  {}
+
+protected:
+  pos_type
+  seekoff(off_type, std::ios::seekdir, std::ios::openmode) override
+  {
+    return pos_type(off_type(-1));
+  }
+  pos_type
+  seekpos(pos_type, std::ios::openmode) override
+  {
+    return pos_type(off_type(-1));
+  }
+};
+
+std::string
+encode(const std::function<void(itk::WasmCBORStreamWriter &)> & write)
+{
+  std::ostringstream stream;
+  itk::WasmCBORStreamWriter writer(stream);
+  write(writer);
+  return stream.str();
+}
+
+/** The message of the std::runtime_error thrown by read, or an empty string. */
+std::string
+readError(std::istream & stream, const std::function<void(itk::WasmCBORStreamReader &)> & read)
+{
+  itk::WasmCBORStreamReader reader(stream);
+  try
+  {
+    read(reader);
+  }
+  catch (const std::runtime_error & error)
+  {
+    std::cout << error.what() << std::endl;
+    return error.what();
+  }
+  return {};
+}
+
+} // namespace
+
+int
+itkWasmCBORStreamTest(int, char *[])
+{
+  const std::string valid = encode([](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteMapHead(2);
+    writer.WriteString("key");
+    writer.WriteHead(cborArrayType, 2);
+    writer.WriteString("a");
+    writer.WriteByteStringHead(3);
+    writer.WriteBytes("xyz", 3);
+    writer.WriteString("last");
+    writer.WriteHead(cborTextStringType, 0);
+  });
+  std::istringstream validStream(valid);
+  std::vector<std::string> keys;
+  const auto readKeys = [&keys](itk::WasmCBORStreamReader & reader) {
+    keys.clear();
+    reader.ReadMapHead();
+    keys.push_back(reader.ReadString());
+    reader.SkipItem();
+    keys.push_back(reader.ReadString());
+    keys.push_back(reader.ReadString());
+  };
+  ITK_TEST_EXPECT_TRUE(readError(validStream, readKeys).empty());
+  ITK_TEST_EXPECT_TRUE(keys == std::vector<std::string>({ "key", "last", "" }));
+
+  // Lengths that exceed the remaining input are rejected before allocating
+  constexpr uint64_t hugeLength = uint64_t{ 1 } << 40;
+  const std::string hugeString = encode([](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteHead(cborTextStringType, hugeLength);
+    writer.WriteString("short");
+  });
+  std::istringstream hugeStringStream(hugeString);
+  ITK_TEST_EXPECT_TRUE(
+    readError(hugeStringStream, [](itk::WasmCBORStreamReader & reader) { reader.ReadString(); }).find("exceeds") !=
+    std::string::npos);
+  hugeStringStream.clear();
+  hugeStringStream.seekg(0);
+  ITK_TEST_EXPECT_TRUE(
+    readError(hugeStringStream, [](itk::WasmCBORStreamReader & reader) { reader.SkipItem(); }).find("exceeds") !=
+    std::string::npos);
+
+  const std::string hugeByteString = encode([](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteHead(cborArrayType, 1);
+    writer.WriteHead(cborByteStringType, hugeLength);
+  });
+  std::istringstream hugeByteStringStream(hugeByteString);
+  ITK_TEST_EXPECT_TRUE(
+    readError(hugeByteStringStream, [](itk::WasmCBORStreamReader & reader) { reader.SkipItem(); }).find("exceeds") !=
+    std::string::npos);
+
+  const std::string hugeArray = encode([](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteHead(cborArrayType, hugeLength);
+    writer.WriteHead(cborArrayType, 0);
+  });
+  std::istringstream hugeArrayStream(hugeArray);
+  ITK_TEST_EXPECT_TRUE(
+    readError(hugeArrayStream, [](itk::WasmCBORStreamReader & reader) { reader.SkipItem(); }).find("exceeds") !=
+    std::string::npos);
+
+  // Twice the entry count wraps around
+  const std::string hugeMap = encode([](itk::WasmCBORStreamWriter & writer) {
+    writer.WriteHead(cborMapType, uint64_t{ 1 } << 63);
+    writer.WriteString("key");
+  });
+  std::istringstream hugeMapStream(hugeMap);
+  ITK_TEST_EXPECT_TRUE(
+    readError(hugeMapStream, [](itk::WasmCBORStreamReader & reader) { reader.SkipItem(); }).find("exceeds") !=
+    std::string::npos);
+
+  // Without a known size, strings are read as far as the data goes
+  ForwardStreamBuffer forwardBuffer(hugeString);
+  std::istream forwardStream(&forwardBuffer);
+  ITK_TEST_EXPECT_TRUE(
+    readError(forwardStream, [](itk::WasmCBORStreamReader & reader) { reader.ReadString(); }).find("missing") !=
+    std::string::npos);
+  ForwardStreamBuffer forwardValidBuffer(valid);
+  std::istream forwardValidStream(&forwardValidBuffer);
+  ITK_TEST_EXPECT_TRUE(readError(forwardValidStream, readKeys).empty());
+  ITK_TEST_EXPECT_TRUE(keys == std::vector<std::string>({ "key", "last", "" }));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkMeshToWasmMeshFilter.h"
+#include "itkWasmMeshToMeshFilter.h"
+#include "itkPolyDataToWasmPolyDataFilter.h"
+#include "itkWasmPolyDataToPolyDataFilter.h"
+#include "itkWasmExports.h"
+
+#include "itkImageFileReader.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMesh.h"
+#include "itkMeshFileReader.h"
+#include "itkMeshToPolyDataFilter.h"
+#include "itkMetaDataObject.h"
+#include "itkPolyData.h"
+#include "itkTestingMacros.h"
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+int
+itkWasmDescriptorTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputImage InputMesh" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFile = argv[1];
+  const char * inputMeshFile = argv[2];
+
+  using ImageType = itk::Image<unsigned char, 3>;
+  ImageType::Pointer inputImage;
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImage = itk::ReadImage<ImageType>(inputImageFile));
+  itk::EncapsulateMetaData<std::string>(inputImage->GetMetaDataDictionary(), "descriptor", "metadata");
+
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToWasmImage = ImageToWasmImageFilterType::New();
+  imageToWasmImage->SetInput(inputImage);
+  imageToWasmImage->GenerateJSONOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(imageToWasmImage->Update());
+  const auto * wasmImage = imageToWasmImage->GetOutput();
+  ITK_TEST_EXPECT_TRUE(wasmImage->GetJSON().empty());
+  ITK_TEST_EXPECT_TRUE(wasmImage->GetDescriptor() != nullptr);
+  ITK_TEST_EXPECT_EQUAL(wasmImage->GetDescriptorSize(), sizeof(itk::wasm::WasmImageDescriptor));
+
+  // Through the memory store, as a host provides an input
+  const size_t descriptorAddress = itk_wasm_input_descriptor_alloc(0, 0, wasmImage->GetDescriptorSize());
+  std::memcpy(reinterpret_cast<void *>(descriptorAddress), wasmImage->GetDescriptor(), wasmImage->GetDescriptorSize());
+  const itk::wasm::WasmDescriptorHeader * storedDescriptor = itk::wasm::getMemoryStoreInputDescriptor(0, 0);
+  ITK_TEST_EXPECT_TRUE(storedDescriptor != nullptr);
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputDescriptor(0, 1) == nullptr);
+
+  using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+  auto descriptorImage = WasmImageToImageFilterType::WasmImageType::New();
+  descriptorImage->SetDescriptor(storedDescriptor);
+  auto descriptorToImage = WasmImageToImageFilterType::New();
+  descriptorToImage->SetInput(descriptorImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(descriptorToImage->Update());
+  const ImageType * descriptorOutput = descriptorToImage->GetOutput();
+
+  // The JSON representation remains available as a fallback
+  imageToWasmImage->GenerateJSONOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(imageToWasmImage->Update());
+  auto jsonImage = WasmImageToImageFilterType::WasmImageType::New();
+  jsonImage->SetJSON(imageToWasmImage->GetOutput()->GetJSON());
+  auto jsonToImage = WasmImageToImageFilterType::New();
+  jsonToImage->SetInput(jsonImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(jsonToImage->Update());
+  const ImageType * jsonOutput = jsonToImage->GetOutput();
+
+  for (const ImageType * outputImage : { descriptorOutput, jsonOutput })
+  {
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetBufferedRegion().GetSize(), inputImage->GetBufferedRegion().GetSize());
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetOrigin(), inputImage->GetOrigin());
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetSpacing(), inputImage->GetSpacing());
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetDirection(), inputImage->GetDirection());
+    itk::ImageRegionConstIterator<ImageType> inputIt(inputImage, inputImage->GetBufferedRegion());
+    itk::ImageRegionConstIterator<ImageType> outputIt(outputImage, outputImage->GetBufferedRegion());
+    for (; !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      if (inputIt.Get() != outputIt.Get())
+      {
+        std::cerr << "Pixel " << inputIt.GetIndex() << " does not match" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    std::string metadata;
+    ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData<std::string>(outputImage->GetMetaDataDictionary(), "descriptor", metadata));
+    ITK_TEST_EXPECT_EQUAL(metadata, std::string("metadata"));
+  }
+
+  // Descriptors and JSON without a direction have the identity direction
+  ImageType::DirectionType identityDirection;
+  identityDirection.SetIdentity();
+  auto noDirectionDescriptor = *itk::wasm::castWasmDescriptor<itk::wasm::WasmImageDescriptor>(storedDescriptor);
+  noDirectionDescriptor.direction = 0;
+  auto noDirectionImage = WasmImageToImageFilterType::WasmImageType::New();
+  noDirectionImage->SetDescriptor(&noDirectionDescriptor.header);
+  auto noDirectionToImage = WasmImageToImageFilterType::New();
+  noDirectionToImage->SetInput(noDirectionImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(noDirectionToImage->Update());
+  ITK_TEST_EXPECT_EQUAL(noDirectionToImage->GetOutput()->GetDirection(), identityDirection);
+  ITK_TEST_EXPECT_EQUAL(noDirectionToImage->GetOutput()->GetBufferedRegion().GetSize(),
+                        inputImage->GetBufferedRegion().GetSize());
+
+  rapidjson::Document noDirectionDocument;
+  noDirectionDocument.Parse(imageToWasmImage->GetOutput()->GetJSON().c_str());
+  ITK_TEST_EXPECT_TRUE(noDirectionDocument.RemoveMember("direction"));
+  rapidjson::StringBuffer noDirectionBuffer;
+  rapidjson::Writer<rapidjson::StringBuffer> noDirectionWriter(noDirectionBuffer);
+  noDirectionDocument.Accept(noDirectionWriter);
+  auto noDirectionJSONImage = WasmImageToImageFilterType::WasmImageType::New();
+  noDirectionJSONImage->SetJSON(noDirectionBuffer.GetString());
+  auto noDirectionJSONToImage = WasmImageToImageFilterType::New();
+  noDirectionJSONToImage->SetInput(noDirectionJSONImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(noDirectionJSONToImage->Update());
+  ITK_TEST_EXPECT_EQUAL(noDirectionJSONToImage->GetOutput()->GetDirection(), identityDirection);
+
+  // Descriptors without pixel data are rejected
+  auto noDataDescriptor = noDirectionDescriptor;
+  noDataDescriptor.data = 0;
+  auto noDataImage = WasmImageToImageFilterType::WasmImageType::New();
+  noDataImage->SetDescriptor(&noDataDescriptor.header);
+  auto noDataToImage = WasmImageToImageFilterType::New();
+  noDataToImage->SetInput(noDataImage);
+  bool noDataRejected = false;
+  try
+  {
+    noDataToImage->Update();
+  }
+  catch (const std::runtime_error &)
+  {
+    noDataRejected = true;
+  }
+  ITK_TEST_EXPECT_TRUE(noDataRejected);
+
+  // Mismatched descriptors are rejected
+  auto meshDescriptor = itk::wasm::makeWasmDescriptor<itk::wasm::WasmMeshDescriptor>();
+  auto mismatchedImage = WasmImageToImageFilterType::WasmImageType::New();
+  mismatchedImage->SetDescriptor(&meshDescriptor.header);
+  auto mismatchedToImage = WasmImageToImageFilterType::New();
+  mismatchedToImage->SetInput(mismatchedImage);
+  bool mismatchRejected = false;
+  try
+  {
+    mismatchedToImage->Update();
+  }
+  catch (const std::runtime_error &)
+  {
+    mismatchRejected = true;
+  }
+  ITK_TEST_EXPECT_TRUE(mismatchRejected);
+
+  using MeshType = itk::Mesh<float, 3>;
+  auto meshReader = itk::MeshFileReader<MeshType>::New();
+  meshReader->SetFileName(inputMeshFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshReader->Update());
+  const MeshType * inputMesh = meshReader->GetOutput();
+
+  using MeshToWasmMeshFilterType = itk::MeshToWasmMeshFilter<MeshType>;
+  auto meshToWasmMesh = MeshToWasmMeshFilterType::New();
+  meshToWasmMesh->SetInput(inputMesh);
+  meshToWasmMesh->GenerateJSONOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshToWasmMesh->Update());
+
+  using WasmMeshToMeshFilterType = itk::WasmMeshToMeshFilter<MeshType>;
+  auto descriptorMesh = WasmMeshToMeshFilterType::WasmMeshType::New();
+  descriptorMesh->SetDescriptor(meshToWasmMesh->GetOutput()->GetDescriptor());
+  auto descriptorToMesh = WasmMeshToMeshFilterType::New();
+  descriptorToMesh->SetInput(descriptorMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(descriptorToMesh->Update());
+  const MeshType * outputMesh = descriptorToMesh->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(outputMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(outputMesh->GetNumberOfCells(), inputMesh->GetNumberOfCells());
+  for (MeshType::PointIdentifier pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+  {
+    if (outputMesh->GetPoint(pointId) != inputMesh->GetPoint(pointId))
+    {
+      std::cerr << "Mesh point " << pointId << " does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  using PolyDataType = itk::PolyData<float>;
+  auto meshToPolyData = itk::MeshToPolyDataFilter<MeshType>::New();
+  meshToPolyData->SetInput(inputMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(meshToPolyData->Update());
+  const PolyDataType * inputPolyData = meshToPolyData->GetOutput();
+
+  using PolyDataToWasmPolyDataFilterType = itk::PolyDataToWasmPolyDataFilter<PolyDataType>;
+  auto polyDataToWasmPolyData = PolyDataToWasmPolyDataFilterType::New();
+  polyDataToWasmPolyData->SetInput(inputPolyData);
+  polyDataToWasmPolyData->GenerateJSONOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(polyDataToWasmPolyData->Update());
+
+  using WasmPolyDataToPolyDataFilterType = itk::WasmPolyDataToPolyDataFilter<PolyDataType>;
+  auto descriptorPolyData = WasmPolyDataToPolyDataFilterType::WasmPolyDataType::New();
+  descriptorPolyData->SetDescriptor(polyDataToWasmPolyData->GetOutput()->GetDescriptor());
+  auto descriptorToPolyData = WasmPolyDataToPolyDataFilterType::New();
+  descriptorToPolyData->SetInput(descriptorPolyData);
+  ITK_TRY_EXPECT_NO_EXCEPTION(descriptorToPolyData->Update());
+  const PolyDataType * outputPolyData = descriptorToPolyData->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(outputPolyData->GetNumberOfPoints(), inputPolyData->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(outputPolyData->GetPolygons()->Size(), inputPolyData->GetPolygons()->Size());
+  ITK_TEST_EXPECT_TRUE(std::equal(inputPolyData->GetPolygons()->begin(), inputPolyData->GetPolygons()->end(),
+                                  outputPolyData->GetPolygons()->begin()));
+
+  itk_wasm_free_all();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryStoreInputDescriptor(0, 0) == nullptr);
+
+  return EXIT_SUCCESS;
+}
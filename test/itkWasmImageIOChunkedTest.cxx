@@ -0,0 +1,114 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmImageIOFactory.h"
+#include "itkWasmImageIO.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+int
+itkWasmImageIOChunkedTest(int argc, char * argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputImage ChunkedDirectory ConvertedImage" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFile = argv[1];
+  const char * chunkedDirectory = argv[2];
+  const char * convertedImageFile = argv[3];
+
+  itk::WasmImageIOFactory::RegisterOneFactory();
+
+  constexpr unsigned int Dimension = 3;
+  using PixelType = unsigned char;
+  using ImageType = itk::Image<PixelType, Dimension>;
+  using ImagePointer = ImageType::Pointer;
+
+  ImagePointer inputImage = nullptr;
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImage = itk::ReadImage<ImageType>(inputImageFile));
+
+  // Chunk sizes that do not divide the image size exercise the clipped edge chunks
+  const std::vector<itk::SizeValueType> chunkSize{ 32, 24, 16 };
+
+  auto writeImageIO = itk::WasmImageIO::New();
+  writeImageIO->SetChunkSize(chunkSize);
+
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetImageIO(writeImageIO);
+  writer->SetFileName(chunkedDirectory);
+  writer->SetInput(inputImage);
+  writer->SetNumberOfStreamDivisions(5);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto readImageIO = itk::WasmImageIO::New();
+  readImageIO->SetFileName(chunkedDirectory);
+  ITK_TRY_EXPECT_NO_EXCEPTION(readImageIO->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(readImageIO->GetChunkSize() == chunkSize);
+  ITK_TEST_EXPECT_TRUE(readImageIO->CanStreamRead());
+  ITK_TEST_EXPECT_TRUE(readImageIO->CanStreamWrite());
+
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetImageIO(readImageIO);
+  reader->SetFileName(chunkedDirectory);
+
+  using StreamingFilterType = itk::StreamingImageFilter<ImageType, ImageType>;
+  auto streamer = StreamingFilterType::New();
+  streamer->SetInput(reader->GetOutput());
+  streamer->SetNumberOfStreamDivisions(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(streamer->GetOutput(), convertedImageFile));
+
+  // Read a region of interest that straddles chunk boundaries
+  auto regionReader = ReaderType::New();
+  regionReader->SetImageIO(itk::WasmImageIO::New());
+  regionReader->SetFileName(chunkedDirectory);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionReader->UpdateOutputInformation());
+
+  ImageType::RegionType regionOfInterest = inputImage->GetLargestPossibleRegion();
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    regionOfInterest.SetIndex(dim, chunkSize[dim] / 2 + 1);
+    regionOfInterest.SetSize(dim, chunkSize[dim] + 3);
+  }
+  regionOfInterest.Crop(inputImage->GetLargestPossibleRegion());
+
+  ImageType * regionImage = regionReader->GetOutput();
+  regionImage->SetRequestedRegion(regionOfInterest);
+  ITK_TRY_EXPECT_NO_EXCEPTION(regionImage->Update());
+  ITK_TEST_EXPECT_EQUAL(regionImage->GetBufferedRegion(), regionOfInterest);
+
+  itk::ImageRegionConstIterator<ImageType> inputIt(inputImage, regionOfInterest);
+  itk::ImageRegionConstIterator<ImageType> regionIt(regionImage, regionOfInterest);
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++regionIt)
+  {
+    if (inputIt.Get() != regionIt.Get())
+    {
+      std::cerr << "Region pixel mismatch at " << inputIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
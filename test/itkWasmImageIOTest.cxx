@@ -22,6 +22,11 @@
 #include "itkTestingMacros.h"
 #include "itkMetaDataObject.h"
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
 int
 itkWasmImageIOTest(int argc, char * argv[])
 {
@@ -82,12 +87,56 @@ itkWasmImageIOTest(int argc, char * argv[])
 
   ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(writtenReadImage, convertedDirectoryFile));
 
+  auto mappedImageIO = itk::WasmImageIO::New();
+  mappedImageIO->UseMemoryMappingOn();
+  auto mappedReader = ReaderType::New();
+  mappedReader->SetImageIO( mappedImageIO );
+  mappedReader->SetFileName( imageDirectory );
+  ITK_TRY_EXPECT_NO_EXCEPTION(mappedReader->Update());
+  const ImageType * mappedImage = mappedReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(mappedImage->GetBufferedRegion(), writtenReadImage->GetBufferedRegion());
+  ITK_TEST_EXPECT_TRUE(std::equal(mappedImage->GetBufferPointer(),
+    mappedImage->GetBufferPointer() + mappedImage->GetPixelContainer()->Size(),
+    writtenReadImage->GetBufferPointer()));
+
+  // Numeric arrays are stored as CBOR typed arrays
+  const std::string arrayEntryKey = "MetaTestArray";
+  const std::vector<double> arrayEntryValue{ 0.5, -1.0, 2.25 };
+  itk::EncapsulateMetaData<std::vector<double>>(inputImage->GetMetaDataDictionary(), arrayEntryKey, arrayEntryValue);
+
   wasmWriter->SetFileName( imageCBOR );
   ITK_TRY_EXPECT_NO_EXCEPTION(wasmWriter->Update());
 
   wasmReader->SetFileName( imageCBOR );
   ITK_TRY_EXPECT_NO_EXCEPTION(wasmReader->Update());
 
+  const auto cborMetaDataDict = wasmReader->GetOutput()->GetMetaDataDictionary();
+  std::string cborEntryValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(cborMetaDataDict, testEntryKey, cborEntryValue));
+  ITK_TEST_EXPECT_EQUAL(cborEntryValue, testEntryValue);
+  std::vector<double> cborArrayEntryValue;
+  ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData(cborMetaDataDict, arrayEntryKey, cborArrayEntryValue));
+  ITK_TEST_EXPECT_TRUE(cborArrayEntryValue == arrayEntryValue);
+
+  // Information-only reads stop before the pixel data, so they succeed on a
+  // file with the payload stripped
+  const std::string truncatedCBOR = std::string(imageCBOR) + ".header.iwi.cbor";
+  {
+    std::ifstream cborStream(imageCBOR, std::ios::binary);
+    const std::string cbor((std::istreambuf_iterator<char>(cborStream)), std::istreambuf_iterator<char>());
+    const size_t payloadSize = wasmReader->GetOutput()->GetPixelContainer()->Size() * sizeof(PixelType);
+    std::ofstream truncatedStream(truncatedCBOR, std::ios::binary);
+    truncatedStream.write(cbor.data(), cbor.size() - payloadSize);
+  }
+  auto headerImageIO = itk::WasmImageIO::New();
+  headerImageIO->SetFileName( truncatedCBOR );
+  ITK_TRY_EXPECT_NO_EXCEPTION(headerImageIO->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(headerImageIO->GetMetaDataDictionary().HasKey(arrayEntryKey));
+  for (unsigned int dim = 0; dim < Dimension; ++dim)
+  {
+    ITK_TEST_EXPECT_EQUAL(headerImageIO->GetDimensions(dim), inputImage->GetLargestPossibleRegion().GetSize(dim));
+  }
+
   ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(wasmReader->GetOutput(), convertedCBORFile));
 
   return EXIT_SUCCESS;
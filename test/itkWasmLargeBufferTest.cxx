@@ -0,0 +1,130 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageToWasmImageFilter.h"
+#include "itkWasmImageToImageFilter.h"
+#include "itkWasmDescriptor.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmMeshIO.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+#include <new>
+
+int
+itkWasmLargeBufferTest(int, char *[])
+{
+  constexpr uint64_t largeCount = (uint64_t{ 1 } << 32) + 16;
+
+  // Counts beyond 32 bits survive the mesh JSON header
+  auto meshIO = itk::WasmMeshIO::New();
+  meshIO->SetPointDimension(3);
+  meshIO->SetPointComponentType(itk::IOComponentEnum::FLOAT);
+  meshIO->SetCellComponentType(itk::IOComponentEnum::UINT);
+  meshIO->SetNumberOfPoints(largeCount);
+  meshIO->SetNumberOfPointPixels(largeCount + 1);
+  meshIO->SetNumberOfCells(largeCount + 2);
+  meshIO->SetNumberOfCellPixels(largeCount + 3);
+  meshIO->SetCellBufferSize(largeCount + 4);
+  rapidjson::Document meshDocument = meshIO->GetJSON();
+  ITK_TEST_EXPECT_EQUAL(meshDocument["cellBufferSize"].GetUint64(), largeCount + 4);
+
+  auto readMeshIO = itk::WasmMeshIO::New();
+  readMeshIO->SetJSON(meshDocument);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readMeshIO->GetNumberOfPoints()), largeCount);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readMeshIO->GetNumberOfPointPixels()), largeCount + 1);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readMeshIO->GetNumberOfCells()), largeCount + 2);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readMeshIO->GetNumberOfCellPixels()), largeCount + 3);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readMeshIO->GetCellBufferSize()), largeCount + 4);
+
+  const auto meshDescriptor = itk::wasm::meshDescriptorFromJSON(meshDocument);
+  ITK_TEST_EXPECT_EQUAL(meshDescriptor.numberOfPoints, largeCount);
+  ITK_TEST_EXPECT_EQUAL(meshDescriptor.cellBufferSize, largeCount + 4);
+
+  // And the image JSON header
+  auto imageIO = itk::WasmImageIO::New();
+  imageIO->SetNumberOfDimensions(2);
+  imageIO->SetComponentType(itk::IOComponentEnum::UCHAR);
+  imageIO->SetPixelType(itk::IOPixelEnum::SCALAR);
+  imageIO->SetDimensions(0, largeCount);
+  imageIO->SetDimensions(1, 1);
+  rapidjson::Document imageDocument = imageIO->GetJSON();
+  auto readImageIO = itk::WasmImageIO::New();
+  readImageIO->SetJSON(imageDocument);
+  ITK_TEST_EXPECT_EQUAL(static_cast<uint64_t>(readImageIO->GetDimensions(0)), largeCount);
+
+  if (sizeof(size_t) < sizeof(uint64_t))
+  {
+    std::cout << "Buffers over 4 GiB are not addressable, skipping the memory IO round trip" << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+  // A synthetic image buffer over 4 GiB through memory IO. The buffer is not
+  // initialized, so only the pages written here are committed.
+  using ImageType = itk::Image<unsigned char, 2>;
+  auto image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = static_cast<itk::SizeValueType>(largeCount);
+  size[1] = 1;
+  image->SetRegions(size);
+  try
+  {
+    image->Allocate(false);
+  }
+  catch (const std::bad_alloc &)
+  {
+    std::cout << "Could not allocate a buffer over 4 GiB, skipping the memory IO round trip" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  catch (const itk::ExceptionObject &)
+  {
+    std::cout << "Could not allocate a buffer over 4 GiB, skipping the memory IO round trip" << std::endl;
+    return EXIT_SUCCESS;
+  }
+  ImageType::IndexType lastIndex;
+  lastIndex[0] = static_cast<itk::IndexValueType>(largeCount - 1);
+  lastIndex[1] = 0;
+  image->SetPixel(lastIndex, 42);
+
+  using ImageToWasmImageFilterType = itk::ImageToWasmImageFilter<ImageType>;
+  auto imageToWasmImage = ImageToWasmImageFilterType::New();
+  imageToWasmImage->SetInput(image);
+  ITK_TRY_EXPECT_NO_EXCEPTION(imageToWasmImage->Update());
+
+  using WasmImageToImageFilterType = itk::WasmImageToImageFilter<ImageType>;
+  for (const bool useDescriptor : { true, false })
+  {
+    auto wasmImage = WasmImageToImageFilterType::WasmImageType::New();
+    if (useDescriptor)
+    {
+      wasmImage->SetDescriptor(imageToWasmImage->GetOutput()->GetDescriptor());
+    }
+    else
+    {
+      wasmImage->SetJSON(imageToWasmImage->GetOutput()->GetJSON());
+    }
+    auto wasmImageToImage = WasmImageToImageFilterType::New();
+    wasmImageToImage->SetInput(wasmImage);
+    ITK_TRY_EXPECT_NO_EXCEPTION(wasmImageToImage->Update());
+    const ImageType * outputImage = wasmImageToImage->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetBufferedRegion().GetSize(), size);
+    ITK_TEST_EXPECT_EQUAL(outputImage->GetBufferPointer(), image->GetBufferPointer());
+    ITK_TEST_EXPECT_EQUAL(static_cast<int>(outputImage->GetPixel(lastIndex)), 42);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,84 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmMemoryArena.h"
+#include "itkWasmExports.h"
+#include "itkTestingMacros.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+int
+itkWasmMemoryArenaTest(int, char *[])
+{
+  ITK_TEST_EXPECT_EQUAL(itk::WasmMemoryArena::SizeClass(0), itk::WasmMemoryArena::Alignment);
+  ITK_TEST_EXPECT_EQUAL(itk::WasmMemoryArena::SizeClass(65), 128);
+  ITK_TEST_EXPECT_EQUAL(itk::WasmMemoryArena::SizeClass(1000000), 1048576);
+  for (size_t size = 1; size < 100000; size = size * 3 + 1)
+  {
+    const size_t sizeClass = itk::WasmMemoryArena::SizeClass(size);
+    ITK_TEST_EXPECT_TRUE(sizeClass >= size && sizeClass - size <= size / 4 + itk::WasmMemoryArena::Alignment);
+  }
+
+  {
+    itk::WasmMemoryArena arena;
+    void * block = arena.Allocate(1000000);
+    ITK_TEST_EXPECT_EQUAL(reinterpret_cast<uintptr_t>(block) % itk::WasmMemoryArena::Alignment, 0);
+    ITK_TEST_EXPECT_EQUAL(arena.GetBlockSize(block), 1048576);
+    void * other = arena.Allocate(100);
+    ITK_TEST_EXPECT_TRUE(other != block);
+
+    // Blocks of the same size class are reused
+    arena.Release(block);
+    ITK_TEST_EXPECT_EQUAL(arena.Allocate(990000), block);
+
+    arena.Reset();
+    ITK_TEST_EXPECT_EQUAL(arena.GetInUseSize(), 0);
+    ITK_TEST_EXPECT_EQUAL(arena.GetReservedSize(), 1048576 + 128);
+    ITK_TEST_EXPECT_EQUAL(arena.Allocate(100), other);
+
+    arena.Trim();
+    ITK_TEST_EXPECT_EQUAL(arena.GetReservedSize(), 128);
+    ITK_TEST_EXPECT_EQUAL(arena.GetInUseSize(), 128);
+
+    // Released blocks are not held beside a block of a new class
+    arena.Allocate(1000000);
+    arena.Reset();
+    void * smaller = arena.Allocate(500000);
+    ITK_TEST_EXPECT_EQUAL(arena.GetBlockSize(smaller), 524288);
+    ITK_TEST_EXPECT_EQUAL(arena.GetReservedSize(), 524288);
+  }
+
+  // Repeated invocations with inputs of the same shape reuse their memory
+  const size_t arrayAddress = itk_wasm_input_array_alloc(0, 0, 0, 1000000);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_alloc(0, 0, 0, 1000000), arrayAddress);
+  const size_t jsonAddress = itk_wasm_input_json_alloc(0, 0, 1000);
+  itk_wasm_free_all();
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_array_alloc(0, 0, 0, 999999), arrayAddress);
+  ITK_TEST_EXPECT_EQUAL(itk_wasm_input_json_alloc(0, 0, 1000), jsonAddress);
+  // The JSON buffer is not zero filled, and is terminated after its size
+  std::memcpy(reinterpret_cast<char *>(itk_wasm_input_json_alloc(0, 0, 2)), "{}", 2);
+  ITK_TEST_EXPECT_EQUAL(std::string(itk::wasm::getMemoryStoreInputJSON(0, 0)), std::string("{}"));
+  ITK_TEST_EXPECT_EQUAL(itk::wasm::getMemoryInputArrayStore().at(std::make_pair(0u, 0u)).second, 999999);
+
+  itk_wasm_free_all();
+  itk_wasm_trim();
+  ITK_TEST_EXPECT_TRUE(itk::wasm::getMemoryInputArrayStore().empty());
+
+  return EXIT_SUCCESS;
+}
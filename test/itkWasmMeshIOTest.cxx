@@ -21,6 +21,12 @@
 #include "itkMeshFileWriter.h"
 #include "itkTestingMacros.h"
 #include "itkMesh.h"
+#include "rapidjson/document.h"
+#include "rapidjson/istreamwrapper.h"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
 
 int
 itkWasmMeshIOTest(int argc, char * argv[])
@@ -77,6 +83,86 @@ itkWasmMeshIOTest(int argc, char * argv[])
   wasmReader->SetFileName( meshZip );
   ITK_TRY_EXPECT_NO_EXCEPTION(wasmReader->Update());
 
+  // Payloads copied out of a memory mapping match the streamed reads
+  auto mappedMeshIO = itk::WasmMeshIO::New();
+  mappedMeshIO->UseMemoryMappingOn();
+  auto mappedReader = ReaderType::New();
+  mappedReader->SetMeshIO( mappedMeshIO );
+  mappedReader->SetFileName( meshZip );
+  ITK_TRY_EXPECT_NO_EXCEPTION(mappedReader->Update());
+
+  const MeshType * streamedMesh = wasmReader->GetOutput();
+  const MeshType * mappedMesh = mappedReader->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(mappedMesh->GetNumberOfPoints(), streamedMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(mappedMesh->GetNumberOfCells(), streamedMesh->GetNumberOfCells());
+  for (MeshType::PointIdentifier pointId = 0; pointId < streamedMesh->GetNumberOfPoints(); ++pointId)
+  {
+    if (mappedMesh->GetPoint(pointId) != streamedMesh->GetPoint(pointId))
+    {
+      std::cerr << "Memory mapped point " << pointId << " does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Quantized points and narrowed cells are expanded on read
+  constexpr double pointPrecision = 1.0e-3;
+  auto compactMeshIO = itk::WasmMeshIO::New();
+  compactMeshIO->SetPointQuantizationPrecision( pointPrecision );
+  compactMeshIO->NarrowCellComponentTypeOn();
+  wasmWriter->SetMeshIO( compactMeshIO );
+  for (const char * compactFile : { meshDirectory, meshZip })
+  {
+    wasmWriter->SetFileName( compactFile );
+    ITK_TRY_EXPECT_NO_EXCEPTION(wasmWriter->Update());
+
+    auto compactReader = ReaderType::New();
+    compactReader->SetFileName( compactFile );
+    ITK_TRY_EXPECT_NO_EXCEPTION(compactReader->Update());
+    const MeshType * compactMesh = compactReader->GetOutput();
+    ITK_TEST_EXPECT_EQUAL(compactMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+    ITK_TEST_EXPECT_EQUAL(compactMesh->GetNumberOfCells(), inputMesh->GetNumberOfCells());
+    for (MeshType::PointIdentifier pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+    {
+      if (compactMesh->GetPoint(pointId).EuclideanDistanceTo(inputMesh->GetPoint(pointId)) > pointPrecision)
+      {
+        std::cerr << "Quantized point " << pointId << " from " << compactFile << " is not within the precision" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    for (MeshType::CellIdentifier cellId = 0; cellId < inputMesh->GetNumberOfCells(); ++cellId)
+    {
+      MeshType::CellAutoPointer inputCell;
+      MeshType::CellAutoPointer compactCell;
+      inputMesh->GetCell(cellId, inputCell);
+      compactMesh->GetCell(cellId, compactCell);
+      if (!std::equal(inputCell->PointIdsBegin(), inputCell->PointIdsEnd(), compactCell->PointIdsBegin(), compactCell->PointIdsEnd()))
+      {
+        std::cerr << "Narrowed cell " << cellId << " from " << compactFile << " does not match" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Readers unaware of the quantization see the stored unsigned integer
+  // points of the directory format, not floats
+  {
+    std::ifstream indexStream( std::string( meshDirectory ) + "/index.json" );
+    rapidjson::IStreamWrapper indexStreamWrapper( indexStream );
+    rapidjson::Document index;
+    index.ParseStream( indexStreamWrapper );
+    ITK_TEST_EXPECT_TRUE(!index.HasParseError());
+    const rapidjson::Value & meshType = index["meshType"];
+    const std::string pointComponentType( meshType["pointComponentType"].GetString() );
+    ITK_TEST_EXPECT_TRUE(pointComponentType == "uint8" || pointComponentType == "uint16" || pointComponentType == "uint32");
+    ITK_TEST_EXPECT_TRUE(meshType.HasMember("pointQuantization"));
+    ITK_TEST_EXPECT_EQUAL(std::string( meshType["pointQuantization"]["componentType"].GetString() ), std::string( "float32" ));
+
+    const itk::SizeValueType componentSize = pointComponentType == "uint8" ? 1 : pointComponentType == "uint16" ? 2 : 4;
+    std::ifstream pointsStream( std::string( meshDirectory ) + "/data/points.raw", std::ios::binary | std::ios::ate );
+    ITK_TEST_EXPECT_EQUAL(static_cast< itk::SizeValueType >( pointsStream.tellg() ),
+                          inputMesh->GetNumberOfPoints() * Dimension * componentSize);
+  }
+
   meshWriter->SetFileName(convertedZipFile);
   ITK_TRY_EXPECT_NO_EXCEPTION(meshWriter->Update());
 
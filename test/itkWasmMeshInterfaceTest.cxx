@@ -23,6 +23,8 @@
 #include "itkMeshFileWriter.h"
 #include "itkTestingMacros.h"
 
+#include <algorithm>
+
 int
 itkWasmMeshInterfaceTest(int argc, char * argv[])
 {
@@ -61,6 +63,90 @@ itkWasmMeshInterfaceTest(int argc, char * argv[])
   ITK_TRY_EXPECT_NO_EXCEPTION(jsonToMeshFilter->Update());
   MeshType::Pointer convertedMesh = jsonToMeshFilter->GetOutput();
   std::cout << "convertedMesh: " << convertedMesh << std::endl;
+  ITK_TEST_EXPECT_TRUE(jsonToMeshFilter->GetPackCells());
+
+  // Packed cells match cells that are allocated one by one
+  auto cellByCellFilter = WasmMeshToMeshFilterType::New();
+  cellByCellFilter->SetInput(meshJSON);
+  cellByCellFilter->PackCellsOff();
+  ITK_TRY_EXPECT_NO_EXCEPTION(cellByCellFilter->Update());
+  const MeshType * cellByCellMesh = cellByCellFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(convertedMesh->GetNumberOfCells(), cellByCellMesh->GetNumberOfCells());
+  for (MeshType::CellIdentifier cellId = 0; cellId < cellByCellMesh->GetNumberOfCells(); ++cellId)
+  {
+    MeshType::CellAutoPointer packedCell;
+    MeshType::CellAutoPointer cell;
+    convertedMesh->GetCell(cellId, packedCell);
+    cellByCellMesh->GetCell(cellId, cell);
+    if (packedCell->GetType() != cell->GetType() ||
+        !std::equal(packedCell->PointIdsBegin(), packedCell->PointIdsEnd(), cell->PointIdsBegin(), cell->PointIdsEnd()))
+    {
+      std::cerr << "Packed cell " << cellId << " does not match" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Importing again replaces the packed cells
+  jsonToMeshFilter->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(jsonToMeshFilter->Update());
+  ITK_TEST_EXPECT_EQUAL(jsonToMeshFilter->GetOutput()->GetNumberOfCells(), cellByCellMesh->GetNumberOfCells());
+
+  // The cell buffer is cached until the cells are modified
+  const auto cellsArrayMatches = [](MeshType * mesh, const MeshToWasmMeshFilterType::WasmMeshType * wasmMesh) {
+    return mesh->GetCellsArray()->CastToSTLConstContainer() == wasmMesh->GetCellBuffer()->CastToSTLConstContainer();
+  };
+  ITK_TEST_EXPECT_TRUE(cellsArrayMatches(inputMesh, meshJSON));
+  auto cachedMeshToJSONFilter = MeshToWasmMeshFilterType::New();
+  cachedMeshToJSONFilter->SetInput(inputMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachedMeshToJSONFilter->Update());
+  ITK_TEST_EXPECT_TRUE(cachedMeshToJSONFilter->GetOutput()->GetCellBuffer() == meshJSON->GetCellBuffer());
+  inputMesh->GetCells()->Modified();
+  auto modifiedMeshToJSONFilter = MeshToWasmMeshFilterType::New();
+  modifiedMeshToJSONFilter->SetInput(inputMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(modifiedMeshToJSONFilter->Update());
+  ITK_TEST_EXPECT_TRUE(modifiedMeshToJSONFilter->GetOutput()->GetCellBuffer() != meshJSON->GetCellBuffer());
+  ITK_TEST_EXPECT_TRUE(cellsArrayMatches(inputMesh, modifiedMeshToJSONFilter->GetOutput()));
+
+  // The buffer cached on import, if any, matches the imported cells
+  ITK_TEST_EXPECT_TRUE(!jsonToMeshFilter->GetCacheCellBuffer());
+  auto convertedMeshToJSONFilter = MeshToWasmMeshFilterType::New();
+  convertedMeshToJSONFilter->SetInput(convertedMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(convertedMeshToJSONFilter->Update());
+  ITK_TEST_EXPECT_TRUE(cellsArrayMatches(convertedMesh, convertedMeshToJSONFilter->GetOutput()));
+  auto cachingFilter = WasmMeshToMeshFilterType::New();
+  cachingFilter->SetInput(meshJSON);
+  cachingFilter->CacheCellBufferOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachingFilter->Update());
+  MeshType::Pointer cachedImportMesh = cachingFilter->GetOutput();
+  auto cachedImportToJSONFilter = MeshToWasmMeshFilterType::New();
+  cachedImportToJSONFilter->SetInput(cachedImportMesh);
+  ITK_TRY_EXPECT_NO_EXCEPTION(cachedImportToJSONFilter->Update());
+  ITK_TEST_EXPECT_TRUE(cellsArrayMatches(cachedImportMesh, cachedImportToJSONFilter->GetOutput()));
+
+  // Float points are converted on import into a mesh with double coordinates
+  using DoubleMeshType = itk::Mesh<PixelType, Dimension, itk::DefaultStaticMeshTraits<PixelType, Dimension, Dimension, double>>;
+  using WasmMeshToDoubleMeshFilterType = itk::WasmMeshToMeshFilter<DoubleMeshType>;
+  auto floatPointsJSON = WasmMeshToDoubleMeshFilterType::WasmMeshType::New();
+  floatPointsJSON->SetJSON(meshJSON->GetJSON());
+  auto doubleMeshFilter = WasmMeshToDoubleMeshFilterType::New();
+  doubleMeshFilter->SetInput(floatPointsJSON);
+  ITK_TRY_EXPECT_NO_EXCEPTION(doubleMeshFilter->Update());
+  const DoubleMeshType * doubleMesh = doubleMeshFilter->GetOutput();
+  ITK_TEST_EXPECT_EQUAL(doubleMesh->GetNumberOfPoints(), inputMesh->GetNumberOfPoints());
+  ITK_TEST_EXPECT_EQUAL(doubleMesh->GetNumberOfCells(), convertedMesh->GetNumberOfCells());
+  for (MeshType::PointIdentifier pointId = 0; pointId < inputMesh->GetNumberOfPoints(); ++pointId)
+  {
+    const MeshType::PointType & point = inputMesh->GetPoint(pointId);
+    const DoubleMeshType::PointType & doublePoint = doubleMesh->GetPoint(pointId);
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      if (doublePoint[dim] != static_cast<double>(point[dim]))
+      {
+        std::cerr << "Converted point " << pointId << " does not match" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
 
   using WriterType = itk::MeshFileWriter<MeshType>;
   auto writer = WriterType::New();
@@ -0,0 +1,100 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkOutputBinaryStream.h"
+#include "itkOutputTextStream.h"
+#include "itkWasmExports.h"
+#include "itkWasmMemoryStreamBuffer.h"
+#include "itkWasmStringStream.h"
+#include "itkTestingMacros.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+int
+itkWasmOutputStreamTest(int, char *[])
+{
+  // The growable buffer keeps the furthest write when seeking back
+  itk::WasmGrowableOutputStream growableStream;
+  growableStream << "0123456789";
+  growableStream.seekp(2);
+  growableStream << "ab";
+  ITK_TEST_EXPECT_EQUAL(static_cast<size_t>(growableStream.tellp()), 4);
+  const itk::WasmGrowableStreamBuffer & growableBuffer = growableStream.GetStreamBuffer();
+  ITK_TEST_EXPECT_EQUAL(std::string(growableBuffer.GetData(), growableBuffer.GetSize()), std::string("01ab456789"));
+
+  const uint32_t memoryIndex = itk_wasm_context_create();
+  itk::wasm::WasmMemoryContext * context = itk::wasm::WasmMemoryContext::GetContext(memoryIndex);
+  context->SetUseMemoryIO(true);
+
+  std::vector<char> payload(3 * 1024 * 1024);
+  for (size_t ii = 0; ii < payload.size(); ++ii)
+  {
+    payload[ii] = static_cast<char>(ii % 251);
+  }
+  const std::string header("header");
+  const std::string text("test 123\n");
+  {
+    itk::wasm::OutputBinaryStream outputBinaryStream;
+    outputBinaryStream.SetMemoryContext(context);
+    ITK_TEST_EXPECT_TRUE(itk::wasm::lexical_cast("0", outputBinaryStream));
+    outputBinaryStream.Reserve(header.size());
+    outputBinaryStream.Get() << header;
+    // Appends beyond the reserved capacity grow the buffer
+    outputBinaryStream.Write(payload.data(), payload.size());
+
+    itk::wasm::OutputTextStream outputTextStream;
+    outputTextStream.SetMemoryContext(context);
+    ITK_TEST_EXPECT_TRUE(itk::wasm::lexical_cast("1", outputTextStream));
+    outputTextStream.Get() << text;
+  }
+
+  // The output buffers are exported in place
+  const size_t binaryAddress = itk_wasm_output_array_address(memoryIndex, 0, 0);
+  const size_t binarySize = itk_wasm_output_array_size(memoryIndex, 0, 0);
+  ITK_TEST_EXPECT_EQUAL(binarySize, header.size() + payload.size());
+  const char * binaryData = reinterpret_cast<const char *>(binaryAddress);
+  ITK_TEST_EXPECT_TRUE(std::memcmp(binaryData, header.data(), header.size()) == 0);
+  ITK_TEST_EXPECT_TRUE(std::memcmp(binaryData + header.size(), payload.data(), payload.size()) == 0);
+
+  const std::string binaryJSON(reinterpret_cast<const char *>(itk_wasm_output_json_address(memoryIndex, 0)),
+                               itk_wasm_output_json_size(memoryIndex, 0));
+  const std::string_view binaryJSONData = itk::WasmStringStream::GetDataFromJSON(binaryJSON.c_str());
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<size_t>(binaryJSONData.data()), binaryAddress);
+  ITK_TEST_EXPECT_EQUAL(binaryJSONData.size(), binarySize);
+
+  const size_t textAddress = itk_wasm_output_array_address(memoryIndex, 1, 0);
+  const size_t textSize = itk_wasm_output_array_size(memoryIndex, 1, 0);
+  ITK_TEST_EXPECT_EQUAL(std::string(reinterpret_cast<const char *>(textAddress), textSize), text);
+
+  // Strings set on a WasmStringStream share the output buffer
+  auto stringStream = itk::WasmStringStream::New();
+  stringStream->SetString(text);
+  ITK_TEST_EXPECT_EQUAL(stringStream->GetString(), text);
+  const std::string_view stringJSONData = itk::WasmStringStream::GetDataFromJSON(stringStream->GetJSON().c_str());
+  ITK_TEST_EXPECT_EQUAL(reinterpret_cast<size_t>(stringJSONData.data()),
+                        reinterpret_cast<size_t>(stringStream->GetOutputData().data()));
+  ITK_TEST_EXPECT_EQUAL(std::string(stringJSONData), text);
+  auto jsonStringStream = itk::WasmStringStream::New();
+  jsonStringStream->SetJSON(stringStream->GetJSON().c_str());
+  ITK_TEST_EXPECT_EQUAL(jsonStringStream->GetString(), text);
+
+  itk_wasm_context_delete(memoryIndex);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWasmImageIOFactory.h"
+#include "itkWasmImageIO.h"
+#include "itkWasmPayloadFilter.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+#include <vector>
+
+namespace
+{
+
+template <typename TPixel>
+int
+roundTripPayloadFilter(const char * inputImageFile, const std::string & outputImageFile, itk::WasmPayloadFilterEnum filter)
+{
+  constexpr unsigned int Dimension = 3;
+  using ImageType = itk::Image<TPixel, Dimension>;
+
+  typename ImageType::Pointer inputImage = nullptr;
+  ITK_TRY_EXPECT_NO_EXCEPTION(inputImage = itk::ReadImage<ImageType>(inputImageFile));
+
+  auto writeImageIO = itk::WasmImageIO::New();
+  writeImageIO->SetPayloadFilter(filter);
+  using WriterType = itk::ImageFileWriter<ImageType>;
+  auto writer = WriterType::New();
+  writer->SetImageIO(writeImageIO);
+  writer->SetFileName(outputImageFile);
+  writer->SetInput(inputImage);
+  ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+  auto readImageIO = itk::WasmImageIO::New();
+  using ReaderType = itk::ImageFileReader<ImageType>;
+  auto reader = ReaderType::New();
+  reader->SetImageIO(readImageIO);
+  reader->SetFileName(outputImageFile);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_EQUAL(readImageIO->GetPayloadFilter(), filter);
+
+  itk::ImageRegionConstIterator<ImageType> inputIt(inputImage, inputImage->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> readIt(reader->GetOutput(), inputImage->GetLargestPossibleRegion());
+  for (; !inputIt.IsAtEnd(); ++inputIt, ++readIt)
+  {
+    if (inputIt.Get() != readIt.Get())
+    {
+      std::cerr << "Pixel mismatch with the " << filter << " filter at " << inputIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+// Compare delta coding with a scalar reference for component types and
+// strides that take the vectorized and the scalar paths
+template <typename TComponent>
+int
+checkDeltaAgainstScalar(unsigned int numberOfComponents, itk::SizeValueType rowLength)
+{
+  const itk::SizeValueType numberOfElements = 1021;
+  std::vector<TComponent> input(numberOfElements);
+  std::vector<TComponent> expected(numberOfElements);
+  TComponent value = 1;
+  for (auto & element : input)
+  {
+    element = value;
+    value = static_cast<TComponent>(value * 2654435761u + 12345u);
+  }
+  const itk::SizeValueType rowElements = rowLength * numberOfComponents;
+  for (itk::SizeValueType ii = 0; ii < numberOfElements; ++ii)
+  {
+    expected[ii] = ii % rowElements < numberOfComponents ? input[ii]
+                                                         : static_cast<TComponent>(input[ii] - input[ii - numberOfComponents]);
+  }
+
+  itk::WasmPayloadLayout layout;
+  layout.componentSize = sizeof(TComponent);
+  layout.numberOfComponents = numberOfComponents;
+  layout.rowLength = rowLength;
+  std::vector<TComponent> encoded(numberOfElements);
+  std::vector<TComponent> decoded(numberOfElements);
+  const itk::SizeValueType numberOfBytes = numberOfElements * sizeof(TComponent);
+  itk::applyPayloadFilter(itk::WasmPayloadFilterEnum::Delta, layout, input.data(), encoded.data(), numberOfBytes);
+  itk::reversePayloadFilter(itk::WasmPayloadFilterEnum::Delta, layout, encoded.data(), decoded.data(), numberOfBytes);
+  if (encoded != expected || decoded != input)
+  {
+    std::cerr << "Delta coding mismatch for " << sizeof(TComponent) << " byte components, " << numberOfComponents
+              << " components and rows of " << rowLength << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+} // end anonymous namespace
+
+int
+itkWasmPayloadFilterTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Missing parameters" << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " InputImage OutputPrefix" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char * inputImageFile = argv[1];
+  const std::string outputPrefix = argv[2];
+
+  itk::WasmImageIOFactory::RegisterOneFactory();
+
+  int result = EXIT_SUCCESS;
+  for (const auto filter : { itk::WasmPayloadFilterEnum::Shuffle, itk::WasmPayloadFilterEnum::Delta,
+                             itk::WasmPayloadFilterEnum::DeltaShuffle })
+  {
+    const std::string filterName = itk::payloadFilterToString(filter);
+    ITK_TEST_EXPECT_EQUAL(itk::payloadFilterFromString(filterName), filter);
+    if (roundTripPayloadFilter<short>(inputImageFile, outputPrefix + "." + filterName + ".short.iwi.cbor", filter) != EXIT_SUCCESS ||
+        roundTripPayloadFilter<float>(inputImageFile, outputPrefix + "." + filterName + ".float.iwi.cbor", filter) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  for (const unsigned int numberOfComponents : { 1u, 3u, 4u, 8u })
+  {
+    for (const itk::SizeValueType rowLength : { 1u, 17u, 256u })
+    {
+      if (checkDeltaAgainstScalar<uint8_t>(numberOfComponents, rowLength) != EXIT_SUCCESS ||
+          checkDeltaAgainstScalar<uint16_t>(numberOfComponents, rowLength) != EXIT_SUCCESS ||
+          checkDeltaAgainstScalar<uint32_t>(numberOfComponents, rowLength) != EXIT_SUCCESS)
+      {
+        result = EXIT_FAILURE;
+      }
+    }
+  }
+  try
+  {
+    itk::payloadFilterFromString("unknown");
+    std::cerr << "Expected an unknown payload filter name to throw" << std::endl;
+    result = EXIT_FAILURE;
+  }
+  catch (const std::runtime_error &)
+  {
+  }
+
+  return result;
+}